@@ -4,13 +4,32 @@
   - Right joystick = Steering (Manual = direct servo, Off = planner)
   - Modes: Normal / Crab / Circle (diameter)
   - Speeds: Low / Normal / Sport
-  - Recorder: 5 slots with auto-wrap, list/record/play/clear/abort
+  - Recorder: REC_SLOTS slots with auto-wrap, list/record/play/clear/abort
   - Fix: Record & replay servo angles when manual-steer is ON
+  - Control: binary WebSocket setpoints on WS_PORT (latest wins), GET fallback
+  - Servos: vel/acc-limited non-blocking slews (ServoControl::update)
+  - Playback: interpolated at the control rate, 0.25x-4x rate, loop, start offset
+  - Command state published as one SeqLock snapshot (no torn reads in control)
+  - /metrics: timing histograms, counters, heap (Prometheus text or ?format=json)
+  - Recording: control task captures into a ring, loop commits whole blocks
+  - Takes stored as keyframe + delta/run-length blocks (format v2)
+  - Binary-search seek (/rec/seek) over fixed-size blocks, instant reverse start
+  - UI built from ui/ (tools/build_ui.py): minified, gzip, ETag / 304
+  - Optional encoder PI wheel speed loop (WHEEL_SPEED_LOOP, PCNT encoders)
+  - Per-side wheel speeds from the 4WS kinematics (inner side slower)
+  - Power governor: wheel accel/jerk ramps + servo slew sharing under a current budget
+  - Gimbal: MPU-6050 FIFO + fixed-point complementary filter hold the camera (/gimbal)
+  - /trace: cycle-stamped span ring as Chrome trace JSON (also "trace" on serial)
+  - Serial link: COBS/CRC16 framed setpoints + telemetry at SLINK_BAUD (SerialLink.h)
+  - /preset: straight / arc / orbit moves with eased drive, generated at the control rate
+  - Takes in preallocated slots on a raw 'takes' partition: O(1) start/stop/clear, power-cut safe
+  - /rec/download (Range, ETag) and /rec/upload (streamed, checked per block), paced to REC_XFER_RATE_KBPS
 */
 
 #include <Arduino.h>
 #include <WiFi.h>
 #include <WebServer.h>
+#include <WebSocketsServer.h>
 #include <FS.h>
 #include <SPIFFS.h>
 
@@ -21,6 +40,19 @@
 #include "MotionPlanner.h"
 #include "Speed.h"
 #include "Recorder.h"
+#include "SlotStore.h"
+#include "SlotCatalog.h"
+#include "ControlTask.h"
+#include "CtlProto.h"
+#include "SerialLink.h"
+#include "Preset.h"
+#include "SeqLock.h"
+#include "Metrics.h"
+#include "Trace.h"
+#include "PowerGovernor.h"
+#include "Imu.h"
+#include "Stabilizer.h"
+#include "ui_index.h"
 
 #ifndef SERIAL_BAUD
 #define SERIAL_BAUD 115200
@@ -30,19 +62,30 @@
 ServoControl servoFront, servoRear;
 WheelControl wheels;
 WebServer server(HTTP_PORT);
+WebSocketsServer ws(WS_PORT);
 Recorder recorder;
-
-// State
-volatile float driveY = 0.0f;
-volatile float steerX = 0.0f;
-volatile float steerY = 0.0f;
-volatile UIMode uiMode = MODE_NORMAL;
-volatile float circleDiam = 1.0f;     // 0..1
-volatile bool manualSteer = true;     // ON = right pad moves servos directly
-volatile bool eStop = false;
-
-volatile int g_manualFF = SERVO_CENTER;  // last manual targets
-volatile int g_manualFR = SERVO_CENTER;
+ControlTask ctl;
+
+// ==== Command state ====
+// HTTP/WS handlers (loop task) edit s_cmd and publish the whole struct;
+// the control step reads one consistent snapshot per cycle, lock-free.
+struct ControlCmd {
+  float   drive  = 0.0f;   // -1..+1
+  float   steerX = 0.0f;   // -1..+1
+  float   steerY = 0.0f;
+  float   diam   = 1.0f;   // 0..1
+  int16_t ff = SERVO_CENTER, fr = SERVO_CENTER; // last manual targets
+  uint8_t mode   = MODE_NORMAL;
+  uint8_t speed  = SPEED_NORMAL;
+  uint8_t manual = 1;      // ON = right pad moves servos directly
+  uint8_t estop  = 0;
+  float   tilt = 0, roll = 0; // gimbal: camera angles vs the horizon (deg)
+  uint8_t stab   = 1;      // gimbal holds tilt/roll against body motion
+  uint8_t leadMs = (uint8_t)STAB_LEAD_MS;
+};
+static ControlCmd s_cmd;               // loop side only
+static SeqLock<ControlCmd> g_cmd;      // published snapshot
+static uint32_t g_cmdRetries = 0, g_cmdStale = 0; // control side
 
 // Helpers
 static inline int clampInt(int v,int lo,int hi){return (v<lo)?lo:((v>hi)?hi:v);}
@@ -52,298 +95,105 @@ static inline void setFrontSteer(int d){ servoFront.writeDeg(clampInt(d, FF_MIN,
 static inline void setRearSteer (int d){ servoRear .writeDeg(clampInt(d, FR_MIN, FR_MAX)); }
 static inline void centerSteer(){ setFrontSteer(SERVO_CENTER); setRearSteer(SERVO_CENTER); }
 
-// ==== Recorder: 5-slot ring ====
-static const int  REC_SLOTS = 5;
-static const char* META_NEXT_PATH = "/rec_next.txt";
-
-static int readNextSlot() {
-  if (!SPIFFS.exists(META_NEXT_PATH)) return 1;
-  File f = SPIFFS.open(META_NEXT_PATH, FILE_READ);
-  if (!f) return 1;
-  String s = f.readString(); f.close();
-  int n = s.toInt();
-  if (n < 1 || n > REC_SLOTS) n = 1;
-  return n;
-}
-static void writeNextSlot(int next) {
-  if (next < 1 || next > REC_SLOTS) next = 1;
-  File f = SPIFFS.open(META_NEXT_PATH, FILE_WRITE);
-  if (!f) return;
-  f.printf("%d", next);
-  f.close();
-}
-static void pathForSlot(int slot, char* dst, size_t cap, bool meta=false) {
-  snprintf(dst, cap, meta ? "/rec%d.meta" : "/rec%d.jsonl", slot);
-}
-static int slotAfter(int slot) { ++slot; if (slot > REC_SLOTS) slot = 1; return slot; }
-
-// ==== UI (ASCII only; flexible layout) ====
-const char PAGE_INDEX[] PROGMEM = R"HTML(
-<!doctype html><html><head>
-<meta charset="utf-8"><meta name="viewport" content="width=device-width,initial-scale=1">
-<title>CamMate</title>
-<style>
-  :root{ --pad: min(40vw, 360px); --dot: 18px; }
-  body{font-family:sans-serif;margin:10px}
-  .row{display:flex;gap:12px;flex-wrap:wrap;align-items:flex-start}
-  .card{border:1px solid #ddd;border-radius:12px;padding:12px}
-  .pads{display:flex;gap:12px;flex-wrap:wrap}
-  .pad{width:var(--pad);height:var(--pad);background:#f2f2f2;border-radius:12px;position:relative;touch-action:none}
-  .pad .label{position:absolute;left:10px;top:10px;background:#fff;border:1px solid #ccc;border-radius:8px;padding:2px 8px;font-size:12px}
-  .dot{position:absolute;width:var(--dot);height:var(--dot);border-radius:50%;background:#222;transform:translate(-50%,-50%);border:2px solid #fff;box-shadow:0 0 3px rgba(0,0,0,0.4)}
-  h2{margin:6px 0 12px}
-  button{padding:8px 12px;border-radius:8px;border:1px solid #aaa;background:#fafafa;margin:3px;cursor:pointer}
-  button.sel{background:#333;color:#fff}
-  button.warn{background:#ffecec;border-color:#e53935}
-  .badge{display:inline-block;padding:2px 8px;border-radius:999px;background:#222;color:#fff;font-size:12px}
-  input[type=range]{width:220px}
-  table{border-collapse:collapse;margin-top:8px;font-size:13px}
-  th,td{padding:6px 8px;border:1px solid #ddd}
-  .stack{display:flex;flex-direction:column;gap:10px}
-</style>
-</head><body>
-<h2>CamMate <span id="spdBadge" class="badge">Normal</span></h2>
-
-<div class="row">
-  <div class="pads">
-    <div class="pad card" id="padDrive">
-      <div class="label">Drive</div>
-      <div class="dot" id="dotDrive" style="left:50%;top:50%"></div>
-    </div>
-    <div class="pad card" id="padSteer">
-      <div class="label">Steer</div>
-      <div class="dot" id="dotSteer" style="left:50%;top:50%"></div>
-    </div>
-  </div>
-
-  <div class="card stack">
-    <div>
-      <div>Manual Steer:
-        <button id="msOn"  class="sel">On</button>
-        <button id="msOff">Off</button>
-      </div>
-      <div id="modeRow" style="margin-top:6px">
-        Mode:
-        <label><input type="radio" name="mode" value="0" checked> Normal</label>
-        <label><input type="radio" name="mode" value="1"> Crab</label>
-        <label><input type="radio" name="mode" value="2"> Circle</label>
-      </div>
-      <div id="diamRow" style="margin-top:6px">
-        Circle diameter
-        <input id="diam" type="range" min="0" max="1" step="0.01" value="1">
-        <span id="dval" class="badge">1.00</span>
-      </div>
-    </div>
-
-    <div>
-      <button id="center">Center</button>
-      <button id="stop" class="warn">STOP</button>
-      <button id="abort" class="warn">Stop Playback</button>
-    </div>
-
-    <div>
-      Speed:
-      <button id="spdLow">Low</button>
-      <button id="spdNormal" class="sel">Normal</button>
-      <button id="spdSport">Sport</button>
-    </div>
-  </div>
-
-  <div class="card" style="min-width:320px">
-    <h3 style="margin:4px 0 8px">Recorder (5 slots)</h3>
-    <div>
-      Active slot:
-      <span id="slots"></span>
-      <button id="refresh">Refresh</button>
-    </div>
-    <table id="tbl">
-      <thead><tr><th>#</th><th>Status</th><th>Frames</th><th>Dur(ms)</th><th>Size</th></tr></thead>
-      <tbody></tbody>
-    </table>
-    <div style="margin-top:8px">
-      <button id="recAuto"  class="warn">Record (Auto-slot)</button>
-      <button id="recTo">Record to Slot</button>
-      <button id="recStop">Stop Record</button>
-    </div>
-    <div style="margin-top:6px">
-      <button id="playF">Play Forward</button>
-      <button id="playR">Play Reverse</button>
-      <button id="clear">Clear Slot</button>
-    </div>
-  </div>
-</div>
-
-<script>
-const DEAD=0.07; // dead-zone
-let manual=true, mode=0, diam=1.0, slot=1;
-let spd='normal';
-const badge=document.getElementById('spdBadge');
-
-function clamp(v,a,b){return v<a?a:(v>b?b:v);}
-function dead(v){return Math.abs(v)<DEAD?0:v;}
-
-function setupPad(id, cb){
-  const pad=document.getElementById(id), dot=pad.querySelector('.dot');
-  let active=false;
-  function setDot(px,py){ dot.style.left=px+'px'; dot.style.top=py+'px'; }
-  function center(){ setDot(pad.clientWidth/2, pad.clientHeight/2); }
-  pad.addEventListener('pointerdown',e=>{active=true;pad.setPointerCapture(e.pointerId);handle(e);});
-  pad.addEventListener('pointermove',e=>{ if(active) handle(e); });
-  pad.addEventListener('pointerup',e=>{ active=false; center(); cb(0,0); });
-  function handle(e){
-    const r=pad.getBoundingClientRect();
-    let px=e.clientX, py=e.clientY;
-    px=clamp(px,r.left,r.right); py=clamp(py,r.top,r.bottom);
-    const nx=((px-r.left)/r.width)*2-1;
-    const ny=((py-r.top)/r.height)*2-1;
-    const x=dead(nx), y=dead(ny);
-    setDot(px-r.left,py-r.top);
-    cb(x,-y);
-  }
-  center();
-}
+static uint32_t s_cmdMs = 0;           // last publishCmd() (loop side)
+static void publishCmd(){ g_cmd.store(s_cmd); s_cmdMs = millis(); }
 
-setupPad('padDrive', (x,y)=>{
-  fetch(`/ctl_drive?y=${y.toFixed(3)}`).catch(()=>{});
-});
+// ==== Recorder slots (SlotStore.h, SlotCatalog.h) ====
+SlotStore store;
+SlotCatalog catalog;
+PowerGovernor gov;
 
-setupPad('padSteer', (x,y)=>{
-  if (manual)
-    fetch(`/ctl_servos?x=${x.toFixed(3)}&y=${y.toFixed(3)}`).catch(()=>{});
-  else
-    fetch(`/ctl_steer?x=${x.toFixed(3)}&y=${y.toFixed(3)}&mode=${mode}&diam=${diam.toFixed(2)}`).catch(()=>{});
-});
-
-// Manual steer toggle
-const msOn = document.getElementById('msOn');
-const msOff= document.getElementById('msOff');
-function setManual(on){
-  manual=on;
-  msOn.classList.toggle('sel', on);
-  msOff.classList.toggle('sel', !on);
-  document.getElementById('modeRow').style.opacity = on ? 0.45 : 1;
-  document.getElementById('diamRow').style.opacity = on ? 0.45 : 1;
-  fetch(`/ui/manual_steer?on=${on?1:0}`).catch(()=>{});
-}
-msOn.onclick = ()=> setManual(true);
-msOff.onclick= ()=> setManual(false);
-
-// Modes + diameter
-document.querySelectorAll('input[name=mode]').forEach(r=>{
-  r.addEventListener('change', ()=>{
-    mode = Number(document.querySelector('input[name=mode]:checked').value);
-  });
-});
-const diamEl=document.getElementById('diam'), dval=document.getElementById('dval');
-diamEl.addEventListener('input', ()=>{
-  diam = Number(diamEl.value);
-  dval.textContent = diam.toFixed(2);
-});
-
-// Speed
-function setSpeed(s){
-  spd=s;
-  badge.textContent = s.charAt(0).toUpperCase()+s.slice(1);
-  document.getElementById('spdLow').classList.toggle('sel', s==='low');
-  document.getElementById('spdNormal').classList.toggle('sel', s==='normal');
-  document.getElementById('spdSport').classList.toggle('sel', s==='sport');
-  fetch(`/speed?mode=${s}`).catch(()=>{});
-}
-document.getElementById('spdLow').onclick=()=>setSpeed('low');
-document.getElementById('spdNormal').onclick=()=>setSpeed('normal');
-document.getElementById('spdSport').onclick=()=>setSpeed('sport');
-
-// Center / stop / abort
-document.getElementById('center').onclick=()=>fetch('/center').catch(()=>{});
-document.getElementById('stop').onclick  =()=>fetch('/stop').catch(()=>{});
-document.getElementById('abort').onclick =()=>fetch('/rec/abort').catch(()=>{});
-
-// Recorder UI
-const slotsDiv=document.getElementById('slots');
-const tbody=document.querySelector('#tbl tbody');
-function drawSlots(){
-  slotsDiv.innerHTML='';
-  for(let i=1;i<=5;i++){
-    const b=document.createElement('button');
-    b.textContent=i; if(i===slot) b.classList.add('sel');
-    b.onclick=()=>{ slot=i; drawSlots(); };
-    slotsDiv.appendChild(b);
-  }
-}
-drawSlots();
-
-function refreshList(){
-  fetch('/rec/list').then(r=>r.json()).then(arr=>{
-    tbody.innerHTML='';
-    arr.forEach(it=>{
-      const tr=document.createElement('tr');
-      tr.innerHTML = `<td>${it.slot}</td>
-        <td>${it.exists?'OK':'(empty)'}</td>
-        <td>${it.frames||0}</td>
-        <td>${it.duration_ms||0}</td>
-        <td>${it.bytes||0}</td>`;
-      tbody.appendChild(tr);
-    });
-  }).catch(()=>{});
-}
-document.getElementById('refresh').onclick=refreshList;
-refreshList();
-
-// Record / Play / Clear
-document.getElementById('recAuto').onclick = ()=>fetch('/rec/start').then(refreshList);
-document.getElementById('recTo').onclick   = ()=>fetch(`/rec/start?slot=${slot}`).then(refreshList);
-document.getElementById('recStop').onclick = ()=>fetch('/rec/stop').then(refreshList);
-document.getElementById('playF').onclick   = ()=>fetch(`/rec/play?slot=${slot}&dir=f`);
-document.getElementById('playR').onclick   = ()=>fetch(`/rec/play?slot=${slot}&dir=r`);
-document.getElementById('clear').onclick   = ()=>fetch(`/rec/clear?slot=${slot}`).then(refreshList);
-
-// Defaults
-setManual(true);
-setSpeed('normal');
-</script>
-</body></html>
-)HTML";
+// ==== Motion presets (Preset.h) ====
+PresetRunner presets;
+static PresetPlan s_presetPlan;  // last started (loop side, for /preset/status)
+
+// ==== Gimbal (Imu.h, Stabilizer.h) ====
+#if GIMBAL_ENABLED
+ServoControl servoTilt, servoRoll;
+Mpu6050 imu;
+Stabilizer stab;
+#endif
 
 // ==== HTTP Handlers ====
-static void handleIndex(){ server.send_P(200, "text/html", PAGE_INDEX); }
+// UI page: gzip built from ui/ by tools/build_ui.py; revalidated by ETag
+static void handleIndex(){
+  server.sendHeader("ETag", UI_INDEX_ETAG);
+  server.sendHeader("Cache-Control", "no-cache");
+  if (server.header("If-None-Match") == UI_INDEX_ETAG) { server.send(304); return; }
+  server.sendHeader("Content-Encoding", "gzip");
+  server.send_P(200, "text/html", (PGM_P)UI_INDEX_GZ, UI_INDEX_GZ_LEN);
+}
 
 static void handleCtlDrive(){
-  if (server.hasArg("y")) driveY = clamp11(server.arg("y").toFloat());
-  recorder.pushLive(manualSteer, steerX, driveY, uiMode, circleDiam, g_speedMode, g_manualFF, g_manualFR);
-  eStop = false;
+  if (server.hasArg("y")) s_cmd.drive = clamp11(server.arg("y").toFloat());
+  s_cmd.estop = 0;
+  publishCmd();
   server.send(204);
 }
 
 static void handleCtlSteer(){
-  if (server.hasArg("x")) steerX = clamp11(server.arg("x").toFloat());
-  if (server.hasArg("y")) steerY = clamp11(server.arg("y").toFloat());
-  if (server.hasArg("mode")) uiMode = (UIMode)server.arg("mode").toInt();
-  if (server.hasArg("diam")) circleDiam = clamp01(server.arg("diam").toFloat());
-  recorder.pushLive(manualSteer, steerX, driveY, uiMode, circleDiam, g_speedMode, g_manualFF, g_manualFR);
-  eStop = false;
+  long mode = server.hasArg("mode") ? server.arg("mode").toInt() : s_cmd.mode;
+  if (mode < MODE_NORMAL || mode > MODE_CIRCLE) { server.send(400, "text/plain", "mode out of range"); return; }
+  if (server.hasArg("x")) s_cmd.steerX = clamp11(server.arg("x").toFloat());
+  if (server.hasArg("y")) s_cmd.steerY = clamp11(server.arg("y").toFloat());
+  s_cmd.mode = (uint8_t)mode;
+  if (server.hasArg("diam")) s_cmd.diam = clamp01(server.arg("diam").toFloat());
+  s_cmd.estop = 0;
+  publishCmd();
   server.send(204);
 }
 
+static void setManualServos(float x, float y){
+  int ff = SERVO_CENTER + (int)roundf(x * (FF_MAX - SERVO_CENTER));
+  int fr = SERVO_CENTER + (int)roundf(y * (FR_MAX - SERVO_CENTER));
+  s_cmd.ff = (int16_t)clampInt(ff, FF_MIN, FF_MAX);
+  s_cmd.fr = (int16_t)clampInt(fr, FR_MIN, FR_MAX);
+}
+
 static void handleCtlServos(){
   float x = 0, y = 0;
   if (server.hasArg("x")) x = clamp11(server.arg("x").toFloat());
   if (server.hasArg("y")) y = clamp11(server.arg("y").toFloat());
-  int ff = SERVO_CENTER + (int)roundf(x * (FF_MAX - SERVO_CENTER));
-  int fr = SERVO_CENTER + (int)roundf(y * (FR_MAX - SERVO_CENTER));
-  g_manualFF = clampInt(ff, FF_MIN, FF_MAX);
-  g_manualFR = clampInt(fr, FR_MIN, FR_MAX);
-  recorder.pushLive(true, steerX, driveY, uiMode, circleDiam, g_speedMode, g_manualFF, g_manualFR);
-  eStop = false;
+  setManualServos(x, y);
+  s_cmd.estop = 0;
+  publishCmd();
   server.send(204);
 }
 
 static void handleManual(){ // /ui/manual_steer?on=1|0
-  if (server.hasArg("on")) manualSteer = (server.arg("on").toInt()!=0);
+  if (server.hasArg("on")) s_cmd.manual = (server.arg("on").toInt()!=0);
+  publishCmd();
   server.send(204);
 }
 
-static void handleCenter(){ centerSteer(); eStop=false; server.send(204); }
-static void handleStop(){ eStop = true; server.send(204); }
+// Servos are only written by the control step; center by moving its targets.
+static void handleCenter(){
+  s_cmd.steerX = 0.0f;
+  s_cmd.ff = SERVO_CENTER;
+  s_cmd.fr = SERVO_CENTER;
+  s_cmd.estop = 0;
+  publishCmd();
+  server.send(204);
+}
+// /gimbal?tilt=DEG&roll=DEG&stab=0|1&lead_ms=N
+static void handleGimbal(){
+  const float r = GIMBAL_RANGE_DEG;
+  if (server.hasArg("tilt")) s_cmd.tilt = fmaxf(-r, fminf(server.arg("tilt").toFloat(), r));
+  if (server.hasArg("roll")) s_cmd.roll = fmaxf(-r, fminf(server.arg("roll").toFloat(), r));
+  if (server.hasArg("stab")) s_cmd.stab = (server.arg("stab").toInt()!=0);
+  if (server.hasArg("lead_ms")) s_cmd.leadMs = (uint8_t)clampInt(server.arg("lead_ms").toInt(), 0, 100);
+  publishCmd();
+  server.send(204);
+}
+
+// GET /stop, /rec/abort (playback) and the WS stop flags
+static void stopMotion(bool playback){
+  if (playback) recorder.stopPlayback();
+  presets.cancel();
+  s_cmd.estop = 1;
+  publishCmd();
+}
+static void handleStop(){ stopMotion(false); server.send(204); }
 
 static void handleSpeed(){
   if (server.hasArg("mode")) {
@@ -351,65 +201,403 @@ static void handleSpeed(){
     if      (m=="sport")  g_speedMode = SPEED_SPORT;
     else if (m=="low")    g_speedMode = SPEED_LOW;
     else                  g_speedMode = SPEED_NORMAL;
+    s_cmd.speed = g_speedMode;
+    publishCmd();
   }
   server.send(204);
 }
 
 // Recorder: list/record/play/clear/abort (slot-aware)
 static void handleRecList(){
-  String out = "[";
-  for (int s=1; s<=REC_SLOTS; ++s) {
-    char pJson[20], pMeta[20];
-    pathForSlot(s, pJson, sizeof(pJson), false);
-    pathForSlot(s, pMeta, sizeof(pMeta), true);
-    bool exists = SPIFFS.exists(pJson);
-    uint32_t frames=0, dur=0, bytes=0;
-    if (exists) {
-      File f = SPIFFS.open(pJson, FILE_READ);
-      if (f) { bytes = f.size(); f.close(); }
-      Recorder::readMeta(pMeta, frames, dur);
-    }
-    out += String("{\"slot\":")+s+",\"exists\":"+(exists?"true":"false")+
-           ",\"frames\":"+frames+",\"duration_ms\":"+dur+",\"bytes\":"+bytes+"}";
-    if (s<REC_SLOTS) out += ",";
-  }
-  out += "]";
-  server.send(200,"application/json", out);
+  size_t n;
+  const char* j = catalog.json(n);
+  server.send_P(200, "application/json", j, n);
 }
 
 static void handleRecStart(){
   int reqSlot = server.hasArg("slot") ? server.arg("slot").toInt() : 0;
-  int slot = (reqSlot>=1 && reqSlot<=REC_SLOTS) ? reqSlot : readNextSlot();
-  char pJson[20], pMeta[20];
-  pathForSlot(slot, pJson, sizeof(pJson), false);
-  pathForSlot(slot, pMeta, sizeof(pMeta), true);
-  if (recorder.startRecording(pJson, pMeta)) {
-    if (reqSlot==0) writeNextSlot(slotAfter(slot));
+  int slot = SlotStore::valid(reqSlot) ? reqSlot : store.next();
+  if (recorder.startRecording(slot, reqSlot==0 ? SlotStore::after(slot) : 0))
     server.send(200,"text/plain","REC START");
-  } else {
+  else
     server.send(500,"text/plain", recorder.lastError());
-  }
 }
-static void handleRecStop(){ recorder.stopRecording(); server.send(200,"text/plain","REC STOP"); }
+static void handleRecStop(){
+  recorder.stopRecording();
+  server.send(200,"text/plain","REC STOP");
+}
 
 static void handleRecPlay(){
   int slot = server.hasArg("slot") ? server.arg("slot").toInt() : 1;
-  char pJson[20]; pathForSlot(slot, pJson, sizeof(pJson), false);
   String dir = server.hasArg("dir") ? server.arg("dir") : "f";
-  bool ok = recorder.startPlayback(dir=="r" ? PLAY_REVERSE : PLAY_FORWARD, pJson);
+  float rate = server.hasArg("rate") ? server.arg("rate").toFloat() : 1.0f;
+  bool  loop = server.hasArg("loop") && server.arg("loop") == "1";
+  int32_t from = server.hasArg("from") ? (int32_t)server.arg("from").toInt() : -1; // ms
+  bool ok = recorder.startPlayback(dir=="r" ? PLAY_REVERSE : PLAY_FORWARD, slot, rate, loop, from);
+  if (ok) presets.cancel();
   if (ok) server.send(200,"text/plain","PLAY");
   else    server.send(500,"text/plain", recorder.lastError());
 }
 static void handleRecClear(){
   int slot = server.hasArg("slot") ? server.arg("slot").toInt() : 1;
-  char pJson[20], pMeta[20];
-  pathForSlot(slot, pJson, sizeof(pJson), false);
-  pathForSlot(slot, pMeta, sizeof(pMeta), true);
-  bool ok1 = recorder.clearFile(pJson);
-  bool ok2 = recorder.clearFile(pMeta);
-  server.send((ok1&&ok2)?200:500, "text/plain", (ok1&&ok2)?"CLEARED":"ERR");
+  bool ok = recorder.clearSlot(slot);
+  server.send(ok?200:500, "text/plain", ok?"CLEARED":recorder.lastError());
+}
+static void handleRecSeek(){
+  uint32_t ms = server.hasArg("ms") ? (uint32_t)server.arg("ms").toInt() : 0;
+  if (recorder.seek(ms)) server.send(200,"text/plain","SEEK");
+  else                   server.send(409,"text/plain", recorder.state()==REC_PLAYING ? recorder.lastError() : "not playing");
+}
+static void handleRecAbort(){ stopMotion(true); server.send(200,"text/plain","ABORTED"); }
+
+// /preset?type=straight|arc|orbit&dist_mm=&dur_ms=&speed=MM_S&radius_mm=
+//   &angle_deg=&turns=&dir=left|right&crab=-1..1&ease=none|linear|smooth
+//   &ramp_ms=&reverse=1
+static void handlePreset(){
+  PresetSpec sp;
+  String type = server.hasArg("type") ? server.arg("type") : "straight";
+  if (type == "arc") sp.type = PRESET_ARC;
+  else if (type == "orbit") sp.type = PRESET_ORBIT;
+  else if (type != "straight") { server.send(400, "text/plain", "type: straight|arc|orbit"); return; }
+  if (server.hasArg("ease")) {
+    String e = server.arg("ease");
+    sp.ease = (e == "none") ? EASE_NONE : (e == "linear") ? EASE_LINEAR : EASE_SMOOTH;
+  }
+  sp.left = server.hasArg("dir") && server.arg("dir") == "left";
+  sp.reverse = server.hasArg("reverse") && server.arg("reverse").toInt() != 0;
+  if (server.hasArg("speed"))     sp.speedMmS = server.arg("speed").toFloat();
+  if (server.hasArg("dist_mm"))   sp.distMm = server.arg("dist_mm").toFloat();
+  if (server.hasArg("dur_ms"))    sp.durMs = (uint32_t)server.arg("dur_ms").toInt();
+  if (server.hasArg("radius_mm")) sp.radiusMm = server.arg("radius_mm").toFloat();
+  if (server.hasArg("angle_deg")) sp.angleDeg = server.arg("angle_deg").toFloat();
+  if (server.hasArg("turns"))     sp.angleDeg = 360.0f * server.arg("turns").toFloat();
+  if (server.hasArg("crab"))      sp.crab = server.arg("crab").toFloat();
+  if (server.hasArg("ramp_ms"))   sp.rampMs = (uint16_t)clampInt(server.arg("ramp_ms").toInt(), 0, 10000);
+  char err[64];
+  PresetPlan p;
+  if (!presetCompile(sp, p, err, sizeof(err))) { server.send(400, "text/plain", err); return; }
+  if (recorder.state() == REC_PLAYING) recorder.stopPlayback();
+  s_presetPlan = p;
+  presets.start(p);
+  s_cmd.estop = 0; publishCmd();
+  char buf[160];
+  snprintf(buf, sizeof(buf), "{\"run_ms\":%u,\"dist_mm\":%.0f,\"speed_mm_s\":%.1f,\"radius_mm\":%.1f}",
+           (unsigned)p.runMs, p.distMm, p.speedMmS, isinf(p.radiusMm) ? 0.0f : p.radiusMm);
+  server.send(200, "application/json", buf);
+}
+static void handlePresetStop(){ presets.stop(); server.send(204); }
+static void handlePresetStatus(){
+  static const char* PH[] = { "idle", "settle", "run", "stopping" };
+  char buf[160];
+  snprintf(buf, sizeof(buf), "{\"phase\":\"%s\",\"t_ms\":%u,\"run_ms\":%u,\"dist_mm\":%.0f,\"speed_mm_s\":%.1f}",
+           PH[presets.phase() & 3], (unsigned)presets.elapsedMs(), (unsigned)s_presetPlan.runMs,
+           s_presetPlan.distMm, s_presetPlan.speedMmS);
+  server.send(200, "application/json", buf);
+}
+
+// ==== WebSocket control channel (latest setpoint wins) ====
+// Frames drained by one ws.loop() overwrite each other; only the newest is
+// applied afterwards. Frames older than the client's last seq are dropped;
+// a stop flag on any of them still applies. While a /rec transfer holds the
+// HTTP server this channel (and serial) is the only way to stop.
+static CtlMsg   s_wsCmd;
+static bool     s_wsHave = false;
+static uint16_t s_wsSeq[WEBSOCKETS_SERVER_CLIENT_MAX];
+static bool     s_wsSeqValid[WEBSOCKETS_SERVER_CLIENT_MAX];
+static uint8_t  s_wsStop = 0;  // ESTOP/ABORT flags since the last serviceWs()
+uint32_t g_ctlMsgs = 0, g_ctlStale = 0, g_ctlCoalesced = 0;
+
+static void onWsEvent(uint8_t num, WStype_t type, uint8_t* payload, size_t len){
+  if (num >= WEBSOCKETS_SERVER_CLIENT_MAX) return;
+  if (type == WStype_CONNECTED || type == WStype_DISCONNECTED) { s_wsSeqValid[num] = false; return; }
+  if (type != WStype_BIN || len != sizeof(CtlMsg)) return;
+  CtlMsg m; memcpy(&m, payload, sizeof(m));
+  if (m.ver != CTL_MSG_VERSION) return;
+  g_ctlMsgs++;
+  s_wsStop |= m.flags & (CTL_FLAG_ESTOP | CTL_FLAG_ABORT);
+  if (s_wsSeqValid[num] && !ctlSeqNewer(m.seq, s_wsSeq[num])) { g_ctlStale++; return; }
+  s_wsSeq[num] = m.seq; s_wsSeqValid[num] = true;
+  if (s_wsHave) g_ctlCoalesced++;
+  s_wsCmd = m; s_wsHave = true;
+}
+
+static void applyCtlMsg(const CtlMsg& m){
+  float x = clamp11(ctlQ14(m.sx)), y = clamp11(ctlQ14(m.sy));
+  s_cmd.drive  = clamp11(ctlQ14(m.drive));
+  s_cmd.manual = (m.flags & CTL_FLAG_MANUAL) != 0;
+  if (s_cmd.manual) {
+    setManualServos(x, y);
+  } else {
+    s_cmd.steerX = x; s_cmd.steerY = y;
+    uint8_t md = m.flags & 0x03;
+    if (md <= MODE_CIRCLE) s_cmd.mode = md;  // 3 is not a mode: keep the last
+    s_cmd.diam = clamp01(ctlQ16(m.diam));
+  }
+  s_cmd.estop = 0;
+  publishCmd();
+}
+
+static void serviceWs(){
+  ws.loop();
+  if (s_wsHave) { s_wsHave = false; applyCtlMsg(s_wsCmd); }
+  if (s_wsStop) { stopMotion(s_wsStop & CTL_FLAG_ABORT); s_wsStop = 0; }
+}
+
+// ==== Tracing ====
+static void traceHttpChunk(const char* s, size_t n){ server.sendContent(s, n); }
+static void traceSerialChunk(const char* s, size_t n){ Serial.write((const uint8_t*)s, n); }
+
+// GET /trace: the span ring as Chrome trace JSON (chrome://tracing,
+// ui.perfetto.dev); ?on=0|1 pauses/resumes recording, ?clear=1 empties it
+static void handleTrace(){
+  if (server.hasArg("on")) traceEnable(server.arg("on").toInt() != 0);
+  if (server.hasArg("clear")) { traceClear(); server.send(200, "application/json", "{\"ok\":true}"); return; }
+  server.setContentLength(CONTENT_LENGTH_UNKNOWN); // chunked
+  server.send(200, "application/json", "");
+  traceRenderJson(traceHttpChunk);
+  server.sendContent("");
+}
+
+// Serial console lines: "trace" dumps the same JSON, "trace clear" empties the ring
+static void serialCommand(const char* line){
+  if (!strcmp(line, "trace")) traceRenderJson(traceSerialChunk);
+  else if (!strcmp(line, "trace clear")) traceClear();
+}
+
+// ==== Serial link (SerialLink.h) ====
+// Setpoint frames drained in one loop() pass collapse to the newest;
+// it is applied and acked with one telemetry frame.
+static SlinkParser s_slink;
+static uint16_t s_slinkSeq = 0;
+static bool     s_slinkSeqValid = false;
+static uint32_t s_slinkLastRxMs = 0, s_slinkLastTxMs = 0;
+uint32_t g_slinkMsgs = 0, g_slinkStale = 0, g_slinkCoalesced = 0, g_slinkTelem = 0;
+static volatile int16_t s_wheelOut[2] = {0, 0}; // last wheel command (control step)
+
+static void applySlinkSetpoint(const SlinkSetpoint& m){
+  s_cmd.drive  = clamp11(ctlQ14(m.drive));
+  s_cmd.manual = (m.flags & SLINK_F_MANUAL) != 0;
+  if (s_cmd.manual) {
+    s_cmd.ff = (int16_t)clampInt(m.ff, FF_MIN, FF_MAX);
+    s_cmd.fr = (int16_t)clampInt(m.fr, FR_MIN, FR_MAX);
+  } else {
+    s_cmd.steerX = clamp11(ctlQ14(m.steer));
+    uint8_t md = m.flags & 0x03;
+    if (md <= MODE_CIRCLE) s_cmd.mode = md;
+    s_cmd.diam = clamp01(ctlQ16(m.diam));
+  }
+  uint8_t sp = (m.flags >> 4) & 0x03;
+  if (sp <= SPEED_SPORT) s_cmd.speed = sp;
+  s_cmd.tilt = m.tilt; s_cmd.roll = m.roll;
+  s_cmd.estop = (m.flags & SLINK_F_ESTOP) ? 1 : 0;
+  publishCmd();
+}
+
+static void sendTelemetry(){
+  SlinkTelem t;
+  t.type = SLINK_TELEM;
+  t.state = (s_cmd.manual ? 1 : 0) | (s_cmd.estop ? 2 : 0) | ((recorder.state() & 3) << 2);
+  t.ack = s_slinkSeq;
+  t.ms = millis();
+  t.ff = (uint8_t)servoFront.readDeg(); t.fr = (uint8_t)servoRear.readDeg();
+  t.left = s_wheelOut[0]; t.right = s_wheelOut[1];
+#if GIMBAL_ENABLED
+  if (imu.ok()) t.state |= 0x10;
+  t.pitch = (int16_t)lroundf(stab.pitchDeg() * 100); t.roll = (int16_t)lroundf(stab.rollDeg() * 100);
+#else
+  t.pitch = 0; t.roll = 0;
+#endif
+  t.rxErrors = (uint16_t)s_slink.errors();
+  uint8_t wire[SLINK_MAX_WIRE];
+  Serial.write(wire, slinkEncode(&t, sizeof(t), wire));
+  s_slinkLastTxMs = t.ms;
+  g_slinkTelem++;
+}
+
+static void serviceSerial(){
+  SlinkSetpoint sp;
+  bool have = false;
+  uint32_t now = millis();
+  uint8_t buf[64];
+  int avail;
+  while ((avail = Serial.available()) > 0) {
+    size_t n = Serial.read(buf, (size_t)avail < sizeof(buf) ? (size_t)avail : sizeof(buf));
+    if (n == 0) break;
+    for (size_t i = 0; i < n; ++i) {
+      SlinkEvent ev = s_slink.push(buf[i]);
+      if (ev == SLINK_LINE) { serialCommand(s_slink.line()); continue; }
+#if SLINK_ENABLED
+      if (ev != SLINK_FRAME || s_slink.payloadLen() != sizeof(SlinkSetpoint) || s_slink.payload()[0] != SLINK_SETPOINT) continue;
+      SlinkSetpoint m; memcpy(&m, s_slink.payload(), sizeof(m));
+      g_slinkMsgs++;
+      if (s_slinkSeqValid && !ctlSeqNewer(m.seq, s_slinkSeq) && now - s_slinkLastRxMs < SLINK_RESYNC_MS) { g_slinkStale++; continue; }
+      s_slinkSeq = m.seq; s_slinkSeqValid = true; s_slinkLastRxMs = now;
+      if (have) g_slinkCoalesced++;
+      sp = m; have = true;
+#endif
+    }
+  }
+#if SLINK_ENABLED
+  if (have) { applySlinkSetpoint(sp); sendTelemetry(); }
+  else if (SLINK_TELEM_MS > 0 && s_slinkSeqValid && now - s_slinkLastTxMs >= SLINK_TELEM_MS) sendTelemetry();
+#endif
+}
+
+// ==== Take transfer (/rec/download, /rec/upload) ====
+// A transfer runs inside one handler call, so between chunks it does the
+// rest of loop()'s work (setpoints, recorder commit / prefetch, serial,
+// inline control) and waits while it is ahead of REC_XFER_RATE_KBPS.
+// Other HTTP requests, /stop and /rec/abort included, wait for the end of
+// the transfer; the WS stop flags (CtlProto.h) and serial stay live.
+static uint8_t s_xferBuf[REC_XFER_CHUNK_BYTES];
+
+static void xferYield(){
+  serviceWs();
+  recorder.service(millis());
+  serviceSerial();
+  ctl.poll();
+}
+static void xferPace(uint32_t startMs, uint32_t bytes){
+  xferYield();
+  while (REC_XFER_RATE_KBPS > 0 && bytes > (uint64_t)(millis() - startMs) * REC_XFER_RATE_KBPS * 1024 / 1000) {
+    delay(1);
+    xferYield();
+  }
+}
+
+// Nothing moves, nothing records and the gimbal is not stabilizing: flash
+// erases (~45 ms, both cores) cannot jerk a move or stall the estimate
+static bool rigIdle(){
+  bool idle = recorder.state() == REC_IDLE && presets.phase() == PRESET_IDLE && s_wheelOut[0] == 0 && s_wheelOut[1] == 0
+           && !servoFront.moving() && !servoRear.moving();
+#if GIMBAL_ENABLED
+  idle = idle && !servoTilt.moving() && !servoRoll.moving() && !(imu.ok() && s_cmd.stab);
+#endif
+  return idle;
+}
+
+// GET /rec/download?slot=N: the take as a .bin file (RecFileHeader +
+// blocks) streamed from flash. Range: bytes=a-b|a-|-n -> 206 with
+// Content-Range (416 if past the end); ETag per take, If-None-Match ->
+// 304, If-Range falls back to the whole take when the ETag has changed.
+static void handleRecDownload(){
+  int slot = server.hasArg("slot") ? server.arg("slot").toInt() : 0;
+  if (!SlotStore::valid(slot)) { server.send(400, "text/plain", "slot out of range"); return; }
+  const SlotMeta& m = store.meta(slot);
+  if (m.state == SLOT_EMPTY) { server.send(404, "text/plain", "empty slot"); return; }
+  if (m.state != SLOT_DONE)  { server.send(409, "text/plain", "slot busy"); return; }
+  char etag[24], val[48];
+  snprintf(etag, sizeof(etag), "\"%d-%08x\"", slot, (unsigned)store.takeId(slot));
+  uint32_t size = store.takeBytes(slot), from = 0, to = size - 1;
+  server.sendHeader("ETag", etag);
+  server.sendHeader("Accept-Ranges", "bytes");
+  if (server.header("If-None-Match") == etag) { server.send(304); return; }
+  int r = 0;
+  if (!server.hasHeader("If-Range") || server.header("If-Range") == etag)
+    r = parseByteRange(server.header("Range").c_str(), size, from, to);
+  if (r < 0) {
+    snprintf(val, sizeof(val), "bytes */%u", (unsigned)size);
+    server.sendHeader("Content-Range", val);
+    server.send(416, "text/plain", "range not satisfiable");
+    return;
+  }
+  if (r > 0) {
+    snprintf(val, sizeof(val), "bytes %u-%u/%u", (unsigned)from, (unsigned)to, (unsigned)size);
+    server.sendHeader("Content-Range", val);
+  }
+  snprintf(val, sizeof(val), "attachment; filename=\"cammate_slot%d.bin\"", slot);
+  server.sendHeader("Content-Disposition", val);
+  server.setContentLength(to - from + 1);
+  server.send(r > 0 ? 206 : 200, "application/octet-stream", "");
+  uint32_t start = millis();
+  for (uint32_t off = from; off <= to; ) {
+    size_t n = to - off + 1 < sizeof(s_xferBuf) ? to - off + 1 : sizeof(s_xferBuf);
+    if (store.readTake(slot, off, s_xferBuf, n) != n) break;  // short body: the client sees the error
+    server.sendContent((const char*)s_xferBuf, n);
+    off += n;
+    xferPace(start, off - from);
+  }
+}
+
+// POST /rec/upload?slot=N with a .bin take as the raw body (as served by
+// /rec/download). Blocks are checked and written as they arrive; the
+// slot's old take is dropped once the header is valid, and a failed
+// upload leaves the slot empty. Only while the rig is idle.
+static uint32_t s_upStart = 0, s_upBytes = 0;
+static bool s_upOk = false;
+static int  s_upCode = 0;
+
+static void handleRecUploadData(){
+  HTTPRaw& raw = server.raw();
+  if (raw.status == RAW_START) {
+    int slot = server.hasArg("slot") ? server.arg("slot").toInt() : 0;
+    uint32_t len = (uint32_t)server.header("Content-Length").toInt();
+    s_upStart = millis(); s_upBytes = 0; s_upOk = false;
+    if (!rigIdle()) s_upCode = 409;
+    else { s_upOk = recorder.importBegin(slot, len); s_upCode = s_upOk ? 200 : 400; }
+  } else if (raw.status == RAW_WRITE) {
+    if (s_upOk && !recorder.importWrite(raw.buf, raw.currentSize)) { s_upOk = false; s_upCode = 400; }
+    s_upBytes += raw.currentSize;
+    xferPace(s_upStart, s_upBytes);
+  } else if (raw.status == RAW_END) {
+    if (s_upOk && !recorder.importEnd()) { s_upOk = false; s_upCode = 400; }
+  } else {  // client gone: no response follows
+    if (s_upOk) recorder.importAbort();
+    s_upOk = false; s_upCode = 0;
+  }
+}
+static void handleRecUpload(){
+  if (s_upCode == 0) { server.send(400, "text/plain", "empty body"); return; }
+  int code = s_upCode;
+  s_upCode = 0;
+  if (code == 409) { server.send(409, "text/plain", "busy: stop recording, playback and motion first"); return; }
+  if (!s_upOk) { server.send(code, "text/plain", recorder.lastError()); return; }
+  int slot = server.arg("slot").toInt();
+  const SlotMeta& m = store.meta(slot);
+  char js[112];
+  snprintf(js, sizeof(js), "{\"slot\":%d,\"frames\":%u,\"duration_ms\":%u,\"bytes\":%u,\"ms\":%u}", slot,
+           (unsigned)m.frames, (unsigned)m.lastT, (unsigned)store.takeBytes(slot), (unsigned)(millis() - s_upStart));
+  server.send(200, "application/json", js);
+}
+
+static void handleCtlStats(){
+  ControlStats st = ctl.stats();
+  WriteStats wf = servoFront.writeStats(), wr = servoRear.writeStats(), ww = wheels.writeStats();
+  const GovStats& gs = gov.stats();
+#if GIMBAL_ENABLED
+  bool imuOk = imu.ok();
+  uint32_t imuN = imu.samples(), imuOvf = imu.overflows(), gated = stab.gated();
+  float pitch = stab.pitchDeg(), roll = stab.rollDeg();
+#else
+  bool imuOk = false;
+  uint32_t imuN = 0, imuOvf = 0, gated = 0;
+  float pitch = 0, roll = 0;
+#endif
+  char buf[896];
+  snprintf(buf, sizeof(buf),
+    "{\"task\":%s,\"period_us\":%u,\"cycles\":%u,\"overruns\":%u,\"exec_us\":%u,\"max_exec_us\":%u,"
+    "\"max_jitter_us\":%u,\"mean_jitter_us\":%u,\"play_underruns\":%u,"
+    "\"ws_msgs\":%u,\"ws_stale\":%u,\"ws_coalesced\":%u,"
+    "\"slink_msgs\":%u,\"slink_stale\":%u,\"slink_coalesced\":%u,\"slink_errors\":%u,\"slink_telem\":%u,"
+    "\"wr_issued\":%u,\"wr_suppressed\":%u,\"cmd_retries\":%u,\"cmd_stale\":%u,"
+    "\"rec_overflows\":%u,\"rec_lag_ms\":%u,\"rec_lag_max_ms\":%u,"
+    "\"whl_loop\":%s,\"whl_cps\":[%d,%d],"
+    "\"gov_ma\":%u,\"gov_peak_ma\":%u,\"gov_wheel\":%u,\"gov_servo\":%u,"
+    "\"imu\":%s,\"imu_samples\":%u,\"imu_overflows\":%u,\"stab_gated\":%u,\"pitch\":%.2f,\"roll\":%.2f}",
+    ctl.running()?"true":"false", (unsigned)st.periodUs, (unsigned)st.cycles, (unsigned)st.overruns,
+    (unsigned)st.lastExecUs, (unsigned)st.maxExecUs, (unsigned)st.maxJitterUs,
+    (unsigned)(st.cycles > 1 ? st.sumJitterUs / (st.cycles - 1) : 0), (unsigned)recorder.underruns(),
+    (unsigned)g_ctlMsgs, (unsigned)g_ctlStale, (unsigned)g_ctlCoalesced,
+    (unsigned)g_slinkMsgs, (unsigned)g_slinkStale, (unsigned)g_slinkCoalesced, (unsigned)s_slink.errors(), (unsigned)g_slinkTelem,
+    (unsigned)(wf.issued + wr.issued + ww.issued), (unsigned)(wf.suppressed + wr.suppressed + ww.suppressed),
+    (unsigned)g_cmdRetries, (unsigned)g_cmdStale,
+    (unsigned)recorder.ringOverflows(), (unsigned)recorder.commitLagMs(), (unsigned)recorder.commitLagMaxMs(),
+    wheels.speedLoop()?"true":"false", (int)wheels.speedCps(0), (int)wheels.speedCps(1),
+    (unsigned)gs.lastMa, (unsigned)gs.peakMa, (unsigned)(gs.wheelRamped + gs.wheelBudget),
+    (unsigned)(gs.servoThrottled + gs.servoHeld),
+    imuOk?"true":"false", (unsigned)imuN, (unsigned)imuOvf, (unsigned)gated, pitch, roll);
+  server.send(200, "application/json", buf);
 }
-static void handleRecAbort(){ recorder.stopPlayback(); eStop = true; server.send(200,"text/plain","ABORTED"); }
 
 // ==== WiFi + HTTP ====
 static void initWiFi(){
@@ -423,35 +611,264 @@ static void initWiFi(){
   Serial.printf("[WiFi] %s  SSID:%s  IP:%s  (cfg:%s)\n",
     ok?"AP STARTED":"FAILED", WIFI_SSID, WiFi.softAPIP().toString().c_str(), cfg?"OK":"ERR");
 }
-static void initHttp(){
-  server.on("/", HTTP_GET, handleIndex);
+// ==== Metrics ====
+static void metricsChunk(const char* s, size_t n){ server.sendContent(s, n); }
+
+static void handleMetrics(){
+  bool json = server.hasArg("format") && server.arg("format") == "json";
+  server.setContentLength(CONTENT_LENGTH_UNKNOWN); // chunked
+  server.send(200, json ? "application/json" : "text/plain; version=0.0.4", "");
+  if (json) metricsRenderJson(metricsChunk);
+  else      metricsRenderText(metricsChunk);
+  server.sendContent("");
+}
+
+static uint32_t metSlinkErrors(){ return s_slink.errors(); }
+static uint32_t metUnderruns(){ return recorder.underruns(); }
+static uint32_t metRecOverflows(){ return recorder.ringOverflows(); }
+static uint32_t metRecHigh(){ return recorder.ringHighWater(); }
+static uint32_t metRecLag(){ return recorder.commitLagMs(); }
+static uint32_t metRecLagMax(){ return recorder.commitLagMaxMs(); }
+static uint32_t metOverruns(){ return ctl.stats().overruns; }
+static uint32_t metWrIssued(){
+  return servoFront.writeStats().issued + servoRear.writeStats().issued + wheels.writeStats().issued;
+}
+static uint32_t metWrSuppressed(){
+  return servoFront.writeStats().suppressed + servoRear.writeStats().suppressed + wheels.writeStats().suppressed;
+}
+static uint32_t metHeapFree(){ return ESP.getFreeHeap(); }
+static uint32_t metHeapMin(){ return ESP.getMinFreeHeap(); }
+static uint32_t metWifiClients(){ return WiFi.softAPgetStationNum(); }
+static uint32_t metWsClients(){ return ws.connectedClients(); }
+
+static uint32_t metGovMa(){ return gov.stats().lastMa; }
+static uint32_t metGovPeak(){ return gov.stats().peakMa; }
+#if GIMBAL_ENABLED
+static uint32_t metImuSamples(){ return imu.samples(); }
+static uint32_t metImuOverflows(){ return imu.overflows(); }
+static uint32_t metStabGated(){ return stab.gated(); }
+#endif
 
-  server.on("/ctl_drive",  HTTP_GET, handleCtlDrive);
-  server.on("/ctl_steer",  HTTP_GET, handleCtlSteer);
-  server.on("/ctl_servos", HTTP_GET, handleCtlServos);
-  server.on("/ui/manual_steer", HTTP_GET, handleManual);
+static void initMetrics(){
+  metricsBegin();
+  metricsCounter("cammate_ws_msgs_total",       "WebSocket control messages received", &g_ctlMsgs);
+  metricsCounter("cammate_ws_stale_total",      "WebSocket messages dropped as older than last seq", &g_ctlStale);
+  metricsCounter("cammate_ws_coalesced_total",  "WebSocket messages overwritten before being applied", &g_ctlCoalesced);
+  metricsCounter("cammate_slink_msgs_total",      "serial link setpoint frames received", &g_slinkMsgs);
+  metricsCounter("cammate_slink_stale_total",     "serial link setpoints dropped as older than last seq", &g_slinkStale);
+  metricsCounter("cammate_slink_coalesced_total", "serial link setpoints overwritten before being applied", &g_slinkCoalesced);
+  metricsCounterFn("cammate_slink_rx_errors_total", "serial link frames with a bad CRC, COBS or length", metSlinkErrors);
+  metricsCounter("cammate_cmd_retries_total",   "control step snapshot reads retried (publish in flight)", &g_cmdRetries);
+  metricsCounter("cammate_cmd_stale_total",     "control cycles that reused the previous snapshot", &g_cmdStale);
+  metricsCounterFn("cammate_play_underruns_total", "playback ticks with no prefetched block", metUnderruns);
+  metricsCounterFn("cammate_rec_ring_overflows_total", "recorded frames dropped (capture ring full)", metRecOverflows);
+  metricsGauge("cammate_rec_ring_high_water",  "most frames queued for the recorder writer", metRecHigh);
+  metricsGauge("cammate_rec_commit_lag_ms",    "last recorded block: last capture to on flash", metRecLag);
+  metricsGauge("cammate_rec_commit_lag_max_ms","largest recorded block commit lag", metRecLagMax);
+  metricsCounter("cammate_store_erases_total",      "take store sector erases (each stalls flash ~45 ms)", &store.stats().erases);
+  metricsCounter("cammate_store_sync_erases_total", "take store erases a write had to wait for", &store.stats().syncErases);
+  metricsCounterFn("cammate_ctl_overruns_total",   "control cycles that overran their period", metOverruns);
+  metricsCounterFn("cammate_actuator_writes_total",     "actuator writes issued", metWrIssued);
+  metricsCounterFn("cammate_actuator_suppressed_total", "actuator writes suppressed (no change)", metWrSuppressed);
+  metricsCounter("cammate_gov_wheel_ramped_total",   "control cycles a wheel was held by accel/jerk limits", &gov.stats().wheelRamped);
+  metricsCounter("cammate_gov_wheel_budget_total",   "control cycles a wheel was held by the current budget", &gov.stats().wheelBudget);
+  metricsCounter("cammate_gov_servo_throttled_total","control cycles a servo slewed below its full rate", &gov.stats().servoThrottled);
+  metricsCounter("cammate_gov_servo_held_total",     "control cycles a servo start was deferred", &gov.stats().servoHeld);
+  metricsGauge("cammate_gov_current_ma",      "modeled supply current", metGovMa);
+  metricsGauge("cammate_gov_peak_ma",         "highest modeled supply current", metGovPeak);
+#if GIMBAL_ENABLED
+  metricsCounterFn("cammate_imu_samples_total",   "IMU samples drained from the FIFO", metImuSamples);
+  metricsCounterFn("cammate_imu_overflows_total", "IMU FIFO overflows (FIFO reset, samples lost)", metImuOverflows);
+  metricsCounterFn("cammate_stab_gated_total",    "IMU samples without accel correction (|a| off 1 g)", metStabGated);
+#endif
+  metricsGauge("cammate_heap_free_bytes",     "free heap", metHeapFree);
+  metricsGauge("cammate_heap_min_free_bytes", "lowest free heap since boot", metHeapMin);
+  metricsGauge("cammate_wifi_clients",        "stations on the soft AP", metWifiClients);
+  metricsGauge("cammate_ws_clients",          "WebSocket clients", metWsClients);
+}
 
-  server.on("/center", HTTP_GET, handleCenter);
-  server.on("/stop",   HTTP_GET, handleStop);
-  server.on("/speed",  HTTP_GET, handleSpeed);
+// GET route whose handler time lands in a per-route histogram
+static void onRoute(const char* uri, void (*fn)()){
+  Histo* h = metricsHisto("cammate_http_handler_us", "HTTP handler duration per route", uri);
+  server.on(uri, HTTP_GET, [uri, h, fn]{ TRACE_SCOPE(uri); MetScope t(*h); fn(); });
+}
+
+static void initHttp(){
+  static const char* HDRS[] = { "If-None-Match", "Range", "If-Range", "Content-Length" };
+  server.collectHeaders(HDRS, 4);
+  onRoute("/", handleIndex);
+
+  onRoute("/ctl_drive",  handleCtlDrive);
+  onRoute("/ctl_steer",  handleCtlSteer);
+  onRoute("/ctl_servos", handleCtlServos);
+  onRoute("/ui/manual_steer", handleManual);
+
+  onRoute("/center", handleCenter);
+  onRoute("/stop",   handleStop);
+  onRoute("/speed",  handleSpeed);
+  onRoute("/gimbal", handleGimbal);
+
+  onRoute("/rec/list",  handleRecList);
+  onRoute("/rec/start", handleRecStart);
+  onRoute("/rec/stop",  handleRecStop);
+  onRoute("/rec/play",  handleRecPlay);
+  onRoute("/rec/seek",  handleRecSeek);
+  onRoute("/rec/clear", handleRecClear);
+  onRoute("/rec/abort", handleRecAbort);
+  onRoute("/rec/download", handleRecDownload);
+  {
+    Histo* h = metricsHisto("cammate_http_handler_us", "HTTP handler duration per route", "/rec/upload");
+    server.on("/rec/upload", HTTP_POST, [h]{ TRACE_SCOPE("/rec/upload"); MetScope t(*h); handleRecUpload(); }, handleRecUploadData);
+  }
 
-  server.on("/rec/list",  HTTP_GET, handleRecList);
-  server.on("/rec/start", HTTP_GET, handleRecStart);
-  server.on("/rec/stop",  HTTP_GET, handleRecStop);
-  server.on("/rec/play",  HTTP_GET, handleRecPlay);
-  server.on("/rec/clear", HTTP_GET, handleRecClear);
-  server.on("/rec/abort", HTTP_GET, handleRecAbort);
+  onRoute("/preset",        handlePreset);
+  onRoute("/preset/stop",   handlePresetStop);
+  onRoute("/preset/status", handlePresetStatus);
+
+  onRoute("/ctl/stats", handleCtlStats);
+  onRoute("/metrics",   handleMetrics);
+  onRoute("/trace",     handleTrace);
 
   server.begin();
   Serial.printf("[HTTP] Listening on %d\n", HTTP_PORT);
+
+  ws.onEvent(onWsEvent);
+  ws.begin();
+  Serial.printf("[WS] Control channel on %d\n", WS_PORT);
+}
+
+// ==== Control step (control task, CONTROL_RATE_HZ) ====
+// Playback overrides the live command for the cycles it is active; the
+// live command (incl. STOP) takes over again when it ends.
+static ControlCmd s_stepCmd;           // control side: this cycle's command
+
+static void applyRecFrame(const RecFrame& fr){
+  s_stepCmd.manual = (fr.manual != 0);
+  s_stepCmd.steerX = fr.x;
+  s_stepCmd.drive  = fr.y;
+  s_stepCmd.mode   = fr.mode;
+  s_stepCmd.diam   = fr.diam;
+  s_stepCmd.speed  = fr.speed;
+  if (s_stepCmd.manual) {
+    s_stepCmd.ff = (int16_t)clampInt(fr.ff, FF_MIN, FF_MAX);
+    s_stepCmd.fr = (int16_t)clampInt(fr.fr, FR_MIN, FR_MAX);
+  }
+}
+
+// Wheel split for manual servo angles; the float model runs only when
+// the pair changes
+static WheelSplit manualSplit(int ff, int fr){
+  static int lastFf = -1, lastFr = -1;
+  static WheelSplit s;
+  if (ff != lastFf || fr != lastFr) { s = wheelSplitRef(ff, fr); lastFf = ff; lastFr = fr; }
+  return s;
+}
+
+#if GIMBAL_ENABLED
+// Camera angle = body angle + sign * servo offset: aim the servos so it
+// stays at the commanded angle, ahead by the servo lag along the body rate
+static void stepGimbal(const ControlCmd& c, uint32_t nowMs){
+  ImuRaw buf[IMU_READ_MAX];
+  int n;
+  // Forward speed for the centripetal term: wheel command x the preset speed model
+  stab.setSpeed((s_wheelOut[0] + s_wheelOut[1]) * (0.5f / 255.0f) * PRESET_MM_S_FULL * 0.001f);
+  { TRACE_SCOPE("imu.read"); MetScope t(mImuRead); n = imu.read(buf, IMU_READ_MAX); }
+  { TRACE_SCOPE("stab.update"); MetScope t(mStabUpdate); for (int i = 0; i < n; ++i) stab.update(buf[i]); }
+  float tilt = c.tilt, roll = c.roll;
+  if (c.stab) {
+    float lead = c.leadMs * 0.001f;
+    tilt -= stab.pitchDeg() + stab.pitchRateDps() * lead;
+    roll -= stab.rollDeg() + stab.rollRateDps() * lead;
+  }
+  const float r = GIMBAL_RANGE_DEG;
+  servoTilt.writeDegF(SERVO_CENTER + GIMBAL_TILT_SIGN * fmaxf(-r, fminf(tilt, r)));
+  servoRoll.writeDegF(SERVO_CENTER + GIMBAL_ROLL_SIGN * fmaxf(-r, fminf(roll, r)));
+  servoTilt.update(nowMs);
+  servoRoll.update(nowMs);
+}
+#endif
+
+static void controlStep(uint32_t nowMs){
+  TRACE_SCOPE("control");
+  MetScope timed(mCtlStep);
+  // One consistent snapshot; if the writer is mid-publish keep last cycle's
+  static ControlCmd live;
+  if (!g_cmd.tryLoad(live, 4, &g_cmdRetries)) g_cmdStale++;
+  s_stepCmd = live;
+
+  // Apply recorder playback state (incl. servo angles when manual)
+  { MetScope t(mRecTick); recorder.tick(nowMs, applyRecFrame); }
+  presets.tick(nowMs, !servoFront.moving() && !servoRear.moving(), applyRecFrame);
+  const ControlCmd& c = s_stepCmd;
+  recorder.capture(nowMs, RecFrame{0, (uint8_t)c.manual, c.steerX, c.drive, c.mode, c.diam, c.speed, c.ff, c.fr});
+
+  // Compute & apply motion
+  int ff=SERVO_CENTER, fr=SERVO_CENTER;
+  int base = (int)(c.drive * 255.0f);
+  float steerExtent = 0.0f;
+  WheelSplit split;
+
+  if (!c.manual) {
+    planSteering(c.steerX, c.drive, (UIMode)c.mode, c.diam, ff, fr, base, steerExtent, split);
+    setFrontSteer(ff);
+    setRearSteer(fr);
+  } else {
+    setFrontSteer(c.ff);
+    setRearSteer(c.fr);
+    split = manualSplit(clampInt(c.ff, FF_MIN, FF_MAX), clampInt(c.fr, FR_MIN, FR_MAX));
+  }
+
+  int pwm = c.estop ? 0 : clampInt(applySpeedScaling(base, steerExtent, (SpeedMode)c.speed), -255, 255);
+#if KIN_WHEEL_SPLIT
+  int left = wheelSplitApply(pwm, split.left), right = wheelSplitApply(pwm, split.right);
+#else
+  int left = pwm, right = pwm;
+#endif
+#if POWER_GOVERNOR
+  // Ramps wheels and sets the servos' slew scale for the update()s below
+  gov.step(nowMs, left, right, servoFront, servoRear, left, right);
+#endif
+  wheels.setSpeedLeft(left);
+  wheels.setSpeedRight(right);
+  s_wheelOut[0] = (int16_t)left; s_wheelOut[1] = (int16_t)right;
+  wheels.update(nowMs);  // speed loop (no-op when open loop)
+
+  // Advance servo slews (vel/acc limited)
+  servoFront.update(nowMs);
+  servoRear.update(nowMs);
+#if GIMBAL_ENABLED
+  if (imu.ok()) stepGimbal(c, nowMs);
+#endif
+
+#if ACTUATOR_RESYNC_MS > 0
+  static uint32_t lastResync = 0;
+  if (nowMs - lastResync >= ACTUATOR_RESYNC_MS) {
+    lastResync = nowMs;
+    servoFront.resync(); servoRear.resync(); wheels.resync();
+#if GIMBAL_ENABLED
+    servoTilt.resync(); servoRoll.resync();
+#endif
+  }
+#endif
 }
 
 // ==== Setup & Loop ====
 void setup(){
+#if SLINK_ENABLED
+  Serial.setRxBufferSize(SLINK_RX_BUFFER);  // before begin()
+  Serial.begin(SLINK_BAUD); delay(400);
+#else
   Serial.begin(SERIAL_BAUD); delay(400);
+#endif
+  traceSyncCore();
   Serial.println(F("\n=== CamMate v3.9 ==="));
 
-  SPIFFS.begin(true);
+  // An image from another partition layout (the default table's 1.4 MB
+  // spiffs) fails SPIFFS's size check and is formatted; its takes are gone
+  if (!SPIFFS.begin(false)) {
+    Serial.println(F("[FS] SPIFFS did not mount, formatting"));
+    SPIFFS.begin(true);
+  }
 
   servoFront.attach(SERVO_FRONT_PIN);
   servoRear.attach(SERVO_REAR_PIN);
@@ -459,48 +876,57 @@ void setup(){
 
   WheelPins p{ L298_IN1, L298_IN2, L298_ENA, L298_IN3, L298_IN4, L298_ENB };
   wheels.begin(p, WHEEL_PWM_FREQ_HZ, WHEEL_PWM_BITS);
+  gov.begin(PowerModel{ POWER_BASE_MA, POWER_SERVO_IDLE_MA, POWER_SERVO_MA_PER_DEGS, POWER_SERVO_MA_PER_DEGS2,
+                        POWER_SERVO_RESERVE_MA, POWER_MOTOR_STALL_MA, POWER_MOTOR_TAU_MS, POWER_MOTOR_RUN_MA, POWER_BUDGET_MA },
+            WHEEL_ACCEL_DUTY_S, WHEEL_JERK_DUTY_S2);
+#if WHEEL_SPEED_LOOP
+  WheelLoopCfg lc{ WHEEL_KP, WHEEL_KI, WHEEL_KD, WHEEL_KFF, WHEEL_KS, WHEEL_MAX_CPS, WHEEL_LOOP_MS };
+  if (!wheels.beginSpeedLoop(lc, WHEEL_ENC_LA, WHEEL_ENC_LB, WHEEL_ENC_RA, WHEEL_ENC_RB))
+    Serial.println(F("[WHL] encoder init failed, wheels open loop"));
+#endif
+
+#if GIMBAL_ENABLED
+  Wire.begin(IMU_SDA_PIN, IMU_SCL_PIN, IMU_I2C_HZ);
+  if (imu.begin(Wire, IMU_I2C_ADDR, IMU_RATE_HZ)) {
+    stab.begin(StabCfg{ imu.rateHz(), STAB_TAU_S, STAB_BIAS_TAU_S, STAB_ACC_GATE_G, IMU_ACC_LSB_G, IMU_GYRO_LSB_DPS });
+    servoTilt.attach(GIMBAL_TILT_PIN);
+    servoRoll.attach(GIMBAL_ROLL_PIN);
+    servoTilt.setLimits(GIMBAL_MAX_VEL_DEG_S, GIMBAL_MAX_ACC_DEG_S2);
+    servoRoll.setLimits(GIMBAL_MAX_VEL_DEG_S, GIMBAL_MAX_ACC_DEG_S2);
+    Serial.printf("[IMU] MPU-6050 at %u Hz, gimbal on\n", (unsigned)imu.rateHz());
+  } else Serial.println(F("[IMU] no MPU-6050, gimbal off"));
+#endif
 
-  if (recorder.begin()) recorder.setSampleMs(50); // 20Hz
-  else Serial.println(F("[REC] SPIFFS mount failed"));
+  if (!store.begin()) Serial.printf("[REC] %s\n", store.lastError());
+  recorder.begin(store);
+  recorder.setSampleMs(50); // 20Hz
+  recorder.importSpiffs();  // take files on a SPIFFS in this layout
+  catalog.begin(store);
 
+  initMetrics();
   initWiFi();
   initHttp();
 
+  if (ctl.begin(controlStep)) Serial.printf("[CTL] %d Hz task on core %d\n", CONTROL_RATE_HZ, CONTROL_TASK_CORE);
+  else Serial.println(F("[CTL] task start failed, running control inline"));
+
   IPAddress ip = WiFi.softAPIP();
   Serial.printf("[UI] Connect '%s' / '%s' -> http://%s/\n", WIFI_SSID, WIFI_PASS, ip.toString().c_str());
 }
 
+// loop() keeps networking and storage; control runs in its own task.
 void loop(){
-  // Apply recorder playback state (incl. servo angles when manual)
-  recorder.tick(millis(), [](const RecFrame& fr){
-    manualSteer = (fr.manual != 0);
-    steerX      = fr.x;
-    driveY      = fr.y;
-    uiMode      = (UIMode)fr.mode;
-    circleDiam  = fr.diam;
-    g_speedMode = (SpeedMode)fr.speed;
-    if (manualSteer) {
-      g_manualFF = clampInt(fr.ff, FF_MIN, FF_MAX);
-      g_manualFR = clampInt(fr.fr, FR_MIN, FR_MAX);
-    }
-  });
-
-  server.handleClient();
-
-  // Compute & apply motion
-  int ff=SERVO_CENTER, fr=SERVO_CENTER;
-  int base = (int)(driveY * 255.0f);
-  float steerExtent = 0.0f;
-
-  if (!manualSteer) {
-    planSteering(steerX, driveY, uiMode, circleDiam, ff, fr, base, steerExtent);
-    setFrontSteer(ff);
-    setRearSteer(fr);
-  } else {
-    setFrontSteer(g_manualFF);
-    setRearSteer(g_manualFR);
-  }
-
-  int pwm = applySpeedScaling(base, steerExtent);
-  wheels.setSpeedBoth(eStop ? 0 : clampInt(pwm, -255, 255));
+  TRACE_SCOPE("loop");
+  static uint32_t lastUs = micros();
+  uint32_t nowUs = micros();
+  mLoopPeriod.add(nowUs - lastUs);
+  lastUs = nowUs;
+
+  { MetScope t(mHandleClient); server.handleClient(); }
+  serviceWs();
+  recorder.service(millis());
+  // a servo between two pointer moves is briefly still: wait for a quiet spell
+  if (rigIdle() && millis() - s_cmdMs >= REC_STORE_IDLE_MS) store.preErase(millis());
+  serviceSerial();
+  ctl.poll(); // inline control only if the task could not be started
 }
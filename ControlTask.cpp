@@ -0,0 +1,74 @@
+#include "ControlTask.h"
+#include "Trace.h"
+
+bool ControlTask::begin(StepFn step, uint16_t rateHz, int core){
+  _step = step;
+  if (rateHz == 0) rateHz = CONTROL_RATE_HZ;
+  _periodUs = 1000000UL / rateHz;
+  resetStats();
+  _nextUs = micros();
+  _run = true;
+  BaseType_t ok = xTaskCreatePinnedToCore(_entry, "control", CONTROL_TASK_STACK, this,
+                                          CONTROL_TASK_PRIO, nullptr, core);
+  _task = (ok == pdPASS);
+  if (!_task) _run = false;
+  return _task;
+}
+
+void ControlTask::stop(){ _run = false; }
+
+void ControlTask::_entry(void* self){
+  ControlTask* ct = (ControlTask*)self;
+  const TickType_t period = pdMS_TO_TICKS(ct->_periodUs / 1000);
+  TickType_t wake = xTaskGetTickCount();
+  traceSyncCore();
+  while (ct->_run) {
+    ct->_cycle();
+    vTaskDelayUntil(&wake, period ? period : 1);
+  }
+  ct->_task = false;
+  vTaskDelete(NULL);
+}
+
+// Inline fallback when there is no control task.
+void ControlTask::poll(){
+  if (_task || !_step) return;
+  uint32_t now = micros();
+  if ((int32_t)(now - _nextUs) < 0) return;
+  _cycle();
+  _nextUs += _periodUs;
+  if ((int32_t)(now - _nextUs) >= 0) _nextUs = now + _periodUs; // fell behind: don't burst
+}
+
+void ControlTask::_cycle(){
+  uint32_t start = micros();
+  if (_started) {
+    uint32_t period = start - _lastStartUs;
+    uint32_t jit = (period > _periodUs) ? (period - _periodUs) : (_periodUs - period);
+    if (jit > _st.maxJitterUs) _st.maxJitterUs = jit;
+    _st.sumJitterUs += jit;
+    int b = (jit < 50) ? 0 : (jit < 100) ? 1 : (jit < 250) ? 2 : (jit < 500) ? 3 : (jit < 1000) ? 4 : (jit < 2500) ? 5 : 6;
+    _st.jitterHist[b]++;
+    if (period >= 2 * _periodUs) _st.overruns++;
+  }
+  _started = true;
+  _lastStartUs = start;
+
+  _step(millis());
+
+  uint32_t exec = micros() - start;
+  _st.lastExecUs = exec;
+  if (exec > _st.maxExecUs) _st.maxExecUs = exec;
+  if (exec >= _periodUs) _st.overruns++;
+  _st.cycles++;
+}
+
+// Fields are updated by the control core; a copy taken from the other
+// core may mix two cycles, which is fine for diagnostics.
+ControlStats ControlTask::stats() const { return _st; }
+
+void ControlTask::resetStats(){
+  _st = ControlStats();
+  _st.periodUs = _periodUs;
+  _started = false;
+}
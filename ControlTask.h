@@ -0,0 +1,49 @@
+#pragma once
+#include <Arduino.h>
+#include "config.h"
+
+// Timing of the fixed-rate control step.
+// jitter = |actual period - nominal period| between consecutive cycle starts.
+// overrun = step ran longer than one period, or a whole period was missed.
+struct ControlStats {
+  uint32_t cycles      = 0;
+  uint32_t overruns    = 0;
+  uint32_t periodUs    = 0;  // nominal
+  uint32_t lastExecUs  = 0;
+  uint32_t maxExecUs   = 0;
+  uint32_t maxJitterUs = 0;
+  uint64_t sumJitterUs = 0;
+  // jitter histogram: <50, <100, <250, <500, <1000, <2500, >=2500 us
+  uint32_t jitterHist[7] = {0};
+};
+
+// Runs step(nowMs) at a fixed rate in its own FreeRTOS task pinned to one
+// core, away from WiFi/HTTP/SPIFFS work in loop(). The rate must divide the
+// FreeRTOS tick rate (1 kHz): 1000, 500, 250, 200, 125, 100 ... Hz.
+// If the task cannot be created (single-core chip, host benches), call
+// poll() from loop() and the step runs inline at the same nominal rate.
+class ControlTask {
+public:
+  typedef void (*StepFn)(uint32_t nowMs);
+
+  bool begin(StepFn step, uint16_t rateHz = CONTROL_RATE_HZ, int core = CONTROL_TASK_CORE);
+  void stop();
+  bool running() const { return _task; }
+  void poll();
+
+  ControlStats stats() const;
+  void resetStats();
+
+private:
+  static void _entry(void* self);
+  void _cycle();
+
+  StepFn   _step = nullptr;
+  uint32_t _periodUs = 5000;
+  volatile bool _task = false;
+  volatile bool _run = false;
+  uint32_t _nextUs = 0;      // poll() schedule
+  uint32_t _lastStartUs = 0;
+  bool     _started = false;
+  ControlStats _st;
+};
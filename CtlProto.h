@@ -0,0 +1,30 @@
+#pragma once
+#include <Arduino.h>
+#include "config.h"
+
+// ==== Binary control setpoint (UI -> rover over WebSocket) ====
+// One fixed 12-byte little-endian message per animation frame. seq is
+// per connection and wraps; the rover applies only the newest message and
+// drops anything older than what it has already seen. The stop flags are
+// the exception: they latch even on a stale or coalesced message.
+#define CTL_MSG_VERSION 1
+#define CTL_FLAG_MANUAL 0x04 // flags[1:0] = UIMode
+#define CTL_FLAG_ESTOP  0x08 // as GET /stop: cancel the preset, wheels off
+#define CTL_FLAG_ABORT  0x10 // as GET /rec/abort: also end playback
+
+struct __attribute__((packed)) CtlMsg {
+  uint8_t  ver;   // CTL_MSG_VERSION
+  uint8_t  flags; // [1:0]=mode [2]=manual steer [3]=estop [4]=abort
+  uint16_t seq;
+  int16_t  drive; // Q14 -1..+1 (throttle)
+  int16_t  sx;    // Q14 -1..+1 (steer pad x)
+  int16_t  sy;    // Q14 -1..+1 (steer pad y)
+  uint16_t diam;  // Q16 0..1 (circle diameter)
+};
+static_assert(sizeof(CtlMsg) == 12, "CtlMsg layout");
+
+static inline float ctlQ14(int16_t v){ return v / 16384.0f; }
+static inline float ctlQ16(uint16_t v){ return v / 65535.0f; }
+
+// true if seq a is newer than b (modulo 2^16)
+static inline bool ctlSeqNewer(uint16_t a, uint16_t b){ return (int16_t)(uint16_t)(a - b) > 0; }
@@ -0,0 +1,79 @@
+#include "Imu.h"
+
+// ==== MPU-6050 registers ====
+enum : uint8_t {
+  REG_SMPLRT_DIV = 0x19, REG_CONFIG = 0x1A, REG_GYRO_CONFIG = 0x1B, REG_ACCEL_CONFIG = 0x1C,
+  REG_FIFO_EN = 0x23, REG_USER_CTRL = 0x6A, REG_PWR_MGMT_1 = 0x6B,
+  REG_FIFO_COUNTH = 0x72, REG_FIFO_R_W = 0x74, REG_WHO_AM_I = 0x75,
+};
+static const int FIFO_BYTES = 1024, SAMPLE_BYTES = 12;
+static const int BURST = 10;  // samples per read (Wire buffer is 128 bytes)
+
+bool Mpu6050::_writeReg(uint8_t reg, uint8_t v) {
+  _wire->beginTransmission(_addr);
+  _wire->write(reg);
+  _wire->write(v);
+  return _wire->endTransmission() == 0;
+}
+
+int Mpu6050::_readRegs(uint8_t reg, uint8_t* buf, int n) {
+  _wire->beginTransmission(_addr);
+  _wire->write(reg);
+  if (_wire->endTransmission(false) != 0) return 0;
+  int got = (int)_wire->requestFrom(_addr, (size_t)n);
+  for (int i = 0; i < got; ++i) buf[i] = (uint8_t)_wire->read();
+  return got;
+}
+
+void Mpu6050::_resetFifo() {
+  _writeReg(REG_USER_CTRL, 0x04);  // FIFO_RESET
+  _writeReg(REG_USER_CTRL, 0x40);  // FIFO_EN
+}
+
+bool Mpu6050::begin(TwoWire& wire, uint8_t addr, uint16_t rateHz) {
+  _wire = &wire; _addr = addr;
+  uint8_t who = 0;
+  if (_readRegs(REG_WHO_AM_I, &who, 1) != 1 || (who & 0x7E) != 0x68) { _wire = nullptr; return false; }
+  int div = rateHz ? 1000 / rateHz - 1 : 0;
+  if (div < 0) div = 0;
+  if (div > 255) div = 255;
+  _rate = (uint16_t)(1000 / (div + 1));
+  bool ok = _writeReg(REG_PWR_MGMT_1, 0x01)   // wake, PLL on gyro X
+         && _writeReg(REG_CONFIG, 0x02)       // DLPF 94/98 Hz, 1 kHz base rate
+         && _writeReg(REG_SMPLRT_DIV, (uint8_t)div)
+         && _writeReg(REG_GYRO_CONFIG, 0x08)  // +-500 deg/s
+         && _writeReg(REG_ACCEL_CONFIG, 0x00) // +-2 g
+         && _writeReg(REG_FIFO_EN, 0x78);     // accel + gyro XYZ
+  if (!ok) { _wire = nullptr; return false; }
+  _resetFifo();
+  return true;
+}
+
+int Mpu6050::read(ImuRaw* out, int max) {
+  if (!_wire) return 0;
+  uint8_t c[2];
+  if (_readRegs(REG_FIFO_COUNTH, c, 2) != 2) return 0;
+  int count = (c[0] << 8) | c[1];
+  if (count > FIFO_BYTES - SAMPLE_BYTES || count % SAMPLE_BYTES) {  // overflowed: data lost, framing unsure
+    _overflows++;
+    _resetFifo();
+    return 0;
+  }
+  int n = count / SAMPLE_BYTES;
+  if (n > max) n = max;
+  uint8_t buf[BURST * SAMPLE_BYTES];
+  int done = 0;
+  while (done < n) {
+    int k = n - done < BURST ? n - done : BURST;
+    if (_readRegs(REG_FIFO_R_W, buf, k * SAMPLE_BYTES) != k * SAMPLE_BYTES) break;
+    for (int i = 0; i < k; ++i) {
+      const uint8_t* b = buf + i * SAMPLE_BYTES;  // big endian: accel XYZ, gyro XYZ
+      ImuRaw& s = out[done + i];
+      s.ax = (int16_t)(b[0] << 8 | b[1]);  s.ay = (int16_t)(b[2] << 8 | b[3]);  s.az = (int16_t)(b[4] << 8 | b[5]);
+      s.gx = (int16_t)(b[6] << 8 | b[7]);  s.gy = (int16_t)(b[8] << 8 | b[9]);  s.gz = (int16_t)(b[10] << 8 | b[11]);
+    }
+    done += k;
+  }
+  _samples += done;
+  return done;
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include <Arduino.h>
+#include <Wire.h>
+
+// One accel + gyro sample in sensor LSBs, body frame: x forward, y left,
+// z up (accel reads +1 g on z when level)
+struct ImuRaw { int16_t ax, ay, az, gx, gy, gz; };
+
+// MPU-6050 sampling at a fixed rate into its 1 KB FIFO (accel + gyro, 12
+// bytes a sample). read() drains it in burst reads, so the control step
+// gets every sample, evenly spaced by the chip clock, with no interrupt per
+// sample. A FIFO that filled up (or lost alignment) is reset and counted.
+class Mpu6050 {
+public:
+  bool begin(TwoWire& wire, uint8_t addr, uint16_t rateHz); // +-2 g, +-500 deg/s, DLPF 98 Hz
+  bool ok() const { return _wire != nullptr; }
+  int  read(ImuRaw* out, int max);  // samples drained, oldest first
+  uint16_t rateHz() const { return _rate; }
+  uint32_t samples() const { return _samples; }
+  uint32_t overflows() const { return _overflows; }
+
+private:
+  TwoWire* _wire = nullptr;
+  uint8_t  _addr = 0;
+  uint16_t _rate = 0;
+  uint32_t _samples = 0, _overflows = 0;
+
+  bool _writeReg(uint8_t reg, uint8_t v);
+  int  _readRegs(uint8_t reg, uint8_t* buf, int n);
+  void _resetFifo();
+};
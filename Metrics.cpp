@@ -0,0 +1,122 @@
+#include "Metrics.h"
+
+Histo mLoopPeriod, mHandleClient, mCtlStep, mRecTick, mImuRead, mStabUpdate, mRecWrite, mRecRead, mFsOpen;
+
+struct MetHisto   { Histo* h; const char* name; const char* help; const char* route; };
+struct MetCounter { const char* name; const char* help; const volatile uint32_t* v; MetGaugeFn fn; bool gauge; };
+
+static MetHisto   s_histos[METRICS_MAX_HISTOS];
+static MetCounter s_counters[METRICS_MAX_COUNTERS];
+static int s_nHistos = 0, s_nCounters = 0;
+static Histo s_routePool[METRICS_MAX_HISTOS];
+static int s_nPool = 0;
+
+void metricsAddHisto(Histo* h, const char* name, const char* help, const char* route){
+  if (s_nHistos >= METRICS_MAX_HISTOS) return;
+  s_histos[s_nHistos++] = { h, name, help, route };
+}
+
+Histo* metricsHisto(const char* name, const char* help, const char* route){
+  static Histo dummy; // registry full: still a valid target
+  if (s_nPool >= METRICS_MAX_HISTOS || s_nHistos >= METRICS_MAX_HISTOS) return &dummy;
+  Histo* h = &s_routePool[s_nPool++];
+  metricsAddHisto(h, name, help, route);
+  return h;
+}
+
+static void addCounter(const char* name, const char* help, const volatile uint32_t* v, MetGaugeFn fn, bool gauge){
+  if (s_nCounters >= METRICS_MAX_COUNTERS) return;
+  s_counters[s_nCounters++] = { name, help, v, fn, gauge };
+}
+void metricsCounter(const char* name, const char* help, const volatile uint32_t* v){ addCounter(name, help, v, nullptr, false); }
+void metricsCounterFn(const char* name, const char* help, MetGaugeFn fn){ addCounter(name, help, nullptr, fn, false); }
+void metricsGauge(const char* name, const char* help, MetGaugeFn fn){ addCounter(name, help, nullptr, fn, true); }
+
+void metricsBegin(){
+  metricsAddHisto(&mLoopPeriod,   "cammate_loop_period_us",     "loop() start-to-start period");
+  metricsAddHisto(&mHandleClient, "cammate_handle_client_us",   "server.handleClient() duration");
+  metricsAddHisto(&mCtlStep,      "cammate_control_step_us",    "control step duration");
+  metricsAddHisto(&mRecTick,      "cammate_rec_tick_us",        "Recorder::tick duration (control side)");
+  metricsAddHisto(&mImuRead,      "cammate_imu_read_us",        "IMU FIFO drain (I2C)");
+  metricsAddHisto(&mStabUpdate,   "cammate_stab_update_us",     "attitude filter over the drained IMU samples");
+  metricsAddHisto(&mRecWrite,     "cammate_rec_block_write_us", "recording block append to flash");
+  metricsAddHisto(&mRecRead,      "cammate_rec_block_read_us",  "playback block read from flash");
+  metricsAddHisto(&mFsOpen,       "cammate_fs_open_us",         "SPIFFS open (take file import)");
+}
+
+void metricsReset(){
+  for (int i = 0; i < s_nHistos; ++i) s_histos[i].h->reset();
+}
+
+static uint32_t counterValue(const MetCounter& c){ return c.fn ? c.fn() : *c.v; }
+static uint32_t bucketLe(int i){ return (1u << i) - 1; }
+
+// Buffered printf into the sink
+struct MetWriter {
+  MetSink sink; char buf[512]; size_t n = 0;
+  explicit MetWriter(MetSink s) : sink(s) {}
+  ~MetWriter() { flush(); }
+  void flush() { if (n) sink(buf, n); n = 0; }
+  void printf(const char* fmt, ...) __attribute__((format(printf, 2, 3))) {
+    char line[192];
+    va_list ap; va_start(ap, fmt);
+    int len = vsnprintf(line, sizeof(line), fmt, ap);
+    va_end(ap);
+    if (len <= 0) return;
+    if ((size_t)len >= sizeof(line)) len = sizeof(line) - 1;
+    if (n + len > sizeof(buf)) flush();
+    memcpy(buf + n, line, len); n += len;
+  }
+};
+
+// Histogram families share one HELP/TYPE header (per-route series follow
+// each other because routes are registered together).
+void metricsRenderText(MetSink sink){
+  MetWriter w(sink);
+  const char* lastName = "";
+  for (int i = 0; i < s_nHistos; ++i) {
+    const MetHisto& m = s_histos[i];
+    Histo h = *m.h; // copy: consistent enough for a scrape
+    if (strcmp(lastName, m.name) != 0) {
+      w.printf("# HELP %s %s\n# TYPE %s histogram\n", m.name, m.help, m.name);
+      lastName = m.name;
+    }
+    char lbl[64] = "", only[64] = "";
+    if (m.route) {
+      snprintf(lbl, sizeof(lbl), "route=\"%s\",", m.route);
+      snprintf(only, sizeof(only), "{route=\"%s\"}", m.route);
+    }
+    uint32_t cum = 0;
+    for (int b = 0; b < MET_BUCKETS - 1; ++b) {
+      cum += h.b[b];
+      w.printf("%s_bucket{%sle=\"%u\"} %u\n", m.name, lbl, (unsigned)bucketLe(b), (unsigned)cum);
+    }
+    w.printf("%s_bucket{%sle=\"+Inf\"} %u\n", m.name, lbl, (unsigned)h.count);
+    w.printf("%s_sum%s %llu\n%s_count%s %u\n", m.name, only, (unsigned long long)h.sum, m.name, only, (unsigned)h.count);
+  }
+  for (int i = 0; i < s_nCounters; ++i) {
+    const MetCounter& c = s_counters[i];
+    w.printf("# HELP %s %s\n# TYPE %s %s\n%s %u\n",
+             c.name, c.help, c.name, c.gauge ? "gauge" : "counter", c.name, (unsigned)counterValue(c));
+  }
+  w.printf("# TYPE cammate_build_info gauge\ncammate_build_info{version=\"%s\",planner_lut=\"%d\",control_hz=\"%d\"} 1\n",
+           CAMMATE_VERSION, PLANNER_USE_LUT, CONTROL_RATE_HZ);
+}
+
+void metricsRenderJson(MetSink sink){
+  MetWriter w(sink);
+  w.printf("{\"build\":{\"version\":\"%s\",\"planner_lut\":%d,\"control_hz\":%d},\"histograms\":[",
+           CAMMATE_VERSION, PLANNER_USE_LUT, CONTROL_RATE_HZ);
+  for (int i = 0; i < s_nHistos; ++i) {
+    const MetHisto& m = s_histos[i];
+    Histo h = *m.h;
+    w.printf("%s{\"name\":\"%s\",\"route\":\"%s\",\"count\":%u,\"sum\":%llu,\"max\":%u,\"buckets\":[",
+             i ? "," : "", m.name, m.route ? m.route : "", (unsigned)h.count, (unsigned long long)h.sum, (unsigned)h.max);
+    for (int b = 0; b < MET_BUCKETS; ++b) w.printf("%s%u", b ? "," : "", (unsigned)h.b[b]);
+    w.printf("]}");
+  }
+  w.printf("],\"counters\":{");
+  for (int i = 0; i < s_nCounters; ++i)
+    w.printf("%s\"%s\":%u", i ? "," : "", s_counters[i].name, (unsigned)counterValue(s_counters[i]));
+  w.printf("}}");
+}
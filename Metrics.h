@@ -0,0 +1,65 @@
+#pragma once
+#include <Arduino.h>
+#include "config.h"
+
+// ==== Runtime metrics ====
+// Fixed log2-bucket histograms (microseconds), counters and gauges in a
+// static registry, rendered at /metrics as Prometheus text or JSON
+// (?format=json). Recording is a bucket index (clz) and four stores; each
+// histogram should have one writer (task), readers may see it mid-update.
+#define MET_BUCKETS 16 // le 0,1,3,7 .. 16383 us (2^i - 1), +Inf
+
+struct Histo {
+  uint32_t b[MET_BUCKETS] = {0};
+  uint32_t count = 0;
+  uint32_t max = 0;
+  uint64_t sum = 0;
+
+  inline void add(uint32_t us) {
+#if METRICS_ENABLED
+    int i = us ? 32 - __builtin_clz(us) : 0; // 0 -> 0, 1 -> 1, 2..3 -> 2 ...
+    b[i < MET_BUCKETS ? i : MET_BUCKETS - 1]++;
+    count++;
+    sum += us;
+    if (us > max) max = us;
+#else
+    (void)us;
+#endif
+  }
+  void reset() { *this = Histo(); }
+};
+
+// Times a scope into a histogram
+struct MetScope {
+  Histo& h; uint32_t t0;
+  explicit MetScope(Histo& hh) : h(hh), t0(micros()) {}
+  ~MetScope() { h.add(micros() - t0); }
+};
+
+// Core histograms (always registered)
+extern Histo mLoopPeriod;    // loop() start to start
+extern Histo mHandleClient;  // server.handleClient()
+extern Histo mCtlStep;       // control step
+extern Histo mRecTick;       // Recorder::tick (control side)
+extern Histo mImuRead;       // IMU FIFO drain (I2C)
+extern Histo mStabUpdate;    // Stabilizer::update over the drained samples
+extern Histo mRecWrite;      // record block append (SlotStore, takes partition)
+extern Histo mRecRead;       // playback block read (SlotStore, takes partition)
+extern Histo mFsOpen;        // SPIFFS open (take file import)
+
+typedef uint32_t (*MetGaugeFn)();
+
+void metricsBegin();
+// name: Prometheus metric name; label: optional route="..." value
+Histo* metricsHisto(const char* name, const char* help, const char* route = nullptr);
+void   metricsAddHisto(Histo* h, const char* name, const char* help, const char* route = nullptr);
+void   metricsCounter(const char* name, const char* help, const volatile uint32_t* v);
+void   metricsCounterFn(const char* name, const char* help, MetGaugeFn fn);
+void   metricsGauge(const char* name, const char* help, MetGaugeFn fn);
+void   metricsReset(); // histograms only
+
+// Rendering goes through a small buffer into sink (e.g. chunked HTTP) so
+// the full text never has to fit in one heap block.
+typedef void (*MetSink)(const char* s, size_t n);
+void metricsRenderText(MetSink sink);
+void metricsRenderJson(MetSink sink);
@@ -1,5 +1,6 @@
 #include "MotionPlanner.h"
 #include <math.h>
+#include "Trace.h"
 
 static inline float clamp11f(float v){
   if (v < -1.0f) return -1.0f;
@@ -12,8 +13,56 @@ static inline float clamp01f(float v){
   return v;
 }
 
-void planSteering(float x, float y, UIMode mode, float diam,
-                  int &ff, int &fr, int &base, float &steerExtent)
+// ==== Kinematics ====
+// x forward, y right, origin mid-wheelbase. Steer angle = servo deg -
+// SERVO_CENTER, positive = wheels toward the right, on both axles. The
+// center of rotation (xc, yc) has tan(d) = (x_axle - xc) / yc on each
+// axle; it is carried as curvature k = 1/yc so straight/parallel poses
+// need no special case.
+static const float KIN_XF = KIN_WHEELBASE_MM * 0.5f, KIN_XR = -KIN_WHEELBASE_MM * 0.5f;
+static inline float steerRad(int deg){ return (deg - SERVO_CENTER) * (float)(M_PI / 180.0); }
+
+WheelSplit wheelSplitRef(int ff, int fr) {
+  float tf = tanf(steerRad(ff)), tr = tanf(steerRad(fr));
+  float k = (tf - tr) / KIN_WHEELBASE_MM;
+  float d  = steerRad(KIN_DRIVE_AXLE ? fr : ff);
+  float xd = KIN_DRIVE_AXLE ? KIN_XR : KIN_XF;
+  // Wheel at lateral py on the driven axle: v.heading = w*(s - py*cos d),
+  // s = yc*cos d + (xd - xc)*sin d = signed radius of the axle center
+  float c = cosf(d);
+  float sk = c + k * (xd - KIN_XF) * sinf(d) + tf * sinf(d);  // s * k
+  float q = fabsf(sk) > 1e-6f ? k * KIN_TRACK_MM * 0.5f * c / sk : 1e6f; // axle center at the ICR: spin
+  float l = 1.0f + q, r = 1.0f - q;
+  float m = fmaxf(fabsf(l), fabsf(r));
+  WheelSplit w;
+  w.left  = (int16_t)lroundf(l / m * (1 << KIN_Q));
+  w.right = (int16_t)lroundf(r / m * (1 << KIN_Q));
+  return w;
+}
+
+float centerSpeedRatio(int ff, int fr) {
+  float tf = tanf(steerRad(ff)), tr = tanf(steerRad(fr));
+  float k = (tf - tr) / KIN_WHEELBASE_MM;
+  if (fabsf(k) < 1e-9f) return 1.0f;
+  float d  = steerRad(KIN_DRIVE_AXLE ? fr : ff);
+  float xd = KIN_DRIVE_AXLE ? KIN_XR : KIN_XF;
+  float c = cosf(d);
+  float sk = c + k * (xd - KIN_XF) * sinf(d) + tf * sinf(d);  // as in wheelSplitRef
+  if (fabsf(sk) < 1e-6f) return 0.0f;                          // driven axle spins in place
+  float q = k * KIN_TRACK_MM * 0.5f * c / sk;
+  float fast = fabsf(sk / k) * fmaxf(fabsf(1.0f + q), fabsf(1.0f - q));
+  return turnRadiusMm(ff, fr) / fast;
+}
+
+float turnRadiusMm(int ff, int fr) {
+  float tf = tanf(steerRad(ff)), tr = tanf(steerRad(fr));
+  if (tf == tr) return INFINITY;
+  float yc = KIN_WHEELBASE_MM / (tf - tr), xc = KIN_XF - yc * tf;
+  return sqrtf(xc * xc + yc * yc);
+}
+
+void planSteeringRef(float x, float y, UIMode mode, float diam,
+                     int &ff, int &fr, int &base, float &steerExtent, WheelSplit &split)
 {
   x = clamp11f(x);
   y = clamp11f(y);
@@ -71,4 +120,101 @@ void planSteering(float x, float y, UIMode mode, float diam,
 
   ff = mp_clampInt((int)lroundf(ffF), FF_MIN, FF_MAX);
   fr = mp_clampInt((int)lroundf(frF), FR_MIN, FR_MAX);
+  split = wheelSplitRef(ff, fr);
+}
+
+// ==== Table-driven fast path ====
+// Every mode is a linear ramp from SERVO_CENTER to one of four end stops,
+// so four 257-entry tables (index = |x| or 1-diam in 1/256 steps) cover
+// all of them. Built at compile time with integer rounding.
+static const int LUT_N = 256;
+
+struct SteerRamp { uint8_t deg[LUT_N + 1]; };
+
+static constexpr SteerRamp makeRamp(int from, int to) {
+  SteerRamp r{};
+  for (int i = 0; i <= LUT_N; ++i) {
+    int v = from * LUT_N + (to - from) * i;          // * 256
+    r.deg[i] = (uint8_t)((v + LUT_N / 2) / LUT_N);   // all values > 0: round half up
+  }
+  return r;
+}
+
+static constexpr SteerRamp RAMP_FF_MIN = makeRamp(SERVO_CENTER, FF_MIN);
+static constexpr SteerRamp RAMP_FF_MAX = makeRamp(SERVO_CENTER, FF_MAX);
+static constexpr SteerRamp RAMP_FR_MIN = makeRamp(SERVO_CENTER, FR_MIN);
+static constexpr SteerRamp RAMP_FR_MAX = makeRamp(SERVO_CENTER, FR_MAX);
+static_assert(RAMP_FF_MAX.deg[LUT_N] == FF_MAX && RAMP_FR_MIN.deg[0] == SERVO_CENTER, "steer ramp");
+
+// Wheel split per ramp pair and index, filled from wheelSplitRef on first
+// use (tanf is not constexpr). Pairs: 0 = FF_MIN/FR_MAX (left turn),
+// 1 = FF_MAX/FR_MIN (right turn), 2 = FF_MIN/FR_MIN, 3 = FF_MAX/FR_MAX (crab)
+struct SplitTables { WheelSplit s[4][LUT_N + 1]; };
+
+static const SplitTables& splitTables() {
+  static const SplitTables t = []{
+    const SteerRamp* f[4] = { &RAMP_FF_MIN, &RAMP_FF_MAX, &RAMP_FF_MIN, &RAMP_FF_MAX };
+    const SteerRamp* r[4] = { &RAMP_FR_MAX, &RAMP_FR_MIN, &RAMP_FR_MIN, &RAMP_FR_MAX };
+    SplitTables v;
+    for (int p = 0; p < 4; ++p)
+      for (int i = 0; i <= LUT_N; ++i) v.s[p][i] = wheelSplitRef(f[p]->deg[i], r[p]->deg[i]);
+    return v;
+  }();
+  return t;
+}
+
+// 0..1 -> 0..256
+static inline int q256(float v){
+  if (v <= 0.0f) return 0;
+  if (v >= 1.0f) return LUT_N;
+  return (int)(v * LUT_N + 0.5f);
+}
+
+void planSteeringLut(float x, float y, UIMode mode, float diam,
+                     int &ff, int &fr, int &base, float &steerExtent, WheelSplit &split)
+{
+  y = clamp11f(y);
+  base = (int)(y * 255.0f);
+
+  const bool left = (x < 0);
+  int i, pair;
+  const SteerRamp *rf, *rr;
+  switch (mode) {
+    case MODE_NORMAL: // opposite steer front/back
+      i = q256(left ? -x : x);
+      rf = left ? &RAMP_FF_MIN : &RAMP_FF_MAX;
+      rr = left ? &RAMP_FR_MAX : &RAMP_FR_MIN;
+      pair = left ? 0 : 1;
+      break;
+    case MODE_CRAB:   // parallel steer
+      i = q256(left ? -x : x);
+      rf = left ? &RAMP_FF_MIN : &RAMP_FF_MAX;
+      rr = left ? &RAMP_FR_MIN : &RAMP_FR_MAX;
+      pair = left ? 2 : 3;
+      break;
+    case MODE_CIRCLE: // diam=0 -> end stops, diam=1 -> straight
+      i = LUT_N - q256(diam);
+      rf = left ? &RAMP_FF_MIN : &RAMP_FF_MAX;
+      rr = left ? &RAMP_FR_MAX : &RAMP_FR_MIN;
+      pair = left ? 0 : 1;
+      break;
+    default:
+      ff = SERVO_CENTER; fr = SERVO_CENTER; steerExtent = 0.0f; split = WheelSplit();
+      return;
+  }
+  ff = rf->deg[i];
+  fr = rr->deg[i];
+  steerExtent = i * (1.0f / LUT_N);
+  split = splitTables().s[pair][i];
+}
+
+void planSteering(float x, float y, UIMode mode, float diam,
+                  int &ff, int &fr, int &base, float &steerExtent, WheelSplit &split)
+{
+  TRACE_SCOPE("planSteering");
+#if PLANNER_USE_LUT
+  planSteeringLut(x, y, mode, diam, ff, fr, base, steerExtent, split);
+#else
+  planSteeringRef(x, y, mode, diam, ff, fr, base, steerExtent, split);
+#endif
 }
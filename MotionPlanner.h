@@ -6,6 +6,22 @@
 static inline float mp_mixf(float a, float b, float t){ return a + (b - a) * t; }
 static inline int   mp_clampInt(int v, int lo, int hi){ return (v<lo)?lo:((v>hi)?hi:v); }
 
+// Per-side wheel speed factors (Q14, -1..1) for a steering pose: the
+// driven wheels roll along the instantaneous center of rotation set by the
+// front/rear steer angles, so the inner side is slower (or reverses) and
+// the faster side gets 1. Geometry: KIN_* in config.h.
+#define KIN_Q 14
+struct WheelSplit { int16_t left = 1 << KIN_Q, right = 1 << KIN_Q; };
+static inline int wheelSplitApply(int pwm, int16_t k){ return (pwm * k + (1 << (KIN_Q - 1))) >> KIN_Q; }
+
+// Exact model for any servo pair (float; manual steer, reference)
+WheelSplit wheelSplitRef(int ff, int fr);
+// Turn radius of the chassis center in mm (INFINITY when driving straight)
+float turnRadiusMm(int ff, int fr);
+// Chassis center speed per unit speed of the faster driven wheel (1 when
+// straight or crabbing)
+float centerSpeedRatio(int ff, int fr);
+
 // Compute steering + speed base from joystick state.
 // Inputs:
 //   x: -1..+1 (steer)
@@ -16,5 +32,15 @@ static inline int   mp_clampInt(int v, int lo, int hi){ return (v<lo)?lo:((v>hi)
 //   ff, fr: servo target degrees (clamped to FF_/FR_ limits)
 //   base:   base PWM from throttle (-255..+255)
 //   steerExtent: 0..1 amount of steering for speed scaling
+//   split:  left/right wheel factors for ff/fr (wheelSplitRef)
+// Steer/diam are quantized to 1/256 and looked up in constexpr tables
+// when PLANNER_USE_LUT is set (within 1 deg of the reference); the split
+// comes from per-ramp tables filled once from wheelSplitRef.
 void planSteering(float x, float y, UIMode mode, float diam,
-                  int &ff, int &fr, int &base, float &steerExtent);
+                  int &ff, int &fr, int &base, float &steerExtent, WheelSplit &split);
+
+// Reference float implementations (always built; used for equivalence checks)
+void planSteeringRef(float x, float y, UIMode mode, float diam,
+                     int &ff, int &fr, int &base, float &steerExtent, WheelSplit &split);
+void planSteeringLut(float x, float y, UIMode mode, float diam,
+                     int &ff, int &fr, int &base, float &steerExtent, WheelSplit &split);
@@ -0,0 +1,107 @@
+#include "PowerGovernor.h"
+#include <math.h>
+
+void PowerGovernor::configure(const PowerModel& m, float wheelAccel, float wheelJerk) {
+  _m = m;
+  _acc = wheelAccel;
+  _jerk = wheelJerk;
+}
+
+void PowerGovernor::begin(const PowerModel& m, float wheelAccel, float wheelJerk) {
+  configure(m, wheelAccel, wheelJerk);
+  _w[0] = _w[1] = Ramp();
+  _haveMs = false;
+  _st = GovStats();
+}
+
+int PowerGovernor::_wheel(int i, int req, float dt, float allowMa, bool& ramped, bool& budget) {
+  Ramp& w = _w[i];
+  if (req == 0) {
+    w.d = 0; w.r = 0;  // stop now: a coasting motor draws nothing
+  } else {
+    // Jerk-limited approach: fastest rate that can still level off at req
+    float e = req - w.d;
+    float rdes = fminf(_acc, sqrtf(2.0f * _jerk * fabsf(e)));
+    if (e < 0) rdes = -rdes;
+    float drMax = _jerk * dt;
+    w.r += fmaxf(-drMax, fminf(rdes - w.r, drMax));
+    float step = w.r * dt;
+    if (fabsf(step) >= fabsf(e)) { w.d = (float)req; w.r = 0; }
+    else { w.d += step; ramped = true; }
+
+    // Current ~ stall * |duty - speed|: cap the lead over the modeled speed
+    float lim = allowMa / _m.motorStallMa * 255.0f;
+    if (lim < 0) lim = 0;
+    if (w.d - w.s > lim)  { w.d = w.s + lim; w.r = fminf(w.r, 0); budget = true; }
+    if (w.s - w.d > lim)  { w.d = w.s - lim; w.r = fmaxf(w.r, 0); budget = true; }
+  }
+  float k = dt * 1000.0f / _m.motorTauMs;
+  w.s += (w.d - w.s) * (k > 1 ? 1 : k);
+  return (int)lroundf(w.d);
+}
+
+// Current a servo's active limits can draw above holding
+float PowerGovernor::_servoNeed(const ServoControl& s) const {
+  return _m.servoMaPerDegS * s.velLimit() + _m.servoMaPerDegS2 * s.accLimit();
+}
+
+void PowerGovernor::step(uint32_t nowMs, int reqL, int reqR, ServoControl& a, ServoControl& b, int& outL, int& outR) {
+  float dt = _haveMs ? (uint32_t)(nowMs - _lastMs) * 0.001f : 1.0f / CONTROL_RATE_HZ;
+  _lastMs = nowMs; _haveMs = true;
+  if (dt <= 0) dt = 1.0f / CONTROL_RATE_HZ;
+  if (dt > 0.1f) dt = 0.1f;
+
+  // Wheels: what is left after base, holding and the steering reserve
+  float fixedMa = _m.baseMa + 2 * _m.servoIdleMa;
+  float allow = (_m.budgetMa - fixedMa - _m.servoReserveMa) * 0.5f - _m.motorRunMa;
+  bool ramped = false, budget = false;
+  outL = _wheel(0, reqL, dt, allow, ramped, budget);
+  outR = _wheel(1, reqR, dt, allow, ramped, budget);
+  if (ramped) _st.wheelRamped++;
+  if (budget) _st.wheelBudget++;
+  float motorsMa = 0;
+  for (int i = 0; i < 2; ++i)
+    if (_w[i].d != 0) motorsMa += _m.motorRunMa + _m.motorStallMa * fabsf(_w[i].d - _w[i].s) / 255.0f;
+
+  // Servos share the rest; a moveTogether pair gets one scale
+  float head = _m.budgetMa - fixedMa - motorsMa;
+  ServoControl* sv[2] = { &a, &b };
+  if (b.velocity() != 0 && a.velocity() == 0) { sv[0] = &b; sv[1] = &a; }
+  float scale[2] = { 1, 1 };
+  bool throttled = false, held = false;
+  if (a.scheduled() && b.scheduled()) {
+    float need = _servoNeed(a) + _servoNeed(b);
+    scale[0] = scale[1] = (need <= head || need <= 0) ? 1.0f : fmaxf(head, 0) / need;
+  } else {
+    for (int i = 0; i < 2; ++i) {
+      if (!sv[i]->moving()) continue;
+      float need = _servoNeed(*sv[i]);
+      float give = fminf(need, fmaxf(head, 0));
+      scale[i] = need > 0 ? give / need : 1.0f;
+      head -= give;
+    }
+  }
+  for (int i = 0; i < 2; ++i) {
+    if (!sv[i]->moving()) { sv[i]->setRateScale(1); continue; }
+    float s = scale[i];
+    // A moving servo keeps a floor so it never stalls mid-slew
+    if (sv[i]->velocity() != 0 && s < GOV_SERVO_MIN_SCALE) s = GOV_SERVO_MIN_SCALE;
+    if (s < GOV_SERVO_MIN_SCALE) { s = 0; held = true; }
+    else if (s < 1) throttled = true;
+    sv[i]->setRateScale(s);
+  }
+  if (throttled) _st.servoThrottled++;
+  if (held) _st.servoHeld++;
+
+  // Estimate from the servo motion of the last update (acceleration capped
+  // at the limit: the final snap onto the target is not a physical jerk)
+  float servosMa = 0;
+  for (int i = 0; i < 2; ++i) {
+    const ServoControl& s = i ? b : a;
+    float v = s.velocity();
+    servosMa += _m.servoMaPerDegS * fabsf(v) + _m.servoMaPerDegS2 * fminf(fabsf(v - _sv[i]) / dt, s.accLimit());
+    _sv[i] = v;
+  }
+  _st.lastMa = (uint32_t)(fixedMa + motorsMa + servosMa);
+  if (_st.lastMa > _st.peakMa) _st.peakMa = _st.lastMa;
+}
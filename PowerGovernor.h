@@ -0,0 +1,57 @@
+#pragma once
+#include <Arduino.h>
+#include "config.h"
+#include "ServoControl.h"
+
+// Supply current model of the actuators on the shared rail (mA)
+struct PowerModel {
+  float baseMa;          // ESP32 + WiFi
+  float servoIdleMa;     // per servo, holding
+  float servoMaPerDegS;  // per servo, per deg/s of slew
+  float servoMaPerDegS2; // per servo, per deg/s^2 of acceleration
+  float servoReserveMa;  // kept free of wheel ramps for steering
+  float motorStallMa;    // per motor, full duty at standstill
+  float motorTauMs;      // motor speed follows duty with this lag
+  float motorRunMa;      // per turning motor, friction load at steady speed
+  float budgetMa;        // keep the estimate under this
+};
+
+// Throttling events (control cycles) and the estimate
+struct GovStats {
+  uint32_t wheelRamped = 0;    // a wheel held back by the accel/jerk limits
+  uint32_t wheelBudget = 0;    // a wheel held back by the current budget
+  uint32_t servoThrottled = 0; // a slewing servo ran below its full rate
+  uint32_t servoHeld = 0;      // a servo start was deferred (stagger)
+  uint32_t lastMa = 0, peakMa = 0;
+};
+
+// Stage between the planner and the actuators, run once per control step
+// before the servo update()s. Wheel commands are ramped with acceleration
+// and jerk limits and kept inside the budget left by the servos' holding
+// current and the steering reserve; servo slews then share what the
+// motors leave, in order (a servo already moving first, then a, then b),
+// via ServoControl::setRateScale. A 0 wheel command (stop / e-stop) passes
+// at once. With WHEEL_SPEED_LOOP the ramp applies to the speed targets.
+class PowerGovernor {
+public:
+  void begin(const PowerModel& m, float wheelAccel, float wheelJerk); // duty/s, duty/s^2
+  // New model/limits, ramp state kept (live tuning); begin() also resets
+  void configure(const PowerModel& m, float wheelAccel, float wheelJerk);
+  void resetStats() { _st = GovStats(); }
+  void step(uint32_t nowMs, int reqL, int reqR, ServoControl& a, ServoControl& b, int& outL, int& outR);
+  const GovStats& stats() const { return _st; }
+  float estimateMa() const { return _st.lastMa; }
+
+private:
+  struct Ramp { float d = 0, r = 0, s = 0; }; // duty, duty rate, modeled speed (duty units)
+  PowerModel _m{};
+  float _acc = 0, _jerk = 0;
+  Ramp _w[2];
+  float _sv[2] = {0, 0};   // servo velocity last step (for acceleration)
+  uint32_t _lastMs = 0;
+  bool _haveMs = false;
+  GovStats _st;
+
+  int   _wheel(int i, int req, float dt, float allowMa, bool& ramped, bool& budget);
+  float _servoNeed(const ServoControl& s) const;
+};
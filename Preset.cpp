@@ -0,0 +1,162 @@
+#include "Preset.h"
+#include "MotionPlanner.h"
+#include "Speed.h"
+#include <math.h>
+
+static const float D2R = (float)(M_PI / 180.0);
+
+// planSteering without its trace span (compile scans the whole ramp)
+static inline void plan(const RecFrame& f, int& ff, int& fr, int& base, float& ext, WheelSplit& split){
+#if PLANNER_USE_LUT
+  planSteeringLut(f.x, f.y, (UIMode)f.mode, f.diam, ff, fr, base, ext, split);
+#else
+  planSteeringRef(f.x, f.y, (UIMode)f.mode, f.diam, ff, fr, base, ext, split);
+#endif
+}
+
+float presetEase(uint8_t ease, float u){
+  if (u <= 0) return 0;
+  if (u >= 1 || ease == EASE_NONE) return 1;
+  if (ease == EASE_LINEAR) return u;
+  return u * u * (3.0f - 2.0f * u);  // smoothstep
+}
+
+float presetFrameSpeedMmS(const RecFrame& f){
+  int ff, fr, base; float ext; WheelSplit split;
+  plan(f, ff, fr, base, ext, split);
+  if (f.manual) { ff = f.ff; fr = f.fr; ext = 0; split = wheelSplitRef(ff, fr); }
+  int pwm = applySpeedScaling(base, ext, (SpeedMode)f.speed);
+  int l = abs(wheelSplitApply(pwm, split.left)), r = abs(wheelSplitApply(pwm, split.right));
+  float v = (l > r ? l : r) * (PRESET_MM_S_FULL / 255.0f) * centerSpeedRatio(ff, fr);
+  return pwm < 0 ? -v : v;
+}
+
+// Drive for a center speed on the pose: the base PWM is an integer, so
+// this returns the nearest one at or below (0 if even 1 PWM is too fast)
+static float driveFor(RecFrame f, float speedMmS, float* got){
+  f.y = 1.0f;
+  float full = presetFrameSpeedMmS(f);
+  int base = full > 0 ? (int)(255.0f * speedMmS / full) : 0;
+  if (base > 255) base = 255;
+  if (base < 1) { *got = 0; return 0; }
+  f.y = (base + 0.5f) / 255.0f;  // (int)(y * 255) == base in the planner
+  *got = presetFrameSpeedMmS(f);
+  return f.y;
+}
+
+bool presetCompile(const PresetSpec& s, PresetPlan& o, char* err, size_t errLen){
+  RecFrame f{};
+  f.manual = 0; f.mode = MODE_NORMAL; f.diam = 1.0f; f.speed = SPEED_SPORT;
+  f.ff = SERVO_CENTER; f.fr = SERVO_CENTER;
+  float R = INFINITY;
+  if (s.speedMmS <= 0) { snprintf(err, errLen, "speed must be > 0"); return false; }
+
+  if (s.type == PRESET_STRAIGHT) {
+    float c = s.crab < -1 ? -1 : (s.crab > 1 ? 1 : s.crab);
+    if (c != 0) { f.mode = MODE_CRAB; f.x = c; }
+  } else {
+    if (!(s.radiusMm > 0)) { snprintf(err, errLen, "radius_mm required"); return false; }
+    // Counter-steer ramp in the planner's 1/256 steps; radii fall with the index
+    float best = INFINITY, rMin = INFINITY, rMax = 0;
+    int bi = 0;
+    for (int i = 1; i <= 256; ++i) {
+      RecFrame t = f; t.x = i / 256.0f;
+      int ff, fr, base; float ext; WheelSplit split;
+      plan(t, ff, fr, base, ext, split);
+      float r = turnRadiusMm(ff, fr);
+      if (isinf(r)) continue;
+      if (r < rMin) rMin = r;
+      if (r > rMax) rMax = r;
+      if (fabsf(r - s.radiusMm) < best) { best = fabsf(r - s.radiusMm); bi = i; R = r; }
+    }
+    if (s.radiusMm < rMin * 0.98f) { snprintf(err, errLen, "radius below full lock (%.0f mm)", rMin); return false; }
+    if (s.radiusMm > rMax * 1.02f) { snprintf(err, errLen, "radius above the smallest steer step (%.0f mm)", rMax); return false; }
+    float a = bi / 256.0f;
+    if (s.type == PRESET_ARC) { f.mode = MODE_NORMAL; f.x = s.left ? -a : a; }
+    else                      { f.mode = MODE_CIRCLE; f.x = s.left ? -1.0f : 1.0f; f.diam = 1.0f - a; }
+  }
+
+  uint32_t ramp = s.ease == EASE_NONE ? 0 : s.rampMs;
+  float v;
+  float y = driveFor(f, s.speedMmS, &v);
+  if (y == 0) { snprintf(err, errLen, "speed below 1 PWM step"); return false; }
+
+  float len = 0;
+  uint32_t T = 0;
+  if (s.distMm > 0) len = s.distMm;
+  else if (s.angleDeg > 0 && !isinf(R)) len = s.angleDeg * D2R * R;
+  if (len > 0) {
+    if (len < v * ramp * 0.001f) {  // too short to reach cruise: slower cruise, ramps only
+      y = driveFor(f, len / (ramp * 0.001f), &v);
+      if (y == 0) { snprintf(err, errLen, "move too short for the ramps"); return false; }
+    }
+    T = (uint32_t)lroundf(len / v * 1000.0f) + ramp;
+  } else if (s.durMs > 0) {
+    T = s.durMs > 2 * ramp ? s.durMs : 2 * ramp;
+    len = v * (T - ramp) * 0.001f;
+  } else if (s.type != PRESET_ORBIT) {
+    snprintf(err, errLen, "dist_mm, angle_deg or dur_ms required"); return false;
+  }
+
+  f.y = s.reverse ? -y : y;
+  o.pose = f; o.runMs = T; o.rampMs = (uint16_t)ramp; o.ease = s.ease;
+  o.radiusMm = R; o.speedMmS = v; o.distMm = len;
+  return true;
+}
+
+// ==== Runner ====
+void PresetRunner::_send(uint8_t op, const PresetPlan* p){
+  Cmd c;
+  c.gen = ++_genTx; c.op = op;
+  if (p) c.plan = *p;
+  _cmd.store(c);
+}
+
+void PresetRunner::start(const PresetPlan& p){ _send(OP_START, &p); _phasePub.store(PRESET_SETTLE, std::memory_order_relaxed); }
+void PresetRunner::stop(){ _send(OP_STOP, nullptr); }
+void PresetRunner::cancel(){ _send(OP_CANCEL, nullptr); }
+
+bool PresetRunner::tick(uint32_t nowMs, bool steerSettled, void (*onApply)(const RecFrame&)){
+  Cmd c;
+  if (_cmd.tryLoad(c) && c.gen != _genRx) {
+    _genRx = c.gen;
+    if (c.op == OP_START) { _p = c.plan; _phase = PRESET_SETTLE; _t0 = nowMs; _settleTicks = 0; _level = 0; }
+    else if (c.op == OP_CANCEL || (c.op == OP_STOP && _phase == PRESET_SETTLE)) _phase = PRESET_IDLE;
+    else if (c.op == OP_STOP && _phase == PRESET_RUN) {
+      _phase = PRESET_STOPPING; _stopT = nowMs; _stopLevel = _level;
+      _stopLen = (uint32_t)(_p.rampMs * _level);
+    }
+  }
+  if (_phase == PRESET_IDLE) { _phasePub.store(PRESET_IDLE, std::memory_order_relaxed); return false; }
+
+  uint32_t t = nowMs - _t0;
+  switch (_phase) {
+    case PRESET_SETTLE:
+      // the first frame sets the servo targets; roll once they have arrived
+      _level = 0;
+      if ((++_settleTicks > 1 && steerSettled) || t >= PRESET_SETTLE_MAX_MS) { _phase = PRESET_RUN; _t0 = nowMs; }
+      break;
+    case PRESET_RUN: {
+      uint32_t r = _p.rampMs;
+      if (_p.runMs && t >= _p.runMs) { _level = 0; _phase = PRESET_IDLE; break; }
+      if (r == 0) _level = 1;
+      else if (t < r) _level = presetEase(_p.ease, (float)t / r);
+      else if (_p.runMs && t > _p.runMs - r) _level = presetEase(_p.ease, (float)(_p.runMs - t) / r);
+      else _level = 1;
+    } break;
+    case PRESET_STOPPING: {
+      uint32_t ts = nowMs - _stopT;
+      if (ts >= _stopLen) { _level = 0; _phase = PRESET_IDLE; }
+      else _level = _stopLevel * presetEase(_p.ease, 1.0f - (float)ts / _stopLen);
+    } break;
+    default: break;
+  }
+
+  RecFrame f = _p.pose;  // the last frame (drive 0) is applied too
+  f.t = t;
+  f.y = _p.pose.y * _level;
+  onApply(f);
+  _phasePub.store(_phase, std::memory_order_relaxed);
+  _elapsedPub.store(_phase == PRESET_SETTLE ? 0 : nowMs - _t0, std::memory_order_relaxed);
+  return true;
+}
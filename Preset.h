@@ -0,0 +1,83 @@
+#pragma once
+#include <Arduino.h>
+#include <atomic>
+#include "config.h"
+#include "Recorder.h"
+#include "SeqLock.h"
+
+// ==== Parametric motion presets ====
+// A preset is compiled once (loop side) into a steering pose and a drive
+// profile, then evaluated at the control rate into the same RecFrame the
+// recorder plays back: no storage, ~200 bytes of state.
+//   straight  distance or duration; crab != 0 slides diagonally with the
+//             heading kept (camera dolly)
+//   arc       radius + sweep angle, distance or duration
+//   orbit     circle around a target at radius, for an angle/turns or until
+//             stopped; 4WS counter-steer keeps the body, and a camera on it,
+//             at a constant heading relative to the target
+// The drive eases in and out over rampMs (linear or smoothstep). The
+// steering servos reach the pose before the wheels roll.
+enum PresetType : uint8_t { PRESET_STRAIGHT = 0, PRESET_ARC = 1, PRESET_ORBIT = 2 };
+enum PresetEase : uint8_t { EASE_NONE = 0, EASE_LINEAR = 1, EASE_SMOOTH = 2 };
+enum PresetPhase : uint8_t { PRESET_IDLE = 0, PRESET_SETTLE = 1, PRESET_RUN = 2, PRESET_STOPPING = 3 };
+
+struct PresetSpec {
+  uint8_t  type = PRESET_STRAIGHT;
+  uint8_t  ease = EASE_SMOOTH;
+  bool     left = false;          // arc/orbit turn side
+  bool     reverse = false;
+  float    speedMmS = PRESET_SPEED_MM_S; // cruise speed of the chassis center
+  float    distMm = 0;            // 0: from angleDeg, else durMs
+  uint32_t durMs = 0;             // orbit with no dist/angle/dur runs until stopped
+  float    radiusMm = 0;          // arc/orbit
+  float    angleDeg = 0;          // arc/orbit sweep
+  float    crab = 0;              // straight: -1..1 crab steer
+  uint16_t rampMs = PRESET_RAMP_MS;
+};
+
+struct PresetPlan {
+  RecFrame pose;      // mode/x/diam/speed of every frame; y = cruise drive
+  uint32_t runMs;     // ramps included; 0 = until stopped
+  uint16_t rampMs;
+  uint8_t  ease;
+  float    radiusMm;  // reached with integer servo angles (INFINITY straight)
+  float    speedMmS;  // cruise speed after drive quantization
+  float    distMm;    // planned path length (0 = endless)
+};
+
+// false + message if the spec cannot be met (radius below full lock, ...)
+bool  presetCompile(const PresetSpec& s, PresetPlan& out, char* err, size_t errLen);
+float presetEase(uint8_t ease, float u);  // 0..1 -> 0..1, area 1/2 for the ramped ones
+// Center speed (mm/s, signed) the speed model gives for a frame
+float presetFrameSpeedMmS(const RecFrame& f);
+
+class PresetRunner {
+public:
+  // Loop side
+  void start(const PresetPlan& p);
+  void stop();    // ease out from the current drive
+  void cancel();  // stop at once
+  PresetPhase phase() const { return (PresetPhase)_phasePub.load(std::memory_order_relaxed); }
+  uint32_t elapsedMs() const { return _elapsedPub.load(std::memory_order_relaxed); }
+
+  // Control step: while a preset runs, fills a frame and hands it to
+  // onApply (true). steerSettled = the steering servos are at rest.
+  bool tick(uint32_t nowMs, bool steerSettled, void (*onApply)(const RecFrame&));
+
+private:
+  enum : uint8_t { OP_NONE = 0, OP_START, OP_STOP, OP_CANCEL };
+  struct Cmd { uint32_t gen = 0; uint8_t op = OP_NONE; PresetPlan plan{}; };
+  SeqLock<Cmd> _cmd;
+  uint32_t _genTx = 0;          // loop side
+
+  uint32_t _genRx = 0;          // control side from here on
+  PresetPlan _p{};
+  PresetPhase _phase = PRESET_IDLE;
+  uint32_t _t0 = 0, _stopT = 0, _stopLen = 0;
+  float    _level = 0, _stopLevel = 0;  // drive as a fraction of cruise
+  uint16_t _settleTicks = 0;
+  std::atomic<uint8_t>  _phasePub{PRESET_IDLE};
+  std::atomic<uint32_t> _elapsedPub{0};
+
+  void _send(uint8_t op, const PresetPlan* p);
+};
@@ -0,0 +1,184 @@
+#include "RecFormat.h"
+#include "Recorder.h"
+
+static inline int16_t q14(float v){
+  long q = lroundf(v * 16384.0f);
+  if (q < -16384) q = -16384;
+  if (q >  16384) q =  16384;
+  return (int16_t)q;
+}
+static inline uint16_t q16u(float v){
+  long q = lroundf(v * 65535.0f);
+  if (q < 0) q = 0;
+  if (q > 65535) q = 65535;
+  return (uint16_t)q;
+}
+static inline uint8_t deg8(int d){ return (uint8_t)((d < 0) ? 0 : ((d > 180) ? 180 : d)); }
+
+void recInitHeader(RecFileHeader& h, uint16_t sampleMs){
+  memset(&h, 0, sizeof(h));
+  h.magic[0]=REC_MAGIC0; h.magic[1]=REC_MAGIC1; h.magic[2]=REC_MAGIC2; h.magic[3]=REC_MAGIC3;
+  h.version    = REC_DELTA ? REC_VERSION : 1;
+  h.frameBytes = (uint8_t)sizeof(RecPacked);
+  h.sampleMs   = sampleMs;
+  h.blockBytes = REC_BLOCK_BYTES;
+}
+
+bool recHeaderValid(const RecFileHeader& h){
+  return h.magic[0]==REC_MAGIC0 && h.magic[1]==REC_MAGIC1 && h.magic[2]==REC_MAGIC2 && h.magic[3]==REC_MAGIC3 &&
+         (h.version==1 || h.version==2) && h.frameBytes==sizeof(RecPacked) && h.blockBytes==REC_BLOCK_BYTES;
+}
+
+void recPack(const RecFrame& f, uint32_t t0, RecPacked& out){
+  out.dt   = (uint16_t)(f.t - t0);
+  out.x    = q14(f.x);
+  out.y    = q14(f.y);
+  out.diam = q16u(f.diam);
+  out.bits = (uint8_t)((f.mode & 0x03) | ((f.speed & 0x03) << 2) | ((f.manual ? 1 : 0) << 4));
+  out.ff   = deg8(f.ff);
+  out.fr   = deg8(f.fr);
+}
+
+void recUnpack(const RecPacked& p, uint32_t t0, RecFrame& out){
+  out.t      = t0 + p.dt;
+  out.x      = p.x / 16384.0f;
+  out.y      = p.y / 16384.0f;
+  out.diam   = p.diam / 65535.0f;
+  out.mode   = (uint8_t)(p.bits & 0x03);
+  out.speed  = (uint8_t)((p.bits >> 2) & 0x03);
+  out.manual = (uint8_t)((p.bits >> 4) & 0x01);
+  out.ff     = p.ff;
+  out.fr     = p.fr;
+}
+
+uint16_t recCrc16(const uint8_t* data, size_t len, uint16_t crc){
+  while (len--) {
+    crc ^= (uint16_t)(*data++) << 8;
+    for (int b = 0; b < 8; ++b) crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+  }
+  return crc;
+}
+
+void recSealBlock(uint8_t* block, uint16_t count){
+  RecBlockHeader* h = (RecBlockHeader*)block;
+  h->count = count;
+  h->crc   = 0;
+  h->crc   = recCrc16(block, REC_BLOCK_BYTES);
+}
+
+bool recBlockValid(const uint8_t* block){
+  RecBlockHeader h;
+  memcpy(&h, block, sizeof(h));
+  if (h.count == 0 || h.count > REC_BLOCK_MAX_FRAMES) return false;
+  uint16_t want = h.crc;
+  uint16_t crc  = recCrc16(block, offsetof(RecBlockHeader, crc));
+  const uint8_t zero[2] = {0, 0};
+  crc = recCrc16(zero, 2, crc);
+  crc = recCrc16(block + sizeof(h.count) + sizeof(h.crc), REC_BLOCK_BYTES - sizeof(h.count) - sizeof(h.crc), crc);
+  return crc == want;
+}
+
+// ==== v2 delta/RLE codec ====
+enum { F_DT=1, F_X=2, F_Y=4, F_DIAM=8, F_BITS=16, F_FF=32, F_FR=64 };
+
+static inline uint8_t putVar(uint8_t* d, uint32_t v){
+  uint8_t n = 0;
+  while (v >= 0x80) { d[n++] = (uint8_t)(v | 0x80); v >>= 7; }
+  d[n++] = (uint8_t)v;
+  return n;
+}
+static inline uint32_t zig(int32_t v){ return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31); }
+static inline int32_t unzig(uint32_t v){ return (int32_t)(v >> 1) ^ -(int32_t)(v & 1); }
+
+// false = ran past end
+static inline bool getVar(const uint8_t*& s, const uint8_t* end, uint32_t& v){
+  v = 0;
+  for (int sh = 0; sh < 35; sh += 7) {
+    if (s >= end) return false;
+    uint8_t b = *s++;
+    v |= (uint32_t)(b & 0x7F) << sh;
+    if (!(b & 0x80)) return true;
+  }
+  return false;
+}
+
+void recEncBegin(RecBlockEnc& e, uint8_t* blk, uint8_t version, uint16_t sampleMs){
+  e.blk = blk; e.version = version; e.sampleMs = sampleMs;
+  e.used = sizeof(RecBlockHeader); e.count = 0; e.rpt = -1;
+}
+
+bool recEncAdd(RecBlockEnc& e, const RecPacked& p){
+  if (e.version < 2 || e.count == 0) { // fixed frame (v1, or v2 keyframe)
+    if (e.version < 2 ? e.count >= REC_FRAMES_PER_BLOCK : e.used + sizeof(p) > REC_BLOCK_BYTES) return false;
+    memcpy(e.blk + e.used, &p, sizeof(p));
+    e.used += sizeof(p); e.count++; e.prev = p;
+    return true;
+  }
+  if (e.count >= REC_BLOCK_MAX_FRAMES) return false;
+  const RecPacked& q = e.prev;
+  uint16_t step = (uint16_t)(p.dt - q.dt);
+  uint8_t mask = (step != e.sampleMs ? F_DT : 0) | (p.x != q.x ? F_X : 0) | (p.y != q.y ? F_Y : 0) |
+                 (p.diam != q.diam ? F_DIAM : 0) | (p.bits != q.bits ? F_BITS : 0) |
+                 (p.ff != q.ff ? F_FF : 0) | (p.fr != q.fr ? F_FR : 0);
+  if (!mask) {
+    if (e.rpt >= 0 && e.blk[e.rpt] < 0xFF) e.blk[e.rpt]++;
+    else {
+      if (e.used + 1 > REC_BLOCK_BYTES) return false;
+      e.rpt = (int16_t)e.used;
+      e.blk[e.used++] = 0x80;
+    }
+  } else {
+    uint8_t op[20], n = 0;
+    op[n++] = mask;
+    if (mask & F_DT)   n += putVar(op + n, step);
+    if (mask & F_X)    n += putVar(op + n, zig(p.x - q.x));
+    if (mask & F_Y)    n += putVar(op + n, zig(p.y - q.y));
+    if (mask & F_DIAM) n += putVar(op + n, zig((int32_t)p.diam - q.diam));
+    if (mask & F_BITS) op[n++] = p.bits;
+    if (mask & F_FF)   n += putVar(op + n, zig(p.ff - q.ff));
+    if (mask & F_FR)   n += putVar(op + n, zig(p.fr - q.fr));
+    if (e.used + n > REC_BLOCK_BYTES) return false;
+    memcpy(e.blk + e.used, op, n);
+    e.used += n;
+    e.rpt = -1;
+  }
+  e.count++; e.prev = p;
+  return true;
+}
+
+int recDecodeBlock(const uint8_t* blk, uint8_t version, uint16_t sampleMs, RecPacked* out, int cap){
+  RecBlockHeader h;
+  memcpy(&h, blk, sizeof(h));
+  if (h.count > cap) return -1;
+  const uint8_t* s = blk + sizeof(h);
+  if (version < 2) {
+    if (h.count > REC_FRAMES_PER_BLOCK) return -1;
+    memcpy(out, s, h.count * sizeof(RecPacked));
+    return h.count;
+  }
+  const uint8_t* end = blk + REC_BLOCK_BYTES;
+  memcpy(&out[0], s, sizeof(RecPacked));
+  s += sizeof(RecPacked);
+  int n = 1;
+  while (n < h.count) {
+    if (s >= end) return -1;
+    uint8_t op = *s++;
+    RecPacked p = out[n - 1];
+    if (op & 0x80) {
+      int run = (op & 0x7F) + 1;
+      if (n + run > h.count) return -1;
+      while (run--) { p.dt += sampleMs; out[n++] = p; }
+      continue;
+    }
+    uint32_t v;
+    if (op & F_DT) { if (!getVar(s, end, v)) return -1; p.dt += (uint16_t)v; } else p.dt += sampleMs;
+    if (op & F_X)    { if (!getVar(s, end, v)) return -1; p.x += (int16_t)unzig(v); }
+    if (op & F_Y)    { if (!getVar(s, end, v)) return -1; p.y += (int16_t)unzig(v); }
+    if (op & F_DIAM) { if (!getVar(s, end, v)) return -1; p.diam = (uint16_t)(p.diam + unzig(v)); }
+    if (op & F_BITS) { if (s >= end) return -1; p.bits = *s++; }
+    if (op & F_FF)   { if (!getVar(s, end, v)) return -1; p.ff = (uint8_t)(p.ff + unzig(v)); }
+    if (op & F_FR)   { if (!getVar(s, end, v)) return -1; p.fr = (uint8_t)(p.fr + unzig(v)); }
+    out[n++] = p;
+  }
+  return n;
+}
@@ -0,0 +1,96 @@
+#pragma once
+#include <Arduino.h>
+#include "config.h"
+
+// ==== CamMate binary recording format ====
+// File  = RecFileHeader + N fixed-size blocks (REC_BLOCK_BYTES each).
+// On the rig the blocks sit in a SlotStore slot (SlotStore.h) with the
+// header fields in its journal; the file form is the import format.
+// v1 block = RecBlockHeader + up to REC_FRAMES_PER_BLOCK packed frames.
+// v2 block = RecBlockHeader + one packed keyframe + a delta stream:
+//   0x80|(n-1)  n (1..128) frames equal to the previous one, dt = sampleMs
+//   0x00|mask   one frame; for each set bit (LSB first: dt, x, y, diam,
+//               bits, ff, fr) a value follows: dt as unsigned varint
+//               (only when it is not sampleMs), bits as a raw byte, the
+//               rest as zigzag varint deltas of the quantized field
+// Every block starts with a keyframe, so blocks decode (and seek)
+// independently and a torn block costs only its own frames.
+//   - frame time is stored as ms since the block's t0
+//   - x/y are Q14 fixed point, diam is Q16 (0..65535 = 0..1)
+//   - mode/speed/manual are packed into one byte
+//   - crc = CRC16-CCITT over the block with the crc field zeroed
+// A short last block is written at full size; its count says how many
+// frames are valid. All fields are little-endian (ESP32 native).
+
+#define REC_MAGIC0 'C'
+#define REC_MAGIC1 'M'
+#define REC_MAGIC2 'R'
+#define REC_MAGIC3 'B'
+#define REC_VERSION     2 // written; 1 is still read
+#define REC_BLOCK_BYTES 256
+
+struct RecFrame;
+
+struct __attribute__((packed)) RecFileHeader {
+  char     magic[4];   // "CMRB"
+  uint8_t  version;    // REC_VERSION
+  uint8_t  frameBytes; // sizeof(RecPacked)
+  uint16_t sampleMs;   // nominal sample period
+  uint16_t blockBytes; // REC_BLOCK_BYTES
+  uint8_t  reserved[6];
+};
+
+struct __attribute__((packed)) RecBlockHeader {
+  uint16_t count; // valid frames in this block
+  uint16_t crc;
+  uint32_t t0;    // ms since record start of the first frame
+};
+
+struct __attribute__((packed)) RecPacked {
+  uint16_t dt;   // ms since block t0
+  int16_t  x;    // Q14
+  int16_t  y;    // Q14
+  uint16_t diam; // Q16
+  uint8_t  bits; // [1:0]=mode [3:2]=speed [4]=manual
+  uint8_t  ff;   // front servo deg
+  uint8_t  fr;   // rear servo deg
+};
+
+#define REC_BLOCK_PAYLOAD    (REC_BLOCK_BYTES - sizeof(RecBlockHeader))
+#define REC_FRAMES_PER_BLOCK (REC_BLOCK_PAYLOAD / sizeof(RecPacked)) // v1
+#define REC_BLOCK_MAX_FRAMES 128 // v2 cap = decoded window size per block
+
+static_assert(sizeof(RecFileHeader) == 16, "RecFileHeader layout");
+static_assert(sizeof(RecBlockHeader) == 8, "RecBlockHeader layout");
+static_assert(sizeof(RecPacked) == 11, "RecPacked layout");
+
+void     recInitHeader(RecFileHeader& h, uint16_t sampleMs);
+bool     recHeaderValid(const RecFileHeader& h); // v1 or v2
+
+// Quantize a frame relative to block start t0 (t - t0 must fit 16 bits).
+void     recPack(const RecFrame& f, uint32_t t0, RecPacked& out);
+void     recUnpack(const RecPacked& p, uint32_t t0, RecFrame& out);
+
+uint16_t recCrc16(const uint8_t* data, size_t len, uint16_t crc = 0xFFFF);
+// Fill in count/crc of a REC_BLOCK_BYTES block buffer, or check them.
+void     recSealBlock(uint8_t* block, uint16_t count);
+bool     recBlockValid(const uint8_t* block);
+
+// Block encoder. recEncAdd() returns false when the frame does not fit
+// (block full); seal with recSealBlock(blk, e.count) and start a new one.
+// p.dt is relative to the block's t0, which the caller stores.
+struct RecBlockEnc {
+  uint8_t*  blk;
+  uint8_t   version;
+  uint16_t  sampleMs;
+  uint16_t  used;   // bytes incl. header
+  uint16_t  count;
+  int16_t   rpt;    // offset of an open repeat op, -1 = none
+  RecPacked prev;
+};
+void recEncBegin(RecBlockEnc& e, uint8_t* blk, uint8_t version, uint16_t sampleMs);
+bool recEncAdd(RecBlockEnc& e, const RecPacked& p);
+
+// Decodes a valid block into at most cap packed frames (dt from t0);
+// -1 if the stream is malformed.
+int  recDecodeBlock(const uint8_t* blk, uint8_t version, uint16_t sampleMs, RecPacked* out, int cap);
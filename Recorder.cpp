@@ -1,153 +1,465 @@
 #include "Recorder.h"
+#include "Metrics.h"
+#include "Trace.h"
+
+// SPIFFS open, timed into mFsOpen
+static File fsOpen(const char* path, const char* mode){ MetScope t(mFsOpen); return SPIFFS.open(path, mode); }
 
 static inline float clamp11f(float v){ if(v<-1)return-1; if(v>1)return 1; return v; }
 static inline float clamp01f(float v){ if(v<0)return 0; if(v>1)return 1; return v; }
 
-bool Recorder::begin(){
-  if (!SPIFFS.begin(true)) { snprintf(_err,sizeof(_err),"SPIFFS mount fail"); return false; }
+bool Recorder::begin(SlotStore& store){
+  if (!_lock) _lock = xSemaphoreCreateMutex();
+  _store = &store;
+  if (!store.ready()) { snprintf(_err,sizeof(_err),"%s", store.lastError()); return false; }
   return true;
 }
 
-bool Recorder::fileExists(const char* pathJson){ return SPIFFS.exists(pathJson); }
-bool Recorder::clearFile(const char* path){ if (SPIFFS.exists(path)) return SPIFFS.remove(path); return true; }
-
-bool Recorder::_openWrite(const char* pathJson){
-  _wf = SPIFFS.open(pathJson, FILE_WRITE);
-  if (!_wf) { snprintf(_err,sizeof(_err),"open write fail"); return false; }
+bool Recorder::_openWrite(int slot, uint8_t version, uint16_t sampleMs, int next){
+  if (!_store->open(slot, version, sampleMs, next)) { snprintf(_err,sizeof(_err),"%s", _store->lastError()); return false; }
+  _framesRecorded = 0;
+  _lastT = 0;
+  memset(_blk, 0, sizeof(_blk));
+  recEncBegin(_enc, _blk, version, sampleMs);
+  _writing = true;
+  return true;
+}
+// Writes the partial block and journals what reached flash
+bool Recorder::_closeWrite(){
+  _flushBlock();
+  _writing = false;
+  if (!_store->close(_framesRecorded, _lastT)) { snprintf(_err,sizeof(_err),"%s", _store->lastError()); return false; }
   return true;
 }
-void Recorder::_closeWrite(){ if (_wf) _wf.close(); }
 
-void Recorder::pushLive(bool manual, float x, float y, UIMode mode, float diam, SpeedMode spd, int ffDeg, int frDeg){
-  _lmanual = manual;
-  _lx = clamp11f(x); _ly = clamp11f(y);
-  _lm = mode; _ld = clamp01f(diam); _ls = spd;
-  _lff = (int16_t)ffDeg; _lfr = (int16_t)frDeg;
+// One flash append per block (1.1 s of frames at 20 Hz in v1; in v2 up
+// to REC_BLOCK_MAX_FRAMES, depending on how much the motion changes).
+// A failed append (slot full, flash error) ends the take there.
+void Recorder::_flushBlock(){
+  if (_enc.count == 0) return;
+  TRACE_SCOPE("rec.flushBlock");
+  recSealBlock(_blk, _enc.count);
+  bool ok;
+  { MetScope t(mRecWrite); ok = _writing && _store->append(_blk); }
+  if (ok) { _framesRecorded += _enc.count; _lastT = _blkLastT; }
+  else if (_writing) { _writing = false; snprintf(_err,sizeof(_err),"%s", _store->lastError()); }
+  if (ok && _state == REC_RECORDING) { // lag from the block's last capture to on flash
+    uint32_t lag = millis() - _recStart - _blkLastT;
+    _lagLastMs = lag;
+    if (lag > _lagMaxMs) _lagMaxMs = lag;
+    _blocksCommitted++;
+  }
+  memset(_blk, 0, sizeof(_blk));
+  recEncBegin(_enc, _blk, _enc.version, _enc.sampleMs);
+}
+
+void Recorder::capture(uint32_t nowMs, const RecFrame& live){
+  if (!_capturing.load(std::memory_order_acquire)) return;
+  if ((int32_t)(nowMs - _nextSample) < 0) return;
+  _nextSample += _sampleMs;
+  if ((int32_t)(nowMs - _nextSample) >= 0) _nextSample = nowMs + _sampleMs; // fell behind: no burst
+  RecFrame f = live;
+  f.t = nowMs - _recStart;
+  f.x = clamp11f(f.x); f.y = clamp11f(f.y); f.diam = clamp01f(f.diam);
+  if (!_ring.push(f)) { _ringOverflows++; return; }
+  uint32_t n = _ring.size();
+  if (n > _ringHigh) _ringHigh = n;
+}
+
+// Commits what was queued on entry; full blocks go out as they fill. The
+// bound keeps a flush slower than the capture rate from pinning the loop.
+void Recorder::_drain(){
+  RecFrame f;
+  for (uint32_t n = _ring.size(); n && _ring.pop(f); --n) {
+    if (_writing) _appendFrame(f);
+  }
 }
 
-bool Recorder::startRecording(const char* pathJson, const char* pathMeta){
+bool Recorder::startRecording(int slot, int next){
   if (_state != REC_IDLE) { snprintf(_err,sizeof(_err),"busy"); return false; }
-  clearFile(pathJson); clearFile(pathMeta);
-  if (!_openWrite(pathJson)) return false;
+  RecFileHeader h;
+  recInitHeader(h, _sampleMs);
+  if (!_openWrite(slot, h.version, _sampleMs, next)) return false;
   _recStart   = millis();
   _nextSample = _recStart;
-  _framesRecorded = 0;
-  _lastT = 0;
-  _metaPath = pathMeta;
+  _ring.clear();
   _state = REC_RECORDING;
+  _capturing.store(true, std::memory_order_release);
   return true;
 }
 
 bool Recorder::stopRecording(){
   if (_state != REC_RECORDING) return false;
-  _closeWrite();
+  _capturing.store(false, std::memory_order_release);
+  _drain();        // a capture racing the store lands in the ring and is
+  _closeWrite();   // cleared by the next startRecording()
   _state = REC_IDLE;
-  File m = SPIFFS.open(_metaPath, FILE_WRITE);
-  if (m) { m.printf("{\"frames\":%u,\"duration_ms\":%u}\n", _framesRecorded, _lastT); m.close(); }
   return true;
 }
 
-bool Recorder::_loadFile(const char* pathJson){
-  _frames.clear();
-  File f = SPIFFS.open(pathJson, FILE_READ);
-  if (!f) { snprintf(_err,sizeof(_err),"open read fail"); return false; }
+// Legacy one-JSON-object-per-line frame (CamMate <= v3.9).
+static bool parseLegacyLine(const String& line, RecFrame& fr){
+  int ti=line.indexOf("\"t\":");
+  int mai=line.indexOf("\"manual\":");
+  int xi=line.indexOf("\"x\":");
+  int yi=line.indexOf("\"y\":");
+  int mi=line.indexOf("\"mode\":");
+  int di=line.indexOf("\"diam\":");
+  int si=line.indexOf("\"speed\":");
+  int ffi=line.indexOf("\"ff\":");
+  int fri=line.indexOf("\"fr\":");
+  if (ti<0||xi<0||yi<0||mi<0||di<0||si<0) return false;
+
+  fr.t     = (uint32_t)line.substring(ti+4).toInt();
+  fr.manual= (uint8_t)((mai>=0)? line.substring(mai+9).toInt() : 0);
+  fr.x     = line.substring(xi+4).toFloat();
+  fr.y     = line.substring(yi+4).toFloat();
+  fr.mode  = (uint8_t)line.substring(mi+7).toInt();
+  fr.diam  = line.substring(di+7).toFloat();
+  fr.speed = (uint8_t)line.substring(si+8).toInt();
+  fr.ff    = (int16_t)((ffi>=0)? line.substring(ffi+5).toInt() : 90);
+  fr.fr    = (int16_t)((fri>=0)? line.substring(fri+5).toInt() : 90);
+  return true;
+}
+
+// Line-by-line conversion into the binary format; RAM use does not depend
+// on take length.
+bool Recorder::_importJsonl(File& in, int slot){
+  RecFileHeader h;
+  recInitHeader(h, _sampleMs);
+  if (!_openWrite(slot, h.version, _sampleMs, 0)) return false;
   String line;
-  while (f.available()) {
-    line = f.readStringUntil('\n'); line.trim();
-    if (line.length() < 10) continue;
+  while (in.available() && _writing) {
+    line = in.readStringUntil('\n'); line.trim();
     RecFrame fr{};
-    int ti=line.indexOf("\"t\":");
-    int mai=line.indexOf("\"manual\":");
-    int xi=line.indexOf("\"x\":");
-    int yi=line.indexOf("\"y\":");
-    int mi=line.indexOf("\"mode\":");
-    int di=line.indexOf("\"diam\":");
-    int si=line.indexOf("\"speed\":");
-    int ffi=line.indexOf("\"ff\":");
-    int fri=line.indexOf("\"fr\":");
-    if (ti<0||xi<0||yi<0||mi<0||di<0||si<0) continue;
-
-    fr.t     = (uint32_t)line.substring(ti+4).toInt();
-    fr.manual= (uint8_t)((mai>=0)? line.substring(mai+9).toInt() : 0);
-    fr.x     = line.substring(xi+4).toFloat();
-    fr.y     = line.substring(yi+4).toFloat();
-    fr.mode  = (uint8_t)line.substring(mi+7).toInt();
-    fr.diam  = line.substring(di+7).toFloat();
-    fr.speed = (uint8_t)line.substring(si+8).toInt();
-    fr.ff    = (int16_t)((ffi>=0)? line.substring(ffi+5).toInt() : 90);
-    fr.fr    = (int16_t)((fri>=0)? line.substring(fri+5).toInt() : 90);
-    _frames.push_back(fr);
-    if (_frames.size() > 30000) break;
+    if (line.length() < 10 || !parseLegacyLine(line, fr)) continue;
+    _appendFrame(fr);
+  }
+  return _closeWrite() && _framesRecorded > 0;
+}
+
+// Copies the blocks that pass their CRC (a torn one is skipped)
+bool Recorder::_importBin(File& in, const RecFileHeader& h, int slot){
+  if (!_openWrite(slot, h.version, h.sampleMs, 0)) return false;
+  while (_writing && in.read(_raw, REC_BLOCK_BYTES) == REC_BLOCK_BYTES) {
+    if (!recBlockValid(_raw)) continue;
+    int n = recDecodeBlock(_raw, h.version, h.sampleMs, _win[0], REC_BLOCK_MAX_FRAMES);
+    if (n <= 0) continue;
+    if (!_store->append(_raw)) { snprintf(_err,sizeof(_err),"%s", _store->lastError()); break; }
+    _framesRecorded += n;
+    _lastT = ((const RecBlockHeader*)_raw)->t0 + _win[0][n - 1].dt;
+  }
+  return _closeWrite() && _framesRecorded > 0;
+}
+
+int Recorder::importSpiffs(){
+  if (_state != REC_IDLE || !_store || !_store->ready()) return 0;
+  int moved = 0;
+  for (int s = 1; s <= REC_SLOTS; ++s) {
+    char bin[20], jsonl[20], meta[20], idx[20];
+    snprintf(bin, sizeof(bin), "/rec%d.bin", s);
+    snprintf(jsonl, sizeof(jsonl), "/rec%d.jsonl", s);
+    const char* src = SPIFFS.exists(bin) ? bin : SPIFFS.exists(jsonl) ? jsonl : nullptr;
+    if (!src || _store->meta(s).state != SLOT_EMPTY) continue;
+    File in = fsOpen(src, FILE_READ);
+    if (!in) continue;
+    RecFileHeader h;
+    bool ok;
+    if (in.read((uint8_t*)&h, sizeof(h)) == sizeof(h) && recHeaderValid(h)) ok = _importBin(in, h, s);
+    else { in.seek(0); ok = _importJsonl(in, s); }
+    in.close();
+    if (!ok) continue;  // files stay for a later attempt
+    snprintf(meta, sizeof(meta), "/rec%d.meta", s);
+    snprintf(idx, sizeof(idx), "/rec%d.idx", s);
+    for (const char* p : { (const char*)bin, (const char*)jsonl, (const char*)meta, (const char*)idx })
+      if (SPIFFS.exists(p)) SPIFFS.remove(p);
+    moved++;
+  }
+  if (SPIFFS.exists("/rec_next.txt")) {
+    File f = fsOpen("/rec_next.txt", FILE_READ);
+    int n = f ? f.readString().toInt() : 0;
+    if (f) f.close();
+    if (_store->setNext(n)) SPIFFS.remove("/rec_next.txt");
+  }
+  return moved;
+}
+
+bool Recorder::importBegin(int slot, uint32_t bytes){
+  if (_state != REC_IDLE) { snprintf(_err,sizeof(_err),"busy"); return false; }
+  if (!_store || !SlotStore::valid(slot)) { snprintf(_err,sizeof(_err),"bad slot"); return false; }
+  if (bytes && (bytes < sizeof(RecFileHeader) + REC_BLOCK_BYTES || (bytes - sizeof(RecFileHeader)) % REC_BLOCK_BYTES)) {
+    snprintf(_err,sizeof(_err),"size is not header + whole blocks"); return false;
+  }
+  if (bytes > sizeof(RecFileHeader) + (uint32_t)REC_STORE_SLOT_BLOCKS * REC_BLOCK_BYTES) {
+    snprintf(_err,sizeof(_err),"take larger than a slot"); return false;
+  }
+  _impSlot = slot; _impOpen = false; _impFill = 0;
+  _state = REC_IMPORTING;
+  return true;
+}
+
+bool Recorder::_importFail(const char* why){
+  if (why) snprintf(_err,sizeof(_err),"%s", why);
+  if (_impOpen) _store->abort();
+  _writing = false; _impOpen = false;
+  _state = REC_IDLE;
+  return false;
+}
+
+bool Recorder::importWrite(const uint8_t* p, size_t n){
+  if (_state != REC_IMPORTING) return false;
+  while (n) {
+    size_t need = (_impOpen ? REC_BLOCK_BYTES : sizeof(RecFileHeader)) - _impFill;
+    size_t k = n < need ? n : need;
+    memcpy(_raw + _impFill, p, k);
+    _impFill += k; p += k; n -= k;
+    if (k < need) break;
+    _impFill = 0;
+    if (!_impOpen) {
+      RecFileHeader h;
+      memcpy(&h, _raw, sizeof(h));
+      if (!recHeaderValid(h) || h.sampleMs == 0) return _importFail("not a take file");
+      if (!_openWrite(_impSlot, h.version, h.sampleMs, 0)) return _importFail(nullptr);
+      _ver = h.version; _fileSampleMs = h.sampleMs;
+      _impOpen = true;
+      continue;
+    }
+    if (!recBlockValid(_raw)) return _importFail("bad block CRC");
+    int f = recDecodeBlock(_raw, _ver, _fileSampleMs, _win[0], REC_BLOCK_MAX_FRAMES);
+    uint32_t t0 = ((const RecBlockHeader*)_raw)->t0;
+    if (f <= 0) return _importFail("block does not decode");
+    if (_framesRecorded && t0 <= _lastT) return _importFail("blocks out of order");
+    if (!_store->append(_raw)) return _importFail(_store->lastError());
+    _framesRecorded += f;
+    _lastT = t0 + _win[0][f - 1].dt;
   }
-  f.close();
-  if (_frames.empty()) { snprintf(_err,sizeof(_err),"no frames"); return false; }
   return true;
 }
 
-bool Recorder::startPlayback(PlayDir dir, const char* pathJson){
+bool Recorder::importEnd(){
+  if (_state != REC_IMPORTING) return false;
+  if (!_impOpen || _impFill) return _importFail("truncated take");
+  if (!_framesRecorded) return _importFail("no blocks");
+  _impOpen = false;
+  _state = REC_IDLE;
+  return _closeWrite();
+}
+
+void Recorder::importAbort(){
+  if (_state == REC_IMPORTING) _importFail("upload aborted");
+}
+
+bool Recorder::clearSlot(int slot){
+  if (_state == REC_PLAYING && slot == _playSlot) stopPlayback();
+  if (!_store->clear(slot)) { snprintf(_err,sizeof(_err),"%s", _store->lastError()); return false; }
+  return true;
+}
+
+// Reads, checks and decodes block no into window half slot.
+bool Recorder::_readBlock(int32_t no, uint8_t slot){
+  if (no < 0 || no >= _blocks) return false;
+  TRACE_SCOPE("rec.readBlock");
+  MetScope t(mRecRead);
+  if (!_store->readBlock(_playSlot, (uint32_t)no, _raw) || !recBlockValid(_raw)) return false;
+  int n = recDecodeBlock(_raw, _ver, _fileSampleMs, _win[slot], REC_BLOCK_MAX_FRAMES);
+  if (n <= 0) return false;
+  _winN[slot]  = (uint16_t)n;
+  _winT0[slot] = ((const RecBlockHeader*)_raw)->t0;
+  return true;
+}
+
+// First block from 'from' on in play direction that passes its CRC
+// (blocks torn by a power cut are skipped); -1 if none is left.
+int32_t Recorder::_loadValid(int32_t from, uint8_t slot){
+  int step = (_dir == PLAY_FORWARD) ? 1 : -1;
+  for (int32_t no = from; no >= 0 && no < _blocks; no += step) {
+    if (_readBlock(no, slot)) return no;
+  }
+  return -1;
+}
+
+// Swap to the prefetched block; the freed half is refilled by service().
+bool Recorder::_nextWindow(){
+  uint8_t nxt = 1 - _cur;
+  if (_winNo[nxt] < 0) return false;
+  _cur = nxt;
+  _fi  = (_dir == PLAY_FORWARD) ? 0 : (int)_winCount() - 1;
+  _winNo[1 - _cur] = WIN_PENDING;
+  return true;
+}
+
+// Reads the pending half of the window without holding the lock: tick()
+// never swaps into a WIN_PENDING half, so only the block number is
+// published under the lock.
+void Recorder::_prefetch(){
+  xSemaphoreTake(_lock, portMAX_DELAY);
+  bool pending = (_state == REC_PLAYING) && (_winNo[1 - _cur] == WIN_PENDING);
+  uint8_t slot = 1 - _cur;
+  int32_t from = _rewind ? _startBlock : _winNo[_cur] + ((_dir == PLAY_FORWARD) ? 1 : -1);
+  xSemaphoreGive(_lock);
+  if (!pending) return;
+  TRACE_SCOPE("rec.prefetch");
+
+  int32_t no = _loadValid(from, slot);
+
+  xSemaphoreTake(_lock, portMAX_DELAY);
+  if (_state == REC_PLAYING) _winNo[slot] = no;
+  xSemaphoreGive(_lock);
+}
+
+void Recorder::_frameAt(int idx, RecFrame& out) const {
+  recUnpack(_win[_cur][idx], _winT0[_cur], out);
+}
+
+// Last block whose first frame is at or before tMs: binary search over
+// the block headers (committed blocks are in time order), log2(blocks)
+// 4-byte reads.
+int32_t Recorder::_findBlock(uint32_t tMs){
+  int32_t lo = 0, hi = _blocks - 1;
+  while (lo < hi) {
+    int32_t mid = (lo + hi + 1) / 2;
+    uint32_t t0;
+    if (!_store->blockT0(_playSlot, (uint32_t)mid, t0)) break;
+    if (t0 <= tMs) lo = mid; else hi = mid - 1;
+  }
+  return lo;
+}
+
+// Loads the window at take time fromMs (-1 = start of the take in play
+// direction). Loop side, with tick() locked out or not running.
+bool Recorder::_seekWindow(int32_t fromMs){
+  const bool fwd = (_dir == PLAY_FORWARD);
+  int32_t start = (fromMs >= 0) ? _findBlock((uint32_t)fromMs) : (fwd ? 0 : _blocks - 1);
+  _cur = 0;
+  _winNo[0] = _loadValid(start, 0);
+  if (_winNo[0] < 0) return false;
+  _winNo[1] = _loadValid(_winNo[0] + (fwd ? 1 : -1), 1);
+  _fi       = fwd ? 0 : (int)_winCount() - 1;
+  _fromMs   = (fromMs >= 0) ? (uint32_t)fromMs : (fwd ? 0 : _total);
+  _rewind   = false;
+  _havePrev = false;
+  return true;
+}
+
+bool Recorder::seek(uint32_t tMs){
+  if (_state != REC_PLAYING) return false;
+  xSemaphoreTake(_lock, portMAX_DELAY);
+  bool ok = _seekWindow((int32_t)tMs);
+  if (ok) _playStart = millis();
+  else    _state = REC_IDLE;
+  xSemaphoreGive(_lock);
+  if (!ok) snprintf(_err,sizeof(_err),"seek fail");
+  return ok;
+}
+
+bool Recorder::startPlayback(PlayDir dir, int slot, float rate, bool loop, int32_t fromMs){
   if (_state != REC_IDLE) { snprintf(_err,sizeof(_err),"busy"); return false; }
-  if (!fileExists(pathJson))  { snprintf(_err,sizeof(_err),"missing file"); return false; }
-  if (!_loadFile(pathJson))   return false;
-  _dir = dir;
+  if (!_store || !SlotStore::valid(slot) || _store->meta(slot).state != SLOT_DONE) {
+    snprintf(_err,sizeof(_err),"empty slot"); return false;
+  }
+  const SlotMeta& m = _store->meta(slot);
+  _playSlot = slot;
+  _ver = m.version;
+  _fileSampleMs = m.sampleMs;
+
+  if (rate < REC_RATE_MIN) rate = REC_RATE_MIN;
+  if (rate > REC_RATE_MAX) rate = REC_RATE_MAX;
+
+  _dir    = dir;
+  _blocks = (int32_t)m.blocks;
+  _cur    = 0;
+  _total  = m.lastT;
+  if (!_seekWindow(fromMs)) { snprintf(_err,sizeof(_err),"no frames"); return false; }
+  _startBlock = _winNo[0];
+  _loopFromMs = _fromMs;
+  _rateQ8   = (uint16_t)lroundf(rate * 256.0f);
+  _loop     = loop;
+  _haveOut  = false;
+  _underruns = 0;
+  xSemaphoreTake(_lock, portMAX_DELAY);
   _playStart = millis();
-  _idx = (dir==PLAY_FORWARD)?0:(_frames.size()-1);
   _state = REC_PLAYING;
+  xSemaphoreGive(_lock);
   return true;
 }
 
 void Recorder::stopPlayback(){
-  if (_state != REC_PLAYING) return;
-  _state = REC_IDLE;
+  xSemaphoreTake(_lock, portMAX_DELAY);
+  if (_state == REC_PLAYING) _state = REC_IDLE;
+  xSemaphoreGive(_lock);
+}
+
+void Recorder::_appendFrame(const RecFrame& fr){
+  if (_enc.count > 0 && (fr.t - _blkT0) > 0xFFFFu) _flushBlock(); // dt must fit 16 bits
+  if (_enc.count == 0) _blkT0 = fr.t;
+  RecPacked p;
+  recPack(fr, _blkT0, p);
+  if (!recEncAdd(_enc, p)) { // block full: this frame is the next keyframe
+    _flushBlock();
+    _blkT0 = fr.t;
+    recPack(fr, _blkT0, p);
+    recEncAdd(_enc, p);
+  }
+  ((RecBlockHeader*)_blk)->t0 = _blkT0;
+  _blkLastT = fr.t;
+  if (_enc.count == (_enc.version < 2 ? REC_FRAMES_PER_BLOCK : REC_BLOCK_MAX_FRAMES)) _flushBlock();
+}
+
+void Recorder::service(uint32_t nowMs){
+  (void)nowMs;
+  if (_state == REC_RECORDING) { _drain(); _store->prepare(); return; }
+  if (_state == REC_IMPORTING) { _store->prepare(); return; }
+  if (_state == REC_PLAYING) _prefetch();
 }
 
 void Recorder::tick(uint32_t nowMs, void (*onApply)(const RecFrame&)){
-  if (_state == REC_RECORDING) {
-    if ((int32_t)(nowMs - _nextSample) >= 0) {
-      uint32_t t = nowMs - _recStart;
-      if (_wf) {
-        _wf.printf("{\"t\":%u,\"manual\":%u,\"x\":%.3f,\"y\":%.3f,"
-                   "\"mode\":%u,\"diam\":%.2f,\"speed\":%u,\"ff\":%d,\"fr\":%d}\n",
-                   t,(unsigned)_lmanual,_lx,_ly,(unsigned)_lm,_ld,(unsigned)_ls,_lff,_lfr);
-        _wf.flush();
-        _framesRecorded++;
-        _lastT = t;
+  if (_state != REC_PLAYING) return;
+  TRACE_SCOPE("rec.tick");
+  if (xSemaphoreTake(_lock, 0) != pdTRUE) { if (_haveOut) onApply(_lastOut); return; }
+
+  const bool fwd = (_dir == PLAY_FORWARD);
+  uint32_t adv = (uint32_t)(((uint64_t)(nowMs - _playStart) * _rateQ8) >> 8);
+  uint32_t tp  = fwd ? _fromMs + adv : ((adv >= _fromMs) ? 0 : _fromMs - adv);
+
+  // Pass every frame at or before the playhead; nx = first one after it
+  RecFrame nx;
+  bool haveNext = false, ended = false;
+  for (;;) {
+    if (fwd ? (_fi >= (int)_winCount()) : (_fi < 0)) {
+      if (_winNo[1 - _cur] == WIN_PENDING) { if (!_rewind) _underruns++; break; } // hold
+      if (!_nextWindow()) {
+        if (!_loop) { ended = true; break; }
+        _rewind = true; _winNo[1 - _cur] = WIN_PENDING; // service() reloads _startBlock
+        break;
       }
-      _nextSample += _sampleMs;
+      if (_rewind) { _rewind = false; _playStart = nowMs; _fromMs = _loopFromMs; tp = _fromMs; _havePrev = false; }
+      continue;
     }
-    return;
+    _frameAt(_fi, nx);
+    if (fwd ? (nx.t > tp) : (nx.t < tp)) { haveNext = true; break; }
+    _prev = nx; _havePrev = true;
+    _fi += fwd ? 1 : -1;
   }
 
-  if (_state == REC_PLAYING) {
-    if (_frames.empty()) { stopPlayback(); return; }
-    uint32_t rel = nowMs - _playStart;
-    if (_dir == PLAY_FORWARD) {
-      while (_idx < _frames.size() && _frames[_idx].t <= rel) {
-        onApply(_frames[_idx]);
-        _idx++;
-      }
-      if (_idx >= _frames.size()) stopPlayback();
-    } else {
-      uint32_t total = _frames.back().t;
-      uint32_t tback = (rel >= total) ? 0 : (total - rel);
-      while (_idx < _frames.size() && _frames[_idx].t >= tback) {
-        onApply(_frames[_idx]);
-        if (_idx==0) { stopPlayback(); break; }
-        _idx--;
-      }
+  if (_havePrev) {
+    RecFrame out = _prev;
+    if (haveNext && nx.mode == _prev.mode && nx.manual == _prev.manual && nx.speed == _prev.speed) {
+      uint32_t span = fwd ? nx.t - _prev.t : _prev.t - nx.t;
+      uint32_t d    = fwd ? tp - _prev.t   : _prev.t - tp;
+      float a = span ? (float)d / span : 0.0f;
+      out.x    += (nx.x - _prev.x) * a;
+      out.y    += (nx.y - _prev.y) * a;
+      out.diam += (nx.diam - _prev.diam) * a;
+      out.ff    = (int16_t)lroundf(_prev.ff + (nx.ff - _prev.ff) * a);
+      out.fr    = (int16_t)lroundf(_prev.fr + (nx.fr - _prev.fr) * a);
     }
+    out.t = tp;
+    onApply(out);
+    _lastOut = out; _haveOut = true;
+  } else if (haveNext) {
+    onApply(nx); // playhead before the first frame: hold it
+    _lastOut = nx; _haveOut = true;
   }
-}
-
-bool Recorder::readMeta(const char* pathMeta, uint32_t& framesOut, uint32_t& durationMsOut){
-  framesOut = 0; durationMsOut = 0;
-  if (!SPIFFS.exists(pathMeta)) return false;
-  File f = SPIFFS.open(pathMeta, FILE_READ);
-  if (!f) return false;
-  String s = f.readString(); f.close();
-  int fi = s.indexOf("\"frames\":");
-  int di = s.indexOf("\"duration_ms\":");
-  if (fi<0||di<0) return false;
-  framesOut = (uint32_t)s.substring(fi+9).toInt();
-  durationMsOut = (uint32_t)s.substring(di+14).toInt();
-  return true;
+  if (ended) _state = REC_IDLE;
+  xSemaphoreGive(_lock);
 }
@@ -0,0 +1,175 @@
+#pragma once
+#include <Arduino.h>
+#include <FS.h>
+#include <SPIFFS.h>
+#include "config.h"
+#include "Speed.h"
+#include "RecFormat.h"
+#include "SpscRing.h"
+#include "SlotStore.h"
+
+struct RecFrame {
+  uint32_t t;     // ms since start
+  uint8_t  manual;// 0=planner, 1=manual-steer
+  float    x;     // -1..+1 (steer)
+  float    y;     // -1..+1 (drive)
+  uint8_t  mode;  // UIMode
+  float    diam;  // 0..1
+  uint8_t  speed; // SpeedMode
+  int16_t  ff;    // front servo deg
+  int16_t  fr;    // rear servo deg
+};
+
+enum RecState : uint8_t { REC_IDLE=0, REC_RECORDING=1, REC_PLAYING=2, REC_IMPORTING=3 };
+enum PlayDir  : uint8_t { PLAY_FORWARD=0, PLAY_REVERSE=1 };
+
+class Recorder {
+public:
+  bool begin(SlotStore& store);
+  void setSampleMs(uint16_t ms) { _sampleMs = ms; }
+
+  // Records into a store slot in the binary format (RecFormat.h). Frames
+  // are captured on the control side into a ring and committed a block at
+  // a time by service(); a power cut loses at most the block being filled
+  // plus what is still queued (<= REC_RING_FRAMES). stopRecording()
+  // drains the ring and writes the partial block before the totals.
+  // next > 0 moves the auto-slot pointer in the same journal record.
+  bool startRecording(int slot, int next = 0);
+  bool stopRecording();
+
+  // Streams the take from flash through a two-block window: constant RAM,
+  // first frame after at most two block reads, no length limit.
+  // rate: take time per wall time (REC_RATE_MIN..REC_RATE_MAX).
+  // fromMs: take time to start at (-1 = start of the take in play
+  // direction). loop: restart at fromMs after the last frame.
+  bool startPlayback(PlayDir dir, int slot, float rate=1.0f, bool loop=false, int32_t fromMs=-1);
+  void stopPlayback();
+  // Loop side, while playing: jump the playhead to take time tMs (block
+  // found by binary search over the block headers; tick() holds its last
+  // output until the window is reloaded). Rate, direction and loop are kept.
+  bool seek(uint32_t tMs);
+
+  // Takes kept as SPIFFS files (/recN.bin, /recN.jsonl and the
+  // /rec_next.txt pointer) move into empty slots once; the files are
+  // removed. Returns the number of takes moved. Only files on a SPIFFS
+  // that mounts in this partition table are seen: one left by firmware on
+  // the default table is formatted at boot and its takes are lost.
+  int importSpiffs();
+  bool clearSlot(int slot);
+
+  // Streamed take upload in the .bin form (RecFileHeader + blocks, as
+  // SlotStore::readTake serves it). importBegin() checks the announced
+  // size (0 = unknown), importWrite() takes the body in chunks of any
+  // size, importEnd() after the last one. The slot is opened (its old
+  // take dropped) once the header checks out; every block must pass its
+  // CRC, decode and start no earlier than the one before, and goes to
+  // flash as soon as it is complete. Any failure ends the import with
+  // the slot empty (lastError). Buffers are the playback ones: no heap.
+  bool importBegin(int slot, uint32_t bytes = 0);
+  bool importWrite(const uint8_t* p, size_t n);
+  bool importEnd();
+  void importAbort();
+
+  // Control side: applies the setpoint at nowMs, interpolated between the
+  // neighbouring frames (x, y, diam, ff, fr; mode/manual/speed switch on
+  // frame boundaries). Reads only the RAM window and never blocks (skips
+  // the cycle if the loop side holds the lock).
+  void tick(uint32_t nowMs, void (*onApply)(const RecFrame&));
+  // Control side: queues the setpoint as a frame when a sample is due
+  // (live.t is ignored). Constant time, no locks, no flash access.
+  void capture(uint32_t nowMs, const RecFrame& live);
+  // Loop side: commits captured frames and prefetches the next playback
+  // block. All flash access happens here or in the API calls.
+  void service(uint32_t nowMs);
+
+  RecState state() const { return _state; }
+  uint32_t underruns() const { return _underruns; } // tick found no prefetched block
+  const char* lastError() const { return _err; }
+  uint32_t ringOverflows() const { return _ringOverflows; } // frames dropped, ring full
+  uint32_t ringHighWater() const { return _ringHigh; }
+  uint32_t commitLagMs() const { return _lagLastMs; }       // last block: full -> on flash
+  uint32_t commitLagMaxMs() const { return _lagMaxMs; }
+  uint32_t blocksCommitted() const { return _blocksCommitted; }
+  // Last take written (valid after stopRecording)
+  uint32_t framesRecorded() const { return _framesRecorded; }
+  uint32_t lastFrameMs() const { return _lastT; }
+
+private:
+  bool _openWrite(int slot, uint8_t version, uint16_t sampleMs, int next);
+  bool _closeWrite();
+  void _appendFrame(const RecFrame& fr);
+  void _flushBlock();
+  void _drain();
+  bool _importBin(File& in, const RecFileHeader& h, int slot);
+  bool _importJsonl(File& in, int slot);
+  bool _importFail(const char* why);
+  bool _readBlock(int32_t no, uint8_t slot);
+  int32_t _loadValid(int32_t from, uint8_t slot);
+  int32_t _findBlock(uint32_t tMs);
+  bool _seekWindow(int32_t fromMs);
+  bool _nextWindow();
+  void _prefetch();
+  void _frameAt(int idx, RecFrame& out) const;
+  uint16_t _winCount() const { return _winN[_cur]; }
+
+  volatile RecState _state = REC_IDLE;
+  SemaphoreHandle_t _lock = nullptr; // window hand-over between tick() and service()
+  SlotStore* _store = nullptr;
+  bool     _writing = false;   // slot open, appends succeeding
+  char     _err[64] = {0};
+
+  uint16_t _sampleMs = 50;
+  uint32_t _recStart = 0;
+  uint32_t _nextSample = 0;  // control side
+
+  // capture (control task) -> commit (service)
+  SpscRing<RecFrame, REC_RING_FRAMES> _ring;
+  std::atomic<bool> _capturing{false};
+  uint32_t _ringOverflows = 0, _ringHigh = 0;
+  uint32_t _lagLastMs = 0, _lagMaxMs = 0, _blocksCommitted = 0;
+
+  // block being filled while recording
+  uint8_t  _blk[REC_BLOCK_BYTES];
+  RecBlockEnc _enc{};
+  uint32_t _blkT0 = 0;
+  uint32_t _blkLastT = 0;
+
+  // playback: _win[_cur] is being played, _win[1-_cur] holds the next
+  // block in play direction, WIN_END after the last one, or WIN_PENDING
+  // until service() has read it. Blocks are decoded into the window
+  // (service side), so tick() indexes frames directly in either format.
+  static const int32_t WIN_END = -1, WIN_PENDING = -2;
+  int       _playSlot = 0;
+  int32_t   _blocks = 0;
+  uint8_t   _ver = REC_VERSION;
+  uint16_t  _fileSampleMs = 50;
+  uint8_t   _raw[REC_BLOCK_BYTES];
+  RecPacked _win[2][REC_BLOCK_MAX_FRAMES];
+  uint16_t  _winN[2] = {0, 0};
+  uint32_t  _winT0[2] = {0, 0};
+  volatile int32_t _winNo[2] = {WIN_END, WIN_END};
+  uint32_t  _underruns = 0;
+  uint8_t   _cur = 0;
+  int       _fi = 0;       // frame index within _win[_cur]
+  uint32_t  _total = 0;    // t of the last frame (reverse playback)
+  PlayDir   _dir = PLAY_FORWARD;
+  uint32_t  _playStart = 0;
+  uint32_t  _fromMs = 0;     // take time at _playStart
+  uint32_t  _loopFromMs = 0; // take time a loop restarts at
+  uint16_t  _rateQ8 = 256;   // take ms per wall ms, Q8
+  bool      _loop = false;
+  volatile bool _rewind = false; // loop restart: next window = _startBlock
+  int32_t   _startBlock = 0;
+  RecFrame  _prev{};         // last frame the playhead passed
+  bool      _havePrev = false;
+  RecFrame  _lastOut{};      // held while the loop side has the window locked
+  bool      _haveOut = false;
+
+  // upload: bytes of the header / block being assembled in _raw
+  int       _impSlot = 0;
+  bool      _impOpen = false;
+  uint16_t  _impFill = 0;
+
+  uint32_t _framesRecorded = 0;
+  uint32_t _lastT = 0;
+};
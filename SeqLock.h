@@ -0,0 +1,56 @@
+#pragma once
+#include <Arduino.h>
+#include <atomic>
+#include <type_traits>
+
+// Single-writer sequence lock for a small trivially-copyable struct.
+// The writer bumps the sequence to odd, copies the words, bumps it to even.
+// A reader copies the words and keeps the copy only if it saw the same even
+// sequence before and after. Neither side takes a lock; the payload is held
+// as relaxed atomic words so the racing copy is well defined.
+//
+// store() must only be called from one task. tryLoad() can fail if the
+// writer is preempted mid-store; callers on a deadline keep their previous
+// snapshot instead of spinning.
+template <typename T>
+class SeqLock {
+  static_assert(std::is_trivially_copyable<T>::value, "SeqLock payload must be trivially copyable");
+  static const size_t WORDS = (sizeof(T) + 3) / 4;
+
+public:
+  SeqLock() { store(T()); }
+  explicit SeqLock(const T& v) { store(v); }
+
+  void store(const T& v) {
+    uint32_t w[WORDS] = {0};
+    memcpy(w, &v, sizeof(T));
+    uint32_t s = _seq.load(std::memory_order_relaxed);
+    _seq.store(s + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < WORDS; ++i) _w[i].store(w[i], std::memory_order_relaxed);
+    _seq.store(s + 2, std::memory_order_release);
+  }
+
+  // true + consistent snapshot in out; false after maxTries torn/busy reads
+  // (out untouched). retries (optional) accumulates the failed attempts.
+  bool tryLoad(T& out, int maxTries = 4, uint32_t* retries = nullptr) const {
+    for (int n = 0; n < maxTries; ++n) {
+      uint32_t s0 = _seq.load(std::memory_order_acquire);
+      if (!(s0 & 1)) {
+        uint32_t w[WORDS];
+        for (size_t i = 0; i < WORDS; ++i) w[i] = _w[i].load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (_seq.load(std::memory_order_relaxed) == s0) { memcpy(&out, w, sizeof(T)); return true; }
+      }
+      if (retries) (*retries)++;
+    }
+    return false;
+  }
+
+  T load() const { T v; while (!tryLoad(v, 1 << 30)) {} return v; }
+  uint32_t version() const { return _seq.load(std::memory_order_acquire) >> 1; }
+
+private:
+  std::atomic<uint32_t> _seq{0};
+  std::atomic<uint32_t> _w[WORDS];
+};
@@ -0,0 +1,71 @@
+#include "SerialLink.h"
+#include "RecFormat.h"
+
+size_t slinkEncode(const void* payload, size_t n, uint8_t* out){
+  if (n > SLINK_MAX_PAYLOAD) return 0;
+  uint8_t raw[SLINK_MAX_PAYLOAD + 2];
+  memcpy(raw, payload, n);
+  uint16_t crc = recCrc16(raw, n);
+  raw[n] = (uint8_t)crc; raw[n + 1] = (uint8_t)(crc >> 8);
+  n += 2;
+
+  size_t o = 0;
+  out[o++] = 0;
+  size_t code = o++;  // COBS: each block starts with the distance to the next zero
+  uint8_t run = 1;
+  for (size_t i = 0; i < n; ++i) {
+    if (raw[i] == 0) { out[code] = run; code = o++; run = 1; continue; }
+    out[o++] = raw[i];
+    if (++run == 0xFF) { out[code] = run; code = o++; run = 1; }
+  }
+  out[code] = run;
+  out[o++] = 0;
+  return o;
+}
+
+size_t slinkDecode(const uint8_t* in, size_t n, uint8_t* out, size_t outMax){
+  size_t o = 0, i = 0;
+  while (i < n) {
+    uint8_t code = in[i++];
+    if (code == 0 || i + code - 1 > n) return 0;
+    for (uint8_t k = 1; k < code; ++k) { if (o == outMax) return 0; out[o++] = in[i++]; }
+    if (code < 0xFF && i < n) { if (o == outMax) return 0; out[o++] = 0; }
+  }
+  if (o < 3) return 0;
+  uint16_t crc = (uint16_t)(out[o - 2] | out[o - 1] << 8);
+  if (recCrc16(out, o - 2) != crc) return 0;
+  return o - 2;
+}
+
+SlinkEvent SlinkParser::push(uint8_t b){
+  if (b == 0) {
+    SlinkEvent ev = SLINK_NONE;
+    if (_n && !_overflow) {
+      _outN = slinkDecode(_buf, _n, _out, sizeof(_out));
+      if (_outN && _out[0] >= 0x80) { _frames++; ev = SLINK_FRAME; }
+      else if (!_text) _errors++;  // leftover text before a frame is not an error
+    } else if (_overflow) _errors++;
+    _n = 0; _text = true; _overflow = false;
+    return ev;
+  }
+  if (b == '\n' && _text && _n) {
+    size_t k = _n;
+    while (k && (_buf[k - 1] == '\r')) --k;
+    size_t s = 0;
+    while (s < k && (_buf[s] == '\n' || _buf[s] == '\r')) ++s;  // blank lines before it
+    memcpy(_out, _buf + s, k - s);
+    _out[k - s] = 0;
+    _outN = k - s;
+    _n = 0;
+    return _outN ? SLINK_LINE : SLINK_NONE;
+  }
+  if (_overflow) return SLINK_NONE;
+  if (_n == sizeof(_buf)) {
+    if (_text) { _n = 0; return SLINK_NONE; }  // over-long text line: drop it
+    _overflow = true;
+    return SLINK_NONE;
+  }
+  if (!((b >= 0x20 && b < 0x7F) || b == '\r' || b == '\n' || b == '\t')) _text = false;
+  _buf[_n++] = b;
+  return SLINK_NONE;
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include <Arduino.h>
+#include "config.h"
+
+// ==== Framed binary serial link (tracker <-> rover) ====
+// A frame on the wire is 0x00, COBS(payload + CRC16-CCITT little endian),
+// 0x00. payload[0] is the frame type, always >= 0x80, so a frame holds a
+// non-text byte right after the COBS code byte. That keeps text console
+// lines ("trace\n") usable on the same port: a line is bytes up to '\n'
+// that are all printable, a frame is anything up to 0x00.
+// The tracker streams setpoints (latest wins, by seq). The rover answers
+// each batch it applies with one telemetry frame acking the newest seq,
+// and sends telemetry every SLINK_TELEM_MS once a tracker has spoken.
+enum : uint8_t { SLINK_SETPOINT = 0xA1, SLINK_TELEM = 0xA2 };
+#define SLINK_F_MANUAL 0x04 // flags[1:0] = UIMode
+#define SLINK_F_ESTOP  0x08 // flags[5:4] = SpeedMode
+
+struct __attribute__((packed)) SlinkSetpoint {
+  uint8_t  type;   // SLINK_SETPOINT
+  uint8_t  flags;  // [1:0] mode [2] manual steer [3] estop [5:4] speed
+  uint16_t seq;
+  int16_t  drive;  // Q14 -1..+1 (throttle)
+  int16_t  steer;  // Q14 -1..+1 (planner steer x)
+  uint16_t diam;   // Q16 0..1 (circle diameter)
+  uint8_t  ff, fr; // servo deg while manual steer
+  int8_t   tilt, roll; // gimbal camera deg vs the horizon
+};
+static_assert(sizeof(SlinkSetpoint) == 14, "SlinkSetpoint layout");
+
+struct __attribute__((packed)) SlinkTelem {
+  uint8_t  type;   // SLINK_TELEM
+  uint8_t  state;  // [0] manual [1] estop [3:2] RecState [4] IMU ok
+  uint16_t ack;    // newest applied setpoint seq
+  uint32_t ms;     // millis()
+  uint8_t  ff, fr; // commanded servo deg
+  int16_t  left, right;  // wheel command -255..255
+  int16_t  pitch, roll;  // body attitude, centideg
+  uint16_t rxErrors;     // bad frames so far (CRC, COBS, length; wraps)
+};
+static_assert(sizeof(SlinkTelem) == 20, "SlinkTelem layout");
+
+#define SLINK_MAX_PAYLOAD 32
+// Encoded frame incl. both delimiters: COBS adds 1 byte per 254
+#define SLINK_MAX_WIRE (SLINK_MAX_PAYLOAD + 2 + 1 + 2)
+
+// Writes the whole frame (delimiters included) into out[SLINK_MAX_WIRE];
+// returns its length (0 if n > SLINK_MAX_PAYLOAD)
+size_t slinkEncode(const void* payload, size_t n, uint8_t* out);
+// COBS-decodes one frame body (no delimiters) and checks the CRC; returns
+// the payload length, 0 if the frame is bad
+size_t slinkDecode(const uint8_t* in, size_t n, uint8_t* out, size_t outMax);
+
+enum SlinkEvent : uint8_t { SLINK_NONE = 0, SLINK_FRAME, SLINK_LINE };
+
+// Incremental receiver: push() one byte at a time, no allocation. After
+// SLINK_FRAME, payload()/payloadLen() hold a frame that passed its CRC;
+// after SLINK_LINE, line() is the text line (no CR/LF).
+class SlinkParser {
+public:
+  SlinkEvent push(uint8_t b);
+  const uint8_t* payload() const { return _out; }
+  size_t payloadLen() const { return _outN; }
+  const char* line() const { return (const char*)_out; }
+  uint32_t frames() const { return _frames; }
+  uint32_t errors() const { return _errors; }
+
+private:
+  uint8_t  _buf[SLINK_MAX_WIRE + 16];
+  uint8_t  _out[sizeof(_buf) + 1];
+  size_t   _n = 0, _outN = 0;
+  bool     _text = true;      // all bytes since the last delimiter printable
+  bool     _overflow = false; // dropping until the next delimiter
+  uint32_t _frames = 0, _errors = 0;
+};
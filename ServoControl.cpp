@@ -1,17 +1,19 @@
 #include "ServoControl.h"
 #include "config.h"
 #include <Arduino.h>
+#include <math.h>
+#include "Trace.h"
 
-ServoControl::ServoControl() {}
+ServoControl::ServoControl() : _vmax(SERVO_MAX_VEL_DEG_S), _amax(SERVO_MAX_ACC_DEG_S2) {}
 
 bool ServoControl::attach(int pin) {
   _pin = pin;
-  bool ok = _servo.attach(_pin, 500, 2400); // 50Hz, wide pulse range
-  if (ok) center();
+  bool ok = _servo.attach(_pin, SERVO_MIN_US, SERVO_MAX_US); // 50Hz, wide pulse range
+  if (ok) writeDegNow(SERVO_CENTER);
   return ok;
 }
 
-void ServoControl::detach() { _servo.detach(); _pin = -1; }
+void ServoControl::detach() { _servo.detach(); _pin = -1; _lastUs = -1; }
 
 bool ServoControl::attached() {                
   return _servo.attached();
@@ -20,31 +22,142 @@ bool ServoControl::attached() {
 void ServoControl::center() { writeDeg(SERVO_CENTER); }
 
 void ServoControl::writeDeg(int deg) {
-  int d = _clampDeg(deg);
-  _servo.write(d);
-  _lastDeg = d;
+  if (_sched) return; // a scheduled move owns the servo until it completes
+  _target = _clampDeg(deg);
 }
 
-int ServoControl::readDeg() const { return _lastDeg; }
+void ServoControl::writeDegF(float deg) {
+  if (_sched) return;
+  _target = fminf(fmaxf(deg, SERVO_MIN_DEG), SERVO_MAX_DEG);
+}
+
+void ServoControl::writeDegNow(int deg) {
+  _sched = false; _done = nullptr; _sweepLegs = 0;
+  _target = _pos = _clampDeg(deg); _vel = 0;
+  _output();
+}
+
+int ServoControl::readDeg() const { return (int)lroundf(_pos); }
+
+void ServoControl::setLimits(float maxVelDegS, float maxAccDegS2) {
+  if (maxVelDegS > 0) _vmax = maxVelDegS;
+  if (maxAccDegS2 > 0) _amax = maxAccDegS2;
+}
+
+void ServoControl::moveTo(int targetDeg, float velDegS, float accDegS2, DoneFn done) {
+  _target = _clampDeg(targetDeg);
+  _mvVel  = velDegS  > 0 ? fminf(velDegS, _vmax)  : _vmax;
+  _mvAcc  = accDegS2 > 0 ? fminf(accDegS2, _amax) : _amax;
+  _sched  = true;
+  _done   = done;
+  _sweepLegs = 0;
+}
 
-void ServoControl::slowMoveTo(int targetDeg, int stepDeg, int stepDelayMs) {
+// Legacy step/delay pair -> velocity (1 deg per 10 ms = 100 deg/s)
+static float stepRate(int stepDeg, int stepDelayMs) {
+  return stepDelayMs > 0 ? abs(stepDeg) * 1000.0f / stepDelayMs : 0;
+}
+
+void ServoControl::slowMoveTo(int targetDeg, int stepDeg, int stepDelayMs, DoneFn done) {
   if (!attached()) return;
-  int current = (_lastDeg < 0) ? SERVO_CENTER : _lastDeg;
-  int target  = _clampDeg(targetDeg);
-  int step    = (target >= current) ? abs(stepDeg) : -abs(stepDeg);
-
-  for (int d = current; (step > 0) ? (d <= target) : (d >= target); d += step) {
-    _servo.write(d);
-    _lastDeg = d;
-    delay(stepDelayMs);
-  }
+  moveTo(targetDeg, stepRate(stepDeg, stepDelayMs), 0, done);
 }
 
-void ServoControl::sweep(int fromDeg, int toDeg, int stepDeg, int stepDelayMs) {
+void ServoControl::sweep(int fromDeg, int toDeg, int stepDeg, int stepDelayMs, DoneFn done) {
   int a = _clampDeg(fromDeg), b = _clampDeg(toDeg);
   if (a > b) { int t = a; a = b; b = t; }
-  for (int d = a; d <= b; d += abs(stepDeg)) { _servo.write(d); _lastDeg = d; delay(stepDelayMs); }
-  for (int d = b; d >= a; d -= abs(stepDeg)) { _servo.write(d); _lastDeg = d; delay(stepDelayMs); }
+  moveTo(a, stepRate(stepDeg, stepDelayMs), 0, done);
+  _sweepA = a; _sweepB = b; _sweepLegs = 2; // a -> b -> a
+}
+
+void ServoControl::stop() {
+  _sched = false; _done = nullptr; _sweepLegs = 0;
+  // Target = where a max-decel stop would land
+  float d = _vel * fabsf(_vel) / (2.0f * _amax);
+  _target = fminf(fmaxf(_pos + d, SERVO_MIN_DEG), SERVO_MAX_DEG);
+}
+
+void ServoControl::update(uint32_t nowMs) {
+  if (!_haveMs) { _lastMs = nowMs; _haveMs = true; return; }
+  float dt = (uint32_t)(nowMs - _lastMs) * 0.001f;
+  _lastMs = nowMs;
+  if (dt <= 0 || (!moving() && !_sched)) { _ws.suppressed++; return; }
+  if (dt > 0.1f) dt = 0.1f; // stalled caller: don't leap
+
+  float vmax = velLimit() * _rate, amax = accLimit() * _rate * _rate;
+  if (_rate <= 0) {
+    if (_vel == 0) { _ws.suppressed++; return; }  // held at rest by the governor
+    amax = accLimit();
+  }
+  float err = _target - _pos, dvMax = amax * dt;
+  // Fastest speed that still lands on the target shedding dvMax per tick:
+  // from v = (n + f) dvMax the ticks cover (n + 1) f + n (n + 1) / 2 steps
+  // of dvMax * dt (the last one <= dvMax), so invert that for |err|
+  float e = fabsf(err) / (dvMax * dt);
+  float n = floorf(0.5f * (sqrtf(1.0f + 8.0f * e) - 1.0f));
+  float f = (e - 0.5f * n * (n + 1.0f)) / (n + 1.0f);
+  float vdes = fminf(vmax, (n + fmaxf(0.0f, fminf(1.0f, f))) * dvMax);
+  if (err < 0) vdes = -vdes;
+  float dv = vdes - _vel;
+  _vel += fmaxf(-dvMax, fminf(dv, dvMax));
+
+  // Arrive only at a speed one tick can shed; faster (the target moved
+  // inside the stopping distance) runs past and comes back. The landing
+  // step is the speed shed next tick, so a rest tick comes before a new leg.
+  float step = _vel * dt;
+  if (fabsf(_vel) <= dvMax && (fabsf(step) >= fabsf(err) || fabsf(err) < 0.05f)) {
+    _vel = err / dt; _pos = _target;
+  } else {
+    _pos += step;
+  }
+  _output();
+
+  if (_vel == 0 && _pos == _target && _sched) {
+    if (_sweepLegs > 0) {
+      _target = (--_sweepLegs == 1) ? _sweepB : _sweepA;
+      return;
+    }
+    _sched = false;
+    DoneFn cb = _done; _done = nullptr;
+    if (cb) cb(*this);
+  }
+}
+
+// Trapezoid (or triangle) duration from rest
+float ServoControl::_duration(float toDeg, float vel, float acc) const {
+  float d = fabsf(_clampDeg((int)toDeg) - _pos);
+  if (d * acc >= vel * vel) return d / vel + vel / acc;
+  return 2.0f * sqrtf(d / acc);
+}
+
+void ServoControl::moveTogether(ServoControl& a, int degA, ServoControl& b, int degB,
+                                float velDegS, float accDegS2, DoneFn done) {
+  float va = velDegS  > 0 ? fminf(velDegS,  a._vmax) : a._vmax;
+  float aa = accDegS2 > 0 ? fminf(accDegS2, a._amax) : a._amax;
+  float vb = velDegS  > 0 ? fminf(velDegS,  b._vmax) : b._vmax;
+  float ab = accDegS2 > 0 ? fminf(accDegS2, b._amax) : b._amax;
+  float ta = a._duration(degA, va, aa), tb = b._duration(degB, vb, ab);
+  // Stretching a profile in time by s scales velocity by 1/s, accel by 1/s^2
+  if (ta > tb && tb > 0) { float s = ta / tb; vb /= s; ab /= s * s; }
+  if (tb > ta && ta > 0) { float s = tb / ta; va /= s; aa /= s * s; }
+  bool aLast = ta >= tb;
+  a.moveTo(degA, va, aa, aLast ? done : nullptr);
+  b.moveTo(degB, vb, ab, aLast ? nullptr : done);
+}
+
+void ServoControl::_output() {
+  int us = SERVO_MIN_US + (int)lroundf(_pos * (SERVO_MAX_US - SERVO_MIN_US) / 180.0f);
+  if (us == _lastUs) { _ws.suppressed++; return; }
+  TRACE_SCOPE("servo.write");
+  _servo.writeMicroseconds(us);
+  _lastUs = us;
+  _ws.issued++;
+}
+
+void ServoControl::resync() {
+  if (_lastUs < 0 || !attached()) return;
+  _servo.writeMicroseconds(_lastUs);
+  _ws.issued++;
 }
 
 int ServoControl::_clampDeg(int d) const {
@@ -1,23 +1,74 @@
 #pragma once
 #include <ESP32Servo.h>
+#include "config.h"
+#include "Utils.h"
 
+// Tick-driven servo: every move (incl. writeDeg) is a velocity/acceleration
+// limited slew advanced by update(nowMs); nothing here blocks. Call all
+// methods from one context (the control step).
 class ServoControl {
 public:
+  typedef void (*DoneFn)(ServoControl& s);
+
   ServoControl();
   bool attach(int pin);
   void detach();
   bool attached();   
 
   void center();
-  void writeDeg(int deg);
-  int  readDeg() const;
+  void writeDeg(int deg);        // slew with the default limits
+  void writeDegF(float deg);     // same, fractional target (gimbal)
+  void writeDegNow(int deg);     // jump (no limits)
+  int  readDeg() const;          // current commanded angle
+  float readDegF() const { return _pos; }
+  int  targetDeg() const { return (int)_target; }
+
+  void setLimits(float maxVelDegS, float maxAccDegS2);
+  // Scheduled move; 0 = default limit. done() fires on arrival.
+  void moveTo(int targetDeg, float velDegS = 0, float accDegS2 = 0, DoneFn done = nullptr);
+  void slowMoveTo(int targetDeg, int stepDeg = 1, int stepDelayMs = 10, DoneFn done = nullptr);
+  void sweep(int fromDeg, int toDeg, int stepDeg = 1, int stepDelayMs = 10, DoneFn done = nullptr);
+  void stop();                   // cancel scheduled move, decelerate to rest
+
+  bool moving() const { return _vel != 0 || _pos != _target; }
+  float velocity() const { return _vel; }                   // deg/s, signed
+  float velLimit() const { return _sched ? _mvVel : _vmax; } // active limits
+  float accLimit() const { return _sched ? _mvAcc : _amax; }
+  // Power governor: from the next update() the active limits are scaled to
+  // vel*s, acc*s^2 (a pure time stretch, so moveTogether pairs given the
+  // same s still arrive together). 0 keeps a servo at rest from starting;
+  // a moving one brakes at the full acceleration.
+  void setRateScale(float s) { _rate = s < 0 ? 0 : (s > 1 ? 1 : s); }
+  bool scheduled() const { return _sched; } // moveTo/sweep in progress
+  void update(uint32_t nowMs);
 
-  void slowMoveTo(int targetDeg, int stepDeg = 1, int stepDelayMs = 10);
-  void sweep(int fromDeg, int toDeg, int stepDeg = 1, int stepDelayMs = 10);
+  // Move a and b so they arrive together: the shorter move is time-scaled
+  // to the longer one. done() fires once, on the servo that arrives last.
+  // The pulse goes out only when its width (us) changes; an update() with
+  // nothing to send counts as suppressed. resync() re-sends it.
+  void resync();
+  WriteStats writeStats() const { return _ws; }
+  void resetWriteStats() { _ws = WriteStats(); }
+
+  static void moveTogether(ServoControl& a, int degA, ServoControl& b, int degB,
+                           float velDegS = 0, float accDegS2 = 0, DoneFn done = nullptr);
 
 private:
   Servo _servo;
   int   _pin = -1;
-  int   _lastDeg = -1;
+  float _pos = SERVO_CENTER, _vel = 0, _target = SERVO_CENTER;
+  float _vmax, _amax;            // defaults
+  float _mvVel = 0, _mvAcc = 0;  // active scheduled-move limits
+  bool  _sched = false;
+  float _rate = 1.0f;            // governor scale (setRateScale)
+  int   _sweepA = 0, _sweepB = 0, _sweepLegs = 0;
+  DoneFn _done = nullptr;
+  uint32_t _lastMs = 0;
+  bool  _haveMs = false;
+  int   _lastUs = -1;          // committed pulse
+  WriteStats _ws;
+
   int   _clampDeg(int d) const;
+  float _duration(float toDeg, float vel, float acc) const;
+  void  _output();
 };
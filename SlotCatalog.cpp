@@ -0,0 +1,22 @@
+#include "SlotCatalog.h"
+
+const char* SlotCatalog::json(size_t& len){
+  if (_store && _store->seq() != _seq) {
+    size_t n = 0;
+    _json[n++] = '[';
+    for (int s = 1; s <= REC_SLOTS; ++s) {
+      const SlotMeta& e = _store->meta(s);
+      bool exists = e.state != SLOT_EMPTY;
+      n += snprintf(_json + n, sizeof(_json) - n,
+        "%s{\"slot\":%d,\"exists\":%s,\"frames\":%u,\"duration_ms\":%u,\"bytes\":%u}",
+        s > 1 ? "," : "", s, exists ? "true" : "false",
+        (unsigned)e.frames, (unsigned)e.lastT, (unsigned)(exists ? _store->takeBytes(s) : 0));
+    }
+    _json[n++] = ']';
+    _json[n] = 0;
+    _len = n;
+    _seq = _store->seq();
+  }
+  len = _len;
+  return _json;
+}
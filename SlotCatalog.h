@@ -0,0 +1,21 @@
+#pragma once
+#include <Arduino.h>
+#include "config.h"
+#include "SlotStore.h"
+
+// ==== Recording slot catalog ====
+// What /rec/list reports for slots 1..REC_SLOTS. The slot table lives in
+// RAM in the SlotStore; the JSON is rendered into a fixed buffer when the
+// store's journal has moved on since the last render, so a list request
+// does no flash access and no heap allocation.
+class SlotCatalog {
+public:
+  void begin(const SlotStore& store) { _store = &store; _seq = ~0u; }
+  const char* json(size_t& len);
+
+private:
+  const SlotStore* _store = nullptr;
+  uint32_t _seq = ~0u;  // store journal seq rendered
+  char   _json[REC_SLOTS * 100 + 4];
+  size_t _len = 0;
+};
@@ -0,0 +1,263 @@
+#include "SlotStore.h"
+#include "Trace.h"
+
+static const uint32_t MAGIC   = 0x4A524D43;  // "CMRJ"
+static const int      RECORDS = REC_STORE_SECTOR / REC_STORE_RECORD;
+static const uint32_t REGION  = REC_STORE_SLOT_SECTORS * REC_STORE_SECTOR;
+static_assert(offsetof(RecBlockHeader, count) == 0, "count word is the commit marker");
+
+static bool blank(const void* p, size_t n){
+  const uint8_t* b = (const uint8_t*)p;
+  for (size_t i = 0; i < n; ++i) if (b[i] != 0xFF) return false;
+  return true;
+}
+
+bool SlotStore::begin(){
+  _part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, REC_STORE_LABEL);
+  if (!_part) { snprintf(_err,sizeof(_err),"no '%s' partition", REC_STORE_LABEL); return false; }
+  if (_part->size < REC_STORE_BYTES) {
+    snprintf(_err,sizeof(_err),"'%s' is %u B, needs %u", REC_STORE_LABEL, (unsigned)_part->size, (unsigned)REC_STORE_BYTES);
+    _part = nullptr; return false;
+  }
+  _wSlot = 0; _head = 0; _lastErase = 0;
+  memset(_clean, 0, sizeof(_clean));
+  return _mount();
+}
+
+bool SlotStore::_mount(){
+  Table r, best{};
+  bool found = false;
+  int bestSec = 0, bestIdx = 0;
+  for (int sec = 0; sec < 2; ++sec) {
+    for (int i = 0; i < RECORDS; ++i) {
+      if (esp_partition_read(_part, sec * REC_STORE_SECTOR + i * REC_STORE_RECORD, &r, sizeof(r)) != ESP_OK) {
+        snprintf(_err,sizeof(_err),"journal read fail"); return false;
+      }
+      uint16_t crc = r.crc;
+      r.crc = 0;
+      if (r.magic != MAGIC || recCrc16((const uint8_t*)&r, sizeof(r)) != crc) continue;
+      r.crc = crc;
+      if (!found || (int32_t)(r.seq - best.seq) > 0) { best = r; bestSec = sec; bestIdx = i; found = true; }
+    }
+  }
+  if (!found || best.slots != REC_SLOTS || best.slotSectors != REC_STORE_SLOT_SECTORS) return _format();
+  _t = best;
+  _jSector = (uint8_t)bestSec;
+  _jPos = RECORDS;  // append after the newest record, past a torn one
+  for (int i = bestIdx + 1; i < RECORDS; ++i) {
+    if (esp_partition_read(_part, bestSec * REC_STORE_SECTOR + i * REC_STORE_RECORD, &r, sizeof(r)) != ESP_OK) break;
+    if (blank(&r, sizeof(r))) { _jPos = (uint8_t)i; break; }
+  }
+  if (!valid(_t.next)) _t.next = 1;
+  for (int s = 1; s <= REC_SLOTS; ++s) if (_t.s[s - 1].state == SLOT_OPEN) _recover(s);
+  return true;
+}
+
+// Blank or foreign journal: every slot empty (their regions are erased
+// before reuse, so old blocks never show up in a new take)
+bool SlotStore::_format(){
+  memset(&_t, 0, sizeof(_t));
+  _t.magic = MAGIC;
+  _t.next = 1;
+  _t.slots = REC_SLOTS;
+  _t.slotSectors = REC_STORE_SLOT_SECTORS;
+  _st.formats++;
+  if (esp_partition_erase_range(_part, 0, 2 * REC_STORE_SECTOR) != ESP_OK) {
+    snprintf(_err,sizeof(_err),"journal erase fail"); return false;
+  }
+  _st.erases += 2;
+  _jSector = 0; _jPos = 0;
+  return _journal();
+}
+
+bool SlotStore::_journal(){
+  if (_jPos >= RECORDS) {  // sector full: continue in the other one
+    uint8_t other = 1 - _jSector;
+    if (esp_partition_erase_range(_part, other * REC_STORE_SECTOR, REC_STORE_SECTOR) != ESP_OK) {
+      snprintf(_err,sizeof(_err),"journal erase fail"); return false;
+    }
+    _st.erases++;
+    _jSector = other; _jPos = 0;
+  }
+  _t.seq++;
+  _t.crc = 0;
+  _t.crc = recCrc16((const uint8_t*)&_t, sizeof(_t));
+  esp_err_t e = esp_partition_write(_part, _jSector * REC_STORE_SECTOR + _jPos * REC_STORE_RECORD, &_t, sizeof(_t));
+  _jPos++;  // a failed write may have left a torn record behind
+  _st.journalWrites++;
+  if (e != ESP_OK) { snprintf(_err,sizeof(_err),"journal write fail"); return false; }
+  return true;
+}
+
+// A take that was open at reset: its committed blocks run up to the first
+// one that is erased or fails its CRC
+void SlotStore::_recover(int slot){
+  static RecPacked dec[REC_BLOCK_MAX_FRAMES];
+  SlotMeta& m = _t.s[slot - 1];
+  uint8_t blk[REC_BLOCK_BYTES];
+  uint32_t n = 0, frames = 0;
+  while (n < REC_STORE_SLOT_BLOCKS && readBlock(slot, n, blk) && recBlockValid(blk)) {
+    frames += ((const RecBlockHeader*)blk)->count;
+    n++;
+  }
+  m.lastT = 0;
+  if (n && readBlock(slot, n - 1, blk)) {
+    int k = recDecodeBlock(blk, m.version, m.sampleMs, dec, REC_BLOCK_MAX_FRAMES);
+    if (k > 0) m.lastT = ((const RecBlockHeader*)blk)->t0 + dec[k - 1].dt;
+  }
+  m.state  = n ? SLOT_DONE : SLOT_EMPTY;
+  m.blocks = n;
+  m.frames = frames;
+  _st.recovered++;
+  _journal();
+}
+
+bool SlotStore::_eraseSector(int slot, uint32_t sector){
+  TRACE_SCOPE("store.erase");
+  _st.erases++;
+  if (esp_partition_erase_range(_part, _base(slot) + sector * REC_STORE_SECTOR, REC_STORE_SECTOR) != ESP_OK) {
+    snprintf(_err,sizeof(_err),"erase fail"); return false;
+  }
+  return true;
+}
+
+// Region of the open slot erased up to bytes (from its start), now
+bool SlotStore::_ensureErased(uint32_t bytes){
+  uint32_t& c = _clean[_wSlot - 1];
+  if (bytes > REGION) bytes = REGION;
+  while (c < bytes) {
+    _st.syncErases++;
+    if (!_eraseSector(_wSlot, c / REC_STORE_SECTOR)) return false;
+    c += REC_STORE_SECTOR;
+  }
+  return true;
+}
+
+bool SlotStore::setNext(int slot){
+  if (!_part) return false;
+  if (!valid(slot)) slot = 1;
+  if (slot == _t.next) return true;
+  _t.next = (uint8_t)slot;
+  return _journal();
+}
+
+bool SlotStore::clear(int slot){
+  if (!_part || !valid(slot)) return false;
+  if (slot == _wSlot) { snprintf(_err,sizeof(_err),"busy"); return false; }
+  if (_t.s[slot - 1].state == SLOT_EMPTY) return true;
+  _t.s[slot - 1] = SlotMeta{};
+  _clean[slot - 1] = 0;
+  return _journal();
+}
+
+bool SlotStore::open(int slot, uint8_t version, uint16_t sampleMs, int next){
+  if (!_part) { snprintf(_err,sizeof(_err),"no '%s' partition", REC_STORE_LABEL); return false; }
+  if (!valid(slot) || _wSlot) { snprintf(_err,sizeof(_err),"busy"); return false; }
+  SlotMeta& m = _t.s[slot - 1];
+  if (m.state != SLOT_EMPTY) {  // the old take goes first: its blocks are about to be erased
+    m = SlotMeta{};
+    _clean[slot - 1] = 0;
+    if (!_journal()) return false;
+  }
+  _wSlot = slot; _head = 0;
+  if (!_ensureErased(2 * REC_BLOCK_BYTES)) { _wSlot = 0; return false; }
+  m.state = SLOT_OPEN;
+  m.version = version;
+  m.sampleMs = sampleMs;
+  _t.id[slot - 1] = _t.seq + 1;  // the seq of the record below
+  if (valid(next)) _t.next = (uint8_t)next;
+  if (!_journal()) { _wSlot = 0; return false; }
+  return true;
+}
+
+bool SlotStore::append(const uint8_t* block){
+  if (!_wSlot) return false;
+  if (_head >= REC_STORE_SLOT_BLOCKS) { snprintf(_err,sizeof(_err),"slot full"); return false; }
+  uint32_t off = _head * REC_BLOCK_BYTES;
+  if (!_ensureErased(off + 2 * REC_BLOCK_BYTES)) return false;  // the block after this one stays erased
+  uint32_t a = _base(_wSlot) + off;
+  if (esp_partition_write(_part, a + 2, block + 2, REC_BLOCK_BYTES - 2) != ESP_OK ||
+      esp_partition_write(_part, a, block, 2) != ESP_OK) {   // count word last: commits the block
+    snprintf(_err,sizeof(_err),"flash write fail"); return false;
+  }
+  _head++;
+  return true;
+}
+
+bool SlotStore::close(uint32_t frames, uint32_t lastT){
+  if (!_wSlot) return false;
+  SlotMeta& m = _t.s[_wSlot - 1];
+  m.state  = _head ? SLOT_DONE : SLOT_EMPTY;
+  m.blocks = _head;
+  m.frames = _head ? frames : 0;
+  m.lastT  = _head ? lastT : 0;
+  if (_head) _clean[_wSlot - 1] = 0;
+  _wSlot = 0;
+  return _journal();
+}
+
+bool SlotStore::abort(){
+  if (!_wSlot) return false;
+  _t.s[_wSlot - 1] = SlotMeta{};
+  _clean[_wSlot - 1] = 0;
+  _wSlot = 0;
+  return _journal();
+}
+
+void SlotStore::prepare(){
+  if (!_wSlot) return;
+  uint32_t& c = _clean[_wSlot - 1];
+  if (c < REGION && c < (_head + 2) * REC_BLOCK_BYTES + REC_STORE_SECTOR / 2) {  // half a sector of lead
+    if (_eraseSector(_wSlot, c / REC_STORE_SECTOR)) c += REC_STORE_SECTOR;
+  }
+}
+
+void SlotStore::preErase(uint32_t nowMs){
+  if (!_part || _wSlot || nowMs - _lastErase < REC_STORE_ERASE_MS) return;
+  uint8_t buf[REC_BLOCK_BYTES];
+  int checked = 0;
+  for (int s = 1; s <= REC_SLOTS; ++s) {
+    uint32_t& c = _clean[s - 1];
+    while (_t.s[s - 1].state == SLOT_EMPTY && c < REGION) {
+      if (++checked > 8) return;  // blank sectors cost only a read; bound those too
+      bool isBlank = true;
+      for (uint32_t o = 0; o < REC_STORE_SECTOR && isBlank; o += sizeof(buf)) {
+        isBlank = esp_partition_read(_part, _base(s) + c + o, buf, sizeof(buf)) == ESP_OK && blank(buf, sizeof(buf));
+      }
+      if (!isBlank) {
+        _lastErase = nowMs;
+        if (_eraseSector(s, c / REC_STORE_SECTOR)) c += REC_STORE_SECTOR;
+        return;
+      }
+      c += REC_STORE_SECTOR;
+    }
+  }
+}
+
+bool SlotStore::readBlock(int slot, uint32_t no, uint8_t* block) const {
+  if (!_part || !valid(slot) || no >= REC_STORE_SLOT_BLOCKS) return false;
+  return esp_partition_read(_part, _base(slot) + no * REC_BLOCK_BYTES, block, REC_BLOCK_BYTES) == ESP_OK;
+}
+
+bool SlotStore::blockT0(int slot, uint32_t no, uint32_t& t0) const {
+  if (!_part || !valid(slot) || no >= REC_STORE_SLOT_BLOCKS) return false;
+  return esp_partition_read(_part, _base(slot) + no * REC_BLOCK_BYTES + offsetof(RecBlockHeader, t0), &t0, 4) == ESP_OK;
+}
+
+size_t SlotStore::readTake(int slot, uint32_t off, uint8_t* buf, size_t n) const {
+  if (!_part || !valid(slot) || meta(slot).state != SLOT_DONE) return 0;
+  uint32_t size = takeBytes(slot);
+  if (off >= size) return 0;
+  if (n > size - off) n = size - off;
+  size_t done = 0;
+  if (off < sizeof(RecFileHeader)) {
+    RecFileHeader h;
+    recInitHeader(h, meta(slot).sampleMs);
+    h.version = meta(slot).version;
+    done = sizeof(h) - off < n ? sizeof(h) - off : n;
+    memcpy(buf, (const uint8_t*)&h + off, done);
+  }
+  if (done < n && esp_partition_read(_part, _base(slot) + off + done - sizeof(RecFileHeader), buf + done, n - done) != ESP_OK)
+    return 0;
+  return n;
+}
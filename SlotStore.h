@@ -0,0 +1,126 @@
+#pragma once
+#include <Arduino.h>
+#include <esp_partition.h>
+#include "config.h"
+#include "RecFormat.h"
+
+// ==== Take storage: preallocated slots on a raw flash partition ====
+// The REC_STORE_LABEL data partition (partitions.csv) holds two journal
+// sectors, then one fixed region of REC_STORE_SLOT_SECTORS per slot.
+// A region holds the take's REC_BLOCK_BYTES blocks back to back, appended
+// log style into erased flash: the block body first, its count word last.
+// The count word is the commit marker: erased (0xFFFF) = never committed,
+// torn = fails the block CRC. The block after the last committed one is
+// always erased, so after a power cut mount() finds the end of an open
+// take by scanning and commits what made it to flash.
+// The journal: REC_STORE_RECORD-byte records, each a full copy of the slot table and
+// the auto-slot pointer with a sequence number and CRC, appended to one
+// of two sectors (the other is erased when one fills). The newest valid
+// record wins at mount; a torn one leaves its predecessor in force.
+// Start, stop, clear and the next pointer cost one record each, whatever
+// the take length; no file is opened, created or removed.
+enum SlotState : uint8_t { SLOT_EMPTY = 0, SLOT_OPEN = 1, SLOT_DONE = 2 };
+
+struct __attribute__((packed)) SlotMeta {
+  uint8_t  state;     // SlotState
+  uint8_t  version;   // RecFormat version of the blocks
+  uint16_t sampleMs;
+  uint32_t blocks;    // committed (0 while open; found by scan at mount)
+  uint32_t frames;
+  uint32_t lastT;     // t of the last frame
+};
+static_assert(sizeof(SlotMeta) == 16, "SlotMeta layout");
+
+#define REC_STORE_SECTOR      4096
+#define REC_STORE_SLOT_BLOCKS (REC_STORE_SLOT_SECTORS * (REC_STORE_SECTOR / REC_BLOCK_BYTES))
+// Journal record: the slot table (16 B + 20 B per slot) rounded up to a
+// power of two, so records tile a sector: 128 B up to 5 slots, 256 B up
+// to 12, ... 2048 B (two per sector) up to 101
+#define REC_STORE_TABLE_BYTES (16 + 20 * REC_SLOTS)
+#define REC_STORE_RECORD      (REC_STORE_TABLE_BYTES <= 128 ? 128 : REC_STORE_TABLE_BYTES <= 256 ? 256 : \
+                               REC_STORE_TABLE_BYTES <= 512 ? 512 : REC_STORE_TABLE_BYTES <= 1024 ? 1024 : 2048)
+static_assert(REC_STORE_TABLE_BYTES <= REC_STORE_RECORD, "REC_SLOTS too large for a journal record (max 101)");
+// Partition size the store needs (partitions.csv 'takes'; checked at begin())
+#define REC_STORE_BYTES ((2u + (uint32_t)REC_SLOTS * REC_STORE_SLOT_SECTORS) * REC_STORE_SECTOR)
+
+class SlotStore {
+public:
+  // Maps the partition and mounts the journal (formats a blank or foreign
+  // one, recovers a take left open by a reset)
+  bool begin();
+  bool ready() const { return _part != nullptr; }
+  const char* lastError() const { return _err; }
+
+  static bool valid(int slot) { return slot >= 1 && slot <= REC_SLOTS; }
+  static int  after(int slot) { return (slot >= REC_SLOTS) ? 1 : slot + 1; }
+  const SlotMeta& meta(int slot) const { return _t.s[slot - 1]; }
+  // Size of the take as a .bin file (RecFileHeader + blocks)
+  uint32_t takeBytes(int slot) const { return sizeof(RecFileHeader) + meta(slot).blocks * REC_BLOCK_BYTES; }
+  // Bytes [off, off + n) of a finished take as that file (header made from
+  // the slot table, blocks in one flash read); returns the bytes read
+  size_t readTake(int slot, uint32_t off, uint8_t* buf, size_t n) const;
+  // Changes with every take written to the slot (journal seq of its open)
+  uint32_t takeId(int slot) const { return _t.id[slot - 1]; }
+  int  next() const { return _t.next; }
+  bool setNext(int slot);
+  bool clear(int slot);
+  uint32_t seq() const { return _t.seq; }  // changes with every journal record
+
+  // Writing, one slot at a time: open() journals the slot empty, erases
+  // its first sector if needed and journals it open (next > 0 also moves
+  // the auto-slot pointer); append() writes one sealed block; close()
+  // journals the totals. false = flash error or region full (lastError).
+  bool open(int slot, uint8_t version, uint16_t sampleMs, int next = 0);
+  bool append(const uint8_t* block);
+  bool close(uint32_t frames, uint32_t lastT);
+  bool abort();  // drops the open take: the slot is journaled empty
+  uint32_t appended() const { return _head; }  // blocks of the open take
+  // Loop side while writing: erases the sector ahead of the head (at most
+  // one per call), so append() normally never waits for an erase
+  void prepare();
+  // Loop side while nothing moves: erases one used sector of an empty
+  // slot per REC_STORE_ERASE_MS, so the next take there starts without one
+  void preErase(uint32_t nowMs);
+
+  bool readBlock(int slot, uint32_t no, uint8_t* block) const;
+  bool blockT0(int slot, uint32_t no, uint32_t& t0) const;
+
+  struct Stats {
+    uint32_t journalWrites = 0, erases = 0, syncErases = 0, recovered = 0, formats = 0;
+  };
+  const Stats& stats() const { return _st; }
+
+private:
+  struct __attribute__((packed)) Table {
+    uint32_t magic;   // "CMRJ"
+    uint32_t seq;
+    uint8_t  next;
+    uint8_t  slots;   // REC_SLOTS
+    uint16_t slotSectors;
+    uint16_t crc;     // CRC16 over the record with crc = 0
+    uint8_t  reserved[2];
+    SlotMeta s[REC_SLOTS];
+    uint32_t id[REC_SLOTS];  // takeId()
+    uint8_t  pad[REC_STORE_RECORD - REC_STORE_TABLE_BYTES];
+  };
+  static_assert(sizeof(Table) == REC_STORE_RECORD, "journal record layout");
+
+  bool _journal();
+  bool _mount();
+  bool _format();
+  void _recover(int slot);
+  bool _eraseSector(int slot, uint32_t sector);
+  bool _ensureErased(uint32_t bytes);
+  uint32_t _base(int slot) const { return (2 + (uint32_t)(slot - 1) * REC_STORE_SLOT_SECTORS) * REC_STORE_SECTOR; }
+
+  const esp_partition_t* _part = nullptr;
+  Table    _t{};
+  uint8_t  _jSector = 0;  // active journal sector
+  uint8_t  _jPos = 0;     // next free record in it
+  int      _wSlot = 0;    // slot open for writing
+  uint32_t _head = 0;     // its next block
+  uint32_t _clean[REC_SLOTS] = {};  // region bytes known erased (empty/open slots)
+  uint32_t _lastErase = 0;
+  Stats    _st;
+  char     _err[48] = {0};
+};
@@ -0,0 +1,53 @@
+#include "Speed.h"
+
+// Default to NORMAL at boot
+SpeedMode g_speedMode = SPEED_NORMAL;
+
+static inline float clamp01f(float v){
+  if (v < 0) return 0;
+  if (v > 1) return 1;
+  return v;
+}
+
+int applySpeedScalingRef(int basePwm, float steerExtent, SpeedMode mode) {
+  // Slow down as steering approaches extremes
+  float steerScale = 1.0f - (SPEED_STEER_SCALE * clamp01f(steerExtent));
+
+  // Speed mode multiplier
+  float modeScale = 1.0f;
+  switch (mode) {
+    case SPEED_SPORT:  modeScale = 1.0f;  break;  // 100%
+    case SPEED_NORMAL: modeScale = 0.5f;  break;  // 50%
+    case SPEED_LOW:    modeScale = 0.25f; break;  // 25%
+    default:           modeScale = 1.0f;  break;  // unknown: pass through
+  }
+
+  float v = basePwm * steerScale * modeScale;
+  if (v >  255) v =  255;
+  if (v < -255) v = -255;
+  return (int)v;
+}
+
+// steer scale in Q8: 256 - STEER_Q8 * extent/256; mode scale as a shift
+static constexpr int STEER_Q8 = (int)(SPEED_STEER_SCALE * 256.0f + 0.5f);
+
+int applySpeedScalingInt(int basePwm, float steerExtent, SpeedMode mode) {
+  int e = (steerExtent <= 0) ? 0 : (steerExtent >= 1) ? 256 : (int)(steerExtent * 256.0f + 0.5f);
+  int scaleQ16 = 65536 - STEER_Q8 * e;
+  int shift = (mode == SPEED_NORMAL) ? 1 : (mode == SPEED_LOW) ? 2 : 0;  // unknown: pass through, as Ref
+
+  // truncate toward zero like the float version's (int) cast
+  int mag = basePwm < 0 ? -basePwm : basePwm;
+  if (mag > 4095) mag = 4095; // result saturates at 255 long before this
+  mag = (mag * scaleQ16) >> (16 + shift);
+  if (mag > 255) mag = 255;
+  return basePwm < 0 ? -mag : mag;
+}
+
+int applySpeedScaling(int basePwm, float steerExtent, SpeedMode mode) {
+#if PLANNER_USE_LUT
+  return applySpeedScalingInt(basePwm, steerExtent, mode);
+#else
+  return applySpeedScalingRef(basePwm, steerExtent, mode);
+#endif
+}
@@ -14,4 +14,10 @@ extern SpeedMode g_speedMode;
 // Apply steering-based slowdown + speed mode scaling.
 // basePwm: -255..+255 (from throttle)
 // steerExtent: 0..1 (0 = straight, 1 = max steering)
-int applySpeedScaling(int basePwm, float steerExtent);
+// mode: defaults to g_speedMode (the control step passes its snapshot's)
+// Integer (Q8) scaling when PLANNER_USE_LUT is set, within 1 PWM of the
+// reference.
+int applySpeedScaling(int basePwm, float steerExtent, SpeedMode mode = g_speedMode);
+
+int applySpeedScalingRef(int basePwm, float steerExtent, SpeedMode mode = g_speedMode);
+int applySpeedScalingInt(int basePwm, float steerExtent, SpeedMode mode = g_speedMode);
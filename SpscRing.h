@@ -0,0 +1,40 @@
+#pragma once
+#include <Arduino.h>
+#include <atomic>
+
+// Single-producer / single-consumer ring of N (power of two) items.
+// push() and pop() are wait-free and constant time; the producer owns
+// _head, the consumer owns _tail.
+template <typename T, uint32_t N>
+class SpscRing {
+  static_assert(N && !(N & (N - 1)), "SpscRing size must be a power of two");
+
+public:
+  // Producer. false = full (item dropped)
+  bool push(const T& v) {
+    uint32_t h = _head.load(std::memory_order_relaxed);
+    if (h - _tail.load(std::memory_order_acquire) >= N) return false;
+    _buf[h & (N - 1)] = v;
+    _head.store(h + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer. false = empty
+  bool pop(T& out) {
+    uint32_t t = _tail.load(std::memory_order_relaxed);
+    if (t == _head.load(std::memory_order_acquire)) return false;
+    out = _buf[t & (N - 1)];
+    _tail.store(t + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer: drop everything queued so far
+  void clear() { _tail.store(_head.load(std::memory_order_acquire), std::memory_order_release); }
+
+  uint32_t size() const { return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire); }
+  static constexpr uint32_t capacity() { return N; }
+
+private:
+  std::atomic<uint32_t> _head{0}, _tail{0};
+  T _buf[N];
+};
@@ -0,0 +1,146 @@
+#include "Stabilizer.h"
+#include <math.h>
+
+static const int32_t DEG_Q16 = 65536;
+static const int64_t DEG2RAD_Q32 = 74961321;     // pi/180 * 2^32
+static const float   BIAS_MAX_DPS = 30.0f;
+static const float   G_MPS2 = 9.81f;
+
+// ==== Fixed-point helpers ====
+static uint32_t isqrt32(uint32_t v) {
+  uint32_t r = 0, b = 1u << 30;
+  while (b > v) b >>= 2;
+  while (b) {
+    if (v >= r + b) { v -= r + b; r = (r >> 1) + b; }
+    else r >>= 1;
+    b >>= 2;
+  }
+  return r;
+}
+
+// atan(num/den) for num <= den (0..45 deg): odd polynomial in Q15, |err| < 0.001 deg
+static int32_t atanDegQ16(uint32_t num, uint32_t den) {
+  while (den >= (1u << 17)) { num >>= 1; den >>= 1; }  // num << 15 fits 32 bits
+  int32_t z = (int32_t)((num << 15) / den);
+  int32_t z2 = (z * z) >> 15;
+  int32_t p = 683;
+  p = -2790  + ((p * z2) >> 15);
+  p = 5903   + ((p * z2) >> 15);
+  p = -10823 + ((p * z2) >> 15);
+  p = 32764  + ((p * z2) >> 15);
+  return (int32_t)(((int64_t)(p * z) * 3754937) >> 30);  // rad Q30 -> deg Q16
+}
+
+int32_t atan2DegQ16(int32_t y, int32_t x) {
+  uint32_t ay = y < 0 ? 0u - (uint32_t)y : (uint32_t)y, ax = x < 0 ? 0u - (uint32_t)x : (uint32_t)x;
+  if (ax == 0 && ay == 0) return 0;
+  int32_t a = ay <= ax ? atanDegQ16(ay, ax) : 90 * DEG_Q16 - atanDegQ16(ax, ay);
+  if (x < 0) a = 180 * DEG_Q16 - a;
+  return y < 0 ? -a : a;
+}
+
+static inline int32_t wrap180(int32_t e) {
+  if (e > 180 * DEG_Q16) e -= 360 * DEG_Q16;
+  if (e < -180 * DEG_Q16) e += 360 * DEG_Q16;
+  return e;
+}
+
+// ==== Stabilizer (fixed point) ====
+void Stabilizer::begin(const StabCfg& c) {
+  float dt = 1.0f / c.rateHz;
+  _kg = (int32_t)lroundf(65536.0f * 4096.0f * dt / c.gyroLsbDps);
+  _alpha = (int32_t)lroundf(65536.0f * dt / c.tauS);
+  _beta = (int64_t)llround(dt * dt / (c.tauS * c.biasTauS) * 1099511627776.0);  // * 2^40: Q16 err -> Q24 bias, Q32 gain
+  _biasMax = (int32_t)lroundf(BIAS_MAX_DPS * dt * 16777216.0f);
+  float lo = (1.0f - c.accGateG) * c.accLsbG, hi = (1.0f + c.accGateG) * c.accLsbG;
+  _m2lo = (uint32_t)(lo * lo);
+  _m2hi = hi * hi < 4.29e9f ? (uint32_t)(hi * hi) : 0xFFFFFFFFu;
+  _rateScale = c.rateHz / 65536.0f;
+  _kcScale = 65536.0f * c.accLsbG * (float)(M_PI / 180.0) / (G_MPS2 * c.gyroLsbDps);
+  _kc = 0;
+  _ang[0] = _ang[1] = _rate[0] = _rate[1] = _bias[0] = _bias[1] = 0;
+  _init = false;
+  _gated = 0;
+}
+
+void Stabilizer::update(const ImuRaw& s) {
+  int32_t ax = s.ax, ay = s.ay - (int32_t)(((int64_t)s.gz * _kc) >> 16), az = s.az;
+  ay = ay > 32767 ? 32767 : (ay < -32767 ? -32767 : ay);
+  uint32_t m2 = (uint32_t)(ax * ax) + (uint32_t)(ay * ay) + (uint32_t)(az * az);
+  bool useAcc = m2 >= _m2lo && m2 <= _m2hi;
+  int32_t acc[2] = { 0, 0 };
+  if (useAcc) {
+    acc[0] = atan2DegQ16(-ax, (int32_t)isqrt32((uint32_t)(ay * ay) + (uint32_t)(az * az)));
+    acc[1] = atan2DegQ16(ay, az);
+  }
+  if (!_init) {  // start from the first usable accel tilt
+    if (!useAcc) return;
+    _ang[0] = acc[0]; _ang[1] = acc[1];
+    _init = true;
+    return;
+  }
+
+  // Gyro step; pitch' = q - r*roll, roll' = p + r*pitch (small angles)
+  int32_t dq = ((s.gy * _kg) >> 12) - (_bias[0] >> 8);
+  int32_t dp = ((s.gx * _kg) >> 12) - (_bias[1] >> 8);
+  int32_t dr = (s.gz * _kg) >> 12;
+  dq -= (int32_t)(((((int64_t)dr * _ang[1]) >> 16) * DEG2RAD_Q32) >> 32);
+  dp += (int32_t)(((((int64_t)dr * _ang[0]) >> 16) * DEG2RAD_Q32) >> 32);
+  _rate[0] = dq; _rate[1] = dp;
+  _ang[0] += dq; _ang[1] += dp;
+
+  if (!useAcc) { _gated++; return; }
+  for (int i = 0; i < 2; ++i) {
+    int32_t err = wrap180(acc[i] - _ang[i]);
+    _ang[i] = wrap180(_ang[i] + (int32_t)(((int64_t)err * _alpha) >> 16));
+    int32_t b = _bias[i] - (int32_t)(((int64_t)err * _beta) >> 32);
+    _bias[i] = b > _biasMax ? _biasMax : (b < -_biasMax ? -_biasMax : b);
+  }
+}
+
+// ==== StabilizerRef (float) ====
+static inline float wrap180f(float e) {
+  if (e > 180.0f) e -= 360.0f;
+  if (e < -180.0f) e += 360.0f;
+  return e;
+}
+
+void StabilizerRef::begin(const StabCfg& c) {
+  _c = c;
+  _ang[0] = _ang[1] = _rate[0] = _rate[1] = _bias[0] = _bias[1] = 0;
+  _speed = 0;
+  _init = false;
+  _gated = 0;
+}
+
+void StabilizerRef::update(const ImuRaw& s) {
+  float ax = s.ax / _c.accLsbG, az = s.az / _c.accLsbG;
+  float ay = s.ay / _c.accLsbG - _speed * (s.gz / _c.gyroLsbDps) * ((float)M_PI / 180.0f) / G_MPS2;
+  float m = sqrtf(ax * ax + ay * ay + az * az);
+  bool useAcc = fabsf(m - 1.0f) <= _c.accGateG;
+  float acc[2] = { 0, 0 };
+  if (useAcc) {
+    acc[0] = atan2f(-ax, sqrtf(ay * ay + az * az)) * (180.0f / (float)M_PI);
+    acc[1] = atan2f(ay, az) * (180.0f / (float)M_PI);
+  }
+  if (!_init) {
+    if (!useAcc) return;
+    _ang[0] = acc[0]; _ang[1] = acc[1];
+    _init = true;
+    return;
+  }
+
+  float dt = 1.0f / _c.rateHz, k = (float)M_PI / 180.0f;
+  float q = s.gy / _c.gyroLsbDps - _bias[0], p = s.gx / _c.gyroLsbDps - _bias[1], r = s.gz / _c.gyroLsbDps;
+  _rate[0] = q - r * _ang[1] * k;
+  _rate[1] = p + r * _ang[0] * k;
+  _ang[0] += _rate[0] * dt; _ang[1] += _rate[1] * dt;
+
+  if (!useAcc) { _gated++; return; }
+  for (int i = 0; i < 2; ++i) {
+    float err = wrap180f(acc[i] - _ang[i]);
+    _ang[i] = wrap180f(_ang[i] + err * dt / _c.tauS);
+    _bias[i] -= err * dt / (_c.tauS * _c.biasTauS);
+    _bias[i] = fmaxf(-BIAS_MAX_DPS, fminf(_bias[i], BIAS_MAX_DPS));
+  }
+}
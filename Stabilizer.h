@@ -0,0 +1,74 @@
+#pragma once
+#include <Arduino.h>
+#include "Imu.h"
+
+struct StabCfg {
+  uint16_t rateHz;      // IMU sample rate (one update() per sample)
+  float tauS;           // accel tilt correction time constant
+  float biasTauS;       // gyro bias integrator time constant
+  float accGateG;       // skip accel when | |a| - 1 g | exceeds this
+  float accLsbG, gyroLsbDps;
+};
+
+// Pitch/roll from gyro + accel: a complementary filter with a gyro-bias
+// integrator (Mahony-style PI on the accel tilt error). The gyro is
+// integrated with the small-angle Euler terms for yaw while tilted, and
+// the accel correction is skipped while the rover accelerates hard or
+// hits a bump (|a| off 1 g). In a turn the accel's y also reads the
+// centripetal v * yaw rate, removed with the chassis speed from
+// setSpeed(). Steady acceleration still leans the estimate (the accel
+// cannot tell it from tilt); tauS trades that lean against gyro drift.
+// Fixed point: angles in Q16 degrees, bias in Q24 degrees per sample; no
+// float or libm per sample.
+class Stabilizer {
+public:
+  void begin(const StabCfg& c);
+  void update(const ImuRaw& s);
+  void setSpeed(float mps) { _kc = (int32_t)lroundf(mps * _kcScale); }  // forward, 0 = unknown
+  int32_t pitchQ16() const { return _ang[0]; }
+  int32_t rollQ16() const  { return _ang[1]; }
+  float pitchDeg() const { return _ang[0] * (1.0f / 65536); }
+  float rollDeg() const  { return _ang[1] * (1.0f / 65536); }
+  float pitchRateDps() const { return _rate[0] * _rateScale; }  // bias corrected
+  float rollRateDps() const  { return _rate[1] * _rateScale; }
+  float biasDps(int axis) const { return _bias[axis] * _rateScale * (1.0f / 256); }
+  uint32_t gated() const { return _gated; }
+
+private:
+  int32_t  _ang[2] = {0, 0};   // pitch, roll (Q16 deg)
+  int32_t  _rate[2] = {0, 0};  // last per-sample step (Q16 deg)
+  int32_t  _bias[2] = {0, 0};  // Q24 deg per sample
+  int32_t  _kg = 0;            // gyro LSB -> Q16 deg per sample, Q12
+  int32_t  _alpha = 0;         // accel weight per sample, Q16
+  int64_t  _beta = 0;          // bias gain per sample, Q32
+  int32_t  _biasMax = 0;
+  uint32_t _m2lo = 0, _m2hi = 0;
+  int32_t  _kc = 0;            // centripetal: accel LSB per gyro z LSB, Q16
+  float    _kcScale = 0;       // _kc per m/s
+  float    _rateScale = 0;
+  bool     _init = false;
+  uint32_t _gated = 0;
+};
+
+// Float reference of the same filter (host comparisons)
+class StabilizerRef {
+public:
+  void begin(const StabCfg& c);
+  void update(const ImuRaw& s);
+  void setSpeed(float mps) { _speed = mps; }
+  float pitchDeg() const { return _ang[0]; }
+  float rollDeg() const  { return _ang[1]; }
+  float pitchRateDps() const { return _rate[0]; }
+  float rollRateDps() const  { return _rate[1]; }
+  uint32_t gated() const { return _gated; }
+
+private:
+  StabCfg _c{};
+  float _ang[2] = {0, 0}, _rate[2] = {0, 0}, _bias[2] = {0, 0}, _speed = 0;
+  bool _init = false;
+  uint32_t _gated = 0;
+};
+
+// Q16 degrees of atan2(y, x), any int32 y and x (operands of 2^17 and up
+// are scaled down to keep the Q15 ratio in 32 bits)
+int32_t atan2DegQ16(int32_t y, int32_t x);
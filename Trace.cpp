@@ -0,0 +1,104 @@
+#include "Trace.h"
+
+#if TRACE_ENABLED
+TraceEvent g_traceRing[TRACE_RING_EVENTS];
+std::atomic<uint32_t> g_traceHead{0};
+volatile bool g_traceOn = true;
+
+static uint32_t s_clearAt = 0;              // head at the last clear
+static int64_t  s_coreOff[2] = {0, 0};      // micros()*MHz - cycle count, per core
+static bool     s_coreSynced[2] = {false, false};
+
+void traceSyncCore(){
+  int c = xPortGetCoreID() & 1;
+  if (s_coreSynced[c]) return;
+  uint32_t cc = ESP.getCycleCount();
+  s_coreOff[c] = (int64_t)micros() * ESP.getCpuFreqMHz() - cc;
+  s_coreSynced[c] = true;
+}
+
+void traceEnable(bool on){ g_traceOn = on; }
+bool traceEnabled(){ return g_traceOn; }
+void traceClear(){ s_clearAt = g_traceHead.load(std::memory_order_acquire); }
+uint32_t traceCount(){ return g_traceHead.load(std::memory_order_acquire) - s_clearAt; }
+
+// Small output buffer flushed through fn
+struct TraceOut {
+  TraceChunkFn fn; char buf[256]; size_t n = 0;
+  void put(const char* fmt, ...) {
+    char tmp[160];
+    va_list ap; va_start(ap, fmt);
+    int k = vsnprintf(tmp, sizeof(tmp), fmt, ap);
+    va_end(ap);
+    if (k < 0) return;
+    if ((size_t)k >= sizeof(tmp)) k = sizeof(tmp) - 1;
+    if (n + k > sizeof(buf)) flush();
+    memcpy(buf + n, tmp, k); n += k;
+  }
+  void flush() { if (n) fn(buf, n); n = 0; }
+};
+
+uint32_t traceRenderJson(TraceChunkFn fn){
+  bool was = g_traceOn;
+  g_traceOn = false;
+  delay(1);  // let a span being stored on the other core finish
+  uint32_t head = g_traceHead.load(std::memory_order_acquire);
+  uint32_t avail = head - s_clearAt;
+  uint32_t first = head - (avail < TRACE_RING_EVENTS ? avail : TRACE_RING_EVENTS);
+  uint32_t mhz = ESP.getCpuFreqMHz();
+
+  // Cycle counters wrap (17.9 s at 240 MHz): unwrap the newest span end
+  // per core against now, then every start by its age from that end
+  int64_t nowAbs = (int64_t)micros() * mhz;
+  uint32_t ref[2] = {0, 0}; bool haveRef[2] = {false, false};
+  for (uint32_t c = first; c != head; ++c) {
+    const TraceEvent& e = g_traceRing[c & (TRACE_RING_EVENTS - 1)];
+    if (e.seq != c + 1) continue;
+    int k = e.core & 1;
+    uint32_t end = e.start + e.dur;
+    if (!haveRef[k] || (int32_t)(end - ref[k]) > 0) { ref[k] = end; haveRef[k] = true; }
+  }
+  int64_t refAbs[2];
+  for (int k = 0; k < 2; ++k) refAbs[k] = nowAbs - (uint32_t)((uint32_t)(nowAbs - s_coreOff[k]) - ref[k]);
+  auto absCycles = [&](const TraceEvent& e) -> int64_t {
+    int k = e.core & 1;
+    return refAbs[k] - (uint32_t)(ref[k] - e.start);
+  };
+  int64_t t0 = INT64_MAX;
+  for (uint32_t c = first; c != head; ++c) {
+    const TraceEvent& e = g_traceRing[c & (TRACE_RING_EVENTS - 1)];
+    if (e.seq == c + 1 && absCycles(e) < t0) t0 = absCycles(e);
+  }
+
+  TraceOut o; o.fn = fn;
+  if (t0 == INT64_MAX) t0 = nowAbs;
+  o.put("{\"displayTimeUnit\":\"ns\",\"otherData\":{\"cpu_mhz\":%u,\"t0_us\":%llu,\"spans\":%u,\"overwritten\":%u},\"traceEvents\":[",
+        (unsigned)mhz, (unsigned long long)(t0 / mhz), (unsigned)avail, (unsigned)(avail - (head - first)));
+  o.put("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"CamMate\"}}");
+  o.put(",{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"core 0 (control)\"}}");
+  o.put(",{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"core 1 (loop, HTTP)\"}}");
+  uint32_t n = 0;
+  for (uint32_t c = first; c != head; ++c) {
+    const TraceEvent& e = g_traceRing[c & (TRACE_RING_EVENTS - 1)];
+    if (e.seq != c + 1) continue;  // torn or overwritten meanwhile
+    double ts = (double)(absCycles(e) - t0) / mhz, dur = (double)e.dur / mhz;
+    o.put(",{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}", e.name, (unsigned)(e.core & 1), ts, dur);
+    n++;
+  }
+  o.put("]}\n");
+  o.flush();
+  g_traceOn = was;
+  return n;
+}
+#else
+void traceSyncCore(){}
+void traceEnable(bool){}
+bool traceEnabled(){ return false; }
+void traceClear(){}
+uint32_t traceCount(){ return 0; }
+uint32_t traceRenderJson(TraceChunkFn fn){
+  static const char EMPTY[] = "{\"traceEvents\":[]}\n";
+  fn(EMPTY, sizeof(EMPTY) - 1);
+  return 0;
+}
+#endif
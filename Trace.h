@@ -0,0 +1,62 @@
+#pragma once
+#include <Arduino.h>
+#include <atomic>
+#include "config.h"
+
+// Scoped trace spans for chrome://tracing / ui.perfetto.dev. A span keeps
+// its name (a string literal: only the pointer is stored), the core, and
+// start + duration in CPU cycles (ESP.getCycleCount()). Both cores claim
+// ring slots with one atomic add; the oldest spans are overwritten.
+// A span costs two cycle-counter reads and a 20-byte store, so it can stay
+// on in the field. TRACE_ENABLED 0 compiles every TRACE_SCOPE out.
+struct TraceEvent {
+  const char* name;
+  uint32_t start, dur;  // cycles
+  uint32_t seq;         // claim number + 1, stored last (0 = being written)
+  uint8_t  core;
+};
+
+typedef void (*TraceChunkFn)(const char* s, size_t n);
+
+#if TRACE_ENABLED
+static_assert(TRACE_RING_EVENTS && !(TRACE_RING_EVENTS & (TRACE_RING_EVENTS - 1)), "TRACE_RING_EVENTS must be a power of two");
+extern TraceEvent g_traceRing[TRACE_RING_EVENTS];
+extern std::atomic<uint32_t> g_traceHead;
+extern volatile bool g_traceOn;
+
+static inline void traceRecord(const char* name, uint32_t start, uint32_t end) {
+  uint32_t i = g_traceHead.fetch_add(1, std::memory_order_relaxed);
+  TraceEvent& e = g_traceRing[i & (TRACE_RING_EVENTS - 1)];
+  e.seq = 0;
+  std::atomic_thread_fence(std::memory_order_release);
+  e.name = name; e.start = start; e.dur = end - start; e.core = (uint8_t)xPortGetCoreID();
+  std::atomic_thread_fence(std::memory_order_release);
+  e.seq = i + 1;
+}
+
+class TraceScope {
+public:
+  explicit TraceScope(const char* name) : _name(g_traceOn ? name : nullptr), _t0(_name ? ESP.getCycleCount() : 0) {}
+  ~TraceScope() { if (_name) traceRecord(_name, _t0, ESP.getCycleCount()); }
+private:
+  const char* _name;
+  uint32_t _t0;
+};
+
+#define TRACE_CAT2(a, b) a##b
+#define TRACE_CAT(a, b) TRACE_CAT2(a, b)
+#define TRACE_SCOPE(name) TraceScope TRACE_CAT(_trace_, __LINE__)(name)
+#else
+#define TRACE_SCOPE(name) ((void)0)
+#endif
+
+// Maps this core's cycle counter to micros() once (the cores' counters
+// start at different times); call early on every core that traces
+void traceSyncCore();
+void traceEnable(bool on);
+bool traceEnabled();
+void traceClear();
+uint32_t traceCount();  // spans since clear, incl. overwritten ones
+// Chrome trace JSON of the ring through fn, in chunks; recording pauses
+// meanwhile. Returns the number of spans written.
+uint32_t traceRenderJson(TraceChunkFn fn);
@@ -41,3 +41,29 @@ int parseAngle(const String& s, int fallback) {
   if (val > SERVO_MAX_DEG) val = SERVO_MAX_DEG;
   return val;
 }
+
+int parseByteRange(const char* h, uint32_t size, uint32_t& from, uint32_t& to){
+  if (!h || strncmp(h, "bytes=", 6) != 0 || strchr(h, ',')) return 0;
+  const char* p = h + 6;
+  char* e;
+  bool suffix = (*p == '-');
+  if (!suffix && !isdigit((unsigned char)*p)) return 0;
+  unsigned long a = suffix ? 0 : strtoul(p, &e, 10);
+  if (!suffix) p = e;
+  if (*p++ != '-') return 0;
+  bool open = (*p == 0);
+  unsigned long b = open ? 0 : strtoul(p, &e, 10);
+  if (!open && (*e != 0 || !isdigit((unsigned char)*p))) return 0;
+  if (suffix) {                  // last b bytes
+    if (open) return 0;
+    if (b == 0 || size == 0) return -1;
+    from = b >= size ? 0 : size - (uint32_t)b;
+    to = size - 1;
+    return 1;
+  }
+  if (!open && b < a) return 0;  // invalid: ignored
+  if (a >= size) return -1;
+  from = (uint32_t)a;
+  to = (open || b >= size) ? size - 1 : (uint32_t)b;
+  return 1;
+}
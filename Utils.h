@@ -4,3 +4,14 @@
 void printMenu();
 bool readLine(Stream& s, String& out);
 int  parseAngle(const String& s, int fallback);
+// HTTP "Range: bytes=a-b" (also a- and -n) against a body of size bytes.
+// 1 = [from, to] set, 0 = absent, not understood or several ranges (send
+// the whole body), -1 = unsatisfiable (416)
+int  parseByteRange(const char* h, uint32_t size, uint32_t& from, uint32_t& to);
+
+// Actuator write accounting: writes sent to the peripheral vs. skipped
+// because the committed output already had that value.
+struct WriteStats {
+  uint32_t issued = 0;
+  uint32_t suppressed = 0;
+};
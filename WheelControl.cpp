@@ -1,10 +1,14 @@
 #include <Arduino.h>
 #include "WheelControl.h"
+#include "Trace.h"
+
+static inline float clamp11f(float v){ if(v<-1)return-1; if(v>1)return 1; return v; }
 
 void WheelControl::begin(const WheelPins& pins, uint32_t pwmFreqHz, uint8_t pwmBits) {
   _p = pins;
   _bits = pwmBits;
   _freq = pwmFreqHz;
+  _loop = false;   // open loop until beginSpeedLoop()
 
   // Direction pins
   pinMode(_p.in1, OUTPUT);
@@ -18,9 +22,11 @@ void WheelControl::begin(const WheelPins& pins, uint32_t pwmFreqHz, uint8_t pwmB
   analogWriteFrequency(_p.enA, _freq);
   analogWriteFrequency(_p.enB, _freq);
 
-  // Safe idle
-  coast();
+  // Safe idle (first writes always go out: committed state is unknown)
+  for (int i = 0; i < 4; ++i) _lvl[i] = -1;
+  _duty[0] = _duty[1] = -1;
   _ready = true;
+  coast();
 }
 
 int WheelControl::_clamp255(int v) const {
@@ -37,18 +43,47 @@ int WheelControl::_toDuty(int val8) const {
 }
 
 void WheelControl::_writePinDuty(uint8_t pin, int duty8) {
-  analogWrite(pin, _toDuty(duty8));
+  int side = (pin == _p.enA) ? 0 : 1;
+  int duty = _toDuty(duty8);
+  if (_duty[side] == duty) { _ws.suppressed++; return; }
+  TRACE_SCOPE("wheel.pwm");
+  analogWrite(pin, duty);
+  _duty[side] = duty;
+  _ws.issued++;
+}
+
+void WheelControl::_dig(int idx, uint8_t pin, int level) {
+  if (_lvl[idx] == level) { _ws.suppressed++; return; }
+  TRACE_SCOPE("wheel.dir");
+  digitalWrite(pin, level);
+  _lvl[idx] = (int8_t)level;
+  _ws.issued++;
+}
+
+void WheelControl::_dirPins(int base, uint8_t pa, uint8_t pb, int la, int lb) {
+  _dig(base, pa, la);
+  _dig(base + 1, pb, lb);
+}
+
+void WheelControl::resync() {
+  if (!_ready) return;
+  const uint8_t dir[4] = { _p.in1, _p.in2, _p.in3, _p.in4 };
+  for (int i = 0; i < 4; ++i) {
+    if (_lvl[i] < 0) continue;
+    digitalWrite(dir[i], _lvl[i]);
+    _ws.issued++;
+  }
+  if (_duty[0] >= 0) { analogWrite(_p.enA, _duty[0]); _ws.issued++; }
+  if (_duty[1] >= 0) { analogWrite(_p.enB, _duty[1]); _ws.issued++; }
 }
 
 void WheelControl::_applyDirLeft(bool fwd, uint8_t duty8) {
-  digitalWrite(_p.in1, fwd ? HIGH : LOW);
-  digitalWrite(_p.in2, fwd ? LOW  : HIGH);
+  _dirPins(0, _p.in1, _p.in2, fwd ? HIGH : LOW, fwd ? LOW  : HIGH);
   _writePinDuty(_p.enA, duty8);
 }
 
 void WheelControl::_applyDirRight(bool fwd, uint8_t duty8) {
-  digitalWrite(_p.in3, fwd ? HIGH : LOW);
-  digitalWrite(_p.in4, fwd ? LOW  : HIGH);
+  _dirPins(2, _p.in3, _p.in4, fwd ? HIGH : LOW, fwd ? LOW  : HIGH);
   _writePinDuty(_p.enB, duty8);
 }
 
@@ -56,6 +91,7 @@ void WheelControl::setSpeedLeft(int spd) {
   if (!_ready) return;
   spd = _clamp255(spd);
   if (spd == 0) { coastLeft(); return; }
+  if (_loop) { _ls[0].target = spd / 255.0f; return; }
   bool fwd = (spd > 0);
   _applyDirLeft(fwd, (uint8_t)abs(spd));
 }
@@ -64,6 +100,7 @@ void WheelControl::setSpeedRight(int spd) {
   if (!_ready) return;
   spd = _clamp255(spd);
   if (spd == 0) { coastRight(); return; }
+  if (_loop) { _ls[1].target = spd / 255.0f; return; }
   bool fwd = (spd > 0);
   _applyDirRight(fwd, (uint8_t)abs(spd));
 }
@@ -75,15 +112,15 @@ void WheelControl::setSpeedBoth(int spd) {
 
 void WheelControl::brakeLeft() {
   if (!_ready) return;
-  digitalWrite(_p.in1, HIGH);
-  digitalWrite(_p.in2, HIGH);
+  _loopIdle(0);
+  _dirPins(0, _p.in1, _p.in2, HIGH, HIGH);
   _writePinDuty(_p.enA, 0);
 }
 
 void WheelControl::brakeRight() {
   if (!_ready) return;
-  digitalWrite(_p.in3, HIGH);
-  digitalWrite(_p.in4, HIGH);
+  _loopIdle(1);
+  _dirPins(2, _p.in3, _p.in4, HIGH, HIGH);
   _writePinDuty(_p.enB, 0);
 }
 
@@ -94,15 +131,15 @@ void WheelControl::brake() {
 
 void WheelControl::coastLeft() {
   if (!_ready) return;
-  digitalWrite(_p.in1, LOW);
-  digitalWrite(_p.in2, LOW);
+  _loopIdle(0);
+  _dirPins(0, _p.in1, _p.in2, LOW, LOW);
   _writePinDuty(_p.enA, 0);
 }
 
 void WheelControl::coastRight() {
   if (!_ready) return;
-  digitalWrite(_p.in3, LOW);
-  digitalWrite(_p.in4, LOW);
+  _loopIdle(1);
+  _dirPins(2, _p.in3, _p.in4, LOW, LOW);
   _writePinDuty(_p.enB, 0);
 }
 
@@ -110,3 +147,49 @@ void WheelControl::coast() {
   coastLeft();
   coastRight();
 }
+
+// ==== Speed loop ====
+bool WheelControl::beginSpeedLoop(const WheelLoopCfg& cfg, uint8_t encLA, uint8_t encLB, uint8_t encRA, uint8_t encRB) {
+  _loop = false;
+  if (!_ready || cfg.maxCps <= 0 || !cfg.periodMs) return false;
+  if (!_ls[0].enc.begin(encLA, encLB) || !_ls[1].enc.begin(encRA, encRB)) return false;
+  _lc = cfg;
+  for (int s = 0; s < 2; ++s) { _loopIdle(s); _ls[s].last = _ls[s].enc.count(); _ls[s].y = 0; }
+  _loopMs = millis();
+  coast();
+  _loop = true;
+  return true;
+}
+
+void WheelControl::update(uint32_t nowMs) {
+  if (!_loop) return;
+  uint32_t el = nowMs - _loopMs;
+  if (el < _lc.periodMs) return;
+  _loopMs = nowMs;
+  _loopSide(0, el * 0.001f);
+  _loopSide(1, el * 0.001f);
+}
+
+void WheelControl::_loopSide(int side, float dt) {
+  LoopSide& L = _ls[side];
+  int32_t c = L.enc.count();
+  float y = (float)(c - L.last) / (dt * _lc.maxCps);
+  float dy = (y - L.y) / dt;
+  L.last = c;
+  L.y = y;
+  if (L.target == 0) return;  // coasting/braked: bridge already set
+
+  float e = L.target - y;
+  float base = _lc.kff * L.target + (L.target > 0 ? _lc.ks : -_lc.ks) + _lc.kp * e - _lc.kd * dy;
+  float u = base + L.integ;
+  // Anti-windup: no integration while saturated in the error's direction
+  if (!((u >= 1.0f && e > 0) || (u <= -1.0f && e < 0))) {
+    L.integ = clamp11f(L.integ + _lc.ki * e * dt);
+    u = base + L.integ;
+  }
+  u = clamp11f(u);
+  L.u = u;
+  uint8_t d = (uint8_t)lroundf(fabsf(u) * 255.0f);
+  if (side == 0) _applyDirLeft(u >= 0, d);
+  else           _applyDirRight(u >= 0, d);
+}
@@ -1,5 +1,7 @@
 #pragma once
 #include <Arduino.h>
+#include "Utils.h"
+#include "WheelEncoder.h"
 
 struct WheelPins {
   // Left motor (A)
@@ -8,6 +10,15 @@ struct WheelPins {
   uint8_t in3, in4, enB; // enB = PWM
 };
 
+// Encoder speed loop gains. Speeds are fractions of maxCps, the output a
+// bridge duty fraction: u = kff*r + ks*sign(r) + kp*e - kd*dy/dt + ki*integral(e)
+struct WheelLoopCfg {
+  float kp, ki, kd;   // ki per second, kd in seconds
+  float kff, ks;      // feed-forward slope, static-friction offset
+  float maxCps;       // encoder counts/s that setSpeed*(+-255) asks for
+  uint16_t periodMs;  // loop period; update() is called at least this often
+};
+
 class WheelControl {
 public:
   WheelControl() {}
@@ -27,6 +38,20 @@ public:
   void coastRight();
   void coast();
 
+  // Closed loop: setSpeed* become speed targets (+-255 = +-maxCps) and
+  // update() sets the duty from encoder feedback. 0 still coasts at once.
+  bool beginSpeedLoop(const WheelLoopCfg& cfg, uint8_t encLA, uint8_t encLB, uint8_t encRA, uint8_t encRB);
+  bool speedLoop() const { return _loop; }
+  void update(uint32_t nowMs);                          // every control step
+  float speedCps(int side) const { return _ls[side].y * _lc.maxCps; } // 0 = left, 1 = right
+  float outputDuty(int side) const { return _ls[side].u; }            // -1..1
+
+  // Hardware is touched only when a pin's committed level/duty changes.
+  // resync() re-issues the committed state unconditionally.
+  void resync();
+  WriteStats writeStats() const { return _ws; }
+  void resetWriteStats() { _ws = WriteStats(); }
+
 private:
   WheelPins _p{};
   bool _ready = false;
@@ -34,9 +59,28 @@ private:
   uint8_t _bits = 10;   // analogWriteResolution
   uint32_t _freq = 10000;
 
+  // Committed output: in1..in4 levels, enA/enB duty (-1 = unknown)
+  int8_t  _lvl[4] = {-1, -1, -1, -1};
+  int32_t _duty[2] = {-1, -1};
+  WriteStats _ws;
+
+  struct LoopSide {
+    WheelEncoder enc;
+    int32_t last = 0;
+    float target = 0, y = 0, integ = 0, u = 0; // fractions of maxCps / duty
+  };
+  LoopSide _ls[2];
+  WheelLoopCfg _lc{};
+  bool _loop = false;
+  uint32_t _loopMs = 0;
+
   int  _clamp255(int v) const;
   int  _toDuty(int val8) const; // map 0..255 -> 0..(2^bits-1)
   void _writePinDuty(uint8_t pin, int duty8);
+  void _dig(int idx, uint8_t pin, int level);
+  void _dirPins(int base, uint8_t pa, uint8_t pb, int la, int lb);
   void _applyDirLeft(bool fwd, uint8_t duty8);
   void _applyDirRight(bool fwd, uint8_t duty8);
+  void _loopSide(int side, float dt);
+  void _loopIdle(int side) { _ls[side].target = 0; _ls[side].integ = 0; _ls[side].u = 0; }
 };
@@ -0,0 +1,40 @@
+#include "WheelEncoder.h"
+
+bool WheelEncoder::begin(uint8_t pinA, uint8_t pinB) {
+  pcnt_unit_config_t uc = {};
+  uc.low_limit = -32768;
+  uc.high_limit = 32767;
+  uc.flags.accum_count = 1;  // keep counting across the limits
+  if (pcnt_new_unit(&uc, &_unit) != ESP_OK) { _unit = nullptr; return false; }
+
+  pcnt_glitch_filter_config_t gf = {};
+  gf.max_glitch_ns = 1000;
+  pcnt_unit_set_glitch_filter(_unit, &gf);
+
+  // Both edges of both channels, direction from the other channel's level
+  pcnt_chan_config_t ca = {}, cb = {};
+  ca.edge_gpio_num = pinA; ca.level_gpio_num = pinB;
+  cb.edge_gpio_num = pinB; cb.level_gpio_num = pinA;
+  pcnt_channel_handle_t a = nullptr, b = nullptr;
+  if (pcnt_new_channel(_unit, &ca, &a) != ESP_OK || pcnt_new_channel(_unit, &cb, &b) != ESP_OK) {
+    _unit = nullptr;
+    return false;
+  }
+  pcnt_channel_set_edge_action(a, PCNT_CHANNEL_EDGE_ACTION_DECREASE, PCNT_CHANNEL_EDGE_ACTION_INCREASE);
+  pcnt_channel_set_level_action(a, PCNT_CHANNEL_LEVEL_ACTION_KEEP, PCNT_CHANNEL_LEVEL_ACTION_INVERSE);
+  pcnt_channel_set_edge_action(b, PCNT_CHANNEL_EDGE_ACTION_INCREASE, PCNT_CHANNEL_EDGE_ACTION_DECREASE);
+  pcnt_channel_set_level_action(b, PCNT_CHANNEL_LEVEL_ACTION_KEEP, PCNT_CHANNEL_LEVEL_ACTION_INVERSE);
+  pcnt_unit_add_watch_point(_unit, uc.low_limit);   // accum_count needs the limits watched
+  pcnt_unit_add_watch_point(_unit, uc.high_limit);
+
+  pcnt_unit_enable(_unit);
+  pcnt_unit_clear_count(_unit);
+  pcnt_unit_start(_unit);
+  return true;
+}
+
+int32_t WheelEncoder::count() const {
+  int v = 0;
+  if (_unit) pcnt_unit_get_count(_unit, &v);
+  return v;
+}
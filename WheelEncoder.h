@@ -0,0 +1,16 @@
+#pragma once
+#include <Arduino.h>
+#include "driver/pulse_cnt.h"
+
+// Quadrature wheel encoder on one PCNT unit: x4 decoding in hardware,
+// glitch filter, count accumulated past the 16-bit counter limits.
+// count() is a register read; no interrupt per edge.
+class WheelEncoder {
+public:
+  bool begin(uint8_t pinA, uint8_t pinB);
+  bool ok() const { return _unit != nullptr; }
+  int32_t count() const;
+
+private:
+  pcnt_unit_handle_t _unit = nullptr;
+};
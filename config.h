@@ -1,5 +1,7 @@
 #pragma once
 
+#define CAMMATE_VERSION "3.9"
+
 // === Servo pins ===
 #define SERVO_FRONT_PIN 18
 #define SERVO_REAR_PIN  19
@@ -27,12 +29,45 @@
 // === Motion tuning (servos) ===
 #define SERVO_DEFAULT_SPEED_DEG_PER_STEP 1
 #define SERVO_DEFAULT_STEP_DELAY_MS       10
+// Trajectory limits for every move incl. writeDeg (manual steer / planner)
+#define SERVO_MAX_VEL_DEG_S  360.0f
+#define SERVO_MAX_ACC_DEG_S2 3000.0f
+#define SERVO_MIN_US 500
+#define SERVO_MAX_US 2400
+
+// === Control task (playback, planner, actuation) ===
+// Rate must divide the 1 kHz FreeRTOS tick. WiFi/HTTP/SPIFFS stay in
+// loop() on core 1 (Arduino loopTask); control runs on core 0 below the
+// WiFi task priority.
+#define CONTROL_RATE_HZ    200
+#define CONTROL_TASK_CORE  0
+#define CONTROL_TASK_PRIO  10
+#define CONTROL_TASK_STACK 4096
+// Actuators skip writes that don't change the output; re-send the full
+// committed state this often anyway (0 = never)
+#define ACTUATOR_RESYNC_MS 1000
 
 // === Wheels defaults ===
 #define WHEEL_DEFAULT_SPEED 200   // base speed mapping (we still clamp 0..255)
 #define WHEEL_PWM_FREQ_HZ   10000 // 10 kHz
 #define WHEEL_PWM_BITS      10    // 0..1023 duty
 
+// === Wheel speed loop (quadrature encoders on PCNT) ===
+// 1 = wheel commands are speed targets held by a PI loop on encoder
+// feedback (repeatable across battery/load), 0 = open-loop duty
+#define WHEEL_SPEED_LOOP 0
+#define WHEEL_ENC_LA 34   // input-only pins
+#define WHEEL_ENC_LB 35
+#define WHEEL_ENC_RA 36
+#define WHEEL_ENC_RB 39
+#define WHEEL_MAX_CPS 3600.0f // counts/s asked for by +-255 (keep below no-load speed at low battery)
+#define WHEEL_LOOP_MS 10      // multiple of the control period
+#define WHEEL_KP  1.0f
+#define WHEEL_KI  5.0f
+#define WHEEL_KD  0.0f
+#define WHEEL_KFF 0.85f
+#define WHEEL_KS  0.04f
+
 // === Speed caps (used by Low/Normal/Sport) ===
 #define MAX_SPEED_NORMAL 140  // Normal & Low cap (0..255)
 #define MAX_SPEED_SPORT  255  // Sport cap (0..255)
@@ -61,10 +96,121 @@
 #define AP_MASK_OCT3 255
 #define AP_MASK_OCT4 0
 
+// === Serial link (SerialLink.h) ===
+// Framed binary setpoints/telemetry on the USB serial port, next to the
+// text console. 0 = console only.
+#define SLINK_ENABLED   1
+// Port rate while the link is on; the console shares the port, so it moves
+// from SERIAL_BAUD (115200, CamMate.ino) to this too
+#define SLINK_BAUD      921600
+#define SLINK_RX_BUFFER 1024  // UART RX buffer (bytes between loop() passes)
+#define SLINK_TELEM_MS  50    // telemetry period once a tracker has spoken (0 = acks only)
+#define SLINK_RESYNC_MS 500   // accept any seq after this much silence (tracker restart)
+
 // === HTTP server ===
 #define HTTP_PORT 80
+// Binary control channel (CtlProto.h); GET /ctl_* stay as fallback
+#define WS_PORT   81
 
 // === UI/Planner ===
 enum UIMode : uint8_t { MODE_NORMAL=0, MODE_CRAB=1, MODE_CIRCLE=2 };
 // scale speed down when steering is extreme (0=no scale, 1=max scale)
 #define SPEED_STEER_SCALE 0.5f
+// Runtime metrics (/metrics); 0 compiles Histo::add() out
+#define METRICS_ENABLED      1
+#define METRICS_MAX_HISTOS   40
+#define METRICS_MAX_COUNTERS 40
+
+// Span tracing (/trace, Trace.h): TRACE_SCOPE spans with CPU cycle
+// timestamps in a RAM ring; 0 compiles every span out
+#define TRACE_ENABLED     1
+#define TRACE_RING_EVENTS 512   // power of two, 20 bytes each
+
+// Playback rate multiplier limits (/rec/play?rate=)
+#define REC_RATE_MIN 0.25f
+#define REC_RATE_MAX 4.0f
+// Recording slots (/rec/list is served from RAM; cost does not grow per request)
+#define REC_SLOTS 5
+// Take storage (SlotStore.h): data partition in partitions.csv, sectors
+// (4 KB) preallocated per slot; 50 = 800 blocks = 25 min of v2 at 20 Hz
+// under continuous motion, over an hour of holds. The partition must hold
+// (2 + REC_SLOTS * REC_STORE_SLOT_SECTORS) sectors (REC_STORE_BYTES): the
+// 1 MB one in partitions.csv fits 5 slots of 50; raise it with either.
+#define REC_STORE_LABEL        "takes"
+#define REC_STORE_SLOT_SECTORS 50
+#define REC_STORE_ERASE_MS     50   // idle pre-erase: at most one sector per period
+#define REC_STORE_IDLE_MS      1000 // ... and only this long after the last command
+// Recorded frames queued between capture (control task) and the slot
+// store writer (loop); power of two. 32 frames = 1.6 s at 20 Hz.
+#define REC_RING_FRAMES 32
+// 1 = write delta/RLE blocks (RecFormat v2), 0 = fixed frames (v1).
+// Both are played back.
+#define REC_DELTA 1
+// Take transfer (/rec/download, /rec/upload): bytes per flash read and
+// send, and a rate cap so loop() keeps serving setpoints, the recorder
+// and playback prefetch between chunks (0 = no cap)
+#define REC_XFER_CHUNK_BYTES 1024
+#define REC_XFER_RATE_KBPS   256
+
+// === Power governor (shared supply) ===
+// 1 = wheel duty ramps (accel/jerk) and servo slew rates are limited so
+// the modeled draw stays under POWER_BUDGET_MA (PowerGovernor.h)
+#define POWER_GOVERNOR 1
+#define POWER_BUDGET_MA          2500.0f
+#define POWER_BASE_MA            250.0f  // ESP32 + WiFi
+#define POWER_SERVO_IDLE_MA      10.0f   // per servo, holding
+#define POWER_SERVO_MA_PER_DEGS  0.45f   // per deg/s of slew
+#define POWER_SERVO_MA_PER_DEGS2 0.12f   // per deg/s^2 of acceleration
+#define POWER_SERVO_RESERVE_MA   400.0f  // kept free of wheel ramps for steering
+#define POWER_MOTOR_STALL_MA     2400.0f // per motor, full duty at standstill
+#define POWER_MOTOR_TAU_MS       33.0f   // motor speed lag behind duty
+#define POWER_MOTOR_RUN_MA       180.0f  // per turning motor, friction load
+#define WHEEL_ACCEL_DUTY_S       600.0f  // wheel duty ramp (0..255 in ~0.5 s)
+#define WHEEL_JERK_DUTY_S2       6000.0f
+#define GOV_SERVO_MIN_SCALE      0.1f    // below this a servo at rest waits
+
+// === Chassis geometry (per-side wheel speeds) ===
+// Steer angle = servo deg - SERVO_CENTER on both axles (positive = right)
+#define KIN_WHEELBASE_MM 200.0f // front to rear axle
+#define KIN_TRACK_MM     180.0f // left to right wheel centers (driven axle)
+#define KIN_DRIVE_AXLE   1      // driven wheels: 0 = front axle, 1 = rear axle
+// 1 = left/right speeds follow the turn (no scrub), 0 = same PWM both sides
+#define KIN_WHEEL_SPLIT  1
+
+// === Gimbal stabilization (MPU-6050 on I2C + tilt/roll servos) ===
+// 1 = drain the IMU FIFO every control step, estimate pitch/roll and hold
+// the camera at the /gimbal angles (Stabilizer.h). Off at runtime when no
+// IMU answers at boot.
+#define GIMBAL_ENABLED 1
+#define GIMBAL_TILT_PIN  16
+#define GIMBAL_ROLL_PIN  17
+#define GIMBAL_TILT_SIGN 1     // camera pitch per servo deg (mounting, +-1)
+#define GIMBAL_ROLL_SIGN 1
+#define GIMBAL_RANGE_DEG 60    // servo travel either side of SERVO_CENTER
+#define GIMBAL_MAX_VEL_DEG_S  600.0f
+#define GIMBAL_MAX_ACC_DEG_S2 20000.0f
+#define IMU_SDA_PIN  21
+#define IMU_SCL_PIN  22
+#define IMU_I2C_HZ   400000
+#define IMU_I2C_ADDR 0x68
+#define IMU_RATE_HZ  500       // chip sample rate: 1 kHz / n (DLPF on)
+#define IMU_READ_MAX 16        // samples drained per control step at most
+#define IMU_ACC_LSB_G    16384.0f // +-2 g
+#define IMU_GYRO_LSB_DPS 65.5f    // +-500 deg/s
+#define STAB_TAU_S       1.0f  // accel tilt correction time constant
+#define STAB_BIAS_TAU_S  8.0f  // gyro bias integrator
+#define STAB_ACC_GATE_G  0.15f // skip accel when |a| is off 1 g by more
+#define STAB_LEAD_MS     25.0f // servo lag compensation (gyro rate * lead)
+
+// === Motion presets (/preset, Preset.h) ===
+// Straight / arc / orbit moves evaluated at the control rate. Distances
+// come from a speed model: chassis speed at full duty, driving straight
+// (calibrate on the rover; with WHEEL_SPEED_LOOP it holds across battery)
+#define PRESET_MM_S_FULL     900.0f
+#define PRESET_SPEED_MM_S    250.0f // default cruise speed of the chassis center
+#define PRESET_RAMP_MS       800    // default ease-in/out time
+#define PRESET_SETTLE_MAX_MS 1000   // max wait for the steering servos before rolling
+
+// 1 = table-driven planSteering + integer applySpeedScaling,
+// 0 = reference float versions (planSteeringRef / applySpeedScalingRef)
+#define PLANNER_USE_LUT 1
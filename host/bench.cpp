@@ -0,0 +1,62 @@
+// CamMate host benchmark driver.
+//   cammate_bench <name> [--option value ...]
+#include "bench.h"
+
+static const BenchEntry BENCHES[] = {
+  { "loop",    benchLoop,    "loop() latency + actuator writes under scripted joystick input" },
+  { "ctltask", benchCtlTask, "control task period jitter/overruns under synthetic HTTP load" },
+  { "ctl",     benchCtl,     "command-to-actuation latency: HTTP GETs vs WebSocket setpoints" },
+  { "servo",   benchServo,   "servo trajectory: slew limits, sweep, synchronized moves" },
+  { "plan",    benchPlan,    "planner/speed LUT fast path: equivalence vs float + ns/call" },
+  { "play",    benchPlay,    "playback smoothness per rate, seek and loop" },
+  { "seqlock", benchSeqLock, "multithreaded torn-read stress of the command snapshot" },
+  { "metrics", benchMetrics, "metrics registry: add() cost, render cost, sample /metrics" },
+  { "rec",     benchRec,     "recording under slow SPIFFS flushes: sample spacing, commit lag" },
+  { "codec",   benchCodec,   "recording codec v1 vs delta/RLE v2: size, round trip, decode ns/frame" },
+  { "seek",    benchSeek,    "playback start/seek cost vs take length: .idx binary search vs scan" },
+  { "list",    benchList,    "/rec/list from the slot catalog: consistency with SPIFFS, cost" },
+  { "ui",      benchUi,      "UI page delivery: gzip body, ETag, If-None-Match -> 304, modeled load time" },
+  { "wheel",   benchWheel,   "wheel PI speed loop on the motor/encoder sim: step, load, repeatability, cost" },
+  { "kin",     benchKin,     "4WS kinematics: orbit diameter vs model per circle diam, wheel split vs rolled distance" },
+  { "power",   benchPower,   "power governor vs actuator plants on a shared rail: peak draw, settle, throttling" },
+  { "stab",    benchStab,    "gimbal stabilizer on IMU traces: fixed vs float filter error + ns/sample, camera residual" },
+  { "trace",   benchTrace,   "span tracing: TRACE_SCOPE cost, scripted session dumped via /trace and validated" },
+  { "serial",  benchSerial,  "framed serial link over a pty: setpoint/ack rates, round-trip latency, fault injection" },
+  { "preset",  benchPreset,  "motion presets: distance/sweep/duration vs request, eased drive, firmware /preset run" },
+  { "store",   benchStore,   "slot store on emulated flash: O(1) start/stop/clear, erase stalls while recording, power-cut fuzz" },
+  { "xfer",    benchXfer,    "/rec/download + /rec/upload: Range/ETag, per-block upload checks, MB/s and peak heap, control impact" },
+};
+
+long benchArg(int argc, char** argv, const char* name, long def) {
+  for (int i = 2; i + 1 < argc; ++i) if (strcmp(argv[i], name) == 0) return strtol(argv[i + 1], nullptr, 10);
+  return def;
+}
+
+const char* benchArgStr(int argc, char** argv, const char* name, const char* def) {
+  for (int i = 2; i + 1 < argc; ++i) if (strcmp(argv[i], name) == 0) return argv[i + 1];
+  return def;
+}
+
+bool benchFlag(int argc, char** argv, const char* name) {
+  for (int i = 2; i < argc; ++i) if (strcmp(argv[i], name) == 0) return true;
+  return false;
+}
+
+void benchPrintPercentiles(const char* label, std::vector<uint64_t>& s, double div, const char* unit) {
+  if (s.empty()) { printf("%-22s (no samples)\n", label); return; }
+  std::sort(s.begin(), s.end());
+  auto pct = [&](double p){ return s[(size_t)(p * (double)(s.size() - 1))] / div; };
+  double sum = 0; for (uint64_t v : s) sum += (double)v;
+  printf("%-22s p50 %8.2f  p90 %8.2f  p99 %8.2f  p99.9 %8.2f  max %8.2f  mean %8.2f %s\n",
+         label, pct(0.50), pct(0.90), pct(0.99), pct(0.999), s.back() / div, sum / s.size() / div, unit);
+}
+
+int main(int argc, char** argv) {
+  const char* name = (argc > 1) ? argv[1] : "";
+  for (const BenchEntry& b : BENCHES) {
+    if (strcmp(b.name, name) == 0) return b.fn(argc, argv);
+  }
+  fprintf(stderr, "usage: %s <bench> [options]\n", argv[0]);
+  for (const BenchEntry& b : BENCHES) fprintf(stderr, "  %-8s %s\n", b.name, b.help);
+  return 2;
+}
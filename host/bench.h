@@ -0,0 +1,55 @@
+#pragma once
+// Shared helpers for the host benchmarks (see host/bench.cpp).
+#include <Arduino.h>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+
+// Firmware entry points and globals from CamMate.ino
+void setup();
+void loop();
+
+static inline uint64_t benchNowNs() {
+  return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+           std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Integer option "--name N" (or default)
+long benchArg(int argc, char** argv, const char* name, long def);
+// String option "--name S" (or default)
+const char* benchArgStr(int argc, char** argv, const char* name, const char* def);
+// Flag "--name"
+bool benchFlag(int argc, char** argv, const char* name);
+
+// Sorts samples in place and prints "label: p50 p90 p99 p99.9 max mean" (unit = ns / div)
+void benchPrintPercentiles(const char* label, std::vector<uint64_t>& samples, double div, const char* unit);
+
+// RecFormat blocks for a take, split like Recorder::_appendFrame (bench_codec.cpp)
+struct RecFrame;
+std::vector<std::vector<uint8_t>> benchEncodeTake(const std::vector<RecFrame>& take, uint8_t version);
+
+typedef int (*BenchFn)(int argc, char** argv);
+struct BenchEntry { const char* name; BenchFn fn; const char* help; };
+
+int benchLoop(int argc, char** argv);
+int benchCtlTask(int argc, char** argv);
+int benchCtl(int argc, char** argv);
+int benchServo(int argc, char** argv);
+int benchPlan(int argc, char** argv);
+int benchPlay(int argc, char** argv);
+int benchSeqLock(int argc, char** argv);
+int benchMetrics(int argc, char** argv);
+int benchRec(int argc, char** argv);
+int benchCodec(int argc, char** argv);
+int benchSeek(int argc, char** argv);
+int benchList(int argc, char** argv);
+int benchUi(int argc, char** argv);
+int benchWheel(int argc, char** argv);
+int benchKin(int argc, char** argv);
+int benchPower(int argc, char** argv);
+int benchStab(int argc, char** argv);
+int benchTrace(int argc, char** argv);
+int benchSerial(int argc, char** argv);
+int benchPreset(int argc, char** argv);
+int benchStore(int argc, char** argv);
+int benchXfer(int argc, char** argv);
@@ -0,0 +1,234 @@
+// Recording codec: v1 fixed frames vs v2 delta/RLE blocks (RecFormat.h).
+// Synthetic takes (idle, held steer, joystick-style holds and ramps,
+// continuous sine) plus one take recorded through the firmware (scripted
+// HTTP joystick, virtual clock) and optionally a device take (--take FILE,
+// .bin of either version). For each: flash bytes per format, ratio, a
+// bit-exact round trip of every quantized frame through both formats, and
+// decode cost per frame (block decode on the loop side, unpack on the
+// control side). Non-zero exit on any mismatch.
+#include "bench.h"
+#include <WebServer.h>
+#include <FS.h>
+#include <SPIFFS.h>
+#include "config.h"
+#include "Recorder.h"
+#include "SlotStore.h"
+
+extern WebServer server;
+extern SlotStore store;
+
+static const uint16_t SAMPLE_MS = 50;
+
+// Same block split as Recorder::_appendFrame
+std::vector<std::vector<uint8_t>> benchEncodeTake(const std::vector<RecFrame>& take, uint8_t version) {
+  std::vector<std::vector<uint8_t>> blocks;
+  uint8_t blk[REC_BLOCK_BYTES] = {0};
+  RecBlockEnc e;
+  uint32_t t0 = 0;
+  recEncBegin(e, blk, version, SAMPLE_MS);
+  auto flush = [&]{
+    if (!e.count) return;
+    ((RecBlockHeader*)blk)->t0 = t0;
+    recSealBlock(blk, e.count);
+    blocks.emplace_back(blk, blk + REC_BLOCK_BYTES);
+    memset(blk, 0, sizeof(blk));
+    recEncBegin(e, blk, version, SAMPLE_MS);
+  };
+  for (const RecFrame& f : take) {
+    if (e.count && f.t - t0 > 0xFFFFu) flush();
+    if (!e.count) t0 = f.t;
+    RecPacked p; recPack(f, t0, p);
+    if (!recEncAdd(e, p)) { flush(); t0 = f.t; recPack(f, t0, p); recEncAdd(e, p); }
+    if (e.count == (version < 2 ? REC_FRAMES_PER_BLOCK : REC_BLOCK_MAX_FRAMES)) flush();
+  }
+  flush();
+  return blocks;
+}
+
+// Quantized frames as the decoder sees them (dt relative to each block t0
+// is folded back into absolute t so both formats compare directly)
+static bool decodeTake(const std::vector<std::vector<uint8_t>>& blocks, uint8_t version, std::vector<RecFrame>& out) {
+  out.clear();
+  RecPacked dec[REC_BLOCK_MAX_FRAMES];
+  for (const auto& b : blocks) {
+    if (!recBlockValid(b.data())) return false;
+    int n = recDecodeBlock(b.data(), version, SAMPLE_MS, dec, REC_BLOCK_MAX_FRAMES);
+    if (n <= 0) return false;
+    for (int i = 0; i < n; ++i) { RecFrame f; recUnpack(dec[i], ((const RecBlockHeader*)b.data())->t0, f); out.push_back(f); }
+  }
+  return true;
+}
+
+static bool sameFrame(const RecFrame& a, const RecFrame& b) {
+  return a.t == b.t && a.manual == b.manual && a.x == b.x && a.y == b.y && a.mode == b.mode &&
+         a.diam == b.diam && a.speed == b.speed && a.ff == b.ff && a.fr == b.fr;
+}
+
+static double decodeNsPerFrame(const std::vector<std::vector<uint8_t>>& blocks, uint8_t version, size_t frames) {
+  RecPacked dec[REC_BLOCK_MAX_FRAMES];
+  volatile uint32_t sink = 0;
+  int reps = (int)std::max<size_t>(1, 2000000 / std::max<size_t>(frames, 1));
+  uint64_t a = benchNowNs();
+  for (int r = 0; r < reps; ++r)
+    for (const auto& b : blocks) { int n = recDecodeBlock(b.data(), version, SAMPLE_MS, dec, REC_BLOCK_MAX_FRAMES); sink += dec[n - 1].dt; }
+  return (double)(benchNowNs() - a) / ((double)reps * frames);
+}
+
+static double unpackNsPerFrame(const std::vector<std::vector<uint8_t>>& blocks, uint8_t version, size_t frames) {
+  RecPacked dec[REC_BLOCK_MAX_FRAMES];
+  std::vector<std::pair<uint32_t, std::vector<RecPacked>>> win;
+  for (const auto& b : blocks) {
+    int n = recDecodeBlock(b.data(), version, SAMPLE_MS, dec, REC_BLOCK_MAX_FRAMES);
+    win.emplace_back(((const RecBlockHeader*)b.data())->t0, std::vector<RecPacked>(dec, dec + n));
+  }
+  volatile float sink = 0;
+  int reps = (int)std::max<size_t>(1, 2000000 / std::max<size_t>(frames, 1));
+  uint64_t a = benchNowNs();
+  for (int r = 0; r < reps; ++r)
+    for (const auto& w : win) for (const RecPacked& p : w.second) { RecFrame f; recUnpack(p, w.first, f); sink += f.x; }
+  return (double)(benchNowNs() - a) / ((double)reps * frames);
+}
+
+static bool report(const char* name, const std::vector<RecFrame>& take) {
+  auto v1 = benchEncodeTake(take, 1), v2 = benchEncodeTake(take, 2);
+  std::vector<RecFrame> ref, d1, d2;
+  for (const RecFrame& f : take) { RecPacked p; RecFrame q; recPack(f, 0, p); recUnpack(p, 0, q); q.t = f.t; ref.push_back(q); }
+  bool ok = decodeTake(v1, 1, d1) && decodeTake(v2, 2, d2) && d1.size() == ref.size() && d2.size() == ref.size();
+  for (size_t i = 0; ok && i < ref.size(); ++i) ok = sameFrame(d1[i], ref[i]) && sameFrame(d2[i], ref[i]);
+  size_t b1 = sizeof(RecFileHeader) + v1.size() * REC_BLOCK_BYTES, b2 = sizeof(RecFileHeader) + v2.size() * REC_BLOCK_BYTES;
+  printf("%-10s %6zu frames  v1 %7zu B  v2 %7zu B  ratio %5.1fx  %5.1f frames/block  decode v1 %5.1f v2 %5.1f ns/frame  unpack %4.1f ns  %s\n",
+         name, take.size(), b1, b2, (double)b1 / b2, v2.empty() ? 0.0 : (double)take.size() / v2.size(),
+         decodeNsPerFrame(v1, 1, take.size()), decodeNsPerFrame(v2, 2, take.size()),
+         unpackNsPerFrame(v2, 2, take.size()), ok ? "bit-exact" : "MISMATCH");
+  return ok;
+}
+
+// ==== Synthetic takes (20 Hz) ====
+static RecFrame frameAt(uint32_t t, float x, float y, bool manual = false, int ff = SERVO_CENTER, int fr = SERVO_CENTER) {
+  return RecFrame{ t, (uint8_t)manual, x, y, MODE_NORMAL, 1.0f, SPEED_NORMAL, (int16_t)ff, (int16_t)fr };
+}
+
+static std::vector<RecFrame> takeIdle(uint32_t ms) {
+  std::vector<RecFrame> v;
+  for (uint32_t t = 0; t < ms; t += SAMPLE_MS) v.push_back(frameAt(t, 0, 0));
+  return v;
+}
+
+static std::vector<RecFrame> takeHold(uint32_t ms) {
+  std::vector<RecFrame> v;
+  for (uint32_t t = 0; t < ms; t += SAMPLE_MS) v.push_back(frameAt(t, 0.35f, 0.6f));
+  return v;
+}
+
+// Operator-style: hold a stick position 0.5-5 s, ramp to the next in
+// 0.3-1 s; manual steer toggles now and then
+static std::vector<RecFrame> takeJoystick(uint32_t ms) {
+  std::vector<RecFrame> v;
+  uint32_t seed = 12345;
+  auto rnd = [&]{ seed = seed * 1103515245u + 12345u; return (seed >> 8) / 16777216.0f; };
+  float x = 0, y = 0, tx = 0, ty = 0;
+  bool manual = false;
+  uint32_t t = 0;
+  while (t < ms) {
+    uint32_t hold = 500 + (uint32_t)(rnd() * 4500), ramp = 300 + (uint32_t)(rnd() * 700);
+    for (uint32_t e = 0; e < hold && t < ms; e += SAMPLE_MS, t += SAMPLE_MS)
+      v.push_back(frameAt(t, x, y, manual, SERVO_CENTER + (int)(x * 30), SERVO_CENTER - (int)(x * 30)));
+    tx = rnd() * 2 - 1; ty = rnd() * 1.6f - 0.6f;
+    if (rnd() < 0.15f) manual = !manual;
+    float x0 = x, y0 = y;
+    for (uint32_t e = 0; e < ramp && t < ms; e += SAMPLE_MS, t += SAMPLE_MS) {
+      float a = (float)e / ramp;
+      x = x0 + (tx - x0) * a; y = y0 + (ty - y0) * a;
+      v.push_back(frameAt(t, x, y, manual, SERVO_CENTER + (int)(x * 30), SERVO_CENTER - (int)(x * 30)));
+    }
+    x = tx; y = ty;
+  }
+  return v;
+}
+
+static std::vector<RecFrame> takeSine(uint32_t ms) {
+  std::vector<RecFrame> v;
+  for (uint32_t t = 0; t < ms; t += SAMPLE_MS) {
+    float s = sinf(2.0f * (float)M_PI * 0.2f * t / 1000.0f), c = cosf(2.0f * (float)M_PI * 0.13f * t / 1000.0f);
+    v.push_back(frameAt(t, 0.5f * s, 0.4f * c, true, SERVO_CENTER + (int)(25 * s), SERVO_CENTER - (int)(25 * s)));
+  }
+  return v;
+}
+
+// ==== Takes from files ====
+static bool readTake(const char* path, std::vector<RecFrame>& out) {
+  File f = SPIFFS.open(path, FILE_READ);
+  RecFileHeader h;
+  if (!f || f.read((uint8_t*)&h, sizeof(h)) != sizeof(h) || !recHeaderValid(h)) return false;
+  std::vector<std::vector<uint8_t>> blocks;
+  uint8_t blk[REC_BLOCK_BYTES];
+  while (f.read(blk, REC_BLOCK_BYTES) == REC_BLOCK_BYTES)
+    if (recBlockValid(blk)) blocks.emplace_back(blk, blk + REC_BLOCK_BYTES);
+  f.close();
+  return decodeTake(blocks, h.version, out);
+}
+
+static bool readSlot(int slot, std::vector<RecFrame>& out) {
+  const SlotMeta& m = store.meta(slot);
+  if (m.state != SLOT_DONE) return false;
+  std::vector<std::vector<uint8_t>> blocks;
+  uint8_t blk[REC_BLOCK_BYTES];
+  for (uint32_t b = 0; b < m.blocks && store.readBlock(slot, b, blk); ++b)
+    if (recBlockValid(blk)) blocks.emplace_back(blk, blk + REC_BLOCK_BYTES);
+  return decodeTake(blocks, m.version, out);
+}
+
+static void drainHttp() { while (server.sim_pending()) loop(); }
+static void get(const char* uri) { server.sim_enqueue(HTTP_GET, uri); drainHttp(); }
+
+// Scripted joystick through /ctl_* while the firmware records slot 5
+static bool recordFirmwareTake(uint32_t ms, std::vector<RecFrame>& out, size_t& fileBytes) {
+  hal::useVirtualClock(true);
+  hal::setTasksEnabled(false);
+  setup();
+  get("/rec/clear?slot=5");
+  get("/rec/start?slot=5");
+  std::vector<RecFrame> script = takeJoystick(ms);
+  size_t k = 0;
+  for (uint32_t t = 0; t < ms; t += 5) {
+    if (k < script.size() && script[k].t <= t) {
+      char q[64];
+      snprintf(q, sizeof(q), "/ctl_drive?y=%.3f", script[k].y);          server.sim_enqueue(HTTP_GET, q);
+      snprintf(q, sizeof(q), "/ctl_steer?x=%.3f&y=0", script[k].x);       server.sim_enqueue(HTTP_GET, q);
+      k++;
+    }
+    for (int i = 0; i < 5; ++i) { loop(); hal::advanceMicros(1000); }
+  }
+  get("/rec/stop");
+  fileBytes = store.takeBytes(5);
+  return readSlot(5, out);
+}
+
+int benchCodec(int argc, char** argv) {
+  long seconds = benchArg(argc, argv, "--seconds", 120);
+  const char* takePath = benchArgStr(argc, argv, "--take", nullptr);
+  hal::setFsRoot(benchArgStr(argc, argv, "--fs", "bench_fs"));
+  uint32_t ms = (uint32_t)seconds * 1000;
+
+  printf("\n== codec: %ld s takes at %u ms, %d-byte blocks (v1 %u frames, v2 <= %d) ==\n",
+         seconds, SAMPLE_MS, REC_BLOCK_BYTES, (unsigned)REC_FRAMES_PER_BLOCK, REC_BLOCK_MAX_FRAMES);
+  bool ok = true;
+  ok &= report("idle",     takeIdle(ms));
+  ok &= report("hold",     takeHold(ms));
+  ok &= report("joystick", takeJoystick(ms));
+  ok &= report("sine",     takeSine(ms));
+
+  std::vector<RecFrame> fw;
+  size_t fwBytes = 0;
+  if (recordFirmwareTake(ms, fw, fwBytes)) {
+    ok &= report("firmware", fw);
+    printf("%-10s recorder wrote %zu B (REC_DELTA %d)\n", "", fwBytes, REC_DELTA);
+  } else { printf("firmware take: read failed\n"); ok = false; }
+
+  if (takePath) {
+    std::vector<RecFrame> dev;
+    if (readTake(takePath, dev)) ok &= report("--take", dev);
+    else { printf("--take %s: not a readable .bin take\n", takePath); ok = false; }
+  }
+  return ok ? 0 : 1;
+}
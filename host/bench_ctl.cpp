@@ -0,0 +1,152 @@
+// Command-to-actuation latency: HTTP GET per pointermove (legacy UI),
+// GETs coalesced per animation frame (new UI fallback) and binary
+// WebSocket setpoints (new UI). Virtual clock; request/frame service cost
+// is charged to the loop through the fake servers.
+//
+// Each run ramps the drive pad 0 -> 1 in 200 steps while the steer pad
+// moves too (two fingers), rover in Sport + manual steer, so wheel duty is
+// monotonic in the command. Command k counts as actuated once the left PWM
+// duty reaches its value (k itself or any newer command applied -- what
+// latest-wins is meant to do).
+#include "bench.h"
+#include <WebServer.h>
+#include <WebSocketsServer.h>
+#include <FS.h>
+#include "config.h"
+#include "CtlProto.h"
+#include "ServoControl.h"
+
+extern WebServer server;
+extern WebSocketsServer ws;
+extern ServoControl servoFront, servoRear;
+
+enum CtlPath { PATH_HTTP, PATH_HTTP_RAF, PATH_WS };
+static const char* PATH_NAME[] = { "http per-move", "http per-frame", "ws per-frame" };
+
+static const int RAMP_STEPS = 200;
+
+static void drainHttp() { while (server.sim_pending()) loop(); }
+
+static int expectedDuty(float y) {
+  int pwm = (int)(y * 255.0f);
+  return (pwm * ((1 << WHEEL_PWM_BITS) - 1)) / 255;
+}
+
+static void runPath(CtlPath path, int ramps, long moveHz, long frameHz, long loopUs) {
+  std::vector<uint64_t> lat;
+  uint16_t seq = 0;
+  uint32_t sent = 0;
+  const uint32_t moveUs = 1000000u / (uint32_t)moveHz, frameUs = 1000000u / (uint32_t)frameHz;
+
+  for (int r = 0; r < ramps; ++r) {
+    // settle at zero
+    server.sim_enqueue(HTTP_GET, "/ctl_drive?y=0.000");
+    drainHttp();
+    for (int i = 0; i < 50; ++i) { loop(); hal::advanceMicros(1000); }
+
+    std::vector<uint32_t> issued(RAMP_STEPS);
+    std::vector<int> expDuty(RAMP_STEPS);
+    int k = 0, next = 0;
+    float cur = 0;
+    bool dirty = false;
+    uint32_t now = micros(), nextMove = now, nextFrame = now;
+
+    while (next < RAMP_STEPS) {
+      now = micros();
+      if (k < RAMP_STEPS && (int32_t)(now - nextMove) >= 0) {          // pointermove
+        cur = (k + 1) / (float)RAMP_STEPS;
+        issued[k] = nextMove; expDuty[k] = expectedDuty(cur);
+        k++;
+        nextMove += moveUs;
+        if (path == PATH_HTTP) {
+          char q[48]; snprintf(q, sizeof(q), "/ctl_drive?y=%.3f", cur);
+          server.sim_enqueue(HTTP_GET, q);
+          server.sim_enqueue(HTTP_GET, "/ctl_servos?x=0.000&y=0.000");
+          sent += 2;
+        } else dirty = true;
+      }
+      if (path != PATH_HTTP && (int32_t)(now - nextFrame) >= 0) {       // requestAnimationFrame
+        nextFrame += frameUs;
+        if (dirty) {
+          dirty = false;
+          if (path == PATH_WS) {
+            sent++;
+            CtlMsg m{};
+            m.ver = CTL_MSG_VERSION; m.flags = CTL_FLAG_MANUAL; m.seq = ++seq;
+            m.drive = (int16_t)lroundf(cur * 16384.0f); m.diam = 65535;
+            ws.sim_enqueueBin(0, &m, sizeof(m));
+          } else {
+            char q[48]; snprintf(q, sizeof(q), "/ctl_drive?y=%.3f", cur);
+            server.sim_enqueue(HTTP_GET, q);
+            server.sim_enqueue(HTTP_GET, "/ctl_servos?x=0.000&y=0.000");
+            sent += 2;
+          }
+        }
+      }
+
+      loop();
+      hal::advanceMicros((uint64_t)loopUs);
+
+      int duty = hal::pinDuty[L298_ENA];
+      uint32_t t = micros();
+      while (next < k && duty >= expDuty[next]) { lat.push_back((uint64_t)(t - issued[next]) * 1000u); next++; }
+    }
+    drainHttp();
+  }
+
+  char label[40];
+  snprintf(label, sizeof(label), "%s", PATH_NAME[path]);
+  printf("%-22s sent %u messages for %d moves\n", label, (unsigned)sent, ramps * RAMP_STEPS);
+  benchPrintPercentiles("  move->actuation", lat, 1e6, "ms");
+}
+
+// Mode 3 is not a UIMode: /ctl_steer must answer 400 and a WS frame
+// carrying it must keep the last mode; the servos stay where crab put them
+static bool checkModes() {
+  auto settle = [] { for (int i = 0; i < 500; ++i) { loop(); hal::advanceMicros(1000); } };
+  auto get = [](const char* uri) { server.sim_enqueue(HTTP_GET, uri); drainHttp(); return server.sim_lastResponse().code; };
+  get("/ui/manual_steer?on=0");
+  get("/ctl_steer?x=0.5&y=0&mode=1&diam=1");
+  settle();
+  float ff = servoFront.readDegF(), fr = servoRear.readDegF();
+  int code = get("/ctl_steer?x=0.5&y=0&mode=3&diam=1");
+  settle();
+  bool httpOk = code == 400 && servoFront.readDegF() == ff && servoRear.readDegF() == fr;
+  CtlMsg m{ CTL_MSG_VERSION, 3, 60000, 0, 8192, 0, 65535 };
+  ws.sim_disconnect(0); ws.sim_connect(0);
+  ws.sim_enqueueBin(0, &m, sizeof(m));
+  settle();
+  bool wsOk = servoFront.readDegF() == ff && servoRear.readDegF() == fr;
+  printf("%-22s crab front %.1f rear %.1f; GET mode=3 -> %d%s; WS mode 3 %s\n", "mode 3", ff, fr, code,
+         httpOk ? "" : " (moved)", wsOk ? "kept crab" : "MOVED");
+  return httpOk && wsOk;
+}
+
+int benchCtl(int argc, char** argv) {
+  int  ramps   = (int)benchArg(argc, argv, "--ramps", 10);
+  long moveHz  = benchArg(argc, argv, "--move-hz", 120);      // touch pointermove rate
+  long frameHz = benchArg(argc, argv, "--frame-hz", 60);      // requestAnimationFrame
+  long reqUs   = benchArg(argc, argv, "--req-cost-us", 4000); // HTTP request on the softAP
+  long wsUs    = benchArg(argc, argv, "--ws-cost-us", 150);   // WS frame
+  long loopUs  = benchArg(argc, argv, "--loop-us", 200);
+  hal::setFsRoot(benchArgStr(argc, argv, "--fs", "bench_fs"));
+  hal::useVirtualClock(true);
+  hal::setTasksEnabled(false);
+
+  setup();
+  server.sim_enqueue(HTTP_GET, "/speed?mode=sport");
+  server.sim_enqueue(HTTP_GET, "/ui/manual_steer?on=1");
+  drainHttp();
+  server.sim_setRequestCostUs((uint32_t)reqUs);
+  ws.sim_setFrameCostUs((uint32_t)wsUs);
+  ws.sim_connect(0);
+
+  printf("\n== ctl: %d ramps x %d moves, move %ld Hz, frame %ld Hz, http %ld us/req, ws %ld us/frame ==\n",
+         ramps, RAMP_STEPS, moveHz, frameHz, reqUs, wsUs);
+  runPath(PATH_HTTP, ramps, moveHz, frameHz, loopUs);
+  runPath(PATH_HTTP_RAF, ramps, moveHz, frameHz, loopUs);
+  runPath(PATH_WS, ramps, moveHz, frameHz, loopUs);
+  bool ok = checkModes();
+  printf("%-22s %s\n", "result", ok ? "ok" : "FAILED");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,58 @@
+// Control-task period stability under synthetic HTTP load. Real clock and
+// a real thread for the control task; this thread plays loopTask.
+#include "bench.h"
+#include <WebServer.h>
+#include <FS.h>
+#include "ControlTask.h"
+#include <thread>
+
+extern WebServer server;
+extern ControlTask ctl;
+
+int benchCtlTask(int argc, char** argv) {
+  long seconds = benchArg(argc, argv, "--seconds", 5);
+  long costUs  = benchArg(argc, argv, "--req-cost-us", 2000); // per HTTP request
+  long listHz  = benchArg(argc, argv, "--list-hz", 20);       // /rec/list storm
+  hal::setFsRoot(benchArgStr(argc, argv, "--fs", "bench_fs"));
+  hal::setTasksEnabled(true);
+
+  setup();
+  if (!ctl.running()) { fprintf(stderr, "control task did not start\n"); return 1; }
+  server.sim_setRequestCostUs((uint32_t)costUs);
+  delay(50);
+  ctl.resetStats();
+
+  std::vector<uint64_t> loopNs;
+  uint32_t t0 = millis(), nextInput = t0, nextList = t0;
+  uint32_t listPeriod = (uint32_t)(1000 / (listHz > 0 ? listHz : 1));
+  while (millis() - t0 < (uint32_t)(seconds * 1000)) {
+    uint32_t now = millis();
+    if ((int32_t)(now - nextInput) >= 0) {
+      char q[64];
+      snprintf(q, sizeof(q), "/ctl_drive?y=%.3f", 0.5f * sinf(now / 700.0f));
+      server.sim_enqueue(HTTP_GET, q);
+      nextInput += 16;
+    }
+    if (listHz > 0 && (int32_t)(now - nextList) >= 0) { server.sim_enqueue(HTTP_GET, "/rec/list"); nextList += listPeriod; }
+    uint64_t a = benchNowNs();
+    loop();
+    loopNs.push_back(benchNowNs() - a);
+    std::this_thread::yield(); // loopTask shares nothing with core 0 on target; be fair on 1-CPU hosts
+  }
+  ControlStats st = ctl.stats();
+  ctl.stop();
+  delay(20);
+
+  printf("\n== ctltask: %ld s, %u us period, %ld us per HTTP request, /rec/list at %ld Hz ==\n",
+         seconds, (unsigned)st.periodUs, costUs, listHz);
+  printf("%-22s %u (expected %lu)  overruns %u\n", "cycles", (unsigned)st.cycles,
+         (unsigned long)(seconds * 1000000L / st.periodUs), (unsigned)st.overruns);
+  printf("%-22s max %u us  mean %.1f us  max exec %u us\n", "period jitter", (unsigned)st.maxJitterUs,
+         st.cycles > 1 ? (double)st.sumJitterUs / (st.cycles - 1) : 0.0, (unsigned)st.maxExecUs);
+  static const char* LBL[7] = {"<50", "<100", "<250", "<500", "<1000", "<2500", ">=2500"};
+  printf("%-22s", "jitter histogram (us)");
+  for (int i = 0; i < 7; ++i) printf(" %s:%u", LBL[i], (unsigned)st.jitterHist[i]);
+  printf("\n");
+  benchPrintPercentiles("loop() (net side)", loopNs, 1000.0, "us");
+  return 0;
+}
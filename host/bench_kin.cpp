@@ -0,0 +1,98 @@
+// 4WS kinematics behind the per-side wheel speeds (MotionPlanner.h).
+// For circle mode at diam 0..1 both ways, and full/half lock in normal and
+// crab mode, the chassis is integrated for one orbit as a rigid body whose
+// axle centers roll along their steer headings (common longitudinal speed,
+// yaw rate from the lateral difference), independent of the ICR algebra:
+//   diameter   traced by the chassis center vs 2 * turnRadiusMm
+//   ratio      rolled distance left/right driven wheel vs the split (the
+//              travel along the wheel heading; one servo per axle leaves
+//              some sideways slip at the wheels, which no speed can fix)
+//   scrub      inner-wheel speed error with equal PWM (setSpeedBoth)
+// Circle diameters must grow with diam and diam=1 must drive straight.
+// Exit code 1 if diameter or ratio is off by more than --tol-pct (0.5).
+#include "bench.h"
+#include "config.h"
+#include "MotionPlanner.h"
+
+struct Orbit { double diam, distL, distR; };
+
+static Orbit orbit(int ff, int fr) {
+  const double D2R = M_PI / 180.0, L = KIN_WHEELBASE_MM, W = KIN_TRACK_MM;
+  double tf = tan((ff - SERVO_CENTER) * D2R), tr = tan((fr - SERVO_CENTER) * D2R);
+  double u = 1.0, vy = u * (tf + tr) / 2, w = u * (tf - tr) / L;  // body frame, x fwd, y right
+  double xd = KIN_DRIVE_AXLE ? -L / 2 : L / 2;
+  double hd = ((KIN_DRIVE_AXLE ? fr : ff) - SERVO_CENTER) * D2R;  // driven wheel heading (body)
+  const int N = 200000;
+  double dt = 2 * M_PI / fabs(w) / N, px = 0, py = 0, psi = 0, dmax = 0, dl = 0, dr = 0;
+  auto wheel = [&](double side, double& wx, double& wy) {  // contact point in world
+    wx = px + xd * cos(psi) - side * sin(psi);
+    wy = py + xd * sin(psi) + side * cos(psi);
+  };
+  double lx, ly, rx, ry;
+  wheel(-W / 2, lx, ly); wheel(W / 2, rx, ry);
+  for (int i = 0; i < N; ++i) {
+    px += (u * cos(psi) - vy * sin(psi)) * dt;
+    py += (u * sin(psi) + vy * cos(psi)) * dt;
+    psi += w * dt;
+    dmax = std::max(dmax, hypot(px, py));
+    double x, y;
+    double hx = cos(psi + hd), hy = sin(psi + hd);
+    wheel(-W / 2, x, y); dl += (x - lx) * hx + (y - ly) * hy; lx = x; ly = y;
+    wheel( W / 2, x, y); dr += (x - rx) * hx + (y - ry) * hy; rx = x; ry = y;
+  }
+  return Orbit{ dmax, dl, dr };
+}
+
+int benchKin(int argc, char** argv) {
+  double tol = atof(benchArgStr(argc, argv, "--tol-pct", "0.5"));
+  printf("\n== kin: wheelbase %.0f mm, track %.0f mm, driven axle %s ==\n",
+         (double)KIN_WHEELBASE_MM, (double)KIN_TRACK_MM, KIN_DRIVE_AXLE ? "rear" : "front");
+  printf("%-18s %4s %4s %10s %10s %7s %7s %7s %8s %11s\n",
+         "pose", "ff", "fr", "model mm", "orbit mm", "err %", "left", "right", "ratio %", "equal scrub");
+  bool ok = true;
+  double maxD = 0, maxR = 0;
+  auto row = [&](const char* lbl, float x, UIMode mode, float diam, double* outDiam) {
+    int ff, fr, base; float ext; WheelSplit k;
+    planSteering(x, 1.0f, mode, diam, ff, fr, base, ext, k);
+    float R = turnRadiusMm(ff, fr);
+    double kl = k.left / (double)(1 << KIN_Q), kr = k.right / (double)(1 << KIN_Q);
+    if (std::isinf(R)) {
+      bool st = k.left == k.right;
+      ok &= st;
+      printf("%-18s %4d %4d %10s %10s %7s %7.3f %7.3f %8s %11s\n", lbl, ff, fr, "straight", "-", "-", kl, kr,
+             st ? "-" : "UNEQUAL", "0.0%");
+      if (outDiam) *outDiam = INFINITY;
+      return;
+    }
+    Orbit o = orbit(ff, fr);
+    double de = 100.0 * (o.diam - 2 * R) / (2 * R);
+    double want = kl / kr, got = o.distL / o.distR;
+    double re = 100.0 * (want - got) / got;
+    double scrub = 100.0 * (1.0 - std::min(fabs(kl), fabs(kr)) / std::max(fabs(kl), fabs(kr)));
+    maxD = std::max(maxD, fabs(de)); maxR = std::max(maxR, fabs(re));
+    if (fabs(de) > tol || fabs(re) > tol) ok = false;
+    printf("%-18s %4d %4d %10.1f %10.1f %+7.3f %7.3f %7.3f %+8.3f %10.1f%%\n",
+           lbl, ff, fr, 2 * R, o.diam, de, kl, kr, re, scrub);
+    if (outDiam) *outDiam = o.diam;
+  };
+
+  for (int dir = 0; dir < 2; ++dir) {
+    double prev = 0;
+    for (int i = 0; i <= 10; ++i) {
+      char lbl[32]; snprintf(lbl, sizeof(lbl), "circle %s d=%.1f", dir ? "R" : "L", i / 10.0);
+      double d;
+      row(lbl, dir ? 1.0f : -1.0f, MODE_CIRCLE, i / 10.0f, &d);
+      if (!(d > prev)) { printf("  diameter not increasing with diam\n"); ok = false; }
+      prev = d;
+    }
+  }
+  row("normal L full", -1.0f, MODE_NORMAL, 1, nullptr);
+  row("normal R half",  0.5f, MODE_NORMAL, 1, nullptr);
+  row("normal R full",  1.0f, MODE_NORMAL, 1, nullptr);
+  row("crab L full",   -1.0f, MODE_CRAB, 1, nullptr);
+  row("crab R full",    1.0f, MODE_CRAB, 1, nullptr);
+  row("straight",       0.0f, MODE_NORMAL, 1, nullptr);
+  printf("%-18s diameter %.3f%%  ratio %.3f%% (tolerance %g%%): %s\n", "max error", maxD, maxR, tol,
+         ok ? "ok" : "FAILED");
+  return ok ? 0 : 1;
+}
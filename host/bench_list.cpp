@@ -0,0 +1,74 @@
+// /rec/list from the RAM slot catalog. Runs a script of auto-slot and
+// explicit recordings, stops and clears (virtual clock), checks after each
+// step that the served JSON matches a catalog over a slot store freshly
+// mounted from flash, then times --requests list requests and counts
+// SPIFFS opens/reads and flash reads.
+#include "bench.h"
+#include <WebServer.h>
+#include <FS.h>
+#include "config.h"
+#include "SlotStore.h"
+#include "SlotCatalog.h"
+#include <FlashSim.h>
+
+extern WebServer server;
+extern SlotCatalog catalog;
+
+static void drainHttp() { while (server.sim_pending()) loop(); }
+static void get(const char* uri) { server.sim_enqueue(HTTP_GET, uri); drainHttp(); }
+static void run(uint32_t ms) { for (uint32_t i = 0; i < ms; ++i) { loop(); hal::advanceMicros(1000); } }
+
+static bool matchesScan(const char* step) {
+  get("/rec/list");
+  static SlotStore mounted;
+  static SlotCatalog fresh;
+  mounted.begin();
+  fresh.begin(mounted);
+  size_t n;
+  const char* j = fresh.json(n);
+  std::string served = server.sim_lastResponse().body;
+  if (served == std::string(j, n)) return true;
+  printf("%-14s MISMATCH\n  served %s\n  scan   %.*s\n", step, served.c_str(), (int)n, j);
+  return false;
+}
+
+int benchList(int argc, char** argv) {
+  int requests = (int)benchArg(argc, argv, "--requests", 2000);
+  hal::setFsRoot(benchArgStr(argc, argv, "--fs", "bench_fs"));
+  hal::useVirtualClock(true);
+  hal::setTasksEnabled(false);
+  setup();
+
+  bool ok = true;
+  for (int s = 1; s <= REC_SLOTS; ++s) { char q[32]; snprintf(q, sizeof(q), "/rec/clear?slot=%d", s); get(q); }
+  ok &= matchesScan("clear all");
+  for (int i = 0; i < REC_SLOTS + 2; ++i) {        // auto-slot wraps around
+    get("/ctl_servos?x=0.3&y=0"); get("/rec/start"); run(400 + 300 * i); get("/rec/stop");
+    ok &= matchesScan("auto record");
+  }
+  get("/rec/start?slot=2"); run(1200);             // (size on flash lags while recording)
+  get("/rec/stop");
+  ok &= matchesScan("explicit stop");
+  get("/rec/clear?slot=3");
+  ok &= matchesScan("clear");
+  get("/rec/stop");                                 // not recording: no change
+  ok &= matchesScan("stray stop");
+
+  hal::resetCounters();
+  hal::flashResetStats();
+  std::vector<uint64_t> ns;
+  for (int i = 0; i < requests; ++i) {
+    server.sim_enqueue(HTTP_GET, "/rec/list");
+    uint64_t a = benchNowNs();
+    drainHttp();
+    ns.push_back(benchNowNs() - a);
+  }
+  printf("\n== list: %d slots, %d requests ==\n", REC_SLOTS, requests);
+  printf("%-22s %s\n", "catalog vs mount", ok ? "match after every step" : "MISMATCH");
+  printf("%-22s opens %.2f  reads %.2f per request\n", "SPIFFS",
+         (double)hal::counters.fileOpens / requests, (double)hal::counters.fileReads / requests);
+  printf("%-22s reads %.2f per request\n", "flash", (double)hal::flashStats().reads / requests);
+  printf("%-22s %zu bytes\n", "response", server.sim_lastResponse().body.size());
+  benchPrintPercentiles("GET /rec/list (host)", ns, 1000.0, "us");
+  return ok ? 0 : 1;
+}
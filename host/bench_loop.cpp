@@ -0,0 +1,89 @@
+// loop() latency benchmark: scripted joystick traffic through the fake
+// WebServer, virtual clock, per-iteration wall time of loop().
+#include "bench.h"
+#include <WebServer.h>
+#include <SPIFFS.h>
+#include "ServoControl.h"
+#include "WheelControl.h"
+
+extern WebServer server;
+extern ServoControl servoFront, servoRear;
+extern WheelControl wheels;
+
+// Joystick script: 5 s phases cycling manual / normal / crab / circle / sport.
+static void scriptInput(uint32_t ms) {
+  char q[96];
+  float t = ms / 1000.0f;
+  float drive = 0.8f * sinf(t * 0.9f);
+  float steer = sinf(t * 2.3f);
+  int phase = (int)(ms / 5000) % 5;
+
+  snprintf(q, sizeof(q), "/ctl_drive?y=%.3f", drive);
+  server.sim_enqueue(HTTP_GET, q);
+
+  if (phase == 0) {
+    snprintf(q, sizeof(q), "/ctl_servos?x=%.3f&y=%.3f", steer, cosf(t * 1.7f));
+  } else {
+    float diam = 0.5f + 0.5f * sinf(t * 0.3f);
+    snprintf(q, sizeof(q), "/ctl_steer?x=%.3f&y=0&mode=%d&diam=%.2f", steer, (phase >= 3) ? 2 : phase - 1, diam);
+  }
+  server.sim_enqueue(HTTP_GET, q);
+
+  if (ms % 5000 == 0) {
+    server.sim_enqueue(HTTP_GET, phase == 0 ? "/ui/manual_steer?on=1" : "/ui/manual_steer?on=0");
+    server.sim_enqueue(HTTP_GET, phase == 4 ? "/speed?mode=sport" : "/speed?mode=normal");
+  }
+}
+
+int benchLoop(int argc, char** argv) {
+  long iters   = benchArg(argc, argv, "--iters", 200000);
+  long loopUs  = benchArg(argc, argv, "--loop-us", 1000);  // virtual time per loop()
+  long inputHz = benchArg(argc, argv, "--input-hz", 60);   // pointermove rate
+  bool record  = benchFlag(argc, argv, "--record");
+  long writeNs = benchArg(argc, argv, "--write-ns", 2000);  // mean cost of one GPIO/LEDC write on target
+  hal::setFsRoot(benchArgStr(argc, argv, "--fs", "bench_fs"));
+  hal::useVirtualClock(true);
+  hal::setTasksEnabled(false); // control step runs inline via ControlTask::poll()
+
+  setup();
+  if (record) { server.sim_enqueue(HTTP_GET, "/rec/start?slot=1"); while (server.sim_pending()) loop(); }
+  hal::resetCounters();
+  servoFront.resetWriteStats(); servoRear.resetWriteStats(); wheels.resetWriteStats();
+
+  std::vector<uint64_t> lat;
+  lat.reserve((size_t)iters);
+  uint32_t inputPeriodMs = (uint32_t)(1000 / (inputHz > 0 ? inputHz : 1));
+  uint32_t t0 = millis(), nextInput = t0;
+
+  for (long i = 0; i < iters; ++i) {
+    uint32_t now = millis();
+    if ((int32_t)(now - nextInput) >= 0) { scriptInput(now - t0); nextInput += inputPeriodMs; }
+    uint64_t a = benchNowNs();
+    loop();
+    lat.push_back(benchNowNs() - a);
+    hal::advanceMicros((uint64_t)loopUs);
+  }
+  hal::Counters c = hal::counters;
+  WriteStats ws[3] = { servoFront.writeStats(), servoRear.writeStats(), wheels.writeStats() };
+  if (record) { server.sim_enqueue(HTTP_GET, "/rec/stop"); while (server.sim_pending()) loop(); }
+
+  printf("\n== loop: %ld iterations, %ld us virtual period, %ld Hz input%s ==\n",
+         iters, loopUs, inputHz, record ? ", recording" : "");
+  benchPrintPercentiles("loop() latency", lat, 1000.0, "us");
+  printf("%-22s servo %llu (%.2f/iter)  digital %llu (%.2f/iter)  analog %llu (%.2f/iter)\n", "actuator writes",
+         (unsigned long long)c.servoWrites,   (double)c.servoWrites / iters,
+         (unsigned long long)c.digitalWrites, (double)c.digitalWrites / iters,
+         (unsigned long long)c.analogWrites,  (double)c.analogWrites / iters);
+  uint64_t issued = 0, supp = 0;
+  for (const WriteStats& w : ws) { issued += w.issued; supp += w.suppressed; }
+  double secs = iters * (double)loopUs / 1e6;
+  printf("%-22s issued %llu  suppressed %llu (%.1f%%)  servo %u/%u  wheels %u/%u\n", "write suppression",
+         (unsigned long long)issued, (unsigned long long)supp, issued + supp ? 100.0 * supp / (issued + supp) : 0.0,
+         (unsigned)(ws[0].issued + ws[1].issued), (unsigned)(ws[0].suppressed + ws[1].suppressed),
+         (unsigned)ws[2].issued, (unsigned)ws[2].suppressed);
+  printf("%-22s %.0f writes/s avoided = %.2f ms/s CPU at %ld ns/write\n", "freed",
+         supp / secs, supp / secs * writeNs / 1e6, writeNs);
+  printf("%-22s http %llu  file opens %llu  flushes %llu\n", "other",
+         (unsigned long long)c.httpRequests, (unsigned long long)c.fileOpens, (unsigned long long)c.fileFlushes);
+  return 0;
+}
@@ -0,0 +1,56 @@
+// Metrics registry: cost of one Histo::add() and of rendering /metrics,
+// then a short scripted session (real clock, control inline, recording on)
+// and the resulting /metrics text.
+#include "bench.h"
+#include <WebServer.h>
+#include <FS.h>
+#include "Metrics.h"
+
+extern WebServer server;
+
+static volatile uint32_t s_sink;
+static Histo s_h;
+static std::string s_out;
+static void toString(const char* s, size_t n) { s_out.append(s, n); }
+
+int benchMetrics(int argc, char** argv) {
+  long adds  = benchArg(argc, argv, "--adds", 20000000);
+  long iters = benchArg(argc, argv, "--iters", 20000);
+  bool json  = benchFlag(argc, argv, "--json");
+  hal::setFsRoot(benchArgStr(argc, argv, "--fs", "bench_fs"));
+  hal::setTasksEnabled(false);
+
+  uint32_t x = 1;
+  uint64_t t0 = benchNowNs();
+  for (long i = 0; i < adds; ++i) { x = x * 1664525u + 1013904223u; s_h.add(x >> 18); }
+  uint64_t t1 = benchNowNs();
+  s_sink = s_h.count + s_h.b[7] + (uint32_t)s_h.sum;
+
+  setup();
+  server.sim_enqueue(HTTP_GET, "/rec/start?slot=4");
+  for (long i = 0; i < iters; ++i) {
+    if (i % 16 == 0) server.sim_enqueue(HTTP_GET, i % 32 ? "/ctl_drive?y=0.300" : "/ctl_steer?x=0.2&y=0&mode=0&diam=1");
+    loop();
+    delayMicroseconds(200);
+  }
+  server.sim_enqueue(HTTP_GET, "/rec/stop");
+  while (server.sim_pending()) loop();
+
+  uint64_t r0 = benchNowNs();
+  metricsRenderText(toString);
+  uint64_t r1 = benchNowNs();
+  std::string text; text.swap(s_out);
+  metricsRenderJson(toString);
+  uint64_t r2 = benchNowNs();
+  std::string js; js.swap(s_out);
+  server.sim_enqueue(HTTP_GET, "/metrics");
+  loop();
+  bool httpOk = server.sim_lastResponse().code == 200 && server.sim_lastResponse().body.size() > 1000;
+
+  printf("\n== metrics: %s ==\n", METRICS_ENABLED ? "enabled" : "compiled out");
+  printf("%-22s %.2f ns/call\n", "Histo::add", (double)(t1 - t0) / adds);
+  printf("%-22s text %zu B in %.1f us, json %zu B in %.1f us (GET /metrics %s)\n", "render",
+         text.size(), (r1 - r0) / 1e3, js.size(), (r2 - r1) / 1e3, httpOk ? "ok" : "FAILED");
+  printf("%s\n", json ? js.c_str() : text.c_str());
+  return 0;
+}
@@ -0,0 +1,105 @@
+// planSteering / applySpeedScaling: table + integer fast path vs the float
+// reference. Exhaustive equivalence over a fine input grid (steer/diam in
+// 1/2000 steps incl. out-of-range values, every base PWM and speed mode,
+// plus unknown modes),
+// then per-call cost of both. Exit code 1 if any output is off by more
+// than 1 deg / 1 PWM, or a table wheel split differs from wheelSplitRef
+// for the same angles.
+#include "bench.h"
+#include "MotionPlanner.h"
+#include "Speed.h"
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+static inline uint64_t cycles() { return __rdtsc(); }
+#else
+static inline uint64_t cycles() { return 0; }
+#endif
+
+static volatile int s_sink;
+
+static int checkPlanner(int steps) {
+  int maxDf = 0, maxDr = 0, maxDk = 0, baseMis = 0, bad = 0;
+  float maxDe = 0;
+  long n = 0;
+  for (int m = 0; m < 3; ++m) {
+    for (int i = -steps - 20; i <= steps + 20; ++i) {     // x (and diam) incl. beyond +-1
+      float v = (float)i / steps;
+      for (int j = -4; j <= 4; ++j) {
+        float y = j / 4.0f;
+        float x = v, diam = (v + 1.0f) * 0.5f;
+        int f0, r0, b0, f1, r1, b1; float e0, e1; WheelSplit k0, k1;
+        planSteeringRef(x, y, (UIMode)m, diam, f0, r0, b0, e0, k0);
+        planSteeringLut(x, y, (UIMode)m, diam, f1, r1, b1, e1, k1);
+        int df = abs(f0 - f1), dr = abs(r0 - r1);
+        // split must be the model's for the angles actually produced
+        WheelSplit k = wheelSplitRef(f1, r1);
+        maxDk = std::max(maxDk, std::max(abs(k.left - k1.left), abs(k.right - k1.right)));
+        if (k.left != k1.left || k.right != k1.right) bad++;
+        maxDf = std::max(maxDf, df); maxDr = std::max(maxDr, dr);
+        maxDe = std::max(maxDe, fabsf(e0 - e1));
+        if (b0 != b1) baseMis++;
+        if (df > 1 || dr > 1 || b0 != b1) bad++;
+        n++;
+      }
+    }
+  }
+  printf("planSteering           %ld inputs  max |dff| %d deg  max |dfr| %d deg  max |dextent| %.4f  base mismatches %d  violations %d\n",
+         n, maxDf, maxDr, maxDe, baseMis, bad);
+  printf("  wheel split table      max |dk| vs model %d (Q%d)\n", maxDk, KIN_Q);
+  return bad;
+}
+
+static int checkSpeed(int steps) {
+  int maxD = 0, bad = 0;
+  long n = 0;
+  for (int m : { (int)SPEED_LOW, (int)SPEED_NORMAL, (int)SPEED_SPORT, 3, 255 }) {  // and two unknown modes
+    for (int b = -300; b <= 300; ++b) {
+      for (int i = -10; i <= steps + 10; ++i) {
+        float e = (float)i / steps;
+        int d = abs(applySpeedScalingRef(b, e, (SpeedMode)m) - applySpeedScalingInt(b, e, (SpeedMode)m));
+        maxD = std::max(maxD, d);
+        if (d > 1) bad++;
+        n++;
+      }
+    }
+  }
+  printf("applySpeedScaling      %ld inputs  max |dpwm| %d  violations %d\n", n, maxD, bad);
+  return bad;
+}
+
+typedef void (*PlanFn)(float, float, UIMode, float, int&, int&, int&, float&, WheelSplit&);
+typedef int (*ScaleFn)(int, float, SpeedMode);
+
+static void timePlan(const char* label, PlanFn plan, ScaleFn scale, const std::vector<float>& in, int reps) {
+  uint64_t t0 = benchNowNs(), c0 = cycles();
+  int acc = 0;
+  for (int r = 0; r < reps; ++r) {
+    for (size_t i = 0; i + 2 < in.size(); i += 3) {
+      int ff, fr, base; float ext; WheelSplit k;
+      plan(in[i], in[i + 1], (UIMode)(i % 3), in[i + 2], ff, fr, base, ext, k);
+      int pwm = scale(base, ext, SPEED_NORMAL);
+      acc += ff + fr + wheelSplitApply(pwm, k.left) + wheelSplitApply(pwm, k.right);
+    }
+  }
+  uint64_t c1 = cycles(), t1 = benchNowNs();
+  s_sink = acc;
+  double calls = (double)reps * (in.size() / 3);
+  printf("%-22s %7.2f ns/call  %7.1f cycles/call (host TSC)\n", label, (t1 - t0) / calls, (c1 - c0) / calls);
+}
+
+int benchPlan(int argc, char** argv) {
+  int steps = (int)benchArg(argc, argv, "--steps", 2000);
+  int reps  = (int)benchArg(argc, argv, "--reps", 200);
+
+  printf("\n== plan: LUT/integer vs float reference (PLANNER_USE_LUT=%d) ==\n", PLANNER_USE_LUT);
+  int bad = checkPlanner(steps) + checkSpeed(steps / 4);
+
+  // Joystick-like inputs; same sequence for both
+  std::vector<float> in(3 * 4096);
+  uint32_t s = 12345;
+  for (float& v : in) { s = s * 1664525u + 1013904223u; v = (int32_t)s / 2147483648.0f; }
+  for (size_t i = 2; i < in.size(); i += 3) in[i] = fabsf(in[i]);
+  timePlan("float reference", planSteeringRef, applySpeedScalingRef, in, reps);
+  timePlan("table + integer", planSteeringLut, applySpeedScalingInt, in, reps);
+  return bad ? 1 : 0;
+}
@@ -0,0 +1,94 @@
+// Playback smoothness: records an 8 s manual-steer sine (0.2 Hz, +-25 deg
+// front servo) at 20 Hz, then replays it at several rates and samples the
+// front servo pulse every control tick. Reports the RMS deviation from the
+// ideal sine at the playhead (stepwise 20 Hz playback is off by up to one
+// sample interval's worth of motion), the longest run of ticks without
+// servo motion and the largest per-tick step (first 250 ms, the slew to
+// the take's start, excluded). Also checks wall duration per rate, a start
+// offset, reverse and looping. Recorded angles are whole degrees, so some
+// holds near the sine peaks are expected.
+#include "bench.h"
+#include <WebServer.h>
+#include <FS.h>
+#include "config.h"
+#include "Recorder.h"
+
+extern WebServer server;
+extern Recorder recorder;
+
+static void drainHttp() { while (server.sim_pending()) loop(); }
+static void get(const char* uri) { server.sim_enqueue(HTTP_GET, uri); drainHttp(); }
+
+static float frontDeg() {
+  return (hal::pinDuty[SERVO_FRONT_PIN] - SERVO_MIN_US) * 180.0f / (SERVO_MAX_US - SERVO_MIN_US);
+}
+
+// Runs loop() in 1 ms steps until playback ends (or maxMs); returns wall ms
+struct PlayStats { int longestHold = 0; float maxStep = 0; double sumSq = 0; long n = 0; };
+
+static float idealDeg(float takeMs) { return SERVO_CENTER + 0.5f * (FF_MAX - SERVO_CENTER) * sinf(2.0f * (float)M_PI * 0.2f * takeMs / 1000.0f); }
+
+// rate > 0: forward playback from 0, accumulate deviation from idealDeg
+static uint32_t playAndMeasure(const char* uri, uint32_t maxMs, PlayStats& ps, float rate = 0, uint32_t measureMs = 0) {
+  const uint32_t tickUs = 1000000u / CONTROL_RATE_HZ;
+  server.sim_enqueue(HTTP_GET, uri);
+  drainHttp();
+  uint32_t t0 = millis(), lastTick = micros();
+  float last = frontDeg();
+  int hold = 0;
+  ps = PlayStats();
+  for (;;) {
+    loop();
+    hal::advanceMicros(1000);
+    uint32_t el = millis() - t0;
+    if (micros() - lastTick >= tickUs) {
+      lastTick += tickUs;
+      float d = frontDeg(), step = fabsf(d - last);
+      last = d;
+      if (el >= 250) {
+        ps.maxStep = std::max(ps.maxStep, step);
+        if (step == 0) ps.longestHold = std::max(ps.longestHold, ++hold); else hold = 0;
+        if (rate > 0) { float e = d - idealDeg(el * rate); ps.sumSq += e * e; ps.n++; }
+      }
+    }
+    if (measureMs && el >= measureMs) { get("/rec/abort"); return el; }
+    if (el >= maxMs || recorder.state() != REC_PLAYING) return el;
+  }
+}
+
+int benchPlay(int argc, char** argv) {
+  long takeMs = benchArg(argc, argv, "--take-ms", 8000);
+  hal::setFsRoot(benchArgStr(argc, argv, "--fs", "bench_fs"));
+  hal::useVirtualClock(true);
+  hal::setTasksEnabled(false);
+
+  setup();
+  get("/ui/manual_steer?on=1");
+  get("/rec/clear?slot=5");
+  get("/rec/start?slot=5");
+  for (uint32_t t = 0; t < (uint32_t)takeMs; t += 5) {
+    char q[64];
+    snprintf(q, sizeof(q), "/ctl_servos?x=%.4f&y=0", 0.5f * sinf(2.0f * (float)M_PI * 0.2f * t / 1000.0f));
+    server.sim_enqueue(HTTP_GET, q);
+    for (int i = 0; i < 5; ++i) { loop(); hal::advanceMicros(1000); }
+  }
+  get("/rec/stop");
+
+  printf("\n== play: %ld ms take, 20 Hz samples, control %d Hz ==\n", takeMs, CONTROL_RATE_HZ);
+  static const char* RATES[] = { "0.25", "0.5", "1", "2", "4" };
+  PlayStats ps;
+  for (const char* r : RATES) {
+    char uri[80];
+    snprintf(uri, sizeof(uri), "/rec/play?slot=5&dir=f&rate=%s", r);
+    uint32_t wall = playAndMeasure(uri, (uint32_t)takeMs * 5, ps, (float)atof(r));
+    printf("rate %-5s wall %6u ms (take/rate %6.0f)  rms dev %5.2f deg  longest hold %3d ticks  max step %5.2f deg/tick\n",
+           r, (unsigned)wall, takeMs / atof(r), ps.n ? sqrt(ps.sumSq / ps.n) : 0.0, ps.longestHold, ps.maxStep);
+  }
+  uint32_t wall = playAndMeasure("/rec/play?slot=5&dir=f&rate=1&from=6000", (uint32_t)takeMs * 2, ps);
+  printf("from=6000 wall %6u ms (expect ~%ld)\n", (unsigned)wall, takeMs - 6000);
+  wall = playAndMeasure("/rec/play?slot=5&dir=r&rate=0.5&from=4000", (uint32_t)takeMs * 2, ps);
+  printf("reverse from=4000 @0.5x wall %6u ms (expect ~8000)\n", (unsigned)wall);
+  wall = playAndMeasure("/rec/play?slot=5&dir=f&rate=4&loop=1", (uint32_t)takeMs * 2, ps, 0, (uint32_t)takeMs);
+  printf("loop @4x  still playing after %u ms (%.1f passes)\n", (unsigned)wall, wall * 4.0 / takeMs);
+  return 0;
+}
@@ -0,0 +1,104 @@
+// Supply current under the power governor. The firmware runs against the
+// actuator plants (hal/MotorSim.h: two MG995-class servos, two gearmotors
+// on a shared 6 V rail), virtual clock, control inline. Rail current =
+// POWER_BASE_MA + servo plant currents + |motor winding currents|.
+//   launch    manual steer: both servos full swing + wheels 0 -> full (sport)
+//   reverse   at speed: wheels full forward -> full reverse + servos swing back
+//   steer     both servos full swing, wheels stopped
+// Each runs with the governor "off" (unlimited budget and ramps) and on;
+// reports plant peak and time over budget, the governor's own estimate,
+// settle times and the throttling counters. --budget overrides
+// POWER_BUDGET_MA, --accel/--jerk the wheel ramp.
+#include "bench.h"
+#include <WebServer.h>
+#include <FS.h>
+#include <MotorSim.h>
+#include "config.h"
+#include "PowerGovernor.h"
+
+extern WebServer server;
+extern PowerGovernor gov;
+
+static void get(const char* uri) { server.sim_enqueue(HTTP_GET, uri); while (server.sim_pending()) loop(); }
+
+static float argF(int argc, char** argv, const char* name, float def) {
+  const char* s = benchArgStr(argc, argv, name, nullptr);
+  return s ? (float)atof(s) : def;
+}
+
+struct Trace { float peak = 0, servoPk = 0, motorPk = 0; uint32_t overMs = 0, servoMs = 0, wheelMs = 0; };
+
+// Runs ms and records the rail; servo settle = last ms a plant is > 1 deg
+// off its final pulse angle, wheel settle = last ms below 90% of final speed
+static Trace record(uint32_t ms, float budget) {
+  std::vector<float> sd[2], wl;
+  Trace t;
+  for (uint32_t i = 0; i < ms; ++i) {
+    loop();
+    hal::advanceMicros(1000);
+    float sv = hal::servoPlantMa(0) + hal::servoPlantMa(1);
+    float mo = 1000.0f * (fabsf(hal::motorCurrentA(0)) + fabsf(hal::motorCurrentA(1)));
+    float ma = POWER_BASE_MA + sv + mo;
+    if (ma > t.peak) { t.peak = ma; t.servoPk = sv; t.motorPk = mo; }
+    if (ma > budget) t.overMs++;
+    sd[0].push_back(hal::servoPlantDeg(0)); sd[1].push_back(hal::servoPlantDeg(1));
+    wl.push_back(fabsf(hal::motorSpeed(0)) + fabsf(hal::motorSpeed(1)));
+  }
+  for (int s = 0; s < 2; ++s)
+    for (uint32_t i = 0; i < ms; ++i) if (fabsf(sd[s][i] - sd[s].back()) > 1.0f) t.servoMs = std::max(t.servoMs, i + 1);
+  for (uint32_t i = 0; i < ms; ++i) if (wl[i] < 0.9f * wl.back()) t.wheelMs = i + 1;
+  return t;
+}
+
+int benchPower(int argc, char** argv) {
+  float budget = argF(argc, argv, "--budget", POWER_BUDGET_MA);
+  float accel = argF(argc, argv, "--accel", WHEEL_ACCEL_DUTY_S), jerk = argF(argc, argv, "--jerk", WHEEL_JERK_DUTY_S2);
+  hal::setFsRoot(benchArgStr(argc, argv, "--fs", "bench_fs"));
+  hal::useVirtualClock(true);
+  hal::setTasksEnabled(false);
+  hal::motorsReset();
+  setup();
+  hal::motorAttach(L298_IN1, L298_IN2, L298_ENA, WHEEL_ENC_LA, WHEEL_ENC_LB, WHEEL_PWM_BITS);
+  hal::motorAttach(L298_IN3, L298_IN4, L298_ENB, WHEEL_ENC_RA, WHEEL_ENC_RB, WHEEL_PWM_BITS);
+  hal::servoPlantAttach(SERVO_FRONT_PIN, SERVO_MIN_US, SERVO_MAX_US);
+  hal::servoPlantAttach(SERVO_REAR_PIN, SERVO_MIN_US, SERVO_MAX_US);
+  hal::motorSetVbat(6.0f);
+  get("/speed?mode=sport");
+  get("/ui/manual_steer?on=1");
+
+  PowerModel on{ POWER_BASE_MA, POWER_SERVO_IDLE_MA, POWER_SERVO_MA_PER_DEGS, POWER_SERVO_MA_PER_DEGS2,
+                 POWER_SERVO_RESERVE_MA, POWER_MOTOR_STALL_MA, POWER_MOTOR_TAU_MS, POWER_MOTOR_RUN_MA, budget };
+  PowerModel off = on; off.budgetMa = 1e9f;
+
+  struct Step { const char* label; const char* pre[2]; const char* go[2]; };
+  static const Step STEPS[] = {
+    { "launch",  { "/ctl_drive?y=0", "/ctl_servos?x=0&y=0" },  { "/ctl_servos?x=1&y=-1", "/ctl_drive?y=1" } },
+    { "reverse", { "/ctl_drive?y=1", "/ctl_servos?x=1&y=-1" }, { "/ctl_servos?x=-1&y=1", "/ctl_drive?y=-1" } },
+    { "steer",   { "/ctl_drive?y=0", "/ctl_servos?x=1&y=-1" }, { "/ctl_servos?x=-1&y=1", nullptr } },
+  };
+  printf("\n== power: budget %.0f mA, wheel ramp %.0f duty/s, jerk %.0f duty/s^2, 6 V rail ==\n", budget, accel, jerk);
+  printf("%-8s %-4s %9s %13s %8s %9s %8s %8s %7s %7s %7s %7s\n", "", "gov", "peak mA", "(servo/motor)", "over ms", "model mA",
+         "servo ms", "wheel ms", "ramped", "budget", "throt", "held");
+  bool ok = true;
+  for (const Step& s : STEPS) {
+    for (int g = 0; g < 2; ++g) {
+      gov.configure(off, 1e9f, 1e12f);
+      for (const char* u : s.pre) get(u);
+      for (int i = 0; i < 2500; ++i) { loop(); hal::advanceMicros(1000); }
+      if (g) gov.configure(on, accel, jerk);
+      gov.resetStats();
+      for (const char* u : s.go) if (u) get(u);
+      Trace t = record(2500, budget);
+      const GovStats& st = gov.stats();
+      printf("%-8s %-4s %9.0f %6.0f/%6.0f %8u %9u %8u %8u %7u %7u %7u %7u\n", s.label, g ? "on" : "off", t.peak,
+             t.servoPk, t.motorPk, (unsigned)t.overMs,
+             (unsigned)st.peakMa, (unsigned)t.servoMs, (unsigned)t.wheelMs, (unsigned)st.wheelRamped,
+             (unsigned)st.wheelBudget, (unsigned)st.servoThrottled, (unsigned)st.servoHeld);
+      if (g && t.overMs > 0) ok = false;
+    }
+  }
+  get("/ctl_drive?y=0");
+  gov.configure(on, accel, jerk);
+  printf("%-8s %s\n", "result", ok ? "plant under budget with the governor" : "OVER BUDGET with the governor");
+  return ok ? 0 : 1;
+}
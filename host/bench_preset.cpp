@@ -0,0 +1,178 @@
+// Motion presets (Preset.h). Two parts:
+//   stream    each preset is compiled and run through PresetRunner at the
+//             control period (servos taken as settled); the frames are
+//             integrated with the speed model into distance, sweep angle
+//             and run time and checked against the request (--tol-pct, 2),
+//             plus drive continuity (largest per-tick change vs the ramp),
+//             zero drive at both ends and a constant steering pose
+//   firmware  GET /preset on the full firmware (virtual clock, control
+//             inline, servo and motor plants attached): time from request
+//             to idle, servo settle before the wheels roll, wheel duty
+//             seen at the driver pins, /preset/stop easing out
+// Also: compile errors for impossible radii, tick cost, runner state size.
+#include "bench.h"
+#include <WebServer.h>
+#include <FS.h>
+#include <MotorSim.h>
+#include "config.h"
+#include "Preset.h"
+#include "MotionPlanner.h"
+
+extern WebServer server;
+
+static void get(const char* uri) { server.sim_enqueue(HTTP_GET, uri); while (server.sim_pending()) loop(); }
+
+static std::vector<RecFrame> s_frames;
+static void capture(const RecFrame& f) { s_frames.push_back(f); }
+
+struct Case { const char* label; PresetSpec s; uint32_t stopAtMs; };
+
+static PresetSpec spec(uint8_t type, float dist, float radius, float angle, uint32_t dur = 0) {
+  PresetSpec s; s.type = type; s.distMm = dist; s.radiusMm = radius; s.angleDeg = angle; s.durMs = dur;
+  return s;
+}
+
+int benchPreset(int argc, char** argv) {
+  double tol = atof(benchArgStr(argc, argv, "--tol-pct", "2"));
+  const uint32_t dt = 1000 / CONTROL_RATE_HZ;
+  bool ok = true;
+
+  std::vector<Case> cases;
+  cases.push_back({ "straight 1 m",      spec(PRESET_STRAIGHT, 1000, 0, 0), 0 });
+  { Case c{ "dolly crab 0.5", spec(PRESET_STRAIGHT, 600, 0, 0), 0 }; c.s.crab = 0.5f; cases.push_back(c); }
+  { Case c{ "straight 3 s rev", spec(PRESET_STRAIGHT, 0, 0, 0, 3000), 0 }; c.s.reverse = true; cases.push_back(c); }
+  { Case c{ "short 100 mm", spec(PRESET_STRAIGHT, 100, 0, 0), 0 }; c.s.ease = EASE_LINEAR; cases.push_back(c); }
+  cases.push_back({ "arc R1000 90",      spec(PRESET_ARC, 0, 1000, 90), 0 });
+  { Case c{ "arc L600 180 fast", spec(PRESET_ARC, 0, 600, 180), 0 }; c.s.left = true; c.s.speedMmS = 500; cases.push_back(c); }
+  cases.push_back({ "orbit R800 360",    spec(PRESET_ORBIT, 0, 800, 360), 0 });
+  { Case c{ "orbit L1500 no ease", spec(PRESET_ORBIT, 0, 1500, 120), 0 }; c.s.left = true; c.s.ease = EASE_NONE; cases.push_back(c); }
+  cases.push_back({ "orbit endless+stop", spec(PRESET_ORBIT, 0, 800, 0), 3000 });
+
+  printf("\n== preset stream: %u ms ticks, speed model %.0f mm/s at full PWM ==\n", (unsigned)dt, (double)PRESET_MM_S_FULL);
+  printf("%-20s %8s %8s %8s %8s %9s %9s %8s %8s %7s %s\n", "preset", "R mm", "v mm/s", "plan ms", "run ms",
+         "plan mm", "got mm", "sweep", "err %", "max dy", "ends/pose");
+  PresetRunner run;
+  uint64_t tickNs = 0, ticks = 0;
+  for (const Case& c : cases) {
+    PresetPlan p;
+    char err[64];
+    if (!presetCompile(c.s, p, err, sizeof(err))) { printf("%-20s compile failed: %s\n", c.label, err); ok = false; continue; }
+    s_frames.clear();
+    uint32_t now = 1000, runStart = 0, runEnd = 0;
+    run.start(p);
+    bool stopped = false;
+    for (int i = 0; i < 100000; ++i, now += dt) {
+      if (c.stopAtMs && !stopped && run.phase() == PRESET_RUN && run.elapsedMs() >= c.stopAtMs) { run.stop(); stopped = true; }
+      uint64_t t0 = benchNowNs();
+      bool on = run.tick(now, true, capture);
+      tickNs += benchNowNs() - t0; ticks++;
+      if (!on) break;
+      if (!runStart && run.phase() == PRESET_RUN) runStart = now;
+      if (run.phase() == PRESET_IDLE) { runEnd = now; break; }
+    }
+    // distance: each frame holds for one tick
+    double dist = 0, maxDy = 0;
+    bool pose = true;
+    for (size_t i = 0; i < s_frames.size(); ++i) {
+      const RecFrame& f = s_frames[i];
+      dist += fabs(presetFrameSpeedMmS(f)) * dt * 1e-3;
+      if (i) maxDy = std::max(maxDy, (double)fabsf(f.y - s_frames[i - 1].y));
+      pose &= f.mode == p.pose.mode && f.x == p.pose.x && f.diam == p.pose.diam && f.speed == p.pose.speed
+           && (f.y == 0 || (f.y > 0) == (p.pose.y > 0));
+    }
+    bool ends = !s_frames.empty() && s_frames.front().y == 0 && s_frames.back().y == 0;
+    uint32_t ranMs = runEnd - runStart;
+    double want = c.stopAtMs ? 0 : p.distMm;
+    double e = want > 0 ? 100.0 * (dist - want) / want : 0;
+    // ramps: a per-tick step of cruise * dt / ramp (x1.5 at the smoothstep midpoint)
+    double dyLimit = p.rampMs ? fabs(p.pose.y) * dt / p.rampMs * 1.5 + 1e-6 : fabs(p.pose.y);
+    bool good = ends && pose && fabs(e) <= tol && maxDy <= dyLimit;
+    if (p.runMs && !c.stopAtMs) good &= ranMs + dt >= p.runMs && ranMs <= p.runMs + dt;
+    if (c.stopAtMs) good &= ranMs >= c.stopAtMs && ranMs <= c.stopAtMs + p.rampMs + 2 * dt;
+    char sweep[16] = "-";
+    if (!std::isinf(p.radiusMm)) snprintf(sweep, sizeof(sweep), "%.1f", dist / p.radiusMm * 180.0 / M_PI);
+    printf("%-20s %8.0f %8.1f %8u %8u %9.0f %9.1f %8s %+8.2f %7.4f %s%s\n", c.label,
+           std::isinf(p.radiusMm) ? 0.0 : (double)p.radiusMm, (double)p.speedMmS, (unsigned)p.runMs, (unsigned)ranMs,
+           (double)p.distMm, dist, sweep, e, maxDy, ends ? "0/0 " : "NONZERO ", pose ? "const" : "CHANGED");
+    if (!good) { printf("  ^ FAILED\n"); ok = false; }
+  }
+  printf("%-20s %.0f ns/tick over %llu ticks, runner state %zu B\n", "cost", (double)tickNs / ticks,
+         (unsigned long long)ticks, sizeof(PresetRunner));
+
+  // Requests the planner cannot meet
+  const struct { const char* label; PresetSpec s; } BAD[] = {
+    { "arc R 50",        spec(PRESET_ARC, 0, 50, 90) },
+    { "orbit R 1e6",     spec(PRESET_ORBIT, 0, 1e6f, 90) },
+    { "arc no radius",   spec(PRESET_ARC, 0, 0, 90) },
+    { "straight no len", spec(PRESET_STRAIGHT, 0, 0, 0) },
+  };
+  for (const auto& b : BAD) {
+    PresetPlan p; char err[64];
+    bool c = presetCompile(b.s, p, err, sizeof(err));
+    printf("%-20s %s\n", b.label, c ? "ACCEPTED" : err);
+    if (c) ok = false;
+  }
+
+  // ---- Firmware end to end ----
+  hal::setFsRoot(benchArgStr(argc, argv, "--fs", "bench_fs"));
+  hal::useVirtualClock(true);
+  hal::setTasksEnabled(false);
+  hal::motorsReset();
+  setup();
+  hal::motorAttach(L298_IN1, L298_IN2, L298_ENA, WHEEL_ENC_LA, WHEEL_ENC_LB, WHEEL_PWM_BITS);
+  hal::motorAttach(L298_IN3, L298_IN4, L298_ENB, WHEEL_ENC_RA, WHEEL_ENC_RB, WHEEL_PWM_BITS);
+  hal::servoPlantAttach(SERVO_FRONT_PIN, SERVO_MIN_US, SERVO_MAX_US);
+  hal::servoPlantAttach(SERVO_REAR_PIN, SERVO_MIN_US, SERVO_MAX_US);
+  hal::motorSetVbat(6.0f);
+  get("/ui/manual_steer?on=0");
+  for (int i = 0; i < 1500; ++i) { loop(); hal::advanceMicros(1000); }
+
+  printf("\n== preset firmware: virtual clock, control inline, servo + motor plants ==\n");
+  printf("%-34s %8s %8s %9s %9s %9s %8s %s\n", "request", "plan ms", "total ms", "settle ms", "roll ms", "peak duty",
+         "end duty", "status");
+  const struct { const char* uri; uint32_t stopAtMs; } E2E[] = {
+    { "/preset?type=arc&radius_mm=800&angle_deg=90&dir=right", 0 },
+    { "/preset?type=orbit&radius_mm=1200&turns=0.25&dir=left", 0 },
+    { "/preset?type=straight&dist_mm=500&crab=-0.4&ease=linear", 0 },
+    { "/preset?type=orbit&radius_mm=800", 2500 },
+  };
+  for (const auto& r : E2E) {
+    get(r.uri);
+    SimHttpResponse res = server.sim_lastResponse();
+    if (res.code != 200) { printf("%-34.34s HTTP %d %s\n", r.uri + 8, res.code, res.body.c_str()); ok = false; continue; }
+    unsigned planMs = 0;
+    const char* k = strstr(res.body.c_str(), "\"run_ms\":");
+    if (k) planMs = (unsigned)strtoul(k + 9, nullptr, 10);
+    uint32_t ms = 0, rollMs = 0, settleMs = 0, peak = 0;
+    float deg[2] = { hal::servoPlantDeg(0), hal::servoPlantDeg(1) };
+    bool stopped = false;
+    for (; ms < 60000; ++ms) {
+      loop(); hal::advanceMicros(1000);
+      uint32_t duty = (uint32_t)std::max(hal::pinDuty[L298_ENA], hal::pinDuty[L298_ENB]);
+      peak = std::max(peak, duty);
+      if (!rollMs && duty > 0) rollMs = ms;
+      for (int s = 0; s < 2; ++s) {  // last servo horn motion before the wheels roll
+        float d = hal::servoPlantDeg(s);
+        if (!rollMs && fabsf(d - deg[s]) > 0.05f) settleMs = ms + 1;
+        deg[s] = d;
+      }
+      if (r.stopAtMs && !stopped && ms >= r.stopAtMs) { get("/preset/stop"); stopped = true; }
+      if (ms % 50 == 0 && ms > 100) {
+        get("/preset/status");
+        if (strstr(server.sim_lastResponse().body.c_str(), "\"idle\"")) break;
+      }
+    }
+    for (int i = 0; i < 500; ++i) { loop(); hal::advanceMicros(1000); }  // wheel ramp-down
+    uint32_t endDuty = (uint32_t)std::max(hal::pinDuty[L298_ENA], hal::pinDuty[L298_ENB]);
+    bool good = rollMs > 0 && settleMs <= rollMs && endDuty == 0 && ms < 60000;
+    if (!r.stopAtMs) good &= ms <= planMs + PRESET_SETTLE_MAX_MS + 100;
+    printf("%-34.34s %8u %8u %9u %9u %9u %8u %s\n", r.uri + 8, planMs, (unsigned)ms, (unsigned)settleMs,
+           (unsigned)(ms - rollMs), (unsigned)peak, (unsigned)endDuty, good ? "ok" : "FAILED");
+    ok &= good;
+  }
+  get("/preset?type=arc&radius_mm=5");
+  printf("%-34s HTTP %d %s\n", "arc radius_mm=5", server.sim_lastResponse().code, server.sim_lastResponse().body.c_str());
+  ok &= server.sim_lastResponse().code == 400;
+  printf("%-20s %s\n", "result", ok ? "ok" : "FAILED");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,96 @@
+// Recording under slow flash. Real clock, control task as a real thread;
+// this thread plays loopTask and serves a joystick stream while every
+// sector erase costs --erase-us and every page program --page-us (ESP32
+// NOR timings by default). Frames are captured by the control step and
+// committed to the slot store by Recorder::service(), so a slow erase
+// should delay the commit (lag) but neither the control period nor the
+// sample times.
+#include "bench.h"
+#include <WebServer.h>
+#include <FS.h>
+#include <FlashSim.h>
+#include "ControlTask.h"
+#include "Recorder.h"
+#include "SlotStore.h"
+#include <thread>
+
+extern WebServer server;
+extern ControlTask ctl;
+extern Recorder recorder;
+extern SlotStore store;
+
+static void get(const char* uri) { server.sim_enqueue(HTTP_GET, uri); while (server.sim_pending()) loop(); }
+
+int benchRec(int argc, char** argv) {
+  long seconds = benchArg(argc, argv, "--seconds", 5);
+  long eraseUs = benchArg(argc, argv, "--erase-us", 45000);
+  long pageUs = benchArg(argc, argv, "--page-us", 700);
+  hal::setFsRoot(benchArgStr(argc, argv, "--fs", "bench_fs"));
+  hal::setTasksEnabled(true);
+
+  setup();
+  if (!ctl.running()) { fprintf(stderr, "control task did not start\n"); return 1; }
+  get("/ui/manual_steer?on=1");
+  get("/rec/clear?slot=5");
+  hal::flashSetCostUs((uint32_t)eraseUs, (uint32_t)pageUs);
+  delay(20);
+  ctl.resetStats();
+
+  get("/rec/start?slot=5");
+  std::vector<uint64_t> loopNs;
+  uint32_t t0 = millis(), nextInput = t0;
+  while (millis() - t0 < (uint32_t)(seconds * 1000)) {
+    uint32_t now = millis();
+    if ((int32_t)(now - nextInput) >= 0) {
+      char q[64];
+      snprintf(q, sizeof(q), "/ctl_servos?x=%.3f&y=0.000", 0.5f * sinf(now / 500.0f));
+      server.sim_enqueue(HTTP_GET, q);
+      nextInput += 16;
+    }
+    uint64_t a = benchNowNs();
+    loop();
+    loopNs.push_back(benchNowNs() - a);
+    std::this_thread::yield();
+  }
+  get("/rec/stop");
+  ControlStats st = ctl.stats();
+  ctl.stop();
+  hal::flashSetCostUs(0, 0);
+
+  // Sample spacing as written to flash
+  const SlotMeta& m = store.meta(5);
+  uint32_t frames = 0, badBlocks = 0, prevT = 0, sampleMs = m.sampleMs ? m.sampleMs : 50;
+  std::vector<uint64_t> dtDev;
+  if (m.state == SLOT_DONE) {
+    uint8_t blk[REC_BLOCK_BYTES];
+    for (uint32_t b = 0; b < m.blocks && store.readBlock(5, b, blk); ++b) {
+      if (!recBlockValid(blk)) { badBlocks++; continue; }
+      RecPacked dec[REC_BLOCK_MAX_FRAMES];
+      int n = recDecodeBlock(blk, m.version, m.sampleMs, dec, REC_BLOCK_MAX_FRAMES);
+      if (n <= 0) { badBlocks++; continue; }
+      for (int i = 0; i < n; ++i) {
+        RecFrame fr;
+        recUnpack(dec[i], ((const RecBlockHeader*)blk)->t0, fr);
+        if (frames++) dtDev.push_back((uint64_t)abs((int)(fr.t - prevT) - (int)sampleMs));
+        prevT = fr.t;
+      }
+    }
+  }
+  uint32_t metaFrames = m.frames, metaDur = m.lastT;
+
+  printf("\n== rec: %ld s recording, flash erase %ld us / page %ld us, ring %u frames ==\n",
+         seconds, eraseUs, pageUs, (unsigned)REC_RING_FRAMES);
+  printf("%-22s %u on flash (meta %u, %u ms), expected ~%lu, bad blocks %u\n", "frames",
+         (unsigned)frames, (unsigned)metaFrames, (unsigned)metaDur,
+         (unsigned long)(seconds * 1000 / sampleMs), (unsigned)badBlocks);
+  printf("%-22s overflows %u  high water %u  blocks %u\n", "capture ring",
+         (unsigned)recorder.ringOverflows(), (unsigned)recorder.ringHighWater(), (unsigned)recorder.blocksCommitted());
+  printf("%-22s last %u ms  max %u ms\n", "commit lag", (unsigned)recorder.commitLagMs(), (unsigned)recorder.commitLagMaxMs());
+  printf("%-22s cycles %u  overruns %u  max jitter %u us  max exec %u us\n", "control task",
+         (unsigned)st.cycles, (unsigned)st.overruns, (unsigned)st.maxJitterUs, (unsigned)st.maxExecUs);
+  printf("%-22s %u sync (in the commit path) of %u\n", "sector erases",
+         (unsigned)store.stats().syncErases, (unsigned)store.stats().erases);
+  benchPrintPercentiles("sample dt - nominal", dtDev, 1.0, "ms");
+  benchPrintPercentiles("loop() (writer side)", loopNs, 1000.0, "us");
+  return (metaFrames == frames && !badBlocks) ? 0 : 1;
+}
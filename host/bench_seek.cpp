@@ -0,0 +1,82 @@
+// Playback start and seek cost vs take length. Writes continuously
+// changing (sine) takes of increasing length to slot 5 of the slot store
+// (up to its capacity), then times Recorder::startPlayback / seek and
+// counts flash reads:
+//   play @0      forward start from the top
+//   play @mid    forward start in the middle (binary search over blocks)
+//   reverse      reverse start from the tail (length from the slot table)
+//   seek         random Recorder::seek() while playing (mean of --seeks)
+// Blocks are fixed size, so reads per start/seek grow with log2(blocks) only.
+#include "bench.h"
+#include <FS.h>
+#include <FlashSim.h>
+#include "config.h"
+#include "Recorder.h"
+#include "SlotStore.h"
+
+extern Recorder recorder;
+extern SlotStore store;
+
+// false when the take does not fit a slot
+static bool writeTake(int slot, uint32_t ms, uint32_t& blocks) {
+  std::vector<RecFrame> take;
+  for (uint32_t t = 0; t < ms; t += 50) {
+    float s = sinf(2.0f * (float)M_PI * 0.2f * t / 1000.0f);
+    take.push_back(RecFrame{ t, 1, 0.5f * s, 0.3f, MODE_NORMAL, 1.0f, SPEED_NORMAL,
+                             (int16_t)(SERVO_CENTER + (int)(25 * s)), (int16_t)(SERVO_CENTER - (int)(25 * s)) });
+  }
+  RecFileHeader h;
+  recInitHeader(h, 50);
+  auto enc = benchEncodeTake(take, h.version);
+  blocks = (uint32_t)enc.size();
+  if (blocks > REC_STORE_SLOT_BLOCKS || !store.open(slot, h.version, 50)) return false;
+  for (const auto& b : enc) if (!store.append(b.data())) return false;
+  return store.close((uint32_t)take.size(), take.back().t);
+}
+
+struct Cost { double us = 0; double reads = 0; };
+
+template <typename F> static Cost measure(F fn) {
+  uint64_t r0 = hal::flashStats().reads, a = benchNowNs();
+  fn();
+  return Cost{ (benchNowNs() - a) / 1000.0, (double)(hal::flashStats().reads - r0) };
+}
+
+int benchSeek(int argc, char** argv) {
+  int seeks = (int)benchArg(argc, argv, "--seeks", 200);
+  hal::setFsRoot(benchArgStr(argc, argv, "--fs", "bench_fs"));
+  hal::useVirtualClock(true);
+  hal::setTasksEnabled(false);
+  setup();
+
+  printf("\n== seek: sine takes at 20 Hz, %d-byte blocks, slot of %u blocks, reads = flash reads ==\n",
+         REC_BLOCK_BYTES, (unsigned)REC_STORE_SLOT_BLOCKS);
+  printf("%-8s %7s %20s %20s %20s %20s\n", "take", "blocks", "play @0", "play @mid", "reverse", "seek");
+  static const uint32_t MINUTES[] = { 1, 5, 15, 30, 60 };
+  bool ok = true;
+  for (uint32_t min : MINUTES) {
+    uint32_t ms = min * 60000u, blocks = 0;
+    char lbl[16]; snprintf(lbl, sizeof(lbl), "%u min", (unsigned)min);
+    if (!writeTake(5, ms, blocks)) { printf("%-8s %7u  does not fit a slot\n", lbl, (unsigned)blocks); continue; }
+
+    Cost first = measure([&]{ ok &= recorder.startPlayback(PLAY_FORWARD, 5); });
+    recorder.stopPlayback();
+    Cost mid = measure([&]{ ok &= recorder.startPlayback(PLAY_FORWARD, 5, 1.0f, false, (int32_t)(ms / 2)); });
+    recorder.stopPlayback();
+    Cost rev = measure([&]{ ok &= recorder.startPlayback(PLAY_REVERSE, 5); });
+    recorder.stopPlayback();
+
+    ok &= recorder.startPlayback(PLAY_FORWARD, 5);
+    uint32_t seed = 7;
+    Cost sk = measure([&]{
+      for (int i = 0; i < seeks; ++i) { seed = seed * 1103515245u + 12345u; ok &= recorder.seek((seed >> 8) % ms); }
+    });
+    recorder.stopPlayback();
+    sk.us /= seeks; sk.reads /= seeks;
+
+    printf("%-8s %7u %9.0f us %5.0f rd %9.1f us %5.0f rd %9.1f us %5.0f rd %9.1f us %5.1f rd\n", lbl, (unsigned)blocks,
+           first.us, first.reads, mid.us, mid.reads, rev.us, rev.reads, sk.us, sk.reads);
+  }
+  if (!ok) printf("playback start/seek failed: %s\n", recorder.lastError());
+  return ok ? 0 : 1;
+}
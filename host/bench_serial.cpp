@@ -0,0 +1,192 @@
+// Serial link over a pseudo-terminal: the firmware's Serial is the pty
+// slave, a tracker thread on the master streams setpoints at fixed rates
+// and reads telemetry. Reports sustained setpoint/ack rates and round-trip
+// latency (setpoint out -> telemetry acking it back) per rate, then injects
+// corrupted frames and a console line mid-stream. Real clock, control
+// inline in loop(); a pty has no baud limit, so the UART serialization at
+// SLINK_BAUD is added from the frame sizes.
+#include "bench.h"
+#include <thread>
+#include <atomic>
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+#include "config.h"
+#include "CtlProto.h"
+#include "SerialLink.h"
+#include "Speed.h"
+#include <FS.h>
+
+struct TrackerRun {
+  long hz = 0;
+  double seconds = 0;
+  int corruptEvery = 0;     // flip a bit in every n-th frame (0 = never)
+  bool consoleLine = false; // send "trace clear" halfway
+  // results
+  uint32_t sent = 0, acked = 0, telem = 0, corrupted = 0, corruptAcked = 0;
+  uint16_t rxErrors0 = 0, rxErrors1 = 0;
+  std::vector<uint64_t> rtt;  // ns
+  SlinkTelem last{};
+};
+
+static std::atomic<bool> s_fwRun{false};
+
+static bool waitReadable(int fd, uint64_t ns) {
+  pollfd p{fd, POLLIN, 0};
+  timespec ts{(time_t)(ns / 1000000000ull), (long)(ns % 1000000000ull)};
+  return ppoll(&p, 1, &ts, nullptr) > 0;
+}
+
+static void tracker(int fd, TrackerRun* r, uint16_t* seq) {
+  SlinkParser rx;
+  std::vector<uint64_t> sentAt(65536, 0);
+  std::vector<uint8_t> bad(65536, 0);
+  bool haveErr0 = false;
+  uint8_t wire[SLINK_MAX_WIRE], in[512];
+  const uint64_t periodNs = 1000000000ull / (uint64_t)r->hz;
+  const uint64_t t0 = benchNowNs(), tEnd = t0 + (uint64_t)(r->seconds * 1e9);
+  uint64_t next = t0;
+  bool consoleSent = false;
+  auto drain = [&]() {
+    ssize_t n;
+    while ((n = ::read(fd, in, sizeof(in))) > 0) {
+      uint64_t now = benchNowNs();
+      for (ssize_t i = 0; i < n; ++i) {
+        SlinkEvent ev = rx.push(in[i]);
+        if (ev == SLINK_LINE) continue;  // console output (boot log)
+        if (ev != SLINK_FRAME || rx.payloadLen() != sizeof(SlinkTelem) || rx.payload()[0] != SLINK_TELEM) continue;
+        SlinkTelem t; memcpy(&t, rx.payload(), sizeof(t));
+        r->telem++;
+        if (!haveErr0) { r->rxErrors0 = t.rxErrors; haveErr0 = true; }
+        r->rxErrors1 = t.rxErrors;
+        r->last = t;
+        if (bad[t.ack]) r->corruptAcked++;
+        if (sentAt[t.ack]) { r->rtt.push_back(now - sentAt[t.ack]); sentAt[t.ack] = 0; r->acked++; }
+      }
+    }
+  };
+  while (benchNowNs() < tEnd) {
+    uint64_t now = benchNowNs();
+    if (now >= next) {
+      // Keep the schedule through host scheduling stalls (the frames sent
+      // to catch up coalesce on the rover); restart it after a long one
+      next += periodNs;
+      if (now - next > 100000000ull && now > next) next = now + periodNs;
+      uint32_t k = r->sent++;
+      float ph = (float)k / (float)r->hz;
+      SlinkSetpoint m;
+      m.type = SLINK_SETPOINT;
+      m.flags = MODE_NORMAL | (SPEED_NORMAL << 4);
+      m.seq = ++*seq;
+      m.drive = (int16_t)(0.4f * sinf(ph * 2.0f) * 16384);
+      m.steer = (int16_t)(0.6f * sinf(ph * 3.1f) * 16384);
+      m.diam = 65535; m.ff = SERVO_CENTER; m.fr = SERVO_CENTER; m.tilt = 0; m.roll = 0;
+      size_t len = slinkEncode(&m, sizeof(m), wire);
+      if (r->corruptEvery && k % r->corruptEvery == (uint32_t)r->corruptEvery - 1) {
+        wire[3 + k % 10] ^= (uint8_t)(1u << (k % 7));  // inside the body, never a delimiter
+        if (wire[3 + k % 10] == 0) wire[3 + k % 10] = 0x55;
+        bad[m.seq] = 1; r->corrupted++;
+      } else {
+        bad[m.seq] = 0;
+      }
+      sentAt[m.seq] = benchNowNs();
+      if (::write(fd, wire, len) != (ssize_t)len) break;
+      if (r->consoleLine && !consoleSent && now - t0 > (tEnd - t0) / 2) {
+        static const char LINE[] = "trace clear\n";
+        if (::write(fd, LINE, sizeof(LINE) - 1) < 0) break;
+        consoleSent = true;
+      }
+    }
+    uint64_t waitNs = next > benchNowNs() ? next - benchNowNs() : 0;
+    if (waitReadable(fd, waitNs)) drain();
+  }
+  // late acks
+  uint64_t stop = benchNowNs() + 50000000ull;
+  while (benchNowNs() < stop) if (waitReadable(fd, 5000000)) drain();
+}
+
+int benchSerial(int argc, char** argv) {
+  double seconds = benchArg(argc, argv, "--seconds", 2);
+  long loopUs = benchArg(argc, argv, "--loop-us", 100);
+  long baud = benchArg(argc, argv, "--baud", SLINK_BAUD);
+  hal::setFsRoot(benchArgStr(argc, argv, "--fs", "bench_fs"));
+  hal::setTasksEnabled(false);
+
+  int master = posix_openpt(O_RDWR | O_NOCTTY);
+  if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0) { perror("posix_openpt"); return 1; }
+  int slave = open(ptsname(master), O_RDWR | O_NOCTTY);
+  if (slave < 0) { perror("open pty slave"); return 1; }
+  termios tio;
+  tcgetattr(slave, &tio); cfmakeraw(&tio); tcsetattr(slave, TCSANOW, &tio);
+  fcntl(master, F_SETFL, fcntl(master, F_GETFL) | O_NONBLOCK);
+  hal::serialAttachFd(slave);
+
+  // Encode/parse cost
+  SlinkSetpoint m{SLINK_SETPOINT, 0, 0, 1000, -2000, 65535, 90, 90, 0, 0};
+  uint8_t wire[SLINK_MAX_WIRE];
+  size_t spLen = slinkEncode(&m, sizeof(m), wire);
+  SlinkParser p;
+  const long N = 200000;
+  uint64_t e0 = benchNowNs();
+  for (long i = 0; i < N; ++i) { m.seq = (uint16_t)i; spLen = slinkEncode(&m, sizeof(m), wire); }
+  uint64_t e1 = benchNowNs();
+  uint32_t frames = 0;
+  for (long i = 0; i < N; ++i) for (size_t k = 0; k < spLen; ++k) frames += p.push(wire[k]) == SLINK_FRAME;
+  uint64_t e2 = benchNowNs();
+  SlinkTelem tm{};
+  uint8_t tw[SLINK_MAX_WIRE];
+  size_t tlLen = slinkEncode(&tm, sizeof(tm), tw);
+
+  // Firmware in this thread, tracker on the master side
+  setup();
+  double byteUs = 10e6 / (double)baud;  // 8N1
+  printf("\n== serial link: setpoint %zu B, telemetry %zu B on the wire, %ld baud (%.1f us/B) ==\n",
+         spLen, tlLen, baud, byteUs);
+  printf("%-22s encode %.0f ns/frame, parse %.1f ns/byte (%u/%ld frames)\n", "codec",
+         (double)(e1 - e0) / N, (double)(e2 - e1) / N / spLen, (unsigned)frames, N);
+  printf("%-22s %.0f setpoints/s with a telemetry ack each (both directions full duplex)\n", "UART limit",
+         1e6 / (byteUs * (double)(spLen > tlLen ? spLen : tlLen)));
+
+  uint16_t seq = 0;
+  std::vector<TrackerRun> runs;
+  for (long hz : {100L, 250L, 500L, 1000L, 2000L}) { runs.emplace_back(); runs.back().hz = hz; runs.back().seconds = seconds; }
+  TrackerRun faults; faults.hz = 500; faults.seconds = seconds; faults.corruptEvery = 25; faults.consoleLine = true;
+  runs.push_back(faults);
+
+  int fails = 0;
+  for (TrackerRun& r : runs) {
+    // drain whatever the firmware printed so far (boot log, earlier runs)
+    uint8_t junk[256];
+    while (::read(master, junk, sizeof(junk)) > 0) {}
+    s_fwRun = true;
+    std::thread th([&] { tracker(master, &r, &seq); s_fwRun = false; });
+    while (s_fwRun) { loop(); delayMicroseconds((uint32_t)loopUs); }
+    th.join();
+
+    char label[48];
+    snprintf(label, sizeof(label), r.corruptEvery ? "%ld Hz + faults" : "%ld Hz", r.hz);
+    double secs = r.seconds;
+    printf("%-22s sent %6.0f/s  acked %6.0f/s  telemetry %6.0f/s  (%u/%u acked)\n", label,
+           r.sent / secs, r.acked / secs, r.telem / secs, (unsigned)r.acked, (unsigned)r.sent);
+    char rl[48]; snprintf(rl, sizeof(rl), "  rtt (pty)");
+    benchPrintPercentiles(rl, r.rtt, 1e3, "us");
+    double wireUs = byteUs * (double)(spLen + tlLen);
+    printf("  %-20s +%.0f us frame serialization at %ld baud\n", "rtt on a UART", wireUs, baud);
+    if (r.corruptEvery) {
+      uint16_t errs = (uint16_t)(r.rxErrors1 - r.rxErrors0);
+      printf("  %-20s %u corrupted sent, rover counted +%u rx errors, %u corrupted acked, console line %s\n",
+             "faults", (unsigned)r.corrupted, (unsigned)errs, (unsigned)r.corruptAcked,
+             r.acked > r.sent / 2 ? "did not stall the link" : "STALLED the link");
+      if (r.corruptAcked || errs + 2u < r.corrupted || r.acked < r.sent / 2) fails++;
+    }
+    if (r.acked == 0) fails++;
+  }
+  const SlinkTelem& t = runs.back().last;
+  printf("%-22s ack %u  t %u ms  servos %u/%u  wheels %d/%d  state 0x%02x\n", "last telemetry",
+         (unsigned)t.ack, (unsigned)t.ms, (unsigned)t.ff, (unsigned)t.fr, (int)t.left, (int)t.right, (unsigned)t.state);
+
+  hal::serialAttachFd(-1);
+  close(slave); close(master);
+  return fails ? 1 : 0;
+}
@@ -0,0 +1,104 @@
+// Servo trajectory engine: step response of a manual-steer jump through
+// writeDeg, a sweep and a moveTogether pair, all advanced by update() at
+// the control rate. Reports the emitted pulse profile (deg, deg/s, deg/s^2
+// recovered from writeMicroseconds over 20 ms windows, so 1 us pulse
+// quantization doesn't dominate), arrival times and the longest single
+// update() call -- the old slowMoveTo/sweep blocked for the whole move.
+// Fails when the commanded angle (readDegF, per tick) breaks the velocity
+// or acceleration limit, or the pulses do by more than their quantization.
+#include "bench.h"
+#include "config.h"
+#include "ServoControl.h"
+
+static const int PIN_A = SERVO_FRONT_PIN, PIN_B = SERVO_REAR_PIN;
+
+static float pinDeg(int pin) {
+  return (hal::pinDuty[pin] - SERVO_MIN_US) * 180.0f / (SERVO_MAX_US - SERVO_MIN_US);
+}
+
+static int s_done = 0;
+static uint32_t s_doneMs[4];
+static void onDone(ServoControl&) { s_doneMs[s_done++ & 3] = millis(); }
+
+struct Profile {
+  float peakVel = 0, peakAcc = 0;  // from the pulses, 20 ms windows
+  float cmdVel = 0, cmdAcc = 0;    // from the commanded angle, per tick
+  uint32_t settleMs = 0; uint64_t maxUpdNs = 0;
+};
+
+// Peaks within vel / acc limits; the pulse ones may be off by 1 us in
+// each window edge: q / window in velocity, 2 q / window^2 in acceleration
+static bool within(const Profile& p, float vel, float acc, const char* label) {
+  const float q = 180.0f / (SERVO_MAX_US - SERVO_MIN_US), w = 0.02f;
+  bool ok = p.cmdVel <= vel * 1.001f && p.cmdAcc <= acc * 1.001f
+         && p.peakVel <= vel + q / w && p.peakAcc <= acc + 2 * q / (w * w);
+  printf("  %-22s commanded %6.1f deg/s %7.1f deg/s^2  limits %.0f / %.0f (pulses +%.0f / +%.0f)  %s\n", label, p.cmdVel,
+         p.cmdAcc, vel, acc, q / w, 2 * q / (w * w), ok ? "ok" : "FAILED");
+  return ok;
+}
+
+// Runs update() at rateHz until both servos rest (or maxMs)
+static Profile run(ServoControl& a, ServoControl* b, int rateHz, uint32_t maxMs, bool jumpEachTick = false, int jumpDeg = 0) {
+  Profile p;
+  const uint32_t t0 = millis(), periodUs = 1000000u / rateHz;
+  const int W = std::max(1, rateHz / 50); // ticks per 20 ms window
+  float lastDeg = pinDeg(PIN_A), lastVel = 0, cmd = a.readDegF(), cmdVel = 0;
+  float dt = W * periodUs * 1e-6f;
+  for (int n = 1; millis() - t0 < maxMs; ++n) {
+    hal::advanceMicros(periodUs);
+    if (jumpEachTick) a.writeDeg(jumpDeg); // joystick held at the new angle
+    uint64_t s = benchNowNs();
+    a.update(millis());
+    if (b) b->update(millis());
+    p.maxUpdNs = std::max(p.maxUpdNs, benchNowNs() - s);
+    float v = (a.readDegF() - cmd) * rateHz;
+    p.cmdVel = std::max(p.cmdVel, fabsf(v));
+    p.cmdAcc = std::max(p.cmdAcc, fabsf(v - cmdVel) * rateHz);
+    cmd = a.readDegF(); cmdVel = v;
+    if (n % W == 0) {
+      float d = pinDeg(PIN_A), v = (d - lastDeg) / dt, acc = (v - lastVel) / dt;
+      p.peakVel = std::max(p.peakVel, fabsf(v));
+      p.peakAcc = std::max(p.peakAcc, fabsf(acc));
+      lastDeg = d; lastVel = v;
+    }
+    if (!a.moving() && !a.scheduled() && (!b || (!b->moving() && !b->scheduled()))) { p.settleMs = millis() - t0; break; }
+  }
+  return p;
+}
+
+int benchServo(int argc, char** argv) {
+  int  rateHz = (int)benchArg(argc, argv, "--rate-hz", CONTROL_RATE_HZ);
+  int  jump   = (int)benchArg(argc, argv, "--jump-deg", 50);
+  hal::useVirtualClock(true);
+
+  bool ok = true;
+  ServoControl a, b;
+  a.attach(PIN_A); b.attach(PIN_B);
+  a.update(millis()); b.update(millis());
+
+  printf("\n== servo: update() at %d Hz, limits %.0f deg/s, %.0f deg/s^2 ==\n",
+         rateHz, SERVO_MAX_VEL_DEG_S, SERVO_MAX_ACC_DEG_S2);
+
+  Profile p = run(a, nullptr, rateHz, 5000, true, SERVO_CENTER + jump);
+  printf("writeDeg jump %+d deg    settle %4u ms  peak %6.1f deg/s  %7.1f deg/s^2  max update %6.2f us\n",
+         jump, (unsigned)p.settleMs, p.peakVel, p.peakAcc, p.maxUpdNs / 1e3);
+  ok &= within(p, SERVO_MAX_VEL_DEG_S, SERVO_MAX_ACC_DEG_S2, "jump");
+
+  s_done = 0;
+  a.sweep(60, 120, 1, 10, onDone); // legacy args: 1 deg / 10 ms
+  p = run(a, nullptr, rateHz, 20000);
+  printf("sweep 60..120 @100 deg/s settle %4u ms  peak %6.1f deg/s  %7.1f deg/s^2  max update %6.2f us  done=%d\n",
+         (unsigned)p.settleMs, p.peakVel, p.peakAcc, p.maxUpdNs / 1e3, s_done);
+  ok &= within(p, 100, SERVO_MAX_ACC_DEG_S2, "sweep") && s_done == 1;
+
+  s_done = 0;
+  uint32_t t0 = millis();
+  ServoControl::moveTogether(a, 140, b, 80, 0, 0, onDone);
+  p = run(a, &b, rateHz, 5000);
+  printf("moveTogether a->140 b->80 settle %4u ms  a=%d b=%d  done=%d at +%u ms\n",
+         (unsigned)p.settleMs, a.readDeg(), b.readDeg(), s_done, (unsigned)(s_doneMs[0] - t0));
+  ok &= within(p, SERVO_MAX_VEL_DEG_S, SERVO_MAX_ACC_DEG_S2, "moveTogether") && s_done == 1
+     && a.readDeg() == 140 && b.readDeg() == 80;
+  printf("%-24s %s\n", "result", ok ? "ok" : "FAILED");
+  return ok ? 0 : 1;
+}
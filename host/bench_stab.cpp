@@ -0,0 +1,316 @@
+// Gimbal stabilization on IMU traces. A trace is raw MPU-6050 samples
+// (LSBs at the firmware's +-2 g / +-500 deg/s) plus, for synthetic ones,
+// the true body pitch/roll and forward speed. The synthetic drive has
+// terrain pitch/roll waves, bumps, 31/43 Hz chassis vibration, turns
+// (centripetal accel), speed changes, gyro bias and noise.
+//   filter   Stabilizer (fixed point) and StabilizerRef (float) over the
+//            trace, given the speed (setSpeed): estimate error vs truth
+//            after --settle-s, fixed vs float, the fixed one without the
+//            speed (centripetal left in), final bias estimate, ns per sample
+//   gimbal   the firmware on the trace: IMU sim on the I2C bus (FIFO at
+//            IMU_RATE_HZ), gimbal servo plants, control inline. Camera =
+//            body + servo offset; residual vs the commanded 0 deg for
+//            stab off, on without lead, on with STAB_LEAD_MS. The trace
+//            speed is driven through /ctl_drive, so the firmware's speed
+//            estimate comes from its own wheel command. Fails when "stab
+//            on" is worse than "stab off" on either axis.
+// Also checks atan2DegQ16 against atan2 up to the int32 operand range.
+// --trace FILE replays "us,ax,ay,az,gx,gy,gz[,pitch,roll[,speed]]" CSV
+// lines (no truth columns: filter compares fixed vs float only, gimbal is
+// skipped; no speed: 0);
+// --write-trace FILE saves the synthetic one in that format. --tau,
+// --bias-tau and --acc-gate override the filter constants (filter part).
+#include "bench.h"
+#include <WebServer.h>
+#include <FS.h>
+#include <MotorSim.h>
+#include <ImuSim.h>
+#include <random>
+#include "config.h"
+#include "Stabilizer.h"
+
+extern WebServer server;
+
+static void get(const char* uri) { server.sim_enqueue(HTTP_GET, uri); while (server.sim_pending()) loop(); }
+
+struct Trace {
+  uint32_t periodUs = 0;
+  std::vector<ImuRaw> raw;
+  std::vector<float> pitch, roll;  // truth (deg), empty if unknown
+  std::vector<float> speed;        // forward m/s, empty if unknown
+  float speedAt(size_t i) const { return speed.empty() ? 0.0f : speed[i]; }
+  bool truth() const { return !pitch.empty(); }
+  float seconds() const { return raw.size() * periodUs * 1e-6f; }
+};
+
+static int16_t lsb(float v, float scale) {
+  float x = roundf(v * scale);
+  return (int16_t)(x > 32767 ? 32767 : (x < -32768 ? -32768 : x));
+}
+
+// Body attitude from Euler angles + rates; specific force and body rates
+// from the exact kinematics (the filter only assumes small angles)
+static Trace synthTrace(float seconds, uint32_t rateHz, unsigned seed) {
+  Trace t;
+  t.periodUs = 1000000u / rateHz;
+  std::mt19937 rng(seed);
+  std::normal_distribution<float> n01(0.0f, 1.0f);
+  const float D = (float)M_PI / 180.0f, W = 2.0f * (float)M_PI;
+  const float bias[3] = { 1.5f, -2.0f, 0.8f };  // deg/s
+  int n = (int)(seconds * rateHz);
+  auto bump = [](float t, float period, float phase) {
+    float u = fmodf(t + phase, period);
+    return expf(-u / 0.15f) * sinf(2.0f * (float)M_PI * 6.0f * u);
+  };
+  auto att = [&](float s, float& th, float& ph, float& psiD) {
+    th = 4.0f * sinf(W * 0.7f * s) + 2.0f * sinf(W * 1.9f * s + 1.0f) + 3.0f * bump(s, 3.0f, 0.0f)
+       + 0.2f * sinf(W * 31.0f * s);
+    ph = 3.0f * sinf(W * 0.5f * s + 0.3f) + 1.5f * sinf(W * 2.3f * s) + 2.0f * bump(s, 4.1f, 1.3f)
+       + 0.15f * sinf(W * 43.0f * s);
+    psiD = 60.0f * sinf(W * 0.1f * s);
+  };
+  const float h = 1e-4f;
+  for (int i = 0; i < n; ++i) {
+    float s = (float)i / rateHz;
+    float th, ph, psiD, th1, ph1, psiD1;
+    att(s, th, ph, psiD);
+    att(s + h, th1, ph1, psiD1);
+    float thD = (th1 - th) / h, phD = (ph1 - ph) / h;  // deg/s
+    float st = sinf(th * D), ct = cosf(th * D), sp = sinf(ph * D), cp = cosf(ph * D);
+    float p = phD - psiD * st;
+    float q = thD * cp + psiD * sp * ct;
+    float r = -thD * sp + psiD * cp * ct;
+    float v = 0.5f + 0.3f * sinf(W * 0.2f * s);           // m/s
+    float axLin = 0.3f * W * 0.2f * cosf(W * 0.2f * s) / 9.81f;
+    float ayLin = v * psiD * D / 9.81f;
+    float f[3] = { -st + axLin, sp * ct + ayLin, cp * ct };
+    float g[3] = { p, q, r };
+    ImuRaw m;
+    int16_t* a = &m.ax; int16_t* w = &m.gx;
+    for (int k = 0; k < 3; ++k) {
+      a[k] = lsb(f[k] + 0.01f * n01(rng) + 0.03f * sinf(W * 37.0f * s + k), IMU_ACC_LSB_G);
+      w[k] = lsb(g[k] + bias[k] + 0.05f * n01(rng), IMU_GYRO_LSB_DPS);
+    }
+    t.raw.push_back(m);
+    t.pitch.push_back(th);
+    t.roll.push_back(ph);
+    t.speed.push_back(v);
+  }
+  return t;
+}
+
+static bool loadTrace(const char* path, Trace& t) {
+  FILE* f = fopen(path, "r");
+  if (!f) return false;
+  char line[256];
+  double firstUs = -1, lastUs = 0;
+  bool withTruth = true;
+  while (fgets(line, sizeof(line), f)) {
+    double us; int v[6]; float p, r, sp;
+    int k = sscanf(line, "%lf,%d,%d,%d,%d,%d,%d,%f,%f,%f", &us, &v[0], &v[1], &v[2], &v[3], &v[4], &v[5], &p, &r, &sp);
+    if (k < 7) continue;  // header / comment
+    t.raw.push_back(ImuRaw{ (int16_t)v[0], (int16_t)v[1], (int16_t)v[2], (int16_t)v[3], (int16_t)v[4], (int16_t)v[5] });
+    withTruth &= (k >= 9);
+    t.pitch.push_back(k >= 9 ? p : 0); t.roll.push_back(k >= 9 ? r : 0);
+    t.speed.push_back(k == 10 ? sp : 0);
+    if (firstUs < 0) firstUs = us;
+    lastUs = us;
+  }
+  fclose(f);
+  if (!withTruth) { t.pitch.clear(); t.roll.clear(); }
+  if (std::all_of(t.speed.begin(), t.speed.end(), [](float v) { return v == 0; })) t.speed.clear();
+  if (t.raw.size() < 2) return false;
+  t.periodUs = (uint32_t)lround((lastUs - firstUs) / (t.raw.size() - 1));
+  return t.periodUs > 0;
+}
+
+static void writeTrace(const char* path, const Trace& t) {
+  FILE* f = fopen(path, "w");
+  if (!f) return;
+  fprintf(f, "us,ax,ay,az,gx,gy,gz,pitch,roll,speed\n");
+  for (size_t i = 0; i < t.raw.size(); ++i) {
+    const ImuRaw& m = t.raw[i];
+    fprintf(f, "%u,%d,%d,%d,%d,%d,%d,%.4f,%.4f,%.3f\n", (unsigned)(i * t.periodUs), m.ax, m.ay, m.az, m.gx, m.gy, m.gz,
+            t.pitch[i], t.roll[i], t.speedAt(i));
+  }
+  fclose(f);
+}
+
+// Error stats; jitter = rms of the error above 0.5 Hz (one-pole high-pass),
+// the part that shows as shake rather than a slow lean
+struct Err {
+  double sq = 0, hsq = 0, lp = 0, k = 0; size_t n = 0;
+  explicit Err(double dtS = 0.001) : k(dtS / (dtS + 1.0 / (2.0 * M_PI * 0.5))) {}
+  void add(double e) {
+    if (n == 0) lp = e;
+    lp += (e - lp) * k;
+    sq += e * e; hsq += (e - lp) * (e - lp); n++;
+  }
+  double rms() const { return n ? sqrt(sq / n) : 0; }
+  double jitter() const { return n ? sqrt(hsq / n) : 0; }
+};
+
+template <typename F> static double nsPerSample(const Trace& t, const StabCfg& c, int reps) {
+  F f; f.begin(c);
+  uint64_t a = benchNowNs();
+  for (int k = 0; k < reps; ++k) for (const ImuRaw& m : t.raw) f.update(m);
+  volatile float sink = f.pitchDeg(); (void)sink;
+  return (double)(benchNowNs() - a) / (reps * t.raw.size());
+}
+
+static void benchFilter(const Trace& t, StabCfg c, float settleS) {
+  c.rateHz = (uint16_t)(1000000u / t.periodUs);
+  Stabilizer fx, fn; StabilizerRef fl;
+  fx.begin(c); fl.begin(c); fn.begin(c);
+  double dt = t.periodUs * 1e-6;
+  Err ex[2] = { Err(dt), Err(dt) }, el[2] = { Err(dt), Err(dt) }, dx[2] = { Err(dt), Err(dt) }, en[2] = { Err(dt), Err(dt) };
+  size_t skip = (size_t)(settleS * 1e6f / t.periodUs);
+  for (size_t i = 0; i < t.raw.size(); ++i) {
+    fx.setSpeed(t.speedAt(i)); fl.setSpeed(t.speedAt(i));
+    fx.update(t.raw[i]); fl.update(t.raw[i]); fn.update(t.raw[i]);
+    if (i < skip) continue;
+    dx[0].add(fx.pitchDeg() - fl.pitchDeg()); dx[1].add(fx.rollDeg() - fl.rollDeg());
+    if (!t.truth()) continue;
+    ex[0].add(fx.pitchDeg() - t.pitch[i]); ex[1].add(fx.rollDeg() - t.roll[i]);
+    el[0].add(fl.pitchDeg() - t.pitch[i]); el[1].add(fl.rollDeg() - t.roll[i]);
+    en[0].add(fn.pitchDeg() - t.pitch[i]); en[1].add(fn.rollDeg() - t.roll[i]);
+  }
+  int reps = std::max(1, (int)(2000000 / t.raw.size()));
+  double nsFx = nsPerSample<Stabilizer>(t, c, reps), nsFl = nsPerSample<StabilizerRef>(t, c, reps);
+  printf("\n== stab filter: %.1f s at %u Hz, tau %.2f s, bias tau %.1f s, gate %.2f g ==\n",
+         t.seconds(), c.rateHz, c.tauS, c.biasTauS, c.accGateG);
+  printf("%-22s %12s %12s %12s %12s %10s\n", "", "pitch rms", "pitch jitter", "roll rms", "roll jitter", "ns/sample");
+  if (t.truth()) {
+    printf("%-22s %10.3f d %10.3f d %10.3f d %10.3f d %10.1f\n", "fixed vs truth", ex[0].rms(), ex[0].jitter(), ex[1].rms(), ex[1].jitter(), nsFx);
+    printf("%-22s %10.3f d %10.3f d %10.3f d %10.3f d %10.1f\n", "float vs truth", el[0].rms(), el[0].jitter(), el[1].rms(), el[1].jitter(), nsFl);
+    if (!t.speed.empty())
+      printf("%-22s %10.3f d %10.3f d %10.3f d %10.3f d\n", "fixed, speed unknown", en[0].rms(), en[0].jitter(), en[1].rms(), en[1].jitter());
+  } else {
+    printf("%-22s %12s %12s %12s %12s %10.1f\n", "fixed", "-", "-", "-", "-", nsFx);
+    printf("%-22s %12s %12s %12s %12s %10.1f\n", "float", "-", "-", "-", "-", nsFl);
+  }
+  printf("%-22s %10.4f d %10.4f d %10.4f d %10.4f d\n", "fixed vs float", dx[0].rms(), dx[0].jitter(), dx[1].rms(), dx[1].jitter());
+  printf("%-22s pitch %.2f  roll %.2f deg/s   accel gated %.1f%% of samples\n", "bias estimate",
+         fx.biasDps(0), fx.biasDps(1), 100.0 * fx.gated() / t.raw.size());
+}
+
+// Firmware run on the trace; returns residual camera error (deg) per axis
+static void gimbalRun(const Trace& t, const char* uri, float settleS, Err out[2], uint32_t& fifoLost) {
+  get(uri);
+  std::vector<hal::ImuSample> s(t.raw.size());
+  for (size_t i = 0; i < t.raw.size(); ++i) {
+    const ImuRaw& m = t.raw[i];
+    s[i] = hal::ImuSample{ { m.ax, m.ay, m.az }, { m.gx, m.gy, m.gz } };
+  }
+  uint32_t lost0 = hal::imuFifoDropped();
+  hal::imuLoad(s, t.periodUs);
+  uint64_t t0 = hal::nowMicros(), dur = (uint64_t)t.raw.size() * t.periodUs;
+  float lastY = NAN;
+  for (uint64_t us = 0; us < dur; us += 1000) {
+    // trace speed as the drive command (straight, sport: PWM maps to PRESET_MM_S_FULL)
+    float y = roundf(t.speedAt(std::min((size_t)(us / t.periodUs), t.raw.size() - 1)) / (PRESET_MM_S_FULL * 0.001f) * 255) / 255;
+    if (y != lastY) {
+      char q[48];
+      snprintf(q, sizeof(q), "/ctl_drive?y=%.4f", y);
+      get(q);
+      lastY = y;
+    }
+    loop();
+    hal::advanceMicros(1000);
+    uint64_t now = hal::nowMicros() - t0;
+    size_t i = std::min((size_t)(now / t.periodUs), t.raw.size() - 1);
+    if (now < settleS * 1e6f) continue;
+    float camP = t.pitch[i] + GIMBAL_TILT_SIGN * (hal::servoPlantDeg(0) - SERVO_CENTER);
+    float camR = t.roll[i]  + GIMBAL_ROLL_SIGN * (hal::servoPlantDeg(1) - SERVO_CENTER);
+    out[0].add(camP); out[1].add(camR);
+  }
+  fifoLost = hal::imuFifoDropped() - lost0;
+  get("/ctl_drive?y=0");
+}
+
+// atan2DegQ16 vs atan2 of the same integers around the circle, from
+// accel-sized operands to the int32 extremes
+static bool checkAtan() {
+  const double R[] = { 1e3, 16384, 131071, 131072, 1e6, 2147483647.0 };
+  double maxErr = 0;
+  for (double r : R) {
+    for (int i = 0; i < 3600; ++i) {
+      double a = i * M_PI / 1800;
+      int32_t y = (int32_t)std::max(-2147483648.0, std::min(2147483647.0, std::round(r * sin(a))));
+      int32_t x = (int32_t)std::max(-2147483648.0, std::min(2147483647.0, std::round(r * cos(a))));
+      double e = fabs(atan2DegQ16(y, x) / 65536.0 - atan2((double)y, (double)x) * 180 / M_PI);
+      maxErr = std::max(maxErr, std::min(e, 360 - e));
+    }
+  }
+  for (int32_t y : { INT32_MIN, INT32_MAX, 0, -1 }) {
+    for (int32_t x : { INT32_MIN, INT32_MAX, 1 }) {
+      double e = fabs(atan2DegQ16(y, x) / 65536.0 - atan2((double)y, (double)x) * 180 / M_PI);
+      maxErr = std::max(maxErr, std::min(e, 360 - e));
+    }
+  }
+  bool ok = maxErr < 0.01;
+  printf("%-22s max |err| %.4f deg, operands up to the int32 range%s\n", "atan2DegQ16", maxErr, ok ? "" : " FAILED");
+  return ok;
+}
+
+int benchStab(int argc, char** argv) {
+  float seconds = (float)benchArg(argc, argv, "--seconds", 30);
+  float settle = (float)benchArg(argc, argv, "--settle-s", 3);
+  const char* path = benchArgStr(argc, argv, "--trace", nullptr);
+  Trace t;
+  if (path) {
+    if (!loadTrace(path, t)) { printf("cannot read trace %s\n", path); return 1; }
+  } else {
+    t = synthTrace(seconds, IMU_RATE_HZ, (unsigned)benchArg(argc, argv, "--seed", 1));
+  }
+  if (const char* w = benchArgStr(argc, argv, "--write-trace", nullptr)) writeTrace(w, t);
+  auto argF = [&](const char* name, float def) {
+    const char* v = benchArgStr(argc, argv, name, nullptr);
+    return v ? (float)atof(v) : def;
+  };
+  StabCfg c{ 0, argF("--tau", STAB_TAU_S), argF("--bias-tau", STAB_BIAS_TAU_S), argF("--acc-gate", STAB_ACC_GATE_G),
+             IMU_ACC_LSB_G, IMU_GYRO_LSB_DPS };
+  bool ok = checkAtan();
+  benchFilter(t, c, settle);
+  if (!t.truth()) { printf("(no truth columns: gimbal run skipped)\n"); return ok ? 0 : 1; }
+
+  hal::setFsRoot(benchArgStr(argc, argv, "--fs", "bench_fs"));
+  hal::useVirtualClock(true);
+  hal::setTasksEnabled(false);
+  hal::motorsReset();
+  hal::imuAttach(IMU_I2C_ADDR);
+  setup();
+  get("/speed?mode=sport");
+  hal::servoPlantAttach(GIMBAL_TILT_PIN, SERVO_MIN_US, SERVO_MAX_US);
+  hal::servoPlantAttach(GIMBAL_ROLL_PIN, SERVO_MIN_US, SERVO_MAX_US);
+
+  struct Row { const char* label; const char* uri; };
+  char onUri[64];
+  snprintf(onUri, sizeof(onUri), "/gimbal?stab=1&lead_ms=%d", (int)STAB_LEAD_MS);
+  const Row ROWS[] = {
+    { "stab off",          "/gimbal?stab=0&tilt=0&roll=0" },
+    { "stab on, no lead",  "/gimbal?stab=1&lead_ms=0" },
+    { "stab on",           onUri },
+  };
+  printf("\n== stab gimbal: firmware + IMU sim (%d Hz FIFO) + servo plants, camera vs level ==\n", IMU_RATE_HZ);
+  printf("%-22s %12s %12s %12s %12s %10s\n", "", "pitch rms", "pitch jitter", "roll rms", "roll jitter", "fifo lost");
+  hal::resetCounters();
+  uint64_t imuBytes = 0;
+  double offRms[2] = { 0, 0 };
+  for (const Row& r : ROWS) {
+    Err e[2];
+    uint32_t lost = 0;
+    uint64_t b0 = hal::counters.i2cBytes;
+    gimbalRun(t, r.uri, settle, e, lost);
+    imuBytes = hal::counters.i2cBytes - b0;
+    printf("%-22s %10.3f d %10.3f d %10.3f d %10.3f d %10u\n", r.label, e[0].rms(), e[0].jitter(), e[1].rms(), e[1].jitter(), (unsigned)lost);
+    if (&r == ROWS) { offRms[0] = e[0].rms(); offRms[1] = e[1].rms(); }
+    else if (e[0].rms() > offRms[0] || e[1].rms() > offRms[1]) { printf("  ^ worse than stab off FAILED\n"); ok = false; }
+  }
+  double busS = imuBytes * 9.0 / IMU_I2C_HZ;
+  printf("%-22s %.0f bytes/s -> %.1f%% of the %d kHz bus\n", "I2C", imuBytes / t.seconds(), 100.0 * busS / t.seconds(),
+         IMU_I2C_HZ / 1000);
+  get("/gimbal?stab=1");
+  printf("%-22s %s\n", "result", ok ? "ok" : "FAILED");
+  return ok ? 0 : 1;
+}
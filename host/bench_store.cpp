@@ -0,0 +1,431 @@
+// Take storage (SlotStore.h) on the emulated flash (hal/FlashSim.h). Three parts:
+//   ops     start / stop / clear / mount through the firmware with ESP32
+//           NOR timings (--erase-us per sector, --page-us per page): virtual
+//           time, sector erases and journal records per operation, short
+//           takes vs a 30 min one; start/stop/clear must not grow with it,
+//           and steering without recording must not pre-erase
+//   record  --seconds of a continuously changing take into a pre-erased
+//           slot and into one holding an old take: erases in the commit
+//           path vs ahead of the head, loop() stalls, ring overflows
+//   cuts    --cuts power cuts at a random byte of a random operation
+//           (record, auto record, clear, idle pre-erase), each replayed
+//           from one image without the cut first; after remount the other
+//           slots are unchanged, the slot in flight holds its old take,
+//           nothing, or a prefix of the new one, frames lost stay within
+//           REC_RING_FRAMES + REC_BLOCK_MAX_FRAMES, and the slot records
+//           again. No flash byte may be programmed twice without an erase.
+//   legacy  boot with take files on SPIFFS: imported from an image in this
+//           partition layout; one from the default table (spiffs
+//           0x170000) does not mount and is formatted, the takes are lost
+#include "bench.h"
+#include <WebServer.h>
+#include <FlashSim.h>
+#include <SPIFFS.h>
+#include "config.h"
+#include "Recorder.h"
+#include "SlotStore.h"
+#include "SlotCatalog.h"
+
+extern WebServer server;
+extern Recorder recorder;
+extern SlotStore store;
+extern SlotCatalog catalog;
+
+static bool s_cutSeen = false;
+static uint32_t s_cutMs = 0;
+static uint32_t s_armAtMs = ~0u, s_armBytes = 0;  // timed cut: arm flashCutAfter at this millis()
+
+static void watchCut() {
+  if (s_armAtMs != ~0u && (int32_t)(millis() - s_armAtMs) >= 0) { hal::flashCutAfter(s_armBytes, s_armBytes + 1); s_armAtMs = ~0u; }
+  if (!s_cutSeen && hal::flashPoweredOff()) { s_cutSeen = true; s_cutMs = millis(); }
+}
+static void get(const char* uri) { server.sim_enqueue(HTTP_GET, uri); while (server.sim_pending()) loop(); watchCut(); }
+static void run(uint32_t ms) { for (uint32_t i = 0; i < ms; ++i) { loop(); hal::advanceMicros(1000); watchCut(); } }
+// The request handler alone (no recorder service or pre-erase from loop())
+static void handle(const char* uri) { server.sim_enqueue(HTTP_GET, uri); while (server.sim_pending()) server.handleClient(); }
+static void steer(uint32_t t) {
+  char q[64];
+  snprintf(q, sizeof(q), "/ctl_servos?x=%.3f&y=0", 0.6f * sinf(t / 700.0f) + 0.3f * sinf(t / 130.0f));
+  get(q);
+}
+// Records ms of a changing steer (wheels stopped, so the take is all servo motion)
+static void recordFor(uint32_t ms) {
+  for (uint32_t t = 0; t < ms; t += 20) { steer(t); run(20); }
+}
+
+// The store as a device reboot sees it
+static bool reboot() {
+  recorder.stopRecording();
+  recorder.stopPlayback();
+  hal::flashPowerOn();
+  bool ok = store.begin();
+  recorder.begin(store);
+  catalog.begin(store);
+  return ok;
+}
+
+// Committed contents of every slot
+struct Image {
+  SlotMeta m[REC_SLOTS];
+  std::vector<uint8_t> data[REC_SLOTS];
+  int next = 0;
+};
+static Image snapshot() {
+  Image im;
+  im.next = store.next();
+  for (int s = 1; s <= REC_SLOTS; ++s) {
+    im.m[s - 1] = store.meta(s);
+    uint8_t blk[REC_BLOCK_BYTES];
+    for (uint32_t b = 0; b < store.meta(s).blocks && store.readBlock(s, b, blk); ++b)
+      im.data[s - 1].insert(im.data[s - 1].end(), blk, blk + REC_BLOCK_BYTES);
+  }
+  return im;
+}
+static bool sameSlot(const Image& a, const Image& b, int s) {
+  return !memcmp(&a.m[s - 1], &b.m[s - 1], sizeof(SlotMeta)) && a.data[s - 1] == b.data[s - 1];
+}
+// Frame times of a slot's take
+static std::vector<uint32_t> frameTimes(const Image& im, int s) {
+  std::vector<uint32_t> t;
+  RecPacked dec[REC_BLOCK_MAX_FRAMES];
+  for (size_t o = 0; o + REC_BLOCK_BYTES <= im.data[s - 1].size(); o += REC_BLOCK_BYTES) {
+    const uint8_t* blk = &im.data[s - 1][o];
+    int n = recDecodeBlock(blk, im.m[s - 1].version, im.m[s - 1].sampleMs, dec, REC_BLOCK_MAX_FRAMES);
+    for (int i = 0; i < n; ++i) t.push_back(((const RecBlockHeader*)blk)->t0 + dec[i].dt);
+  }
+  return t;
+}
+
+// A sine take of ms at 20 Hz
+static std::vector<RecFrame> sineTake(uint32_t ms) {
+  std::vector<RecFrame> take;
+  for (uint32_t t = 0; t < ms; t += 50) {
+    float s = sinf(2.0f * (float)M_PI * 0.2f * t / 1000.0f);
+    take.push_back(RecFrame{ t, 1, 0.5f * s, 0.0f, MODE_NORMAL, 1.0f, SPEED_NORMAL,
+                             (int16_t)(SERVO_CENTER + (int)(25 * s)), (int16_t)(SERVO_CENTER - (int)(25 * s)) });
+  }
+  return take;
+}
+// ... written straight into the store
+static bool writeTake(int slot, uint32_t ms) {
+  std::vector<RecFrame> take = sineTake(ms);
+  RecFileHeader h;
+  recInitHeader(h, 50);
+  auto enc = benchEncodeTake(take, h.version);
+  if (enc.size() > REC_STORE_SLOT_BLOCKS || !store.open(slot, h.version, 50)) return false;
+  for (const auto& b : enc) if (!store.append(b.data())) return false;
+  return store.close((uint32_t)take.size(), take.back().t);
+}
+
+// ---- ops ----
+struct OpCost { uint64_t us, erases, records, programs, reads; };
+template <typename F> static OpCost measure(F fn) {
+  hal::FlashStats f0 = hal::flashStats();
+  SlotStore::Stats s0 = store.stats();
+  uint64_t t0 = hal::nowMicros();
+  fn();
+  const hal::FlashStats& f = hal::flashStats();
+  return OpCost{ hal::nowMicros() - t0, f.erases - f0.erases, store.stats().journalWrites - s0.journalWrites,
+                 f.programs - f0.programs, f.reads - f0.reads };
+}
+static void printCost(const char* label, const OpCost& c) {
+  printf("%-30s %9.1f ms %7u %8u %9u %7u\n", label, c.us / 1000.0, (unsigned)c.erases, (unsigned)c.records,
+         (unsigned)c.programs, (unsigned)c.reads);
+}
+
+static bool partOps(uint32_t eraseUs, uint32_t pageUs) {
+  printf("\n== store ops: erase %u us / sector, program %u us / page, %u-sector slots ==\n",
+         (unsigned)eraseUs, (unsigned)pageUs, (unsigned)REC_STORE_SLOT_SECTORS);
+  printf("%-30s %12s %7s %8s %9s %7s\n", "operation", "time", "erases", "records", "programs", "reads");
+  bool ok = true;
+  for (int s = 1; s <= REC_SLOTS; ++s) { char q[32]; snprintf(q, sizeof(q), "/rec/clear?slot=%d", s); get(q); }
+  ok &= writeTake(3, 30 * 60000u) && writeTake(4, 30 * 60000u);
+  hal::flashSetCostUs(eraseUs, pageUs);
+  OpCost c;
+  // steering servos in motion: no idle pre-erase of a cleared take
+  ok &= writeTake(5, 60000);
+  get("/rec/clear?slot=5");
+  c = measure([]{ recordFor(5000); });              printCost("steer 5 s, not recording", c);
+  ok &= c.erases == 0;
+  // idle until the empty slots are pre-erased (one sector per REC_STORE_ERASE_MS)
+  run(3 * REC_STORE_SLOT_SECTORS * REC_STORE_ERASE_MS + 1000);
+
+  c = measure([]{ handle("/rec/start?slot=1"); });  printCost("start (pre-erased slot)", c);
+  ok &= c.erases == 0 && c.records == 1;
+  recordFor(2000);
+  c = measure([]{ handle("/rec/stop"); });          printCost("stop (2 s take)", c);
+  ok &= c.erases == 0 && c.records == 1;
+  c = measure([]{ handle("/rec/start?slot=3"); });  printCost("start (over a 30 min take)", c);
+  ok &= c.erases == 1 && c.records == 2;
+  recordFor(2000);
+  c = measure([]{ handle("/rec/stop"); });          printCost("stop (2 s take)", c);
+  c = measure([]{ handle("/rec/start"); });         printCost("start (auto slot)", c);
+  ok &= c.erases <= 1 && c.records <= 2;
+  recordFor(60000);
+  c = measure([]{ handle("/rec/stop"); });          printCost("stop (60 s take)", c);
+  ok &= c.erases == 0 && c.records == 1;
+  c = measure([]{ handle("/rec/clear?slot=1"); });  printCost("clear (2 s take)", c);
+  ok &= c.erases == 0 && c.records == 1;
+  c = measure([]{ handle("/rec/clear?slot=4"); });  printCost("clear (30 min take)", c);
+  ok &= c.erases == 0 && c.records == 1;
+  c = measure([]{ handle("/rec/list"); });          printCost("list", c);
+  ok &= c.reads == 0;
+
+  static SlotStore fresh;
+  c = measure([]{ fresh.begin(); });             printCost("mount", c);
+  ok &= c.erases == 0 && c.records == 0;
+  // a take left open by a power cut: mount scans its blocks once
+  ok &= writeTake(4, 20 * 60000u);
+  Image before = snapshot();
+  ok &= store.open(2, before.m[3].version, 50);
+  for (uint32_t b = 0; b < before.m[3].blocks; ++b) ok &= store.append(&before.data[3][b * REC_BLOCK_BYTES]);
+  c = measure([]{ fresh.begin(); });
+  char lbl[48]; snprintf(lbl, sizeof(lbl), "mount (recover %u blocks)", (unsigned)before.m[3].blocks);
+  printCost(lbl, c);
+  ok &= fresh.meta(2).state == SLOT_DONE && fresh.meta(2).blocks == before.m[3].blocks
+     && fresh.meta(2).frames == before.m[3].frames && fresh.meta(2).lastT == before.m[3].lastT;
+  ok &= reboot();  // the journal moved on under the firmware's store
+  hal::flashSetCostUs(0, 0);
+  return ok;
+}
+
+// ---- record ----
+static bool recordTake(const char* label, int slot, uint32_t seconds) {
+  char q[32]; snprintf(q, sizeof(q), "/rec/start?slot=%d", slot);
+  SlotStore::Stats s0 = store.stats();
+  get(q);
+  uint32_t startMs = millis();
+  uint64_t maxLoopUs = 0, stalls = 0;
+  for (uint32_t t = 0; t < seconds * 1000; t += 20) {
+    steer(t);
+    for (int i = 0; i < 20; ++i) {
+      uint64_t a = hal::nowMicros();
+      loop();
+      uint64_t d = hal::nowMicros() - a;
+      maxLoopUs = std::max(maxLoopUs, d);
+      if (d > 10000) stalls++;
+      hal::advanceMicros(1000);
+    }
+  }
+  uint32_t expected = (millis() - startMs) / 50 + 1;  // erase stalls stretch the take
+  get("/rec/stop");
+  const SlotMeta& m = store.meta(slot);
+  bool ok = m.state == SLOT_DONE && recorder.ringOverflows() == 0 && m.frames + 2 >= expected && m.frames <= expected + 2;
+  printf("%-22s %6u %7u %6u %10u %9.1f %7u %6u/%-5u %s\n", label, (unsigned)m.blocks,
+         (unsigned)(store.stats().erases - s0.erases), (unsigned)(store.stats().syncErases - s0.syncErases),
+         (unsigned)stalls, maxLoopUs / 1000.0, (unsigned)recorder.ringHighWater(), (unsigned)m.frames,
+         (unsigned)expected, ok ? "ok" : "FAILED");
+  return ok;
+}
+
+static bool partRecord(uint32_t eraseUs, uint32_t pageUs, uint32_t seconds) {
+  printf("\n== store record: %u s of changing steer at 20 Hz, erase %u us, control inline ==\n",
+         (unsigned)seconds, (unsigned)eraseUs);
+  printf("%-22s %6s %7s %6s %10s %9s %7s %12s\n", "slot", "blocks", "erases", "sync", "stalls>10ms",
+         "max loop", "ring hi", "frames");
+  bool ok = writeTake(2, 30 * 60000u);
+  get("/rec/clear?slot=1");
+  run(2 * REC_STORE_SLOT_SECTORS * REC_STORE_ERASE_MS + 1000);  // slot 1 pre-erased, slot 2 keeps its take
+  hal::flashSetCostUs(eraseUs, pageUs);
+  ok &= recordTake("pre-erased", 1, seconds);
+  ok &= recordTake("over a 30 min take", 2, seconds);
+  hal::flashSetCostUs(0, 0);
+  printf("%-22s on ESP32 an erase also stalls the control core (flash cache off); see README\n", "note");
+  return ok;
+}
+
+// ---- cuts ----
+enum { OP_REC, OP_AUTO, OP_CLEAR, OP_IDLE };
+struct Op { int kind, slot; uint32_t ms, idleMs; };
+
+static void runOp(const Op& op, uint32_t& startMs) {
+  steer(0);
+  run(op.idleMs);
+  startMs = millis();
+  if (op.kind == OP_REC || op.kind == OP_AUTO) {
+    char q[32];
+    if (op.kind == OP_REC) snprintf(q, sizeof(q), "/rec/start?slot=%d", op.slot);
+    else snprintf(q, sizeof(q), "/rec/start");
+    get(q);
+    startMs = millis();
+    recordFor(op.ms);
+    get("/rec/stop");
+  } else if (op.kind == OP_CLEAR) {
+    char q[32]; snprintf(q, sizeof(q), "/rec/clear?slot=%d", op.slot);
+    get(q);
+  }
+}
+
+// Same virtual clock phase for the dry run and the cut run
+static void align() { hal::advanceMicros(1000000 - hal::nowMicros() % 1000000); }
+
+static bool partCuts(int cuts, uint32_t seed) {
+  printf("\n== store cuts: %d power cuts, seed %u ==\n", cuts, (unsigned)seed);
+  bool ok = true;
+  // Baseline: takes in 1..3, slot 4 cleared (dirty), slot 5 never used
+  hal::flashWipe(REC_STORE_LABEL);
+  ok &= reboot();
+  ok &= writeTake(1, 90000) && writeTake(2, 5 * 60000u) && writeTake(3, 20000) && writeTake(4, 60000);
+  ok &= store.clear(4) && store.setNext(2);
+  std::vector<uint8_t> img;
+  ok &= hal::flashSave(REC_STORE_LABEL, img);
+  if (!ok) { printf("baseline failed: %s\n", store.lastError()); return false; }
+
+  const char* KIND[] = { "record", "auto", "clear", "idle" };
+  int outcome[4][4] = {};  // kind x { old, empty, prefix, complete }
+  uint32_t maxLost = 0, failures = 0;
+  uint64_t over0 = hal::flashStats().overprograms;
+  uint32_t rng = seed;
+  auto rnd = [&](uint32_t n) { rng = rng * 1103515245u + 12345u; return (rng >> 8) % n; };
+
+  for (int i = 0; i < cuts; ++i) {
+    Op op{ (int)rnd(4), 1 + (int)rnd(REC_SLOTS), 300 + rnd(8000), rnd(3) ? 0 : rnd(2000) };
+    if (op.kind == OP_IDLE) op.idleMs = 500 + rnd(2000);
+    int slot = op.kind == OP_AUTO ? 2 : op.slot;
+
+    hal::flashLoad(REC_STORE_LABEL, img);
+    reboot();
+    Image base = snapshot();
+    align();
+    hal::FlashStats f0 = hal::flashStats();
+    uint32_t start, cutStart, t0 = millis();
+    runOp(op, start);
+    uint32_t dur = millis() - t0;
+    uint64_t total = (hal::flashStats().programBytes - f0.programBytes) + (hal::flashStats().erases - f0.erases) * REC_STORE_SECTOR;
+    Image dry = snapshot();
+    if (!total) continue;
+
+    // half the cuts at a random byte of the operation (mostly inside erases,
+    // which dominate the bytes), half at a random time plus a few bytes
+    bool timed = rnd(2);
+    uint64_t at = timed ? rnd(512) : rnd((uint32_t)total);
+    hal::flashLoad(REC_STORE_LABEL, img);
+    reboot();
+    align();
+    s_cutSeen = false;
+    if (timed) { s_armAtMs = millis() + rnd(dur + 1); s_armBytes = (uint32_t)at; }
+    else hal::flashCutAfter(at, i + 1);
+    runOp(op, cutStart);
+    s_armAtMs = ~0u;
+    bool mounted = reboot();
+    Image got = snapshot();
+
+    bool good = mounted;
+    for (int s = 1; s <= REC_SLOTS; ++s) if (s != slot) good &= sameSlot(got, base, s);
+    good &= got.next == base.next || got.next == dry.next;
+    const SlotMeta& m = got.m[slot - 1];
+    int kind = -1;
+    if (sameSlot(got, base, slot)) kind = 0;
+    else if (m.state == SLOT_EMPTY && got.data[slot - 1].empty()) kind = 1;
+    else if (op.kind <= OP_AUTO && m.state == SLOT_DONE && m.version == dry.m[slot - 1].version
+             && m.blocks <= dry.m[slot - 1].blocks
+             && std::equal(got.data[slot - 1].begin(), got.data[slot - 1].end(), dry.data[slot - 1].begin()))
+      kind = m.blocks == dry.m[slot - 1].blocks ? 3 : 2;
+    if (op.kind == OP_IDLE) good &= kind == 0;
+    if (op.kind == OP_CLEAR) good &= kind == 0 || kind == 1;
+    good &= kind >= 0;
+    if (kind >= 2) {
+      std::vector<uint32_t> t = frameTimes(got, slot);
+      good &= m.frames == t.size() && !t.empty() && m.lastT == t.back();
+    }
+
+    // Frames captured before the cut that did not survive it
+    if (op.kind <= OP_AUTO && s_cutSeen && s_cutMs >= cutStart && kind != 0) {
+      std::vector<uint32_t> t = frameTimes(dry, slot);
+      uint32_t captured = (uint32_t)(std::upper_bound(t.begin(), t.end(), s_cutMs - cutStart) - t.begin());
+      uint32_t kept = kind >= 2 ? m.frames : 0;
+      uint32_t lost = captured > kept ? captured - kept : 0;
+      maxLost = std::max(maxLost, lost);
+      good &= lost <= REC_RING_FRAMES + REC_BLOCK_MAX_FRAMES;
+    }
+
+    // The slot records again
+    char q[32]; snprintf(q, sizeof(q), "/rec/start?slot=%d", slot);
+    get(q); recordFor(1500); get("/rec/stop");
+    good &= store.meta(slot).state == SLOT_DONE && store.meta(slot).frames >= 25;
+
+    if (kind >= 0) outcome[op.kind][kind]++;
+    if (!good) {
+      failures++;
+      printf("FAILED cut %d: %s slot %d, %u ms, idle %u, %s %llu of %llu -> state %u blocks %u (dry %u)\n", i,
+             KIND[op.kind], slot, (unsigned)op.ms, (unsigned)op.idleMs, timed ? "timed, bytes" : "at byte",
+             (unsigned long long)at, (unsigned long long)total,
+             (unsigned)m.state, (unsigned)m.blocks, (unsigned)dry.m[slot - 1].blocks);
+    }
+  }
+  uint64_t over = hal::flashStats().overprograms - over0;
+  printf("%-10s %6s %6s %7s %9s\n", "op", "old", "empty", "prefix", "complete");
+  for (int k = 0; k < 4; ++k)
+    printf("%-10s %6d %6d %7d %9d\n", KIND[k], outcome[k][0], outcome[k][1], outcome[k][2], outcome[k][3]);
+  printf("%-22s %u (bound %u = ring %u + block %u)\n", "max frames lost", (unsigned)maxLost,
+         (unsigned)(REC_RING_FRAMES + REC_BLOCK_MAX_FRAMES), (unsigned)REC_RING_FRAMES, (unsigned)REC_BLOCK_MAX_FRAMES);
+  printf("%-22s %llu\n", "bytes overprogrammed", (unsigned long long)over);
+  printf("%-22s %u of %d\n", "failed", (unsigned)failures, cuts);
+  return failures == 0 && over == 0;
+}
+
+// ---- legacy ----
+// Boot with /rec1.bin and /rec_next.txt on a SPIFFS formatted for a
+// partition of partBytes: mount (formatting on failure, as setup() does),
+// then importSpiffs(). In this layout the take must land in slot 1; an
+// image from the default table (0x170000) must not mount, and the format
+// leaves no take and no files behind.
+static bool legacyBoot(const char* label, uint32_t partBytes) {
+  hal::flashWipe(REC_STORE_LABEL);
+  reboot();
+  hal::setFsFormattedBytes(partBytes);
+  std::vector<RecFrame> take = sineTake(60000);
+  RecFileHeader h;
+  recInitHeader(h, 50);
+  File f = SPIFFS.open("/rec1.bin", FILE_WRITE);
+  f.write((const uint8_t*)&h, sizeof(h));
+  for (const auto& b : benchEncodeTake(take, h.version)) f.write(b.data(), REC_BLOCK_BYTES);
+  f.close();
+  f = SPIFFS.open("/rec_next.txt", FILE_WRITE);
+  f.print("3");
+  f.close();
+
+  bool mounted = SPIFFS.begin(false);
+  if (!mounted) SPIFFS.begin(true);
+  int moved = recorder.importSpiffs();
+  const SlotMeta& m = store.meta(1);
+  bool left = SPIFFS.exists("/rec1.bin") || SPIFFS.exists("/rec_next.txt");
+  printf("%-30s %-9s %5d %8u %5d %5s\n", label, mounted ? "mounted" : "formatted", moved, (unsigned)m.frames,
+         store.next(), left ? "yes" : "no");
+  bool same = partBytes == SPIFFS_PART_BYTES;
+  return same ? mounted && moved == 1 && m.frames == take.size() && store.next() == 3 && !left
+              : !mounted && moved == 0 && m.state == SLOT_EMPTY && !left;
+}
+static bool partLegacy() {
+  printf("\n== store legacy: SPIFFS takes from older firmware at boot (spiffs partition 0x%X) ==\n",
+         (unsigned)SPIFFS_PART_BYTES);
+  printf("%-30s %-9s %5s %8s %5s %5s\n", "image", "SPIFFS", "moved", "frames", "next", "files");
+  bool ok = legacyBoot("this table (0x60000)", SPIFFS_PART_BYTES);
+  ok &= legacyBoot("default table (0x170000)", 0x170000);
+  hal::setFsFormattedBytes(SPIFFS_PART_BYTES);
+  return ok;
+}
+
+int benchStore(int argc, char** argv) {
+  uint32_t eraseUs = (uint32_t)benchArg(argc, argv, "--erase-us", 45000);
+  uint32_t pageUs  = (uint32_t)benchArg(argc, argv, "--page-us", 700);
+  uint32_t seconds = (uint32_t)benchArg(argc, argv, "--seconds", 300);
+  int cuts = (int)benchArg(argc, argv, "--cuts", 500);
+  uint32_t seed = (uint32_t)benchArg(argc, argv, "--seed", 1);
+  hal::setFsRoot(benchArgStr(argc, argv, "--fs", "bench_fs"));
+  hal::useVirtualClock(true);
+  hal::setTasksEnabled(false);
+  hal::flashWipe(REC_STORE_LABEL);  // same journal position every run
+  setup();
+  get("/ui/manual_steer?on=1");
+
+  bool ok = true;
+  if (!benchFlag(argc, argv, "--cuts-only")) {
+    ok &= partOps(eraseUs, pageUs);
+    ok &= partRecord(eraseUs, pageUs, seconds);
+  }
+  ok &= partCuts(cuts, seed);
+  ok &= partLegacy();
+  printf("%-22s %s\n", "result", ok ? "ok" : "FAILED");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,127 @@
+// Span tracing: cost of one TRACE_SCOPE (recording on / paused), then a
+// scripted session (real clock, control inline, recording + playback)
+// dumped through GET /trace and checked: valid Chrome trace events, the
+// expected span names, proper nesting per core, spans ranked by time.
+#include "bench.h"
+#include <WebServer.h>
+#include <FS.h>
+#include <map>
+#include <string>
+#include "Trace.h"
+
+extern WebServer server;
+
+static volatile uint32_t s_sink;
+
+struct Span { std::string name; unsigned tid; double ts, dur; };
+
+// Pulls the "ph":"X" events out of the /trace body (the format Trace.cpp writes)
+static bool parseSpans(const std::string& js, std::vector<Span>& out, unsigned& spansField) {
+  if (js.compare(0, 2, "{\"") != 0 || js.find("\"traceEvents\":[") == std::string::npos) return false;
+  size_t o = js.find("\"spans\":");
+  spansField = o == std::string::npos ? 0 : (unsigned)strtoul(js.c_str() + o + 8, nullptr, 10);
+  size_t p = 0;
+  while ((p = js.find("{\"name\":\"", p)) != std::string::npos) {
+    size_t q = js.find('"', p + 9);
+    if (q == std::string::npos) return false;
+    Span s; s.name = js.substr(p + 9, q - p - 9);
+    const char* rest = js.c_str() + q;
+    if (strncmp(rest, "\",\"ph\":\"M\"", 10) == 0) { p = js.find("}}", q); continue; }  // metadata, has args
+    if (sscanf(rest, "\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%lf,\"dur\":%lf}", &s.tid, &s.ts, &s.dur) != 3) return false;
+    out.push_back(s);
+    p = q;
+  }
+  return js.find("]}", js.size() - 3) != std::string::npos;
+}
+
+// Spans on one core must nest or be disjoint (they are scopes on one stack)
+static int nestingErrors(std::vector<Span> v) {
+  std::sort(v.begin(), v.end(), [](const Span& a, const Span& b) {
+    return a.tid != b.tid ? a.tid < b.tid : a.ts != b.ts ? a.ts < b.ts : a.dur > b.dur; });
+  int bad = 0;
+  std::vector<const Span*> stack;
+  for (size_t i = 0; i < v.size(); ++i) {
+    if (i && v[i].tid != v[i - 1].tid) stack.clear();
+    while (!stack.empty() && stack.back()->ts + stack.back()->dur <= v[i].ts + 0.01) stack.pop_back();
+    if (!stack.empty() && v[i].ts + v[i].dur > stack.back()->ts + stack.back()->dur + 0.01) bad++;
+    if (v[i].ts < 0 || v[i].dur < 0) bad++;
+    stack.push_back(&v[i]);
+  }
+  return bad;
+}
+
+int benchTrace(int argc, char** argv) {
+  long spans = benchArg(argc, argv, "--spans", 20000000);
+  long iters = benchArg(argc, argv, "--iters", 6000);
+  const char* outPath = benchArgStr(argc, argv, "--out", nullptr);
+  hal::setFsRoot(benchArgStr(argc, argv, "--fs", "bench_fs"));
+  hal::setTasksEnabled(false);
+
+  // Per-span cost against the bare loop
+  uint32_t x = 1;
+  uint64_t t0 = benchNowNs();
+  for (long i = 0; i < spans; ++i) { x = x * 1664525u + 1013904223u; s_sink = x; }
+  uint64_t t1 = benchNowNs();
+  for (long i = 0; i < spans; ++i) { TRACE_SCOPE("bench"); x = x * 1664525u + 1013904223u; s_sink = x; }
+  uint64_t t2 = benchNowNs();
+  traceEnable(false);
+  for (long i = 0; i < spans; ++i) { TRACE_SCOPE("bench"); x = x * 1664525u + 1013904223u; s_sink = x; }
+  uint64_t t3 = benchNowNs();
+  traceEnable(true);
+  double base = (double)(t1 - t0) / spans;
+
+  // Session: drive + planner steering left/right, record a take, play it back
+  setup();
+  hal::setFsFlushCostUs(3000);
+  server.sim_enqueue(HTTP_GET, "/ui/manual_steer?on=0");
+  server.sim_enqueue(HTTP_GET, "/trace?clear=1");
+  server.sim_enqueue(HTTP_GET, "/rec/start?slot=4");
+  for (long i = 0; i < iters; ++i) {
+    if (i == iters / 2) {
+      server.sim_enqueue(HTTP_GET, "/rec/stop");
+      server.sim_enqueue(HTTP_GET, "/rec/play?slot=4");
+    }
+    if (i % 16 == 0) server.sim_enqueue(HTTP_GET, i % 32 ? "/ctl_drive?y=0.300"
+                                        : i % 256 < 128 ? "/ctl_steer?x=0.4&y=0&mode=0&diam=1" : "/ctl_steer?x=-0.4&y=0&mode=0&diam=1");
+    loop();
+    delayMicroseconds(200);
+  }
+  uint32_t recorded = traceCount();
+  server.sim_enqueue(HTTP_GET, "/trace");
+  loop();
+  const SimHttpResponse& r = server.sim_lastResponse();
+  std::string js = r.body;
+  server.sim_enqueue(HTTP_GET, "/rec/abort");
+  while (server.sim_pending()) loop();
+
+  std::vector<Span> v;
+  unsigned spansField = 0;
+  bool parsed = r.code == 200 && parseSpans(js, v, spansField);
+  std::map<std::string, std::pair<int, std::pair<double, double>>> by;  // name -> count, (total, max) us
+  for (const Span& s : v) {
+    auto& e = by[s.name];
+    e.first++; e.second.first += s.dur;
+    if (s.dur > e.second.second) e.second.second = s.dur;
+  }
+  static const char* WANT[] = { "loop", "control", "planSteering", "servo.write", "wheel.pwm", "rec.tick", "/ctl_drive" };
+  int missing = 0;
+  for (const char* w : WANT) if (!by.count(w)) { printf("missing span: %s\n", w); missing++; }
+  int bad = parsed ? nestingErrors(v) : -1;
+
+  printf("\n== trace: %s, ring %d spans ==\n", TRACE_ENABLED ? "enabled" : "compiled out", TRACE_RING_EVENTS);
+  printf("%-22s %.2f ns/span (on), %.2f ns/span (paused), loop body %.2f ns\n", "TRACE_SCOPE",
+         (double)(t2 - t1) / spans - base, (double)(t3 - t2) / spans - base, base);
+  printf("%-22s %u spans recorded, %zu in the dump (%zu B), json %s, nesting errors %d, missing names %d\n",
+         "GET /trace", (unsigned)recorded, v.size(), js.size(), parsed ? "ok" : "FAILED", bad, missing);
+  std::vector<std::pair<std::string, std::pair<int, std::pair<double, double>>>> rank(by.begin(), by.end());
+  std::sort(rank.begin(), rank.end(), [](const auto& a, const auto& b) { return a.second.second.second > b.second.second.second; });
+  printf("%-22s %6s %12s %10s %10s\n", "span", "count", "total us", "mean us", "max us");
+  for (const auto& e : rank)
+    printf("%-22s %6d %12.1f %10.2f %10.1f\n", e.first.c_str(), e.second.first, e.second.second.first,
+           e.second.second.first / e.second.first, e.second.second.second);
+  if (outPath) {
+    FILE* f = fopen(outPath, "wb");
+    if (f) { fwrite(js.data(), 1, js.size(), f); fclose(f); printf("wrote %s (open in ui.perfetto.dev)\n", outPath); }
+  }
+  return (parsed && bad == 0 && (!TRACE_ENABLED || missing == 0)) ? 0 : 1;
+}
@@ -0,0 +1,60 @@
+// UI asset delivery. Serves GET / cold and revalidated (If-None-Match) and
+// checks: 200 carries the gzip body (magic 1f 8b, UI_INDEX_GZ_LEN bytes),
+// Content-Encoding and the ETag; a matching ETag gets 304 with no body, a
+// stale one the full page. Sizes per stage of tools/build_ui.py and a
+// modeled load time at --kbps / --rtt-ms (one round trip + body bytes).
+#include "bench.h"
+#include <WebServer.h>
+#include <FS.h>
+#include "ui_index.h"
+
+extern WebServer server;
+
+static const SimHttpResponse& getIndex(const char* etag) {
+  std::vector<std::pair<std::string, std::string>> h;
+  if (etag) h.push_back({ "If-None-Match", etag });
+  server.sim_enqueue(HTTP_GET, "/", h);
+  while (server.sim_pending()) loop();
+  return server.sim_lastResponse();
+}
+
+static std::string hdr(const SimHttpResponse& r, const char* name) {
+  for (auto& h : r.headers) if (strcasecmp(h.first.c_str(), name) == 0) return h.second;
+  return "";
+}
+
+int benchUi(int argc, char** argv) {
+  double kbps = (double)benchArg(argc, argv, "--kbps", 1000);
+  double rtt  = (double)benchArg(argc, argv, "--rtt-ms", 20);
+  hal::setFsRoot(benchArgStr(argc, argv, "--fs", "bench_fs"));
+  hal::useVirtualClock(true);
+  hal::setTasksEnabled(false);
+  setup();
+
+  bool ok = true;
+  auto check = [&](bool c, const char* what) { if (!c) { printf("FAIL: %s\n", what); ok = false; } };
+
+  const auto& cold = getIndex(nullptr);
+  size_t coldBytes = cold.body.size();
+  check(cold.code == 200, "cold GET / -> 200");
+  check(coldBytes == UI_INDEX_GZ_LEN && (uint8_t)cold.body[0] == 0x1f && (uint8_t)cold.body[1] == 0x8b, "gzip body");
+  check(hdr(cold, "Content-Encoding") == "gzip", "Content-Encoding: gzip");
+  check(hdr(cold, "ETag") == UI_INDEX_ETAG, "ETag");
+  std::string etag = hdr(cold, "ETag");
+
+  const auto& hit = getIndex(etag.c_str());
+  check(hit.code == 304 && hit.body.empty(), "If-None-Match match -> 304, empty body");
+  check(hdr(hit, "ETag") == UI_INDEX_ETAG, "ETag on 304");
+  const auto& miss = getIndex("\"0000000000000000\"");
+  check(miss.code == 200 && miss.body.size() == UI_INDEX_GZ_LEN, "stale ETag -> 200");
+
+  auto ms = [&](double bytes) { return rtt + bytes * 8.0 / kbps; };
+  printf("\n== ui: GET / at %.0f kbit/s, %.0f ms RTT (modeled) ==\n", kbps, rtt);
+  printf("%-26s %7s %9s\n", "", "bytes", "load ms");
+  printf("%-26s %7d %9.1f\n", "sources (uncompressed)", UI_INDEX_SRC_BYTES, ms(UI_INDEX_SRC_BYTES));
+  printf("%-26s %7d %9.1f\n", "minified", UI_INDEX_MIN_BYTES, ms(UI_INDEX_MIN_BYTES));
+  printf("%-26s %7zu %9.1f\n", "gzip (cold 200)", coldBytes, ms(coldBytes));
+  printf("%-26s %7d %9.1f\n", "revalidated (304)", 0, ms(0));
+  printf("%-26s %s\n", "checks", ok ? "ok" : "FAILED");
+  return ok ? 0 : 1;
+}
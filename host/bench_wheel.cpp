@@ -0,0 +1,128 @@
+// Wheel speed loop against the DC motor + encoder plant (hal/MotorSim.h),
+// virtual clock, update() at CONTROL_RATE_HZ like the control step:
+//   step      0 -> 60% -> 30% target: rise, overshoot, settling, error
+//   load      0.3 N*m load step at 60%: dip and recovery
+//   saturate  100% at 10.5 V (unreachable) then 50%: anti-windup recovery
+//   repeat    steady speed at 60% over battery x load, open vs closed loop
+//   cost      update() ns per loop iteration (host)
+// Gains default to config.h; override with --kp --ki --kd --kff --ks.
+#include "bench.h"
+#include <MotorSim.h>
+#include "config.h"
+#include "WheelControl.h"
+
+static float argF(int argc, char** argv, const char* name, float def) {
+  const char* s = benchArgStr(argc, argv, name, nullptr);
+  return s ? (float)atof(s) : def;
+}
+
+static const float CPS_PER_RADS = 1320.0f / (2.0f * (float)M_PI); // MotorParams().cpr
+static const uint32_t CTL_MS = 1000 / CONTROL_RATE_HZ;
+
+// Runs ms of virtual time; speed of the left wheel in % of maxCps per ms
+static std::vector<float> run(WheelControl& w, uint32_t ms) {
+  std::vector<float> v;
+  for (uint32_t i = 0; i < ms; ++i) {
+    hal::advanceMicros(1000);
+    if (millis() % CTL_MS == 0) w.update(millis());
+    v.push_back(100.0f * hal::motorSpeed(0) * CPS_PER_RADS / WHEEL_MAX_CPS);
+  }
+  return v;
+}
+
+static float pct(int spd) { return 100.0f * spd / 255.0f; }
+
+static float meanTail(const std::vector<float>& v, size_t n) {
+  float s = 0; for (size_t i = v.size() - n; i < v.size(); ++i) s += v[i]; return s / n;
+}
+
+// Step from v[0] toward target (%): 10-90% rise, overshoot, last exit from +-5% band
+static void stepRow(const char* lbl, const std::vector<float>& v, float from, float target) {
+  float span = target - from, t10 = -1, t90 = -1, peak = from, settle = 0;
+  for (size_t i = 0; i < v.size(); ++i) {
+    float f = (v[i] - from) / span;
+    if (t10 < 0 && f >= 0.1f) t10 = (float)i;
+    if (t90 < 0 && f >= 0.9f) t90 = (float)i;
+    if ((span > 0 && v[i] > peak) || (span < 0 && v[i] < peak)) peak = v[i];
+    if (fabsf(v[i] - target) > 0.05f * fabsf(target)) settle = (float)(i + 1);
+  }
+  float os = 100.0f * (peak - target) / span;
+  printf("%-22s rise %5.0f ms  overshoot %5.1f%%  settle(5%%) %5.0f ms  error %+5.2f%%\n",
+         lbl, t90 - t10, os > 0 ? os : 0.0f, settle, meanTail(v, 300) - target);
+}
+
+int benchWheel(int argc, char** argv) {
+  WheelLoopCfg cfg{ argF(argc, argv, "--kp", WHEEL_KP), argF(argc, argv, "--ki", WHEEL_KI),
+                    argF(argc, argv, "--kd", WHEEL_KD), argF(argc, argv, "--kff", WHEEL_KFF),
+                    argF(argc, argv, "--ks", WHEEL_KS), WHEEL_MAX_CPS, WHEEL_LOOP_MS };
+  int iters = (int)benchArg(argc, argv, "--iters", 20000);
+  hal::useVirtualClock(true);
+  hal::motorsReset();
+  WheelPins p{ L298_IN1, L298_IN2, L298_ENA, L298_IN3, L298_IN4, L298_ENB };
+  static WheelControl w;  // not the firmware's instance; setup() is not run
+  w.begin(p, WHEEL_PWM_FREQ_HZ, WHEEL_PWM_BITS);
+  hal::motorAttach(L298_IN1, L298_IN2, L298_ENA, WHEEL_ENC_LA, WHEEL_ENC_LB, WHEEL_PWM_BITS);
+  hal::motorAttach(L298_IN3, L298_IN4, L298_ENB, WHEEL_ENC_RA, WHEEL_ENC_RB, WHEEL_PWM_BITS);
+  hal::motorSetVbat(12.0f);
+  bool ok = w.beginSpeedLoop(cfg, WHEEL_ENC_LA, WHEEL_ENC_LB, WHEEL_ENC_RA, WHEEL_ENC_RB);
+
+  printf("\n== wheel: PI speed loop, %u ms period, kp %.2f ki %.2f kd %.3f kff %.2f ks %.3f ==\n",
+         (unsigned)cfg.periodMs, cfg.kp, cfg.ki, cfg.kd, cfg.kff, cfg.ks);
+  w.setSpeedBoth(153);
+  stepRow("step 0 -> 60% @12V", run(w, 1500), 0, pct(153));
+  w.setSpeedBoth(77);
+  stepRow("step 60 -> 30% @12V", run(w, 1500), pct(153), pct(77));
+
+  w.setSpeedBoth(153); run(w, 1000);
+  hal::motorSetLoad(0, 0.3f);
+  std::vector<float> v = run(w, 1500);
+  float dip = 60; size_t rec = 0;
+  for (size_t i = 0; i < v.size(); ++i) { dip = fminf(dip, v[i]); if (fabsf(v[i] - 60) > 3) rec = i + 1; }
+  printf("%-22s dip to %5.1f%%  back within 5%% after %4u ms  error %+5.2f%%\n",
+         "load +0.3 N*m @60%", dip, (unsigned)rec, meanTail(v, 300) - 60);
+  hal::motorSetLoad(0, 0);
+
+  hal::motorSetVbat(10.5f);
+  w.setSpeedBoth(255); run(w, 1500);
+  w.setSpeedBoth(128);
+  float sat = 100.0f * hal::motorSpeed(0) * CPS_PER_RADS / WHEEL_MAX_CPS;
+  stepRow("saturated 100 -> 50%", run(w, 1500), sat, pct(128));
+  w.coast(); run(w, 1000);
+
+  // Repeatability: open loop is plain setSpeed* duty on a second begin()
+  printf("\n%-22s %18s %18s\n", "steady 60% (% target)", "open loop", "closed loop");
+  static const float VB[] = { 12.6f, 11.1f, 10.5f };
+  static const float LD[] = { 0.0f, 0.3f };
+  float lo[2] = { 1e9f, 1e9f }, hi[2] = { -1e9f, -1e9f };
+  for (float vb : VB) for (float ld : LD) {
+    float r[2];
+    for (int closed = 0; closed < 2; ++closed) {
+      w.begin(p, WHEEL_PWM_FREQ_HZ, WHEEL_PWM_BITS);
+      if (closed) ok &= w.beginSpeedLoop(cfg, WHEEL_ENC_LA, WHEEL_ENC_LB, WHEEL_ENC_RA, WHEEL_ENC_RB);
+      hal::motorSetVbat(vb); hal::motorSetLoad(0, ld);
+      w.setSpeedBoth(153);
+      r[closed] = 100.0f * meanTail(run(w, 2000), 500) / 60.0f;
+      w.coast(); run(w, 1500);
+      lo[closed] = fminf(lo[closed], r[closed]); hi[closed] = fmaxf(hi[closed], r[closed]);
+    }
+    char lbl[32]; snprintf(lbl, sizeof(lbl), "%.1f V, load %.1f N*m", vb, ld);
+    printf("%-22s %17.1f%% %17.1f%%\n", lbl, r[0], r[1]);
+  }
+  printf("%-22s %17.1f%% %17.1f%%\n", "spread", hi[0] - lo[0], hi[1] - lo[1]);
+  hal::motorSetLoad(0, 0);
+
+  // Cost: plant integrated before timing so only update() is measured
+  std::vector<uint64_t> ns;
+  w.setSpeedBoth(153);
+  for (int i = 0; i < iters; ++i) {
+    hal::advanceMicros(cfg.periodMs * 1000u);
+    hal::motorSync();
+    uint64_t a = benchNowNs();
+    w.update(millis());
+    ns.push_back(benchNowNs() - a);
+  }
+  w.coast();
+  benchPrintPercentiles("\nupdate() both sides", ns, 1.0, "ns");
+  if (!ok) printf("beginSpeedLoop failed\n");
+  return ok ? 0 : 1;
+}
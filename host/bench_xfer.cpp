@@ -0,0 +1,389 @@
+// Take transfer: /rec/download and /rec/upload on the full firmware
+// (virtual clock, control inline, flash with ESP32 NOR timings). Parts:
+//   download  every slot filled with a full take, then downloads in turn
+//             until --mb have been sent: body vs Content-Length and the
+//             store, wall-clock MB/s of the code path, modeled MB/s
+//             (flash reads + REC_XFER_RATE_KBPS pacing), peak heap
+//   upload    each downloaded file posted to the next slot and downloaded
+//             again: byte-identical, same frames / duration
+//   http      Range (a-b, a-, -n, past the end -> 416), If-Range with a
+//             stale ETag, If-None-Match -> 304, empty slot -> 404
+//   reject    bad header, corrupted block, blocks out of order, torn size,
+//             larger than a slot, client gone mid-body, no body, rig busy:
+//             an error before the header is taken leaves the slot as it
+//             was, one after it leaves the slot empty
+//   control   a download while recording another slot: control overruns,
+//             ring overflows, commit lag
+//   stop      playback, then a download; a quarter in, a WS frame with
+//             CTL_FLAG_ABORT and GET /rec/abort: the WS abort must end
+//             playback by the next chunk, the HTTP one waits for the transfer
+// Heap: global operator new/delete are counted (live bytes, peak above
+// the start) while a transfer runs; the bench's own buffers are excluded.
+#include "bench.h"
+#include <WebServer.h>
+#include <WebSocketsServer.h>
+#include <FlashSim.h>
+#include <malloc.h>
+#include <atomic>
+#include <new>
+#include "config.h"
+#include "Recorder.h"
+#include "SlotStore.h"
+#include "ControlTask.h"
+#include "CtlProto.h"
+
+extern WebServer server;
+extern WebSocketsServer ws;
+extern Recorder recorder;
+extern SlotStore store;
+extern ControlTask ctl;
+
+// ---- heap tracking ----
+static std::atomic<bool> s_heapOn{false};
+static std::atomic<int64_t> s_heapLive{0}, s_heapPeak{0};
+
+static void heapAdd(int64_t n) {
+  int64_t v = s_heapLive += n, p = s_heapPeak.load();
+  while (v > p && !s_heapPeak.compare_exchange_weak(p, v)) {}
+}
+void* operator new(size_t n) {
+  void* p = malloc(n ? n : 1);
+  if (!p) throw std::bad_alloc();
+  if (s_heapOn) heapAdd((int64_t)malloc_usable_size(p));
+  return p;
+}
+void operator delete(void* p) noexcept {
+  if (p && s_heapOn) heapAdd(-(int64_t)malloc_usable_size(p));
+  free(p);
+}
+void operator delete(void* p, size_t) noexcept { operator delete(p); }
+
+static void heapStart() { s_heapLive = 0; s_heapPeak = 0; s_heapOn = true; }
+static int64_t heapStop() { s_heapOn = false; return s_heapPeak; }
+// Bench-side work inside a transfer (sink / source) is not the firmware's
+struct HeapPause {
+  bool was = s_heapOn.exchange(false);
+  ~HeapPause() { s_heapOn = was; }
+};
+
+// ---- helpers ----
+typedef std::vector<uint8_t> Bytes;
+typedef std::vector<std::pair<std::string, std::string>> Headers;
+
+static Bytes s_rx;  // response body via the sink
+static void run(uint32_t ms) { for (uint32_t i = 0; i < ms; ++i) { loop(); hal::advanceMicros(1000); } }
+static void send(HTTPMethod m, const char* uri, Headers h = {}) {
+  s_rx.clear();
+  server.sim_enqueue(m, uri, std::move(h));
+  while (server.sim_pending()) loop();
+}
+static void recStart(int slot) {
+  char uri[32];
+  snprintf(uri, sizeof(uri), "/rec/start?slot=%d", slot);
+  send(HTTP_GET, uri);
+}
+// Response text (bodies go to the sink)
+static std::string text() { return std::string(s_rx.begin(), s_rx.end()); }
+static std::string hdr(const char* name) {
+  for (auto& h : server.sim_lastResponse().headers) if (!strcasecmp(h.first.c_str(), name)) return h.second;
+  return "";
+}
+
+static int download(int slot, Headers h = {}) {
+  char uri[40];
+  snprintf(uri, sizeof(uri), "/rec/download?slot=%d", slot);
+  send(HTTP_GET, uri, std::move(h));
+  return server.sim_lastResponse().code;
+}
+
+// Posts body (only the first cut bytes, then the client goes away) with
+// Content-Length len; returns the HTTP code, 0 = no response
+static int upload(int slot, const Bytes& body, size_t len, size_t cut = ~(size_t)0) {
+  char uri[40];
+  snprintf(uri, sizeof(uri), "/rec/upload?slot=%d", slot);
+  size_t pos = 0;
+  s_rx.clear();
+  server.sim_enqueue(HTTP_POST, uri, {}, len, [&](uint8_t* buf, size_t max) -> size_t {
+    HeapPause hp;
+    size_t n = std::min(max, std::min(body.size(), cut) - std::min(pos, std::min(body.size(), cut)));
+    memcpy(buf, body.data() + pos, n);
+    pos += n;
+    return n;
+  });
+  while (server.sim_pending()) loop();
+  // an aborted upload sends nothing: the last response is still the reset one
+  return server.sim_lastResponse().code;
+}
+
+// A take filling the slot (sine steer, amplitude per slot) straight into the store
+static bool fillSlot(int slot) {
+  std::vector<RecFrame> take;
+  float a = 10.0f + 3.0f * slot;
+  for (uint32_t t = 0; t < 3u * 3600 * 1000; t += 50) {
+    float s = sinf(2.0f * (float)M_PI * 0.2f * t / 1000.0f) * sinf(t / (5000.0f + 900.0f * slot));
+    take.push_back(RecFrame{ t, 1, 0.5f * s, 0.2f * slot / REC_SLOTS, MODE_NORMAL, 1.0f, SPEED_NORMAL,
+                             (int16_t)(SERVO_CENTER + (int)(a * s)), (int16_t)(SERVO_CENTER - (int)(a * s)) });
+  }
+  RecFileHeader h;
+  recInitHeader(h, 50);
+  auto enc = benchEncodeTake(take, h.version);
+  if (enc.size() < REC_STORE_SLOT_BLOCKS || !store.open(slot, h.version, 50)) return false;
+  static RecPacked tmp[REC_BLOCK_MAX_FRAMES];
+  uint32_t frames = 0;
+  for (uint32_t b = 0; b < REC_STORE_SLOT_BLOCKS; ++b) {
+    if (!store.append(enc[b].data())) return false;
+    frames += recDecodeBlock(enc[b].data(), h.version, 50, tmp, REC_BLOCK_MAX_FRAMES);
+  }
+  return store.close(frames, take[frames - 1].t);
+}
+
+static Bytes storeBytes(int slot) {
+  Bytes b(store.takeBytes(slot));
+  return store.readTake(slot, 0, b.data(), b.size()) == b.size() ? b : Bytes();
+}
+
+// ---- download ----
+static bool partDownload(double mb, Bytes files[]) {
+  printf("\n== download: full slots (%u B each), %.1f MB in total ==\n", (unsigned)store.takeBytes(1), mb);
+  bool ok = true;
+  for (int s = 1; s <= REC_SLOTS; ++s) files[s - 1] = storeBytes(s);
+  uint64_t total = 0, wallNs = 0, virtUs = 0, reads = 0;
+  int64_t peak = 0;
+  int n = 0, bad = 0;
+  while (total < mb * 1e6) {
+    int s = 1 + n++ % REC_SLOTS;
+    char uri[40];
+    snprintf(uri, sizeof(uri), "/rec/download?slot=%d", s);
+    s_rx.clear();
+    server.sim_enqueue(HTTP_GET, uri);
+    uint64_t r0 = hal::flashStats().reads, t0 = benchNowNs(), v0 = hal::nowMicros();
+    heapStart();
+    server.handleClient();
+    peak = std::max(peak, heapStop());
+    wallNs += benchNowNs() - t0; virtUs += hal::nowMicros() - v0;
+    reads += hal::flashStats().reads - r0;
+    const SimHttpResponse& r = server.sim_lastResponse();
+    bool good = r.code == 200 && r.contentLength == files[s - 1].size() && r.bodyBytes == r.contentLength
+             && s_rx == files[s - 1];
+    if (!good) bad++;
+    total += r.bodyBytes;
+    run(5);
+  }
+  double sec = virtUs / 1e6;
+  printf("%-22s %d downloads, %llu B, %d mismatched\n", "sent", n, (unsigned long long)total, bad);
+  printf("%-22s %.1f MB/s (code path, flash read as memcpy)\n", "wall clock", total / 1e6 / (wallNs / 1e9));
+  printf("%-22s %.1f KB/s in %.2f s virtual (pacing %d KB/s, chunk %d B, %.0f flash reads)\n", "modeled",
+         total / 1024.0 / sec, sec, REC_XFER_RATE_KBPS, REC_XFER_CHUNK_BYTES, (double)reads);
+  printf("%-22s %lld B over the transfer (chunk buffer is static)\n", "peak heap", (long long)peak);
+  ok &= bad == 0 && n >= 1;
+  if (REC_XFER_RATE_KBPS) ok &= total / 1024.0 / sec <= REC_XFER_RATE_KBPS * 1.02;
+  ok &= peak < 4096;
+  return ok;
+}
+
+// ---- upload ----
+static bool partUpload(const Bytes files[]) {
+  printf("\n== upload: each file posted to the next slot, downloaded again ==\n");
+  printf("%-6s %-6s %6s %10s %10s %8s %10s %10s %s\n", "from", "to", "code", "bytes", "virt ms", "KB/s", "erases", "peak heap", "round trip");
+  bool ok = true;
+  SlotMeta m[REC_SLOTS];
+  for (int s = 1; s <= REC_SLOTS; ++s) m[s - 1] = store.meta(s);
+  int64_t peakAll = 0;
+  for (int s = 1; s <= REC_SLOTS; ++s) {
+    int to = SlotStore::after(s);
+    const Bytes& f = files[s - 1];
+    uint64_t e0 = hal::flashStats().erases, v0 = hal::nowMicros();
+    heapStart();
+    int code = upload(to, f, f.size());
+    int64_t peak = heapStop();
+    peakAll = std::max(peakAll, peak);
+    double ms = (hal::nowMicros() - v0) / 1000.0;
+    bool same = code == 200 && download(to) == 200 && s_rx == f && store.meta(to).frames == m[s - 1].frames
+             && store.meta(to).lastT == m[s - 1].lastT;
+    printf("%-6d %-6d %6d %10zu %10.0f %8.1f %10llu %10lld %s\n", s, to, code, f.size(), ms, f.size() / 1024.0 / (ms / 1000),
+           (unsigned long long)(hal::flashStats().erases - e0), (long long)peak, same ? "identical" : "DIFFERENT");
+    if (code != 200) printf("  %s\n", text().c_str());
+    ok &= same;
+    run(5);
+  }
+  ok &= peakAll < 4096;
+  return ok;
+}
+
+// ---- http ----
+static bool partHttp(const Bytes& f) {
+  printf("\n== http: ranges and validators (slot 1, %zu B) ==\n", f.size());
+  bool ok = true;
+  char sz[16];
+  snprintf(sz, sizeof(sz), "%zu", f.size());
+  download(1);
+  std::string etag = hdr("ETag");
+  struct Case { const char* label; Headers h; int code; size_t from, to; std::string cr; };
+  std::vector<Case> cases = {
+    { "Range 100-1123",   {{"Range", "bytes=100-1123"}}, 206, 100, 1123, std::string("bytes 100-1123/") + sz },
+    { "Range 200000-",    {{"Range", "bytes=200000-"}}, 206, 200000, f.size() - 1, "bytes 200000-" + std::to_string(f.size() - 1) + "/" + sz },
+    { "Range -16",        {{"Range", "bytes=-16"}}, 206, f.size() - 16, f.size() - 1, "bytes " + std::to_string(f.size() - 16) + "-" + std::to_string(f.size() - 1) + "/" + sz },
+    { "Range past end",   {{"Range", std::string("bytes=") + sz + "-"}}, 416, 0, 0, std::string("bytes */") + sz },
+    { "Range two parts",  {{"Range", "bytes=0-1,5-9"}}, 200, 0, f.size() - 1, "" },
+    { "If-Range current", {{"Range", "bytes=0-255"}, {"If-Range", etag}}, 206, 0, 255, std::string("bytes 0-255/") + sz },
+    { "If-Range stale",   {{"Range", "bytes=0-255"}, {"If-Range", "\"1-00000000\""}}, 200, 0, f.size() - 1, "" },
+    { "If-None-Match",    {{"If-None-Match", etag}}, 304, 0, 0, "" },
+  };
+  printf("%-18s %6s %8s %-26s %s\n", "request", "code", "bytes", "Content-Range", "status");
+  for (auto& c : cases) {
+    int code = download(1, c.h);
+    const SimHttpResponse& r = server.sim_lastResponse();
+    bool good = code == c.code && hdr("Content-Range") == c.cr && hdr("ETag") == etag;
+    if (c.code == 200 || c.code == 206)
+      good &= r.contentLength == c.to - c.from + 1 && s_rx == Bytes(f.begin() + c.from, f.begin() + c.to + 1);
+    else good &= s_rx.empty() || c.code == 416;
+    printf("%-18s %6d %8zu %-26s %s\n", c.label, code, r.bodyBytes, hdr("Content-Range").c_str(), good ? "ok" : "FAILED");
+    ok &= good;
+  }
+  store.clear(REC_SLOTS);
+  int code = download(REC_SLOTS);
+  printf("%-18s %6d\n", "empty slot", code);
+  ok &= code == 404;
+  code = download(REC_SLOTS + 1);
+  printf("%-18s %6d\n", "slot out of range", code);
+  ok &= code == 400;
+  return ok;
+}
+
+// ---- reject ----
+static bool partReject(const Bytes& f) {
+  printf("\n== reject: slot %d holds a take, slot %d is empty ==\n", 2, REC_SLOTS);
+  printf("%-22s %6s %-8s %-34s %s\n", "upload", "code", "slot", "error", "status");
+  bool ok = true;
+  const size_t H = sizeof(RecFileHeader), B = REC_BLOCK_BYTES;
+  Bytes badHdr = f;  badHdr[0] ^= 0xFF;
+  Bytes badBlk = f;  badBlk[H + 40 * B + 17] ^= 0x01;
+  Bytes swapped = f; std::swap_ranges(swapped.begin() + H + 10 * B, swapped.begin() + H + 11 * B, swapped.begin() + H + 11 * B);
+  Bytes torn(f.begin(), f.begin() + H + 5 * B + 100);
+  Bytes big = f;     big.insert(big.end(), f.end() - B, f.end());
+  struct Case { const char* label; const Bytes* body; size_t len, cut; int code; bool kept; };
+  const Case cases[] = {
+    { "bad header",        &badHdr,  f.size(), ~(size_t)0, 400, true },
+    { "corrupted block",   &badBlk,  f.size(), ~(size_t)0, 400, false },
+    { "blocks out of order", &swapped, f.size(), ~(size_t)0, 400, false },
+    { "torn size",         &torn,    torn.size(), ~(size_t)0, 400, true },
+    { "larger than a slot", &big,    big.size(), ~(size_t)0, 400, true },
+    { "client gone",       &f,       f.size(), f.size() / 2, 0, false },
+  };
+  for (const Case& c : cases) {
+    Bytes before = storeBytes(2);
+    int code = upload(2, *c.body, c.len, c.cut);
+    bool kept = storeBytes(2) == before, empty = store.meta(2).state == SLOT_EMPTY;
+    bool good = code == c.code && (c.kept ? kept : empty) && recorder.state() == REC_IDLE;
+    printf("%-22s %6d %-8s %-34s %s\n", c.label, code, kept ? "kept" : (empty ? "empty" : "CHANGED"),
+           code ? text().c_str() : recorder.lastError(), good ? "ok" : "FAILED");
+    ok &= good;
+    if (!c.kept) ok &= upload(2, f, f.size()) == 200;  // put it back
+  }
+  send(HTTP_POST, "/rec/upload?slot=2");
+  printf("%-22s %6d %-8s %-34s %s\n", "no body", server.sim_lastResponse().code, "-", text().c_str(), server.sim_lastResponse().code == 400 ? "ok" : "FAILED");
+  ok &= server.sim_lastResponse().code == 400;
+  recStart(REC_SLOTS);
+  Bytes before = storeBytes(2);
+  int code = upload(2, f, f.size());
+  bool good = code == 409 && storeBytes(2) == before && recorder.state() == REC_RECORDING;
+  printf("%-22s %6d %-8s %-34s %s\n", "while recording", code, storeBytes(2) == before ? "kept" : "CHANGED",
+         text().c_str(), good ? "ok" : "FAILED");
+  ok &= good;
+  send(HTTP_GET, "/rec/stop");
+  return ok;
+}
+
+// ---- control ----
+static bool partControl(int seconds) {
+  printf("\n== control: downloads for %d s while recording slot %d ==\n", seconds, REC_SLOTS);
+  send(HTTP_GET, "/ui/manual_steer?on=1");
+  recStart(REC_SLOTS);
+  ctl.resetStats();
+  uint32_t ov0 = recorder.ringOverflows(), t0 = millis(), n = 0;
+  uint64_t bytes = 0;
+  while (millis() - t0 < (uint32_t)seconds * 1000) {
+    char q[64];
+    snprintf(q, sizeof(q), "/ctl_servos?x=%.3f&y=0", 0.6f * sinf((millis() - t0) / 700.0f));
+    send(HTTP_GET, q);  // the setpoint changes between downloads only: the take is still all distinct frames
+    download(1 + n++ % (REC_SLOTS - 1));
+    bytes += server.sim_lastResponse().bodyBytes;
+  }
+  send(HTTP_GET, "/rec/stop");
+  run(50);
+  ControlStats st = ctl.stats();
+  uint32_t ms = millis() - t0, ov = recorder.ringOverflows() - ov0;
+  printf("%-22s %u downloads, %.1f MB in %u ms\n", "transfer", (unsigned)n, bytes / 1e6, (unsigned)ms);
+  printf("%-22s %u cycles, %u overruns, max jitter %u us\n", "control", (unsigned)st.cycles, (unsigned)st.overruns,
+         (unsigned)st.maxJitterUs);
+  printf("%-22s %u frames, %u ring overflows, commit lag max %u ms\n", "recording", (unsigned)store.meta(REC_SLOTS).frames,
+         (unsigned)ov, (unsigned)recorder.commitLagMaxMs());
+  return st.overruns == 0 && ov == 0 && store.meta(REC_SLOTS).state == SLOT_DONE && st.cycles >= ms * CONTROL_RATE_HZ / 1000 * 9 / 10;
+}
+
+// ---- stop ----
+static bool partStop() {
+  printf("\n== stop: abort playback of slot 2 during a download of slot 1 (%u B) ==\n", (unsigned)store.takeBytes(1));
+  send(HTTP_GET, "/rec/play?slot=2");
+  run(200);
+  bool playing = recorder.state() == REC_PLAYING;
+  ws.sim_connect(0);
+  run(5);
+  uint32_t size = store.takeBytes(1), got = 0, stopMs = 0, wsMs = 0;
+  server.sim_setBodySink([&](const char* p, size_t n) {
+    (void)p;
+    got += n;
+    if (!stopMs && got >= size / 4) {
+      CtlMsg m{ CTL_MSG_VERSION, CTL_FLAG_MANUAL | CTL_FLAG_ABORT, 1, 0, 0, 0, 0 };
+      ws.sim_enqueueBin(0, &m, sizeof(m));
+      server.sim_enqueue(HTTP_GET, "/rec/abort");
+      stopMs = millis();
+    } else if (stopMs && !wsMs && recorder.state() != REC_PLAYING) wsMs = millis();
+  });
+  server.sim_enqueue(HTTP_GET, "/rec/download?slot=1");
+  server.handleClient();
+  uint32_t endMs = millis();
+  bool full = server.sim_lastResponse().bodyBytes == size;
+  while (server.sim_pending()) loop();
+  uint32_t httpMs = millis();
+  bool aborted = server.sim_lastResponse().code == 200;
+  server.sim_setBodySink([](const char* p, size_t n) { HeapPause hp; s_rx.insert(s_rx.end(), p, p + n); });
+  ws.sim_disconnect(0);
+  run(5);
+  float chunkMs = REC_XFER_RATE_KBPS ? REC_XFER_CHUNK_BYTES * 1000.0f / (REC_XFER_RATE_KBPS * 1024) : 1.0f;
+  printf("%-22s %s, %u ms after the stop, %u ms before the transfer ended\n", "WS abort",
+         wsMs ? "applied" : "NOT applied", wsMs ? (unsigned)(wsMs - stopMs) : 0, wsMs ? (unsigned)(endMs - wsMs) : 0);
+  printf("%-22s served %u ms after the stop (waits for the transfer)\n", "GET /rec/abort", (unsigned)(httpMs - stopMs));
+  return playing && full && aborted && wsMs && wsMs - stopMs <= 2 * chunkMs + 1 && wsMs < endMs;  // seen at the next chunk
+}
+
+int benchXfer(int argc, char** argv) {
+  double mb = atof(benchArgStr(argc, argv, "--mb", "8"));
+  uint32_t eraseUs = (uint32_t)benchArg(argc, argv, "--erase-us", 45000);
+  uint32_t pageUs  = (uint32_t)benchArg(argc, argv, "--page-us", 700);
+  uint32_t readUs  = (uint32_t)benchArg(argc, argv, "--read-us", 15);
+  int seconds = (int)benchArg(argc, argv, "--seconds", 10);
+  hal::setFsRoot(benchArgStr(argc, argv, "--fs", "bench_fs"));
+  hal::useVirtualClock(true);
+  hal::setTasksEnabled(false);
+  hal::flashWipe(REC_STORE_LABEL);  // same journal position every run
+  setup();
+  server.sim_setBodySink([](const char* p, size_t n) { HeapPause hp; s_rx.insert(s_rx.end(), p, p + n); });
+  s_rx.reserve(256 * 1024);
+
+  bool ok = true;
+  for (int s = 1; s <= REC_SLOTS; ++s) ok &= fillSlot(s);
+  if (!ok) { printf("fill failed: %s\n", store.lastError()); return 1; }
+  hal::flashSetCostUs(eraseUs, pageUs, readUs);
+  static Bytes files[REC_SLOTS];
+  ok &= partDownload(mb, files);
+  ok &= partUpload(files);
+  ok &= partHttp(storeBytes(1));
+  ok &= partReject(files[1]);
+  ok &= partControl(seconds);
+  ok &= partStop();
+  server.sim_setBodySink(nullptr);
+  hal::flashSetCostUs(0, 0, 0);
+  printf("%-22s %s\n", "result", ok ? "ok" : "FAILED");
+  return ok ? 0 : 1;
+}
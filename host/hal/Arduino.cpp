@@ -0,0 +1,143 @@
+#include <Arduino.h>
+#include "MotorSim.h"
+#include <chrono>
+#include <thread>
+#include <ctype.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+
+HardwareSerial Serial;
+EspClass ESP;
+
+namespace hal {
+  Counters counters;
+  int pinLevel[MAX_PINS];
+  int pinDuty[MAX_PINS];
+  uint32_t heapSize = 327680, heapFree = 250000, heapMinFree = 240000;
+
+  static bool     s_virtual = false;
+  static uint64_t s_virtualUs = 0;
+  static const auto s_epoch = std::chrono::steady_clock::now();
+
+  void useVirtualClock(bool on) { s_virtualUs = nowMicros(); s_virtual = on; }
+  void advanceMicros(uint64_t us) { s_virtualUs += us; }
+
+  uint64_t nowMicros() {
+    if (s_virtual) return s_virtualUs;
+    return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now() - s_epoch).count();
+  }
+
+  void resetCounters() { counters = Counters(); }
+}
+
+uint32_t EspClass::getCycleCount() {
+  if (hal::s_virtual) return (uint32_t)(hal::s_virtualUs * 240u);
+  return (uint32_t)(std::chrono::duration_cast<std::chrono::nanoseconds>(
+           std::chrono::steady_clock::now() - hal::s_epoch).count() * 6 / 25);
+}
+
+// ==== Serial ====
+static int s_serialFd = -1;
+void hal::serialAttachFd(int fd) { s_serialFd = fd; }
+
+size_t HardwareSerial::write(const uint8_t* buf, size_t n) {
+  if (s_serialFd < 0) return fwrite(buf, 1, n, stdout);
+  size_t done = 0;
+  while (done < n) {  // blocking, like a full UART TX buffer
+    ssize_t w = ::write(s_serialFd, buf + done, n - done);
+    if (w <= 0) break;
+    done += (size_t)w;
+  }
+  return done;
+}
+
+int HardwareSerial::available() {
+  int n = 0;
+  if (s_serialFd < 0 || ioctl(s_serialFd, FIONREAD, &n) != 0) return 0;
+  return n;
+}
+
+int HardwareSerial::read() {
+  uint8_t c;
+  return read(&c, 1) == 1 ? c : -1;
+}
+
+size_t HardwareSerial::read(uint8_t* buf, size_t n) {
+  if (s_serialFd < 0 || available() <= 0) return 0;
+  ssize_t r = ::read(s_serialFd, buf, n);
+  return r > 0 ? (size_t)r : 0;
+}
+
+// ==== Time ====
+unsigned long millis() { return (unsigned long)(hal::nowMicros() / 1000); }
+unsigned long micros() { return (unsigned long)hal::nowMicros(); }
+
+void delayMicroseconds(uint32_t us) {
+  if (hal::s_virtual) { hal::advanceMicros(us); return; }
+  std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+void delay(uint32_t ms) { delayMicroseconds(ms * 1000u); }
+
+// ==== GPIO / PWM ====
+void pinMode(uint8_t pin, uint8_t mode) { (void)pin; (void)mode; }
+
+void digitalWrite(uint8_t pin, uint8_t val) {
+  hal::counters.digitalWrites++;
+  if (hal::plantsAttached) hal::motorSync();  // plant sees the old level up to now
+  if (pin < hal::MAX_PINS) hal::pinLevel[pin] = val ? HIGH : LOW;
+}
+
+int digitalRead(uint8_t pin) { return (pin < hal::MAX_PINS) ? hal::pinLevel[pin] : LOW; }
+
+void analogWrite(uint8_t pin, int value) {
+  hal::counters.analogWrites++;
+  if (hal::plantsAttached) hal::motorSync();
+  if (pin < hal::MAX_PINS) hal::pinDuty[pin] = value;
+}
+
+bool analogWriteResolution(uint8_t pin, uint8_t bits) { (void)pin; (void)bits; return true; }
+bool analogWriteFrequency(uint8_t pin, uint32_t freq) { (void)pin; (void)freq; return true; }
+
+// ==== String ====
+void String::trim() {
+  size_t a = 0, b = _s.size();
+  while (a < b && isspace((unsigned char)_s[a])) a++;
+  while (b > a && isspace((unsigned char)_s[b - 1])) b--;
+  _s = _s.substr(a, b - a);
+}
+
+void String::toLowerCase() {
+  for (auto& c : _s) c = (char)tolower((unsigned char)c);
+}
+
+// ==== Print / Stream ====
+size_t Print::printf(const char* fmt, ...) {
+  char small[128];
+  va_list ap;
+  va_start(ap, fmt);
+  int n = vsnprintf(small, sizeof(small), fmt, ap);
+  va_end(ap);
+  if (n < 0) return 0;
+  if ((size_t)n < sizeof(small)) return write((const uint8_t*)small, (size_t)n);
+
+  std::string big((size_t)n + 1, '\0');
+  va_start(ap, fmt);
+  vsnprintf(&big[0], big.size(), fmt, ap);
+  va_end(ap);
+  return write((const uint8_t*)big.data(), (size_t)n);
+}
+
+String Stream::readString() {
+  std::string s;
+  int c;
+  while ((c = read()) >= 0) s += (char)c;
+  return String(s);
+}
+
+String Stream::readStringUntil(char term) {
+  std::string s;
+  int c;
+  while ((c = read()) >= 0 && c != term) s += (char)c;
+  return String(s);
+}
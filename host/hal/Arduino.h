@@ -0,0 +1,211 @@
+#pragma once
+// Host (Linux) stand-in for the ESP32 Arduino core.
+// Only what CamMate uses is provided; every hardware touch is counted in
+// hal::counters so benchmarks can report actuator traffic.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <string>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+
+typedef uint8_t byte;
+typedef bool    boolean;
+
+#define HIGH 1
+#define LOW  0
+#define INPUT        0x01
+#define OUTPUT       0x03
+#define INPUT_PULLUP 0x05
+
+#define PROGMEM
+#define PGM_P const char*
+#define F(s) (s)
+
+// ==== Sim bookkeeping ====
+namespace hal {
+  struct Counters {
+    uint64_t digitalWrites = 0;
+    uint64_t analogWrites  = 0;
+    uint64_t servoWrites   = 0;
+    uint64_t fileOpens     = 0;
+    uint64_t fileFlushes   = 0;
+    uint64_t fileReads     = 0; // File::read(buf, n) calls
+    uint64_t httpRequests  = 0;
+    uint64_t i2cBytes      = 0; // address + data bytes on the Wire bus
+  };
+  extern Counters counters;
+
+  static const int MAX_PINS = 64;
+  extern int pinLevel[MAX_PINS];
+  extern int pinDuty[MAX_PINS];
+
+  // Clock: real monotonic time by default; virtual time advances only
+  // through advanceMicros()/delay() so runs are reproducible.
+  void     useVirtualClock(bool on);
+  void     advanceMicros(uint64_t us);
+  uint64_t nowMicros();
+
+  void resetCounters();
+}
+
+// ==== Time ====
+unsigned long millis();
+unsigned long micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+static inline void yield() {}
+
+// ==== GPIO / PWM ====
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int  digitalRead(uint8_t pin);
+void analogWrite(uint8_t pin, int value);
+bool analogWriteResolution(uint8_t pin, uint8_t bits);
+bool analogWriteFrequency(uint8_t pin, uint32_t freq);
+
+// ==== String ====
+class String {
+public:
+  String() {}
+  String(const char* s) : _s(s ? s : "") {}
+  String(const std::string& s) : _s(s) {}
+  String(char c) : _s(1, c) {}
+  String(int v)           : _s(std::to_string(v)) {}
+  String(unsigned int v)  : _s(std::to_string(v)) {}
+  String(long v)          : _s(std::to_string(v)) {}
+  String(unsigned long v) : _s(std::to_string(v)) {}
+  String(float v, unsigned char decimals = 2)  { _fmt(v, decimals); }
+  String(double v, unsigned char decimals = 2) { _fmt(v, decimals); }
+
+  unsigned int length() const { return (unsigned int)_s.size(); }
+  bool isEmpty() const { return _s.empty(); }
+  const char* c_str() const { return _s.c_str(); }
+  void reserve(unsigned int n) { _s.reserve(n); }
+
+  char charAt(unsigned int i) const { return i < _s.size() ? _s[i] : 0; }
+  char operator[](unsigned int i) const { return charAt(i); }
+
+  int indexOf(char c, unsigned int from = 0) const { return _pos(_s.find(c, from)); }
+  int indexOf(const char* s, unsigned int from = 0) const { return _pos(_s.find(s, from)); }
+  int indexOf(const String& s, unsigned int from = 0) const { return _pos(_s.find(s._s, from)); }
+  int lastIndexOf(char c) const { return _pos(_s.rfind(c)); }
+
+  String substring(unsigned int from) const { return from < _s.size() ? String(_s.substr(from)) : String(); }
+  String substring(unsigned int from, unsigned int to) const {
+    if (from > to) { unsigned int t = from; from = to; to = t; }
+    if (from >= _s.size()) return String();
+    return String(_s.substr(from, to - from));
+  }
+
+  bool startsWith(const String& p) const { return _s.compare(0, p._s.size(), p._s) == 0; }
+  bool endsWith(const String& p) const {
+    return _s.size() >= p._s.size() && _s.compare(_s.size() - p._s.size(), p._s.size(), p._s) == 0;
+  }
+
+  void trim();
+  void toLowerCase();
+  long  toInt() const   { return strtol(_s.c_str(), nullptr, 10); }
+  float toFloat() const { return strtof(_s.c_str(), nullptr); }
+
+  bool equals(const String& o) const { return _s == o._s; }
+  bool operator==(const String& o) const { return _s == o._s; }
+  bool operator==(const char* o) const   { return _s == (o ? o : ""); }
+  bool operator!=(const String& o) const { return !(*this == o); }
+  bool operator!=(const char* o) const   { return !(*this == o); }
+
+  String& operator+=(const String& o) { _s += o._s; return *this; }
+  String& operator+=(const char* o)   { if (o) _s += o; return *this; }
+  String& operator+=(char c)          { _s += c; return *this; }
+  template <typename T> String& operator+=(T v) { return *this += String(v); }
+
+  template <typename T> friend String operator+(const String& a, const T& b) { String r(a); r += String(b); return r; }
+  friend String operator+(const String& a, const char* b) { String r(a); r += b; return r; }
+  friend String operator+(const char* a, const String& b) { String r(a); r += b; return r; }
+
+private:
+  std::string _s;
+  static int _pos(size_t p) { return p == std::string::npos ? -1 : (int)p; }
+  void _fmt(double v, unsigned char decimals) {
+    char buf[48]; snprintf(buf, sizeof(buf), "%.*f", (int)decimals, v); _s = buf;
+  }
+};
+
+// ==== Print / Stream ====
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t* buf, size_t n) {
+    size_t w = 0; while (n--) w += write(*buf++); return w;
+  }
+  size_t write(const char* s) { return s ? write((const uint8_t*)s, strlen(s)) : 0; }
+
+  size_t print(const char* s)     { return write(s); }
+  size_t print(const String& s)   { return write(s.c_str()); }
+  size_t print(char c)            { return write((uint8_t)c); }
+  size_t print(int v)             { return print(String(v)); }
+  size_t print(unsigned int v)    { return print(String(v)); }
+  size_t print(long v)            { return print(String(v)); }
+  size_t print(unsigned long v)   { return print(String(v)); }
+  size_t print(double v, int d=2) { return print(String(v, (unsigned char)d)); }
+
+  size_t println()                { return write("\r\n"); }
+  template <typename T> size_t println(const T& v) { size_t n = print(v); return n + println(); }
+
+  size_t printf(const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+};
+
+class Stream : public Print {
+public:
+  virtual int available() = 0;
+  virtual int read() = 0;
+  virtual int peek() { return -1; }
+  void setTimeout(unsigned long ms) { _timeout = ms; }
+
+  String readString();
+  String readStringUntil(char term);
+
+protected:
+  unsigned long _timeout = 1000;
+};
+
+// Writes to stdout and reads nothing, unless hal::serialAttachFd() points
+// it at a file descriptor (e.g. a pty for the serial link bench)
+namespace hal { void serialAttachFd(int fd); } // -1 = back to stdout
+class HardwareSerial : public Stream {
+public:
+  void begin(unsigned long baud) { (void)baud; }
+  void end() {}
+  size_t setRxBufferSize(size_t n) { return n; }
+  size_t write(uint8_t c) override { return write(&c, 1); }
+  size_t write(const uint8_t* buf, size_t n) override;
+  using Print::write;
+  int available() override;
+  int read() override;
+  size_t read(uint8_t* buf, size_t n);
+  void flush() { fflush(stdout); }
+  operator bool() const { return true; }
+};
+extern HardwareSerial Serial;
+
+// ==== ESP (heap, cycle counter) ====
+namespace hal {
+  // Simulated heap: free/min-free report these (benches may set them)
+  extern uint32_t heapSize, heapFree, heapMinFree;
+}
+class EspClass {
+public:
+  uint32_t getHeapSize()    { return hal::heapSize; }
+  uint32_t getFreeHeap()    { return hal::heapFree; }
+  uint32_t getMinFreeHeap() { return hal::heapMinFree; }
+  uint32_t getCpuFreqMHz()  { return 240; }
+  uint32_t getCycleCount(); // CCOUNT stand-in: clock time * 240 MHz (virtual clock: virtual us)
+};
+extern EspClass ESP;
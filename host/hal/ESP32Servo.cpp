@@ -0,0 +1,26 @@
+#include <ESP32Servo.h>
+#include "MotorSim.h"
+
+int Servo::attach(int pin, int minUs, int maxUs) {
+  _pin = pin; _minUs = minUs; _maxUs = maxUs;
+  return pin >= 0 ? 1 : 0;
+}
+
+void Servo::write(int value) {
+  if (value < 0)   value = 0;
+  if (value > 180) value = 180;
+  writeMicroseconds(_minUs + (value * (_maxUs - _minUs)) / 180);
+}
+
+void Servo::writeMicroseconds(int us) {
+  if (!attached()) return;
+  hal::counters.servoWrites++;
+  if (hal::plantsAttached) hal::motorSync();
+  _us = us;
+  if (_pin < hal::MAX_PINS) hal::pinDuty[_pin] = us;
+}
+
+int Servo::read() const {
+  if (_maxUs == _minUs) return 0;
+  return ((_us - _minUs) * 180 + (_maxUs - _minUs) / 2) / (_maxUs - _minUs);
+}
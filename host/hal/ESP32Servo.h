@@ -0,0 +1,20 @@
+#pragma once
+#include <Arduino.h>
+
+// Host stand-in for the ESP32Servo library. Pulse widths land in
+// hal::pinDuty[pin] (microseconds) and each write bumps servoWrites.
+class Servo {
+public:
+  int  attach(int pin, int minUs = 544, int maxUs = 2400);
+  void detach() { _pin = -1; }
+  bool attached() const { return _pin >= 0; }
+  void write(int value);
+  void writeMicroseconds(int us);
+  int  read() const;
+  int  readMicroseconds() const { return _us; }
+
+private:
+  int _pin = -1;
+  int _minUs = 544, _maxUs = 2400;
+  int _us = 0;
+};
@@ -0,0 +1,161 @@
+#include <FS.h>
+#include <SPIFFS.h>
+#include <sys/stat.h>
+#include <dirent.h>
+
+SPIFFSFS SPIFFS;
+
+namespace hal {
+  static std::string s_root = "spiffs";
+  static uint32_t s_flushUs = 0;
+
+  void setFsRoot(const char* dir) { s_root = dir ? dir : "spiffs"; }
+  void setFsFlushCostUs(uint32_t us) { s_flushUs = us; }
+
+  std::string fsPath(const char* path) {
+    std::string p = s_root;
+    if (!path || path[0] != '/') p += '/';
+    if (path) p += path;
+    return p;
+  }
+
+  // The partition size the root was formatted for, in a hidden file
+  static const char* FORMATTED = "/.spiffs_bytes";
+  void setFsFormattedBytes(uint32_t bytes) {
+    mkdir(fsPath("").c_str(), 0755);
+    if (FILE* f = fopen(fsPath(FORMATTED).c_str(), "w")) { fprintf(f, "%u\n", (unsigned)bytes); fclose(f); }
+  }
+  static uint32_t fsFormattedBytes() {
+    unsigned v = SPIFFS_PART_BYTES;  // unmarked: this layout
+    if (FILE* f = fopen(fsPath(FORMATTED).c_str(), "r")) { if (fscanf(f, "%u", &v) != 1) v = 0; fclose(f); }
+    return v;
+  }
+}
+
+// ==== File ====
+File::File(FILE* fp, const char* path) : _h(std::make_shared<Handle>()) {
+  _h->fp = fp;
+  _h->path = path ? path : "";
+}
+
+size_t File::write(uint8_t c) { return (*this) ? (fputc(c, _h->fp) == EOF ? 0 : 1) : 0; }
+size_t File::write(const uint8_t* buf, size_t n) { return (*this) ? fwrite(buf, 1, n, _h->fp) : 0; }
+
+int File::available() {
+  if (!*this) return 0;
+  long d = (long)size() - (long)position();
+  return d > 0 ? (int)d : 0;
+}
+
+int File::read() { return (*this) ? fgetc(_h->fp) : -1; }
+
+int File::peek() {
+  if (!*this) return -1;
+  int c = fgetc(_h->fp);
+  if (c != EOF) ungetc(c, _h->fp);
+  return c;
+}
+
+size_t File::read(uint8_t* buf, size_t n) {
+  if (!*this) return 0;
+  hal::counters.fileReads++;
+  return fread(buf, 1, n, _h->fp);
+}
+
+void File::flush() {
+  if (!*this) return;
+  hal::counters.fileFlushes++;
+  fflush(_h->fp);
+  if (hal::s_flushUs) delayMicroseconds(hal::s_flushUs);
+}
+
+bool File::seek(uint32_t pos, SeekMode mode) {
+  if (!*this) return false;
+  int whence = (mode == SeekCur) ? SEEK_CUR : (mode == SeekEnd) ? SEEK_END : SEEK_SET;
+  return fseek(_h->fp, (long)pos, whence) == 0;
+}
+
+size_t File::position() const { return (*this) ? (size_t)ftell(_h->fp) : 0; }
+
+size_t File::size() const {
+  if (!*this) return 0;
+  struct stat st;
+  fflush(_h->fp);
+  if (fstat(fileno(_h->fp), &st) != 0) return 0;
+  return (size_t)st.st_size;
+}
+
+void File::close() {
+  if (_h && _h->fp) { fclose(_h->fp); _h->fp = nullptr; }
+  _h.reset();
+}
+
+const char* File::name() const {
+  const char* p = path();
+  const char* s = strrchr(p, '/');
+  return s ? s + 1 : p;
+}
+
+// ==== FS ====
+namespace fs {
+  bool FS::exists(const char* path) {
+    struct stat st;
+    return stat(hal::fsPath(path).c_str(), &st) == 0;
+  }
+
+  File FS::open(const char* path, const char* mode) {
+    hal::counters.fileOpens++;
+    // ESP32 opens are binary; "r" on a missing file fails like on target.
+    std::string m = mode;
+    if (m.find('b') == std::string::npos) m += 'b';
+    FILE* fp = fopen(hal::fsPath(path).c_str(), m.c_str());
+    if (!fp) return File();
+    return File(fp, path);
+  }
+
+  bool FS::remove(const char* path) { return ::remove(hal::fsPath(path).c_str()) == 0; }
+
+  bool FS::rename(const char* from, const char* to) {
+    return ::rename(hal::fsPath(from).c_str(), hal::fsPath(to).c_str()) == 0;
+  }
+}
+
+// ==== SPIFFS ====
+bool SPIFFSFS::begin(bool formatOnFail, const char* basePath, uint8_t maxOpenFiles, const char* label) {
+  (void)basePath; (void)maxOpenFiles; (void)label;
+  std::string root = hal::fsPath("");
+  struct stat st;
+  bool have = stat(root.c_str(), &st) == 0;
+  if (have && !S_ISDIR(st.st_mode)) return false;
+  if (have && hal::fsFormattedBytes() == SPIFFS_PART_BYTES) return true;
+  if (!formatOnFail) return false;
+  if (!have && mkdir(root.c_str(), 0755) != 0) return false;
+  if (!format()) return false;
+  hal::setFsFormattedBytes(SPIFFS_PART_BYTES);
+  return true;
+}
+
+bool SPIFFSFS::format() {
+  std::string root = hal::fsPath("");
+  DIR* d = opendir(root.c_str());
+  if (!d) return false;
+  while (dirent* e = readdir(d)) {
+    if (e->d_name[0] == '.') continue;
+    ::remove((root + e->d_name).c_str());
+  }
+  closedir(d);
+  return true;
+}
+
+size_t SPIFFSFS::usedBytes() {
+  std::string root = hal::fsPath("");
+  DIR* d = opendir(root.c_str());
+  if (!d) return 0;
+  size_t used = 0;
+  while (dirent* e = readdir(d)) {
+    struct stat st;
+    if (e->d_name[0] != '.' && stat((root + e->d_name).c_str(), &st) == 0) used += (size_t)st.st_size;
+  }
+  closedir(d);
+  return used;
+}
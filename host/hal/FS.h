@@ -0,0 +1,65 @@
+#pragma once
+// Host stand-in for the ESP32 FS layer: a File wraps a stdio FILE* under
+// the directory chosen with hal::setFsRoot().
+#include <Arduino.h>
+#include <memory>
+
+#define FILE_READ   "r"
+#define FILE_WRITE  "w"
+#define FILE_APPEND "a"
+
+enum SeekMode { SeekSet = 0, SeekCur = 1, SeekEnd = 2 };
+
+namespace hal {
+  void setFsRoot(const char* dir);
+  std::string fsPath(const char* path);
+  // Added to every File::flush() (SPIFFS page program + GC stand-in)
+  void setFsFlushCostUs(uint32_t us);
+  // Marks the root as formatted for a spiffs partition of this size; a
+  // SPIFFS.begin() on another size fails like the magic check on the ESP32
+  void setFsFormattedBytes(uint32_t bytes);
+}
+
+class File : public Stream {
+public:
+  File() {}
+  File(FILE* fp, const char* path);
+
+  operator bool() const { return _h && _h->fp; }
+
+  size_t write(uint8_t c) override;
+  size_t write(const uint8_t* buf, size_t n) override;
+  using Print::write;
+  int    available() override;
+  int    read() override;
+  int    peek() override;
+  size_t read(uint8_t* buf, size_t n);
+  void   flush();
+  bool   seek(uint32_t pos, SeekMode mode = SeekSet);
+  size_t position() const;
+  size_t size() const;
+  void   close();
+  const char* path() const { return _h ? _h->path.c_str() : ""; }
+  const char* name() const;
+
+private:
+  struct Handle {
+    FILE* fp = nullptr;
+    std::string path;
+    ~Handle() { if (fp) fclose(fp); }
+  };
+  std::shared_ptr<Handle> _h;
+};
+
+namespace fs {
+  class FS {
+  public:
+    bool exists(const char* path);
+    bool exists(const String& path) { return exists(path.c_str()); }
+    File open(const char* path, const char* mode = FILE_READ);
+    File open(const String& path, const char* mode = FILE_READ) { return open(path.c_str(), mode); }
+    bool remove(const char* path);
+    bool remove(const String& path) { return remove(path.c_str()); }
+    bool rename(const char* from, const char* to);
+  };
+}
@@ -0,0 +1,137 @@
+#include <esp_partition.h>
+#include <FlashSim.h>
+#include <FS.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <vector>
+
+// Data partitions the host maps raw; offsets/sizes as in partitions.csv
+static esp_partition_t s_parts[] = {
+  { nullptr, ESP_PARTITION_TYPE_DATA, (esp_partition_subtype_t)0x40, 0x2F0000, 0x100000, 4096, "takes", false, false },
+};
+static const int NPARTS = sizeof(s_parts) / sizeof(s_parts[0]);
+static const uint32_t SECTOR = 4096, PAGE = 256;
+
+namespace hal {
+  static FlashStats s_stats;
+  static int s_fd[NPARTS] = { -1 };
+  static uint32_t s_eraseUs = 0, s_progUs = 0, s_readUs = 0;
+  static uint64_t s_budget = ~0ull;
+  static bool s_off = false;
+  static uint32_t s_rng = 1;
+
+  FlashStats& flashStats() { return s_stats; }
+  void flashResetStats() { s_stats = FlashStats(); }
+  void flashSetCostUs(uint32_t eraseSectorUs, uint32_t programPageUs, uint32_t readPageUs) {
+    s_eraseUs = eraseSectorUs; s_progUs = programPageUs; s_readUs = readPageUs;
+  }
+  void flashCutAfter(uint64_t bytes, uint32_t seed) { s_budget = bytes; s_rng = seed ? seed : 1; }
+  bool flashPoweredOff() { return s_off; }
+  void flashPowerOn() { s_off = false; s_budget = ~0ull; }
+
+  static int fdFor(const esp_partition_t* p) {
+    int i = (int)(p - s_parts);
+    if (i < 0 || i >= NPARTS) return -1;
+    if (s_fd[i] >= 0) return s_fd[i];
+    std::string path = fsPath((std::string("/.flash_") + p->label).c_str());  // hidden from SPIFFS listings
+    int fd = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0) return -1;
+    off_t have = lseek(fd, 0, SEEK_END);
+    if (have < (off_t)p->size) {  // fresh chip: erased
+      std::vector<uint8_t> ff(p->size - have, 0xFF);
+      if (pwrite(fd, ff.data(), ff.size(), have) != (ssize_t)ff.size()) { close(fd); return -1; }
+    }
+    s_fd[i] = fd;
+    return fd;
+  }
+
+  void flashWipe(const char* label) {
+    const esp_partition_t* p = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, label);
+    int fd = p ? fdFor(p) : -1;
+    if (fd < 0) return;
+    std::vector<uint8_t> ff(p->size, 0xFF);
+    if (pwrite(fd, ff.data(), ff.size(), 0) != (ssize_t)ff.size()) perror("flashWipe");
+  }
+
+  bool flashSave(const char* label, std::vector<uint8_t>& out) {
+    const esp_partition_t* p = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, label);
+    int fd = p ? fdFor(p) : -1;
+    if (fd < 0) return false;
+    out.resize(p->size);
+    return pread(fd, out.data(), out.size(), 0) == (ssize_t)out.size();
+  }
+  bool flashLoad(const char* label, const std::vector<uint8_t>& img) {
+    const esp_partition_t* p = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, label);
+    int fd = p ? fdFor(p) : -1;
+    if (fd < 0 || img.size() != p->size) return false;
+    return pwrite(fd, img.data(), img.size(), 0) == (ssize_t)img.size();
+  }
+
+  // Bytes of an n-byte operation that land before the power cut
+  static size_t spend(size_t n) {
+    if (s_budget >= n) { if (s_budget != ~0ull) s_budget -= n; return n; }
+    size_t k = (size_t)s_budget;
+    s_budget = 0; s_off = true; s_stats.cuts++;
+    return k;
+  }
+  static uint8_t noise() { s_rng = s_rng * 1103515245u + 12345u; return (uint8_t)(s_rng >> 16); }
+}
+
+using namespace hal;
+
+const esp_partition_t* esp_partition_find_first(esp_partition_type_t type, esp_partition_subtype_t subtype,
+                                                const char* label) {
+  for (esp_partition_t& p : s_parts) {
+    if (p.type != type || (subtype != ESP_PARTITION_SUBTYPE_ANY && p.subtype != subtype)) continue;
+    if (label && strcmp(label, p.label) != 0) continue;
+    return fdFor(&p) >= 0 ? &p : nullptr;
+  }
+  return nullptr;
+}
+
+esp_err_t esp_partition_read(const esp_partition_t* p, size_t off, void* dst, size_t n) {
+  int fd = p ? fdFor(p) : -1;
+  if (fd < 0 || off + n > p->size) return ESP_ERR_INVALID_ARG;
+  s_stats.reads++; s_stats.readBytes += n;
+  if (s_readUs) delayMicroseconds(s_readUs * (uint32_t)((n + PAGE - 1) / PAGE));
+  return pread(fd, dst, n, (off_t)off) == (ssize_t)n ? ESP_OK : ESP_FAIL;
+}
+
+esp_err_t esp_partition_write(const esp_partition_t* p, size_t off, const void* src, size_t n) {
+  int fd = p ? fdFor(p) : -1;
+  if (fd < 0 || off + n > p->size) return ESP_ERR_INVALID_ARG;
+  if (s_off) return ESP_FAIL;
+  static std::vector<uint8_t> cur;  // scratch kept: the emulator stays out of heap counts (bench_xfer)
+  cur.resize(n);
+  if (pread(fd, cur.data(), n, (off_t)off) != (ssize_t)n) return ESP_FAIL;
+  const uint8_t* s = (const uint8_t*)src;
+  size_t k = spend(n);
+  for (size_t i = 0; i < k; ++i) {
+    if ((cur[i] & s[i]) != s[i]) s_stats.overprograms++;
+    cur[i] &= s[i];
+  }
+  if (k < n) cur[k] &= (uint8_t)(s[k] | noise());  // the byte in flight: some bits made it
+  s_stats.programs++; s_stats.programBytes += k;
+  if (s_progUs) delayMicroseconds(s_progUs * (uint32_t)((n + PAGE - 1) / PAGE));
+  if (pwrite(fd, cur.data(), n, (off_t)off) != (ssize_t)n) return ESP_FAIL;
+  return k == n ? ESP_OK : ESP_FAIL;
+}
+
+esp_err_t esp_partition_erase_range(const esp_partition_t* p, size_t off, size_t n) {
+  int fd = p ? fdFor(p) : -1;
+  if (fd < 0 || off + n > p->size || off % SECTOR || n % SECTOR) return ESP_ERR_INVALID_ARG;
+  if (s_off) return ESP_FAIL;
+  for (size_t o = off; o < off + n; o += SECTOR) {
+    static std::vector<uint8_t> buf(SECTOR);
+    if (pread(fd, buf.data(), SECTOR, (off_t)o) != (ssize_t)SECTOR) return ESP_FAIL;
+    size_t k = spend(SECTOR);
+    // an interrupted erase leaves the sector part erased, part old data
+    for (size_t i = 0; i < k; ++i) buf[i] = 0xFF;
+    if (k < SECTOR) for (size_t i = k; i < SECTOR && i < k + 64; ++i) buf[i] |= noise();
+    s_stats.erases++;
+    if (s_eraseUs) delayMicroseconds(s_eraseUs);
+    if (pwrite(fd, buf.data(), SECTOR, (off_t)o) != (ssize_t)SECTOR) return ESP_FAIL;
+    if (k < SECTOR) return ESP_FAIL;
+  }
+  return ESP_OK;
+}
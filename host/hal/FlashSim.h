@@ -0,0 +1,33 @@
+#pragma once
+// NOR flash behind hal/esp_partition.h. The image is a file in the FS
+// root (.flash_<label>, skipped by SPIFFS format/usage), created erased
+// (0xFF) on first use and kept between runs like the chip. Program = AND into the image, erase =
+// 0xFF per 4 KB sector; optional per-operation costs go through
+// delayMicroseconds() (virtual clock aware).
+// Power cut: flashCutAfter(n) lets n more bytes be programmed or erased;
+// the operation that crosses the budget stops there (the byte it stops in
+// gets a random subset of its bits), and every later write/erase fails
+// until flashPowerOn() - the firmware's next boot.
+#include <Arduino.h>
+#include <vector>
+
+namespace hal {
+  struct FlashStats {
+    uint64_t reads = 0, readBytes = 0;
+    uint64_t programs = 0, programBytes = 0;
+    uint64_t erases = 0;        // sectors
+    uint64_t overprograms = 0;  // bytes programmed over a non-erased value (0 -> 1 bits lost)
+    uint64_t cuts = 0;
+  };
+  FlashStats& flashStats();
+  void flashResetStats();
+
+  void flashSetCostUs(uint32_t eraseSectorUs, uint32_t programPageUs, uint32_t readPageUs = 0);
+  void flashCutAfter(uint64_t bytes, uint32_t seed = 1);  // ~0ull = never
+  bool flashPoweredOff();
+  void flashPowerOn();
+  void flashWipe(const char* label);  // whole partition 0xFF, no cost
+  // Whole partition image, e.g. to replay one scenario from the same state
+  bool flashSave(const char* label, std::vector<uint8_t>& out);
+  bool flashLoad(const char* label, const std::vector<uint8_t>& img);
+}
@@ -0,0 +1,54 @@
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+#include <thread>
+#include <mutex>
+#include <chrono>
+
+namespace hal {
+  static bool s_tasks = true;
+  void setTasksEnabled(bool on) { s_tasks = on; }
+}
+
+static thread_local BaseType_t t_core = 1; // loopTask runs on core 1
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char* name, uint32_t stackBytes,
+                                   void* arg, UBaseType_t prio, TaskHandle_t* handle, BaseType_t core) {
+  (void)name; (void)stackBytes; (void)prio;
+  if (!hal::s_tasks) return pdFAIL;
+  std::thread th([fn, arg, core]{ t_core = core; fn(arg); });
+  if (handle) *handle = (TaskHandle_t)(uintptr_t)std::hash<std::thread::id>()(th.get_id());
+  th.detach();
+  return pdPASS;
+}
+
+void vTaskDelete(TaskHandle_t h) { (void)h; }
+void vTaskDelay(TickType_t ticks) { delay(ticks * portTICK_PERIOD_MS); }
+TickType_t xTaskGetTickCount() { return (TickType_t)millis(); }
+BaseType_t xPortGetCoreID() { return t_core; }
+
+BaseType_t xTaskDelayUntil(TickType_t* prevWake, TickType_t increment) {
+  TickType_t wake = *prevWake + increment;
+  *prevWake = wake;
+  int32_t wait = (int32_t)(wake - xTaskGetTickCount());
+  if (wait <= 0) return pdFALSE;
+  // Sleep to the tick boundary on the same clock millis() uses.
+  uint64_t target = (uint64_t)wake * 1000u;
+  uint64_t now = hal::nowMicros();
+  if (target > now) delayMicroseconds((uint32_t)(target - now));
+  return pdTRUE;
+}
+
+struct SimSemaphore { std::timed_mutex m; };
+
+SemaphoreHandle_t xSemaphoreCreateMutex() { return new SimSemaphore(); }
+void vSemaphoreDelete(SemaphoreHandle_t s) { delete s; }
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t s, TickType_t ticks) {
+  if (ticks == 0) return s->m.try_lock() ? pdTRUE : pdFALSE;
+  if (ticks == portMAX_DELAY) { s->m.lock(); return pdTRUE; }
+  return s->m.try_lock_for(std::chrono::milliseconds(ticks)) ? pdTRUE : pdFALSE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t s) { s->m.unlock(); return pdTRUE; }
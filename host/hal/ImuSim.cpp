@@ -0,0 +1,100 @@
+#include "ImuSim.h"
+#include <Wire.h>
+#include <deque>
+
+namespace hal {
+  struct Mpu6050Sim : I2cDevice {
+    uint8_t regs[128] = {};
+    uint8_t ptr = 0;
+    std::deque<uint8_t> fifo;
+    std::vector<ImuSample> trace;
+    uint32_t tracePeriodUs = 2000;
+    uint64_t traceT0 = 0, nextUs = 0;
+    bool sampling = false;
+    uint32_t dropped = 0;
+
+    Mpu6050Sim() { regs[0x6B] = 0x40; regs[0x75] = 0x68; }  // asleep at power-up
+
+    uint32_t periodUs() const { return 1000u * (1 + regs[0x19]); }  // DLPF on: 1 kHz base
+    bool fifoOn() const { return (regs[0x6A] & 0x40) && regs[0x23] == 0x78; }
+
+    void sample(uint64_t t) {
+      ImuSample s{};
+      if (!trace.empty()) {
+        uint64_t i = t > traceT0 ? (t - traceT0) / tracePeriodUs : 0;
+        s = trace[i < trace.size() ? i : trace.size() - 1];
+      }
+      uint8_t b[12];
+      for (int k = 0; k < 3; ++k) {
+        b[2 * k] = (uint8_t)(s.a[k] >> 8);     b[2 * k + 1] = (uint8_t)s.a[k];
+        b[6 + 2 * k] = (uint8_t)(s.g[k] >> 8); b[7 + 2 * k] = (uint8_t)s.g[k];
+      }
+      for (int k = 0; k < 6; ++k) { regs[0x3B + k] = b[k]; regs[0x43 + k] = b[6 + k]; }
+      if (!fifoOn()) return;
+      fifo.insert(fifo.end(), b, b + 12);
+      if (fifo.size() > 1024) { fifo.erase(fifo.begin(), fifo.begin() + 12); dropped++; }
+    }
+
+    void sync() {
+      uint64_t now = nowMicros();
+      if (regs[0x6B] & 0x40) { sampling = false; return; }
+      if (!sampling) { sampling = true; nextUs = now + periodUs(); }
+      while (nextUs <= now) { sample(nextUs); nextUs += periodUs(); }
+    }
+
+    void i2cWrite(const uint8_t* d, size_t n) override {
+      sync();
+      if (n == 0) return;
+      ptr = d[0] & 0x7F;
+      for (size_t i = 1; i < n; ++i) {
+        uint8_t r = ptr;
+        regs[r] = d[i];
+        if (r == 0x6A && (d[i] & 0x04)) { fifo.clear(); regs[r] &= ~0x04; }  // FIFO_RESET self-clears
+        if (r != 0x74) ptr = (ptr + 1) & 0x7F;
+      }
+    }
+
+    size_t i2cRead(uint8_t* d, size_t n) override {
+      sync();
+      for (size_t i = 0; i < n; ++i) {
+        if (ptr == 0x74) {
+          if (fifo.empty()) d[i] = 0;
+          else { d[i] = fifo.front(); fifo.pop_front(); }
+          continue;
+        }
+        if (ptr == 0x72) d[i] = (uint8_t)(fifo.size() >> 8);
+        else if (ptr == 0x73) d[i] = (uint8_t)fifo.size();
+        else d[i] = regs[ptr];
+        ptr = (ptr + 1) & 0x7F;
+      }
+      return n;
+    }
+  };
+
+  static Mpu6050Sim* s_imu = nullptr;
+  static uint8_t s_imuAddr = 0x68;
+
+  void imuAttach(uint8_t addr) {
+    imuDetach();
+    s_imu = new Mpu6050Sim();
+    s_imuAddr = addr;
+    i2cAttach(addr, s_imu);
+  }
+
+  void imuDetach() {
+    if (!s_imu) return;
+    i2cAttach(s_imuAddr, nullptr);
+    delete s_imu;
+    s_imu = nullptr;
+  }
+
+  void imuLoad(const std::vector<ImuSample>& trace, uint32_t periodUs) {
+    if (!s_imu) return;
+    s_imu->sync();
+    s_imu->trace = trace;
+    s_imu->tracePeriodUs = periodUs ? periodUs : 1;
+    s_imu->traceT0 = nowMicros();
+  }
+
+  uint32_t imuFifoDropped() { return s_imu ? s_imu->dropped : 0; }
+}
@@ -0,0 +1,18 @@
+#pragma once
+// MPU-6050 on the sim I2C bus (hal/Wire.h): the registers Mpu6050 (Imu.h)
+// uses, and a 1 KB FIFO filled at the rate set through SMPLRT_DIV from a
+// loaded trace, lazily up to hal::nowMicros() on every bus access. A full
+// FIFO drops its oldest sample, like the chip.
+#include <Arduino.h>
+#include <vector>
+
+namespace hal {
+  struct ImuSample { int16_t a[3], g[3]; };  // sensor LSBs (accel XYZ, gyro XYZ)
+
+  void imuAttach(uint8_t addr = 0x68);
+  void imuDetach();
+  // Body motion from now on: sample i holds at now + i*periodUs; the chip
+  // picks the sample at each of its own sample times (last one held).
+  void imuLoad(const std::vector<ImuSample>& trace, uint32_t periodUs);
+  uint32_t imuFifoDropped();  // samples the full FIFO overwrote
+}
@@ -0,0 +1,130 @@
+#include "MotorSim.h"
+#include "driver/pulse_cnt.h"
+#include <vector>
+
+namespace hal {
+  int plantsAttached = 0;
+
+  struct Motor {
+    uint8_t in1, in2, en, encA, encB;
+    float dutyMax;
+    MotorParams p;
+    float i = 0, w = 0, theta = 0, load = 0;
+  };
+  static std::vector<Motor> s_motors;
+
+  struct ServoPlant {
+    uint8_t pin; int minUs, maxUs;
+    ServoParams p;
+    float deg = 90, w = 0, u = 0;
+  };
+  static std::vector<ServoPlant> s_servos;
+  static float    s_vbat = 12.0f;
+  static uint64_t s_lastUs = 0;
+  static const float SUBSTEP_S = 50e-6f; // << L/R (0.8 ms) and J*R/ke^2 (33 ms)
+
+  int motorAttach(uint8_t in1, uint8_t in2, uint8_t en, uint8_t encA, uint8_t encB,
+                  uint8_t pwmBits, const MotorParams& p) {
+    motorSync();
+    s_motors.push_back(Motor{ in1, in2, en, encA, encB, (float)((1 << pwmBits) - 1), p });
+    plantsAttached++;
+    s_lastUs = nowMicros();
+    return (int)s_motors.size() - 1;
+  }
+
+  void motorsReset() { s_motors.clear(); s_servos.clear(); plantsAttached = 0; }
+  void motorSetVbat(float volts) { motorSync(); s_vbat = volts; }
+  void motorSetLoad(int id, float nm) { motorSync(); s_motors[id].load = nm; }
+  float motorSpeed(int id) { motorSync(); return s_motors[id].w; }
+  float motorCurrentA(int id) { motorSync(); return s_motors[id].i; }
+
+  int servoPlantAttach(uint8_t pin, int minUs, int maxUs, const ServoParams& p) {
+    motorSync();
+    ServoPlant sp{ pin, minUs, maxUs, p };
+    if (pin < MAX_PINS && pinDuty[pin] > 0) sp.deg = (float)(pinDuty[pin] - minUs) * 180.0f / (maxUs - minUs);
+    s_servos.push_back(sp);
+    plantsAttached++;
+    s_lastUs = nowMicros();
+    return (int)s_servos.size() - 1;
+  }
+
+  float servoPlantDeg(int id) { motorSync(); return s_servos[id].deg; }
+
+  float servoPlantMa(int id) {
+    motorSync();
+    const ServoPlant& s = s_servos[id];
+    return s.p.idleMa + s.p.stallMa * fabsf(s.u - s.w / s.p.wmax) + s.p.fricMa * fabsf(s.w) / s.p.wmax;
+  }
+
+  static void stepServo(ServoPlant& s, float dt) {
+    int us = s.pin < MAX_PINS ? pinDuty[s.pin] : 0;
+    if (us <= 0) { s.u = 0; s.w = 0; return; }  // no pulse: motor off
+    float cmd = (float)(us - s.minUs) * 180.0f / (s.maxUs - s.minUs);
+    float u = (cmd - s.deg) * s.p.kp;
+    s.u = u > 1 ? 1 : (u < -1 ? -1 : u);
+    s.w += dt * (s.u * s.p.wmax - s.w) / s.p.tau;
+    s.deg += dt * s.w;
+  }
+
+  int32_t motorCountForPin(uint8_t encA) {
+    motorSync();
+    for (auto& m : s_motors)
+      if (m.encA == encA) return (int32_t)floorf(m.theta * m.p.cpr / (2.0f * (float)M_PI));
+    return 0;
+  }
+
+  // Averaged bridge: in1!=in2 drives +-duty*Vbat, in1==in2==HIGH shorts the
+  // winding (brake), both LOW opens it (coast: no current).
+  static void step(Motor& m, float dt) {
+    int a = pinLevel[m.in1], c = pinLevel[m.in2];
+    float d = (float)pinDuty[m.en] / m.dutyMax;
+    if (d < 0) d = 0; else if (d > 1) d = 1;
+    if (a == LOW && c == LOW) m.i = 0;
+    else {
+      float v = (a == c) ? 0.0f : (a == HIGH ? 1.0f : -1.0f) * d * s_vbat;
+      m.i += dt * (v - m.p.r * m.i - m.p.ke * m.w) / m.p.l;
+    }
+    float tq = m.p.ke * m.i - m.p.b * m.w - m.load;
+    if (fabsf(m.w) < 1e-3f && fabsf(tq) <= m.p.tc) { m.w = 0; return; } // stiction
+    float sgn = fabsf(m.w) >= 1e-3f ? (m.w > 0 ? 1.0f : -1.0f) : (tq > 0 ? 1.0f : -1.0f);
+    float w = m.w + dt * (tq - sgn * m.p.tc) / m.p.j;
+    if (m.w != 0 && (w > 0) != (m.w > 0)) w = 0; // friction stops, never reverses
+    m.w = w;
+    m.theta += dt * m.w;
+  }
+
+  void motorSync() {
+    uint64_t now = nowMicros();
+    if (now <= s_lastUs) return;
+    float left = (float)(now - s_lastUs) * 1e-6f;
+    s_lastUs = now;
+    while (left > 0) {
+      float dt = left < SUBSTEP_S ? left : SUBSTEP_S;
+      for (auto& m : s_motors) step(m, dt);
+      for (auto& v : s_servos) stepServo(v, dt);
+      left -= dt;
+    }
+  }
+}
+
+// ==== PCNT stub ====
+struct pcnt_unit_t { int encA = -1; int32_t base = 0; };
+struct pcnt_chan_t { int dummy; };
+
+esp_err_t pcnt_new_unit(const pcnt_unit_config_t*, pcnt_unit_handle_t* u) { *u = new pcnt_unit_t(); return ESP_OK; }
+esp_err_t pcnt_unit_set_glitch_filter(pcnt_unit_handle_t, const pcnt_glitch_filter_config_t*) { return ESP_OK; }
+esp_err_t pcnt_new_channel(pcnt_unit_handle_t u, const pcnt_chan_config_t* c, pcnt_channel_handle_t* ch) {
+  if (u->encA < 0) u->encA = c->edge_gpio_num;
+  *ch = new pcnt_chan_t();
+  return ESP_OK;
+}
+esp_err_t pcnt_channel_set_edge_action(pcnt_channel_handle_t, pcnt_channel_edge_action_t, pcnt_channel_edge_action_t) { return ESP_OK; }
+esp_err_t pcnt_channel_set_level_action(pcnt_channel_handle_t, pcnt_channel_level_action_t, pcnt_channel_level_action_t) { return ESP_OK; }
+esp_err_t pcnt_unit_add_watch_point(pcnt_unit_handle_t, int) { return ESP_OK; }
+esp_err_t pcnt_unit_enable(pcnt_unit_handle_t) { return ESP_OK; }
+esp_err_t pcnt_unit_clear_count(pcnt_unit_handle_t u) { u->base = hal::motorCountForPin((uint8_t)u->encA); return ESP_OK; }
+esp_err_t pcnt_unit_start(pcnt_unit_handle_t) { return ESP_OK; }
+esp_err_t pcnt_unit_get_count(pcnt_unit_handle_t u, int* v) {
+  *v = (int)(hal::motorCountForPin((uint8_t)u->encA) - u->base);
+  return ESP_OK;
+}
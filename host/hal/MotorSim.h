@@ -0,0 +1,51 @@
+#pragma once
+// Actuator plants for closed-loop and power tests on the host:
+//  - brushed DC gearmotor + quadrature encoder behind an L298-style bridge
+//    (inputs: bridge pins via digitalWrite/analogWrite; encoder counts via
+//    the PCNT stub, driver/pulse_cnt.h)
+//  - hobby servo (input: pulse width via Servo::writeMicroseconds)
+// Plants integrate lazily up to hal::nowMicros() before any input change
+// or read, so inputs are exact piecewise-constant signals.
+#include <Arduino.h>
+
+namespace hal {
+  // Referred to the wheel shaft (gearbox folded in). Defaults: 12 V class
+  // 200 rpm gearmotor moving ~1.5 kg per wheel on a 35 mm radius.
+  struct MotorParams {
+    float r   = 2.5f;     // winding resistance (ohm)
+    float l   = 0.002f;   // inductance (H)
+    float ke  = 0.55f;    // back-EMF = torque constant (V*s/rad = N*m/A)
+    float j   = 0.004f;   // inertia (kg*m^2)
+    float b   = 0.002f;   // viscous friction (N*m*s/rad)
+    float tc  = 0.08f;    // Coulomb friction (N*m)
+    float cpr = 1320.0f;  // encoder counts per wheel revolution (x4)
+  };
+
+  // Bridge pins in1/in2 (direction), en (PWM, pwmBits), encoder A/B pins.
+  // Returns the motor id.
+  int   motorAttach(uint8_t in1, uint8_t in2, uint8_t en, uint8_t encA, uint8_t encB,
+                    uint8_t pwmBits, const MotorParams& p = MotorParams());
+  void  motorsReset();                    // detach all plants
+  void  motorSync();                      // integrate every plant up to now
+  void  motorSetVbat(float volts);        // supply, shared by all motors
+  void  motorSetLoad(int id, float nm);   // external torque opposing forward motion
+  float motorSpeed(int id);               // wheel rad/s
+  int32_t motorCountForPin(uint8_t encA); // encoder count (0 if no motor on encA)
+  float motorCurrentA(int id);            // winding current (A, signed)
+
+  // MG995-class servo referred to the horn: internal P loop on the pulse
+  // angle saturating at full drive, first-order speed response.
+  struct ServoParams {
+    float wmax    = 353.0f;  // no-load speed (deg/s; 0.17 s/60 deg)
+    float tau     = 0.03f;   // speed time constant (s)
+    float kp      = 0.1f;    // drive per deg of error (full beyond 10 deg)
+    float stallMa = 1200.0f; // full drive at standstill
+    float fricMa  = 150.0f;  // extra at full speed (gear friction)
+    float idleMa  = 10.0f;   // holding, no error
+  };
+  int   servoPlantAttach(uint8_t pin, int minUs, int maxUs, const ServoParams& p = ServoParams());
+  float servoPlantMa(int id);             // supply current (mA)
+  float servoPlantDeg(int id);            // horn angle
+
+  extern int plantsAttached;              // input writes sync the plants only when > 0
+}
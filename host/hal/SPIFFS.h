@@ -0,0 +1,15 @@
+#pragma once
+#include <FS.h>
+
+#define SPIFFS_PART_BYTES 0x60000u  // spiffs in partitions.csv
+
+class SPIFFSFS : public fs::FS {
+public:
+  bool begin(bool formatOnFail = false, const char* basePath = "/spiffs",
+             uint8_t maxOpenFiles = 10, const char* label = nullptr);
+  void end() {}
+  bool format();
+  size_t totalBytes() { return SPIFFS_PART_BYTES; }
+  size_t usedBytes();
+};
+extern SPIFFSFS SPIFFS;
@@ -0,0 +1,143 @@
+#include <WebServer.h>
+#include <strings.h>
+#include <algorithm>
+
+static std::string urlDecode(const std::string& s) {
+  std::string out;
+  for (size_t i = 0; i < s.size(); ++i) {
+    if (s[i] == '+') out += ' ';
+    else if (s[i] == '%' && i + 2 < s.size()) { out += (char)strtol(s.substr(i + 1, 2).c_str(), nullptr, 16); i += 2; }
+    else out += s[i];
+  }
+  return out;
+}
+
+void WebServer::on(const char* uri, HTTPMethod method, THandlerFunction fn) {
+  _routes.push_back(Route{uri, method, fn, nullptr});
+}
+void WebServer::on(const char* uri, HTTPMethod method, THandlerFunction fn, THandlerFunction ufn) {
+  _routes.push_back(Route{uri, method, fn, ufn});
+}
+
+void WebServer::sim_enqueue(HTTPMethod method, const char* uri,
+                            std::vector<std::pair<std::string, std::string>> headers) {
+  Request r;
+  r.method = method;
+  r.headers = std::move(headers);
+  std::string u = uri;
+  size_t q = u.find('?');
+  r.path = u.substr(0, q);
+  if (q != std::string::npos) {
+    std::string qs = u.substr(q + 1);
+    size_t a = 0;
+    while (a <= qs.size()) {
+      size_t b = qs.find('&', a);
+      if (b == std::string::npos) b = qs.size();
+      std::string kv = qs.substr(a, b - a);
+      if (!kv.empty()) {
+        size_t e = kv.find('=');
+        if (e == std::string::npos) r.args.push_back({urlDecode(kv), ""});
+        else r.args.push_back({urlDecode(kv.substr(0, e)), urlDecode(kv.substr(e + 1))});
+      }
+      a = b + 1;
+    }
+  }
+  _queue.push_back(std::move(r));
+}
+
+void WebServer::sim_enqueue(HTTPMethod method, const char* uri,
+                            std::vector<std::pair<std::string, std::string>> headers, size_t len, SimBodySource source) {
+  headers.push_back({"Content-Length", std::to_string(len)});
+  sim_enqueue(method, uri, std::move(headers));
+  _queue.back().bodyLen = len;
+  _queue.back().body = std::move(source);
+}
+
+// Body to the upload handler in HTTP_RAW_BUFLEN chunks; false = aborted
+bool WebServer::_readBody(const Route& r) {
+  _raw.status = RAW_START; _raw.totalSize = 0; _raw.currentSize = 0;
+  r.ufn();
+  _raw.status = RAW_WRITE;
+  while (_raw.totalSize < _req.bodyLen) {
+    size_t want = std::min((size_t)HTTP_RAW_BUFLEN, _req.bodyLen - _raw.totalSize);
+    _raw.currentSize = _req.body ? _req.body(_raw.buf, want) : 0;
+    _raw.totalSize += _raw.currentSize;
+    if (_raw.currentSize == 0) { _raw.status = RAW_ABORTED; r.ufn(); return false; }
+    r.ufn();
+  }
+  _raw.status = RAW_END;
+  r.ufn();
+  return true;
+}
+void WebServer::handleClient() {
+  if (!_running || _queue.empty()) return;
+  _req = std::move(_queue.front());
+  _queue.pop_front();
+  _resp = SimHttpResponse();
+  _pendingHeaders.clear();
+  _contentLength = CONTENT_LENGTH_UNKNOWN;
+  hal::counters.httpRequests++;
+  if (_costUs) delayMicroseconds(_costUs);
+
+  for (auto& r : _routes) {
+    if (r.uri == _req.path && (r.method == HTTP_ANY || r.method == _req.method)) {
+      if (r.ufn && _req.bodyLen && !_readBody(r)) return;  // client gone: no response
+      r.fn();
+      return;
+    }
+  }
+  if (_notFound) _notFound();
+  else send(404, "text/plain", "Not found");
+}
+
+bool WebServer::hasArg(const String& name) const {
+  for (auto& a : _req.args) if (a.first == name.c_str()) return true;
+  return false;
+}
+
+String WebServer::arg(const String& name) const {
+  for (auto& a : _req.args) if (a.first == name.c_str()) return String(a.second);
+  return String();
+}
+
+bool WebServer::hasHeader(const String& name) const {
+  for (auto& h : _req.headers) if (strcasecmp(h.first.c_str(), name.c_str()) == 0) return true;
+  return false;
+}
+
+String WebServer::header(const String& name) const {
+  for (auto& h : _req.headers) if (strcasecmp(h.first.c_str(), name.c_str()) == 0) return String(h.second);
+  return String();
+}
+
+void WebServer::sendHeader(const String& name, const String& value, bool first) {
+  auto h = std::make_pair(std::string(name.c_str()), std::string(value.c_str()));
+  if (first) _pendingHeaders.insert(_pendingHeaders.begin(), h);
+  else _pendingHeaders.push_back(h);
+}
+
+void WebServer::_body(const char* p, size_t n) {
+  _resp.bodyBytes += n;
+  if (_sink) _sink(p, n);
+  else _resp.body.append(p, n);
+}
+
+void WebServer::send(int code, const char* type, const String& content) {
+  _resp.code = code;
+  _resp.type = type ? type : "";
+  _resp.headers = _pendingHeaders;
+  _resp.contentLength = _contentLength != CONTENT_LENGTH_UNKNOWN ? _contentLength : content.length();
+  _body(content.c_str(), content.length());
+}
+
+void WebServer::send_P(int code, PGM_P type, PGM_P content) { send_P(code, type, content, strlen(content)); }
+
+void WebServer::send_P(int code, PGM_P type, PGM_P content, size_t len) {
+  _resp.code = code;
+  _resp.type = type ? type : "";
+  _resp.headers = _pendingHeaders;
+  _resp.contentLength = len;
+  _body(content, len);
+}
+
+void WebServer::sendContent(const char* p, size_t n) { _body(p, n); }
@@ -0,0 +1,112 @@
+#pragma once
+// Host stand-in for the ESP32 WebServer. Requests are queued with
+// sim_enqueue() and handleClient() serves at most one per call, like the
+// real server does with one pending client. A request body goes to the
+// route's upload handler as HTTPRaw chunks of HTTP_RAW_BUFLEN, as the
+// ESP32 core does for non-form bodies.
+#include <Arduino.h>
+#include <functional>
+#include <deque>
+#include <vector>
+#include <utility>
+
+enum HTTPMethod { HTTP_ANY, HTTP_GET, HTTP_HEAD, HTTP_POST, HTTP_PUT, HTTP_PATCH, HTTP_DELETE, HTTP_OPTIONS };
+
+#define CONTENT_LENGTH_UNKNOWN ((size_t)-1)
+#define HTTP_RAW_BUFLEN 1436
+
+enum HTTPRawStatus { RAW_START, RAW_WRITE, RAW_END, RAW_ABORTED };
+struct HTTPRaw {
+  HTTPRawStatus status = RAW_START;
+  size_t totalSize = 0;    // body bytes so far
+  size_t currentSize = 0;  // bytes in buf
+  uint8_t buf[HTTP_RAW_BUFLEN];
+};
+
+struct SimHttpResponse {
+  int code = 0;
+  std::string type;
+  std::string body;        // empty when a body sink is set
+  size_t contentLength = CONTENT_LENGTH_UNKNOWN;  // as announced
+  size_t bodyBytes = 0;    // as sent
+  std::vector<std::pair<std::string, std::string>> headers;
+};
+
+class WebServer {
+public:
+  typedef std::function<void(void)> THandlerFunction;
+
+  explicit WebServer(int port = 80) : _port(port) {}
+
+  void begin() { _running = true; }
+  void stop()  { _running = false; }
+  void handleClient();
+
+  void on(const char* uri, THandlerFunction fn) { on(uri, HTTP_ANY, fn); }
+  void on(const char* uri, HTTPMethod method, THandlerFunction fn);
+  void on(const char* uri, HTTPMethod method, THandlerFunction fn, THandlerFunction ufn);
+  void onNotFound(THandlerFunction fn) { _notFound = fn; }
+
+  String uri() const { return String(_req.path); }
+  HTTPMethod method() const { return _req.method; }
+  bool   hasArg(const String& name) const;
+  String arg(const String& name) const;
+  int    args() const { return (int)_req.args.size(); }
+  HTTPRaw& raw() { return _raw; }
+
+  void   collectHeaders(const char* keys[], size_t n) { (void)keys; (void)n; }
+  bool   hasHeader(const String& name) const;
+  String header(const String& name) const;
+
+  void send(int code, const char* type = nullptr, const String& content = String(""));
+  void send(int code, const String& type, const String& content) { send(code, type.c_str(), content); }
+  void send_P(int code, PGM_P type, PGM_P content);
+  void send_P(int code, PGM_P type, PGM_P content, size_t len);
+  void sendHeader(const String& name, const String& value, bool first = false);
+  void setContentLength(size_t len) { _contentLength = len; }
+  void sendContent(const String& s) { sendContent(s.c_str(), s.length()); }
+  void sendContent(const char* p, size_t n);
+
+  // ==== Sim side ====
+  // uri may carry a query string: "/ctl_drive?y=0.5"
+  void sim_enqueue(HTTPMethod method, const char* uri,
+                   std::vector<std::pair<std::string, std::string>> headers = {});
+  // With a body of len bytes pulled from source (Content-Length is added);
+  // source returning 0 early = client gone (RAW_ABORTED)
+  typedef std::function<size_t(uint8_t* buf, size_t max)> SimBodySource;
+  void sim_enqueue(HTTPMethod method, const char* uri,
+                   std::vector<std::pair<std::string, std::string>> headers, size_t len, SimBodySource source);
+  // Response bodies go to sink instead of sim_lastResponse().body (null = keep)
+  typedef std::function<void(const char* p, size_t n)> SimBodySink;
+  void sim_setBodySink(SimBodySink sink) { _sink = sink; }
+  size_t sim_pending() const { return _queue.size(); }
+  const SimHttpResponse& sim_lastResponse() const { return _resp; }
+  // Extra wall time burned per served request (slow client / weak link).
+  void sim_setRequestCostUs(uint32_t us) { _costUs = us; }
+
+private:
+  struct Route { std::string uri; HTTPMethod method; THandlerFunction fn, ufn; };
+  struct Request {
+    HTTPMethod method = HTTP_GET;
+    std::string path;
+    std::vector<std::pair<std::string, std::string>> args;
+    std::vector<std::pair<std::string, std::string>> headers;
+    size_t bodyLen = 0;
+    SimBodySource body;
+  };
+  void _body(const char* p, size_t n);
+  bool _readBody(const Route& r);
+
+  int  _port;
+  bool _running = false;
+  std::vector<Route> _routes;
+  THandlerFunction _notFound;
+  std::deque<Request> _queue;
+  Request _req;
+  SimHttpResponse _resp;
+  std::vector<std::pair<std::string, std::string>> _pendingHeaders;
+  size_t _contentLength = CONTENT_LENGTH_UNKNOWN;
+  uint32_t _costUs = 0;
+  HTTPRaw _raw;
+  SimBodySink _sink;
+};
@@ -0,0 +1,13 @@
+#include <WebSocketsServer.h>
+
+void WebSocketsServer::loop() {
+  if (!_running) return;
+  while (!_queue.empty()) {
+    Ev e = std::move(_queue.front());
+    _queue.pop_front();
+    if (e.type == WStype_CONNECTED) _clients++;
+    if (e.type == WStype_DISCONNECTED && _clients) _clients--;
+    if (_costUs) delayMicroseconds(_costUs);
+    if (_cb) _cb(e.num, e.type, e.data.empty() ? nullptr : e.data.data(), e.data.size());
+  }
+}
@@ -0,0 +1,53 @@
+#pragma once
+// Host stand-in for the arduinoWebSockets server (Links2004). Frames are
+// queued with sim_enqueue*() and loop() delivers everything pending, like
+// the real server drains its clients on each call.
+#include <Arduino.h>
+#include <functional>
+#include <deque>
+#include <vector>
+
+typedef enum {
+  WStype_ERROR, WStype_DISCONNECTED, WStype_CONNECTED, WStype_TEXT, WStype_BIN,
+  WStype_FRAGMENT_TEXT_START, WStype_FRAGMENT_BIN_START, WStype_FRAGMENT, WStype_FRAGMENT_FIN,
+  WStype_PING, WStype_PONG,
+} WStype_t;
+
+#define WEBSOCKETS_SERVER_CLIENT_MAX 5
+
+class WebSocketsServer {
+public:
+  typedef std::function<void(uint8_t num, WStype_t type, uint8_t* payload, size_t length)> WebSocketServerEvent;
+
+  explicit WebSocketsServer(uint16_t port) : _port(port) {}
+  void begin() { _running = true; }
+  void onEvent(WebSocketServerEvent cb) { _cb = cb; }
+  void loop();
+
+  bool sendBIN(uint8_t num, const uint8_t* payload, size_t len) { (void)num; (void)payload; (void)len; return true; }
+  bool broadcastTXT(const char* payload, size_t len = 0) { (void)payload; (void)len; return true; }
+  uint8_t connectedClients(bool ping = false) { (void)ping; return _clients; }
+
+  // ==== Sim side ====
+  void sim_connect(uint8_t num)    { _push(num, WStype_CONNECTED, nullptr, 0); }
+  void sim_disconnect(uint8_t num) { _push(num, WStype_DISCONNECTED, nullptr, 0); }
+  void sim_enqueueBin(uint8_t num, const void* data, size_t len) { _push(num, WStype_BIN, data, len); }
+  size_t sim_pending() const { return _queue.size(); }
+  // Wall time burned per delivered frame (socket read + unmasking).
+  void sim_setFrameCostUs(uint32_t us) { _costUs = us; }
+
+private:
+  struct Ev { uint8_t num; WStype_t type; std::vector<uint8_t> data; };
+  void _push(uint8_t num, WStype_t type, const void* data, size_t len) {
+    Ev e{num, type, {}};
+    if (data) e.data.assign((const uint8_t*)data, (const uint8_t*)data + len);
+    _queue.push_back(std::move(e));
+  }
+
+  uint16_t _port;
+  bool _running = false;
+  uint8_t _clients = 0;
+  uint32_t _costUs = 0;
+  WebSocketServerEvent _cb;
+  std::deque<Ev> _queue;
+};
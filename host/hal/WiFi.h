@@ -0,0 +1,31 @@
+#pragma once
+#include <Arduino.h>
+
+enum wifi_mode_t { WIFI_OFF = 0, WIFI_STA = 1, WIFI_AP = 2, WIFI_AP_STA = 3 };
+
+class IPAddress {
+public:
+  IPAddress(uint8_t a = 0, uint8_t b = 0, uint8_t c = 0, uint8_t d = 0) : _o{a, b, c, d} {}
+  String toString() const {
+    char buf[16]; snprintf(buf, sizeof(buf), "%u.%u.%u.%u", _o[0], _o[1], _o[2], _o[3]);
+    return String(buf);
+  }
+  uint8_t operator[](int i) const { return _o[i]; }
+private:
+  uint8_t _o[4];
+};
+
+class WiFiClass {
+public:
+  bool mode(wifi_mode_t m) { _mode = m; return true; }
+  bool softAPConfig(IPAddress ip, IPAddress gw, IPAddress mask) { _ip = ip; (void)gw; (void)mask; return true; }
+  bool softAP(const char* ssid, const char* pass = nullptr) { (void)ssid; (void)pass; return true; }
+  IPAddress softAPIP() const { return _ip; }
+  uint8_t softAPgetStationNum() const { return stations; }
+
+  uint8_t stations = 1; // sim knob
+private:
+  wifi_mode_t _mode = WIFI_OFF;
+  IPAddress _ip{192, 168, 4, 1};
+};
+extern WiFiClass WiFi;
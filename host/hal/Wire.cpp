@@ -0,0 +1,37 @@
+#include <Wire.h>
+
+TwoWire Wire;
+
+namespace hal {
+  static I2cDevice* s_devs[128];
+  void i2cAttach(uint8_t addr, I2cDevice* dev) { s_devs[addr & 0x7F] = dev; }
+}
+
+void TwoWire::beginTransmission(uint8_t addr) { _addr = addr & 0x7F; _txLen = 0; }
+
+size_t TwoWire::write(uint8_t b) {
+  if (_txLen >= BUFFER) return 0;
+  _tx[_txLen++] = b;
+  return 1;
+}
+
+uint8_t TwoWire::endTransmission(bool sendStop) {
+  (void)sendStop;
+  hal::counters.i2cBytes += 1 + _txLen;
+  hal::I2cDevice* d = hal::s_devs[_addr];
+  if (!d) return 2;
+  d->i2cWrite(_tx, _txLen);
+  return 0;
+}
+
+size_t TwoWire::requestFrom(uint8_t addr, size_t n, bool sendStop) {
+  (void)sendStop;
+  _rxLen = _rxPos = 0;
+  hal::I2cDevice* d = hal::s_devs[addr & 0x7F];
+  hal::counters.i2cBytes += 1;
+  if (!d) return 0;
+  if (n > BUFFER) n = BUFFER;
+  _rxLen = d->i2cRead(_rx, n);
+  hal::counters.i2cBytes += _rxLen;
+  return _rxLen;
+}
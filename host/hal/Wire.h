@@ -0,0 +1,35 @@
+#pragma once
+#include <Arduino.h>
+
+// Host stand-in for the Arduino Wire (I2C master) library. Transfers go to
+// a device registered at the address (hal::i2cAttach, e.g. the MPU-6050 in
+// hal/ImuSim.h); address and data bytes count in hal::counters.i2cBytes.
+namespace hal {
+  struct I2cDevice {
+    virtual ~I2cDevice() {}
+    virtual void   i2cWrite(const uint8_t* d, size_t n) = 0;  // one write transaction
+    virtual size_t i2cRead(uint8_t* d, size_t n) = 0;         // one read transaction
+  };
+  void i2cAttach(uint8_t addr, I2cDevice* dev);  // nullptr detaches
+}
+
+class TwoWire {
+public:
+  bool begin(int sda = -1, int scl = -1, uint32_t freq = 0) { (void)sda; (void)scl; (void)freq; return true; }
+  void setClock(uint32_t freq) { (void)freq; }
+  void beginTransmission(uint8_t addr);
+  size_t write(uint8_t b);
+  uint8_t endTransmission(bool sendStop = true);        // 0 = ok, 2 = NACK on address
+  size_t requestFrom(uint8_t addr, size_t n, bool sendStop = true);
+  int available() const { return (int)(_rxLen - _rxPos); }
+  int read() { return _rxPos < _rxLen ? _rx[_rxPos++] : -1; }
+
+  static const size_t BUFFER = 128;  // arduino-esp32 I2C buffer
+
+private:
+  uint8_t _addr = 0;
+  uint8_t _tx[BUFFER]; size_t _txLen = 0;
+  uint8_t _rx[BUFFER]; size_t _rxLen = 0, _rxPos = 0;
+};
+
+extern TwoWire Wire;
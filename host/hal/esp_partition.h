@@ -0,0 +1,42 @@
+#pragma once
+// Host stand-in for ESP-IDF esp_partition.h. Only the data partitions of
+// partitions.csv that the firmware maps raw ("takes"); each is a NOR flash
+// emulator backed by a file (hal/FlashSim.h): erase sets 0xFF a sector at
+// a time, programming can only clear bits.
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+typedef int esp_err_t;
+#ifndef ESP_OK
+#define ESP_OK 0
+#define ESP_FAIL -1
+#endif
+#define ESP_ERR_INVALID_ARG  0x102
+#define ESP_ERR_INVALID_SIZE 0x104
+
+typedef enum { ESP_PARTITION_TYPE_APP = 0x00, ESP_PARTITION_TYPE_DATA = 0x01 } esp_partition_type_t;
+typedef enum {
+  ESP_PARTITION_SUBTYPE_DATA_SPIFFS = 0x82,
+  ESP_PARTITION_SUBTYPE_ANY = 0xff,
+} esp_partition_subtype_t;
+
+typedef struct {
+  void*                   flash_chip;
+  esp_partition_type_t    type;
+  esp_partition_subtype_t subtype;
+  uint32_t                address;
+  uint32_t                size;
+  uint32_t                erase_size;
+  char                    label[17];
+  bool                    encrypted;
+  bool                    readonly;
+} esp_partition_t;
+
+const esp_partition_t* esp_partition_find_first(esp_partition_type_t type, esp_partition_subtype_t subtype,
+                                                const char* label);
+esp_err_t esp_partition_read(const esp_partition_t* p, size_t src_offset, void* dst, size_t size);
+// offset/size need not be aligned; fails past the end or after a power cut
+esp_err_t esp_partition_write(const esp_partition_t* p, size_t dst_offset, const void* src, size_t size);
+// offset/size must be multiples of erase_size (4096)
+esp_err_t esp_partition_erase_range(const esp_partition_t* p, size_t offset, size_t size);
@@ -0,0 +1,25 @@
+#pragma once
+// Host stand-in for the FreeRTOS subset CamMate uses. Tasks are detached
+// std::threads (core pinning and priorities are ignored); ticks are 1 ms.
+#include <stdint.h>
+
+typedef uint32_t TickType_t;
+typedef int      BaseType_t;
+typedef unsigned UBaseType_t;
+
+#define configTICK_RATE_HZ   1000
+#define portTICK_PERIOD_MS   (1000 / configTICK_RATE_HZ)
+#define pdMS_TO_TICKS(ms)    ((TickType_t)(ms))
+#define portMAX_DELAY        ((TickType_t)0xFFFFFFFFu)
+#define configMAX_PRIORITIES 25
+
+#define pdFALSE 0
+#define pdTRUE  1
+#define pdFAIL  0
+#define pdPASS  1
+
+namespace hal {
+  // Off: xTaskCreatePinnedToCore() fails, so firmware falls back to its
+  // single-threaded path (used by virtual-clock benches).
+  void setTasksEnabled(bool on);
+}
@@ -0,0 +1,14 @@
+#pragma once
+#include "FreeRTOS.h"
+
+typedef void* TaskHandle_t;
+typedef void (*TaskFunction_t)(void*);
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char* name, uint32_t stackBytes,
+                                   void* arg, UBaseType_t prio, TaskHandle_t* handle, BaseType_t core);
+void       vTaskDelete(TaskHandle_t h);   // NULL: caller returns from its task function
+void       vTaskDelay(TickType_t ticks);
+BaseType_t xTaskDelayUntil(TickType_t* prevWake, TickType_t increment);
+static inline void vTaskDelayUntil(TickType_t* prevWake, TickType_t increment) { xTaskDelayUntil(prevWake, increment); }
+TickType_t xTaskGetTickCount();
+BaseType_t xPortGetCoreID();
@@ -0,0 +1,121 @@
+#!/usr/bin/env python3
+"""Builds ui_index.h (repo root) from ui/: inlines style.css and app.js into
+index.html, minifies conservatively, gzips and emits a PROGMEM array plus a
+content-hash ETag.
+
+    python3 tools/build_ui.py          # regenerate ui_index.h
+    python3 tools/build_ui.py --check  # exit 1 if ui_index.h is stale
+
+Only whitespace and comments are removed; string and template literals are
+kept byte for byte. app.js must not use regex literals (the JS pass does
+not tell them apart from division).
+"""
+import gzip
+import hashlib
+import os
+import re
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+UI = os.path.join(ROOT, "ui")
+OUT = os.path.join(ROOT, "ui_index.h")
+
+
+def read(name):
+    with open(os.path.join(UI, name), encoding="ascii") as f:
+        return f.read()
+
+
+def min_css(s):
+    s = re.sub(r"/\*.*?\*/", "", s, flags=re.S)
+    s = re.sub(r"\s+", " ", s)
+    s = re.sub(r"\s*([{};,])\s*", r"\1", s)   # not ':' -- "a :hover" differs from "a:hover"
+    s = re.sub(r":\s+", ":", s)
+    return s.replace(";}", "}").strip()
+
+
+IDENT = re.compile(r"[A-Za-z0-9_$]")
+
+
+def min_js(s):
+    out, i, n = [], 0, len(s)
+    ws = ""  # pending whitespace outside literals: "", " " or "\n"
+    while i < n:
+        c = s[i]
+        if c in "'\"`":
+            j = i + 1
+            while j < n and s[j] != c:
+                j += 2 if s[j] == "\\" else 1
+            tok = s[i:j + 1]
+            i = j + 1
+        elif s.startswith("//", i):
+            j = s.find("\n", i)
+            i = n if j < 0 else j
+            continue
+        elif s.startswith("/*", i):
+            i = s.index("*/", i) + 2
+            ws = ws or " "
+            continue
+        elif c.isspace():
+            ws = "\n" if (c == "\n" or ws == "\n") else " "
+            i += 1
+            continue
+        else:
+            tok = c
+            i += 1
+        if ws and out:
+            p, q = out[-1][-1], tok[0]
+            if ws == "\n":
+                if p in "{;,([:=?&|" or q in "})].,;:?&|=":  # no statement ends here
+                    ws = " " if IDENT.match(p) and IDENT.match(q) else ""
+            if ws == " " and not (IDENT.match(p) and IDENT.match(q)) and not (p == q and p in "+-"):
+                ws = ""
+            out.append(ws)
+        ws = ""
+        out.append(tok)
+    return "".join(out)
+
+
+def min_html(s):
+    s = re.sub(r"<!--.*?-->", "", s, flags=re.S)
+    s = re.sub(r"\s+", " ", s)
+    return re.sub(r">\s+<", "><", s).strip()  # inter-tag gaps only; text runs keep one space
+
+
+def build():
+    html = min_html(read("index.html"))
+    html = html.replace('<link rel="stylesheet" href="style.css">', "<style>" + min_css(read("style.css")) + "</style>")
+    html = html.replace('<script src="app.js"></script>', "<script>" + min_js(read("app.js")) + "</script>")
+    src_bytes = sum(len(read(f)) for f in ("index.html", "style.css", "app.js"))
+    gz = gzip.compress(html.encode("ascii"), compresslevel=9, mtime=0)
+    etag = hashlib.sha1(gz).hexdigest()[:16]
+    rows = [", ".join("0x%02x" % b for b in gz[k:k + 16]) for k in range(0, len(gz), 16)]
+    return (
+        "// Generated by tools/build_ui.py from ui/ -- do not edit.\n"
+        "#pragma once\n"
+        "#include <Arduino.h>\n\n"
+        "#define UI_INDEX_ETAG \"\\\"%s\\\"\"\n"
+        "#define UI_INDEX_SRC_BYTES %d // ui/ sources\n"
+        "#define UI_INDEX_MIN_BYTES %d // minified page\n"
+        "static const size_t UI_INDEX_GZ_LEN = %d;\n"
+        "static const uint8_t UI_INDEX_GZ[] PROGMEM = {\n  %s\n};\n"
+    ) % (etag, src_bytes, len(html), len(gz), ",\n  ".join(rows)), (src_bytes, len(html), len(gz), etag)
+
+
+def main():
+    text, stats = build()
+    old = open(OUT).read() if os.path.exists(OUT) else ""
+    if "--check" in sys.argv:
+        if old != text:
+            print("ui_index.h is stale; run tools/build_ui.py")
+            return 1
+        return 0
+    if old != text:
+        with open(OUT, "w") as f:
+            f.write(text)
+    print("ui_index.h: %d B sources -> %d B minified -> %d B gzip, ETag %s" % stats)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
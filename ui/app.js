@@ -0,0 +1,165 @@
+const DEAD=0.07; // dead-zone
+let manual=true, mode=0, diam=1.0, slot=1, nslots=0;
+let spd='normal';
+const badge=document.getElementById('spdBadge');
+
+function clamp(v,a,b){return v<a?a:(v>b?b:v);}
+function dead(v){return Math.abs(v)<DEAD?0:v;}
+
+function setupPad(id, cb){
+  const pad=document.getElementById(id), dot=pad.querySelector('.dot');
+  let active=false;
+  function setDot(px,py){ dot.style.left=px+'px'; dot.style.top=py+'px'; }
+  function center(){ setDot(pad.clientWidth/2, pad.clientHeight/2); }
+  pad.addEventListener('pointerdown',e=>{active=true;pad.setPointerCapture(e.pointerId);handle(e);});
+  pad.addEventListener('pointermove',e=>{ if(active) handle(e); });
+  pad.addEventListener('pointerup',e=>{ active=false; center(); cb(0,0); });
+  function handle(e){
+    const r=pad.getBoundingClientRect();
+    let px=e.clientX, py=e.clientY;
+    px=clamp(px,r.left,r.right); py=clamp(py,r.top,r.bottom);
+    const nx=((px-r.left)/r.width)*2-1;
+    const ny=((py-r.top)/r.height)*2-1;
+    const x=dead(nx), y=dead(ny);
+    setDot(px-r.left,py-r.top);
+    cb(x,-y);
+  }
+  center();
+}
+
+// Control channel: pads only update cmd; one setpoint per animation frame
+// goes out as a 12-byte binary WebSocket message (see CtlProto.h), or as
+// GETs while the socket is down.
+const cmd={drive:0,sx:0,sy:0};
+let dirty=false, seq=0, ws=null;
+function wsOpen(){
+  ws=new WebSocket(`ws://${location.hostname}:81/`);
+  ws.binaryType='arraybuffer';
+  ws.onclose=()=>{ ws=null; setTimeout(wsOpen,1000); };
+}
+wsOpen();
+function q14(v){return Math.round(clamp(v,-1,1)*16384);}
+const wsUp=()=>ws && ws.readyState===1;
+function wsSend(stop){ // stop: 0, 8 = estop, 16 = abort (CtlProto.h)
+  const b=new DataView(new ArrayBuffer(12));
+  seq=(seq+1)&0xffff;
+  b.setUint8(0,1); b.setUint8(1,(mode&3)|(manual?4:0)|stop); b.setUint16(2,seq,true);
+  b.setInt16(4,q14(cmd.drive),true); b.setInt16(6,q14(cmd.sx),true); b.setInt16(8,q14(cmd.sy),true);
+  b.setUint16(10,Math.round(clamp(diam,0,1)*65535),true);
+  ws.send(b.buffer);
+}
+function flush(){
+  requestAnimationFrame(flush);
+  if(!dirty) return;
+  dirty=false;
+  if(wsUp()){ wsSend(0); return; }
+  fetch(`/ctl_drive?y=${cmd.drive.toFixed(3)}`).catch(()=>{});
+  if (manual)
+    fetch(`/ctl_servos?x=${cmd.sx.toFixed(3)}&y=${cmd.sy.toFixed(3)}`).catch(()=>{});
+  else
+    fetch(`/ctl_steer?x=${cmd.sx.toFixed(3)}&y=${cmd.sy.toFixed(3)}&mode=${mode}&diam=${diam.toFixed(2)}`).catch(()=>{});
+}
+requestAnimationFrame(flush);
+
+setupPad('padDrive', (x,y)=>{ cmd.drive=y; dirty=true; });
+setupPad('padSteer', (x,y)=>{ cmd.sx=x; cmd.sy=y; dirty=true; });
+
+// Manual steer toggle
+const msOn = document.getElementById('msOn');
+const msOff= document.getElementById('msOff');
+function setManual(on){
+  manual=on;
+  msOn.classList.toggle('sel', on);
+  msOff.classList.toggle('sel', !on);
+  document.getElementById('modeRow').style.opacity = on ? 0.45 : 1;
+  document.getElementById('diamRow').style.opacity = on ? 0.45 : 1;
+  fetch(`/ui/manual_steer?on=${on?1:0}`).catch(()=>{});
+}
+msOn.onclick = ()=> setManual(true);
+msOff.onclick= ()=> setManual(false);
+
+// Modes + diameter
+document.querySelectorAll('input[name=mode]').forEach(r=>{
+  r.addEventListener('change', ()=>{
+    mode = Number(document.querySelector('input[name=mode]:checked').value);
+  });
+});
+const diamEl=document.getElementById('diam'), dval=document.getElementById('dval');
+diamEl.addEventListener('input', ()=>{
+  diam = Number(diamEl.value);
+  dval.textContent = diam.toFixed(2);
+});
+
+// Speed
+function setSpeed(s){
+  spd=s;
+  badge.textContent = s.charAt(0).toUpperCase()+s.slice(1);
+  document.getElementById('spdLow').classList.toggle('sel', s==='low');
+  document.getElementById('spdNormal').classList.toggle('sel', s==='normal');
+  document.getElementById('spdSport').classList.toggle('sel', s==='sport');
+  fetch(`/speed?mode=${s}`).catch(()=>{});
+}
+document.getElementById('spdLow').onclick=()=>setSpeed('low');
+document.getElementById('spdNormal').onclick=()=>setSpeed('normal');
+document.getElementById('spdSport').onclick=()=>setSpeed('sport');
+
+// Center / stop / abort
+document.getElementById('center').onclick=()=>fetch('/center').catch(()=>{});
+// Over WS when it is up: HTTP waits behind a take download or upload
+document.getElementById('stop').onclick  =()=>wsUp() ? wsSend(8)  : fetch('/stop').catch(()=>{});
+document.getElementById('abort').onclick =()=>wsUp() ? wsSend(16) : fetch('/rec/abort').catch(()=>{});
+
+// Recorder UI
+const slotsDiv=document.getElementById('slots');
+const tbody=document.querySelector('#tbl tbody');
+function drawSlots(){
+  slotsDiv.innerHTML='';
+  for(let i=1;i<=nslots;i++){
+    const b=document.createElement('button');
+    b.textContent=i; if(i===slot) b.classList.add('sel');
+    b.onclick=()=>{ slot=i; drawSlots(); };
+    slotsDiv.appendChild(b);
+  }
+}
+function refreshList(){
+  fetch('/rec/list').then(r=>r.json()).then(arr=>{
+    if(arr.length!==nslots){ nslots=arr.length; document.getElementById('nslots').textContent=nslots; drawSlots(); }
+    tbody.innerHTML='';
+    arr.forEach(it=>{
+      const tr=document.createElement('tr');
+      tr.innerHTML = `<td>${it.slot}</td>
+        <td>${it.exists?'OK':'(empty)'}</td>
+        <td>${it.frames||0}</td>
+        <td>${it.duration_ms||0}</td>
+        <td>${it.exists?`<a href="/rec/download?slot=${it.slot}">${it.bytes}</a>`:0}</td>`;
+      tbody.appendChild(tr);
+    });
+  }).catch(()=>{});
+}
+document.getElementById('refresh').onclick=refreshList;
+refreshList();
+
+// Record / Play / Clear
+document.getElementById('recAuto').onclick = ()=>fetch('/rec/start').then(refreshList);
+document.getElementById('recTo').onclick   = ()=>fetch(`/rec/start?slot=${slot}`).then(refreshList);
+document.getElementById('recStop').onclick = ()=>fetch('/rec/stop').then(refreshList);
+function playArgs(){
+  const from=document.getElementById('from').value;
+  return `&rate=${document.getElementById('rate').value}&loop=${document.getElementById('loop').checked?1:0}`+(from!==''?`&from=${from}`:'');
+}
+document.getElementById('playF').onclick   = ()=>fetch(`/rec/play?slot=${slot}&dir=f`+playArgs());
+document.getElementById('playR').onclick   = ()=>fetch(`/rec/play?slot=${slot}&dir=r`+playArgs());
+document.getElementById('clear').onclick   = ()=>fetch(`/rec/clear?slot=${slot}`).then(refreshList);
+document.getElementById('upload').onclick  = ()=>{
+  const f=document.getElementById('upFile').files[0], msg=document.getElementById('upMsg');
+  if(!f) return;
+  msg.textContent='uploading...';
+  fetch(`/rec/upload?slot=${slot}`,{method:'POST',body:f})
+    .then(r=>r.text().then(t=>{ msg.textContent=r.ok?'ok':t; refreshList(); }))
+    .catch(()=>{ msg.textContent='failed'; });
+};
+document.getElementById('seek').onclick    = ()=>fetch(`/rec/seek?ms=${document.getElementById('from').value||0}`);
+
+// Defaults
+setManual(true);
+setSpeed('normal');
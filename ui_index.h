@@ -0,0 +1,226 @@
+// Generated by tools/build_ui.py from ui/ -- do not edit.
+#pragma once
+#include <Arduino.h>
+
+#define UI_INDEX_ETAG "\"7175597274f25d97\""
+#define UI_INDEX_SRC_BYTES 11239 // ui/ sources
+#define UI_INDEX_MIN_BYTES 9757 // minified page
+static const size_t UI_INDEX_GZ_LEN = 3445;
+static const uint8_t UI_INDEX_GZ[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xa5, 0x1a, 0x69, 0x93, 0x9b, 0x38,
+  0xf6, 0x7b, 0x7e, 0x05, 0x71, 0xb2, 0x0d, 0x4c, 0x30, 0xbe, 0xba, 0x7b, 0x3a, 0x60, 0xdc, 0xd5,
+  0xb9, 0x6a, 0xa6, 0x36, 0x99, 0xa4, 0xd2, 0xc9, 0xce, 0x6e, 0x4d, 0x4d, 0x8d, 0x65, 0x10, 0x36,
+  0xdb, 0x18, 0x88, 0x24, 0x7c, 0xac, 0xe3, 0xff, 0xbe, 0xef, 0x49, 0x80, 0xc1, 0x57, 0x92, 0xdd,
+  0xa4, 0xca, 0x80, 0xf4, 0xee, 0x4b, 0xef, 0x29, 0x19, 0x3e, 0x0e, 0x52, 0x5f, 0xac, 0x33, 0xaa,
+  0xcd, 0xc4, 0x3c, 0x1e, 0x0d, 0x8b, 0x5f, 0x4a, 0x82, 0xd1, 0x70, 0x4e, 0x05, 0xd1, 0xfc, 0x19,
+  0x61, 0x9c, 0x0a, 0xaf, 0x95, 0x8b, 0xb0, 0x7d, 0xd3, 0x2a, 0x56, 0x13, 0x32, 0xa7, 0x5e, 0x6b,
+  0x11, 0xd1, 0x65, 0x96, 0x32, 0xd1, 0xd2, 0xfc, 0x34, 0x11, 0x34, 0x01, 0xa8, 0x65, 0x14, 0x88,
+  0x99, 0x17, 0xd0, 0x45, 0xe4, 0xd3, 0xb6, 0xfc, 0xb0, 0xa2, 0x24, 0x12, 0x11, 0x89, 0xdb, 0xdc,
+  0x27, 0x31, 0xf5, 0x7a, 0x40, 0x42, 0x44, 0x22, 0xa6, 0xa3, 0x97, 0x64, 0xfe, 0x8e, 0x08, 0x3a,
+  0xec, 0xa8, 0xcf, 0x21, 0x17, 0x6b, 0x78, 0x38, 0x2c, 0x4d, 0xc5, 0xa6, 0xdd, 0xce, 0x48, 0xe0,
+  0xcc, 0xa3, 0xc4, 0xb8, 0xec, 0x2e, 0x96, 0xd6, 0xe0, 0xba, 0x9b, 0xad, 0x4c, 0xb7, 0xdd, 0x0e,
+  0x52, 0xe1, 0xf4, 0x6e, 0xb2, 0xd5, 0x76, 0x92, 0x06, 0xeb, 0x4d, 0x08, 0x5c, 0xdb, 0x21, 0x99,
+  0x47, 0xf1, 0xda, 0xe1, 0x24, 0xe1, 0x6d, 0x4e, 0x59, 0x14, 0xba, 0x73, 0xc2, 0xa6, 0x51, 0xe2,
+  0xf4, 0x00, 0x67, 0x6b, 0xb3, 0x74, 0xb9, 0x09, 0x22, 0x9e, 0xc5, 0x64, 0xed, 0x84, 0x31, 0x5d,
+  0xb9, 0x53, 0x92, 0x39, 0xbd, 0x7e, 0xb6, 0x72, 0xf1, 0xab, 0xbd, 0x64, 0xf0, 0x89, 0x3f, 0x2e,
+  0x89, 0xa3, 0x69, 0xd2, 0x8e, 0x04, 0x9d, 0x73, 0x09, 0xd8, 0xe6, 0x82, 0x30, 0xb1, 0xb5, 0x7d,
+  0xc2, 0x82, 0xcd, 0x24, 0x65, 0x01, 0x65, 0x4e, 0x2f, 0x5b, 0x69, 0x3c, 0x8d, 0xa3, 0x40, 0x7b,
+  0x12, 0x04, 0x81, 0xab, 0x56, 0xdb, 0x8c, 0x04, 0x51, 0xce, 0x15, 0x51, 0x10, 0x3b, 0x88, 0x92,
+  0xa9, 0xfc, 0xd8, 0xda, 0xf0, 0xc5, 0xbf, 0x8b, 0xbb, 0x04, 0xdd, 0x48, 0x7b, 0x39, 0x0b, 0xc2,
+  0x0c, 0xa9, 0xbf, 0xe9, 0xce, 0x68, 0x34, 0x9d, 0x89, 0xfa, 0xca, 0x84, 0xf8, 0x0f, 0x53, 0x96,
+  0xe6, 0x49, 0xe0, 0x3c, 0x09, 0xfb, 0xf8, 0xf7, 0xa8, 0x14, 0x29, 0x07, 0x9b, 0xa7, 0x89, 0xc3,
+  0x68, 0x4c, 0x44, 0xb4, 0xa0, 0xae, 0x48, 0x73, 0x7f, 0xd6, 0x26, 0xbe, 0x5c, 0x4d, 0xd2, 0x84,
+  0x4a, 0x8e, 0x9a, 0x1d, 0x93, 0x09, 0x8d, 0x37, 0x15, 0x3c, 0x99, 0x80, 0x7a, 0xb9, 0xa0, 0x6e,
+  0x4c, 0x43, 0x21, 0x2d, 0x08, 0x98, 0x99, 0x7a, 0x69, 0xb0, 0x0e, 0x43, 0xf7, 0xd0, 0x26, 0xbe,
+  0xef, 0xef, 0x49, 0x73, 0x53, 0x33, 0x09, 0x08, 0xa6, 0xe1, 0xb7, 0xf4, 0x1a, 0x8f, 0xfe, 0x43,
+  0x0b, 0x23, 0x81, 0x4f, 0x8f, 0x08, 0x50, 0xb7, 0x05, 0x40, 0xec, 0xd9, 0x42, 0xae, 0x34, 0x59,
+  0x5d, 0x75, 0xff, 0xd6, 0x10, 0xb1, 0xdf, 0xef, 0xbb, 0x82, 0x41, 0x54, 0x84, 0x29, 0x9b, 0x3b,
+  0xf2, 0x0d, 0x6c, 0x41, 0x8d, 0x36, 0x00, 0x5a, 0xf8, 0x53, 0x12, 0x90, 0x82, 0x15, 0x1a, 0x28,
+  0xbd, 0xc0, 0xf7, 0x33, 0x12, 0xa4, 0x4b, 0xa7, 0xab, 0x75, 0xb5, 0x01, 0xec, 0xb2, 0xe9, 0x84,
+  0x18, 0x5d, 0x4b, 0xfe, 0xb5, 0x2f, 0xcd, 0xed, 0xac, 0xbf, 0x29, 0x82, 0xec, 0x1a, 0x76, 0xbb,
+  0x9a, 0x54, 0x64, 0x92, 0x0b, 0x91, 0x26, 0x9b, 0x52, 0x5d, 0x50, 0x55, 0xae, 0x1f, 0xb1, 0xc8,
+  0xa1, 0xe5, 0x08, 0x21, 0x4d, 0xfb, 0x12, 0xfc, 0x5b, 0x46, 0x32, 0x88, 0xe0, 0xfa, 0x39, 0xe3,
+  0x29, 0x73, 0xb2, 0x34, 0x82, 0x4c, 0x63, 0x05, 0x33, 0x9b, 0x83, 0xf3, 0xea, 0x78, 0x83, 0xc1,
+  0xc0, 0xf5, 0xd3, 0x18, 0x00, 0x51, 0x95, 0x12, 0x6a, 0x49, 0x58, 0xb2, 0x69, 0xba, 0x8f, 0xfa,
+  0xb4, 0xf2, 0x55, 0x81, 0x40, 0xaf, 0x06, 0xcf, 0x07, 0x57, 0x5b, 0x7b, 0x42, 0x82, 0x29, 0xad,
+  0xa2, 0x36, 0x4a, 0xe2, 0x28, 0xa1, 0xed, 0x49, 0x9c, 0xfa, 0x0f, 0x07, 0xae, 0x6c, 0xaa, 0xf6,
+  0xfc, 0xf9, 0xf3, 0xbd, 0x30, 0x41, 0x1f, 0xec, 0xc4, 0xd9, 0xf7, 0x7c, 0x94, 0x64, 0xb9, 0xf8,
+  0x03, 0x8b, 0x8f, 0x07, 0xde, 0x99, 0xd2, 0x3f, 0x8b, 0x04, 0xe8, 0xf7, 0x31, 0x73, 0x05, 0x99,
+  0xc4, 0x74, 0xb3, 0x13, 0x31, 0x26, 0x19, 0xa7, 0x4e, 0xf9, 0x52, 0x98, 0xa6, 0x8d, 0xd1, 0xb9,
+  0x17, 0x54, 0x03, 0x44, 0x9e, 0x59, 0x22, 0xa8, 0x5c, 0x71, 0xdd, 0x10, 0x77, 0x2f, 0x8b, 0xb7,
+  0x36, 0x24, 0xba, 0xff, 0xd0, 0x4c, 0x53, 0x99, 0x9d, 0x41, 0xc4, 0xa8, 0x4a, 0x18, 0xe0, 0x9a,
+  0xcf, 0x13, 0x95, 0xbc, 0x28, 0xdb, 0xb0, 0xa3, 0x8a, 0xd5, 0xb0, 0xa3, 0x2a, 0x25, 0x56, 0x23,
+  0xa8, 0x9a, 0xfd, 0xb2, 0xa6, 0x69, 0x43, 0x9e, 0x91, 0x44, 0x8b, 0x02, 0xaf, 0xc5, 0xb3, 0xe0,
+  0x05, 0x1a, 0x14, 0x6a, 0x64, 0x4c, 0x38, 0xf7, 0x5a, 0xd2, 0xbc, 0xad, 0xd1, 0x6f, 0x10, 0x95,
+  0x24, 0x06, 0x42, 0x00, 0x88, 0x74, 0xfa, 0xa3, 0x61, 0x10, 0x2d, 0x4a, 0x20, 0xa8, 0x5a, 0xad,
+  0xc6, 0x02, 0x56, 0x92, 0x83, 0x15, 0x0d, 0x6b, 0x53, 0x4b, 0xb2, 0x81, 0xaf, 0x57, 0x0c, 0x12,
+  0xbd, 0x09, 0x23, 0xb3, 0xbb, 0x35, 0x92, 0x3b, 0xc3, 0x0e, 0x6c, 0x34, 0x76, 0x21, 0x89, 0x14,
+  0x32, 0xbc, 0x28, 0x64, 0x4d, 0xaa, 0x05, 0x78, 0x98, 0xfd, 0x98, 0x50, 0x68, 0x5e, 0x78, 0x02,
+  0x55, 0x85, 0x7d, 0x40, 0xe3, 0x40, 0x8a, 0x7b, 0x41, 0x29, 0x3b, 0x2a, 0x85, 0xdc, 0x39, 0x2f,
+  0x85, 0x42, 0xfe, 0x4e, 0x29, 0x0e, 0x28, 0xa1, 0x1c, 0x9a, 0x74, 0xa6, 0xe2, 0xaf, 0x7e, 0xde,
+  0x91, 0x24, 0x27, 0xb1, 0x26, 0x49, 0x3b, 0xda, 0x50, 0xa5, 0x84, 0x64, 0x38, 0xe7, 0xef, 0x93,
+  0xca, 0x2d, 0x1c, 0x45, 0x7c, 0x9f, 0x0c, 0x3b, 0x0a, 0x60, 0xb4, 0x07, 0x18, 0x86, 0xb0, 0x1b,
+  0x86, 0xbb, 0xed, 0x1d, 0x77, 0x09, 0x91, 0x06, 0xf4, 0x23, 0xf8, 0xac, 0x14, 0xbd, 0x16, 0x9d,
+  0x10, 0x7c, 0xad, 0x91, 0xf6, 0x0e, 0x00, 0x80, 0xbb, 0x34, 0xc5, 0x68, 0x28, 0x23, 0x5f, 0x93,
+  0x91, 0xdf, 0xc2, 0xe4, 0x49, 0x5b, 0xc5, 0x89, 0x8a, 0x74, 0x5a, 0xda, 0x82, 0xc4, 0x39, 0x7c,
+  0x74, 0x41, 0xb8, 0x19, 0xf5, 0x1f, 0x68, 0x30, 0xd2, 0xca, 0x70, 0x29, 0x08, 0xfc, 0x10, 0x1d,
+  0x38, 0x72, 0xb5, 0x97, 0x8c, 0x4c, 0xfe, 0x37, 0xec, 0x3e, 0x62, 0x47, 0xcc, 0x8f, 0x69, 0x85,
+  0xdf, 0xd4, 0x3d, 0x88, 0xc8, 0xfc, 0xac, 0xee, 0x0a, 0x5b, 0x43, 0x38, 0x0a, 0xb5, 0x4b, 0x2b,
+  0x18, 0x97, 0xb8, 0xad, 0x4a, 0x84, 0x04, 0xd3, 0x04, 0x0e, 0x7d, 0xa9, 0xfa, 0x9c, 0xac, 0x50,
+  0x74, 0xa0, 0x4a, 0x33, 0x58, 0xb0, 0xbb, 0xbd, 0xba, 0x42, 0xbb, 0x04, 0x0b, 0x60, 0x71, 0x3f,
+  0xb9, 0x7a, 0x76, 0xb7, 0x5b, 0xa5, 0x56, 0x33, 0x58, 0x1a, 0x8e, 0xf5, 0x29, 0x16, 0xd3, 0xd6,
+  0xe8, 0xa5, 0x7c, 0x1e, 0xf5, 0x3d, 0x07, 0x3d, 0x2a, 0xf2, 0x58, 0x48, 0x21, 0x90, 0x3f, 0xbd,
+  0xff, 0x70, 0x14, 0x96, 0x4c, 0x54, 0x33, 0xd4, 0x00, 0x06, 0x7c, 0xed, 0x03, 0x14, 0x16, 0xac,
+  0x8b, 0x47, 0xc2, 0x67, 0xa4, 0xdd, 0x67, 0x94, 0x06, 0xcd, 0xc8, 0x84, 0xa2, 0xf1, 0x16, 0x2b,
+  0x00, 0xfc, 0x1c, 0x17, 0x2a, 0x0b, 0x54, 0x40, 0x34, 0xc3, 0xb7, 0x0c, 0x92, 0xe3, 0x18, 0xf7,
+  0xb2, 0x55, 0x1b, 0xc9, 0xc7, 0xbe, 0x20, 0x47, 0x73, 0x69, 0xe7, 0x51, 0x70, 0xa7, 0x2a, 0xcd,
+  0x03, 0x2c, 0xcd, 0x60, 0xfd, 0xd9, 0xa0, 0xe9, 0x6d, 0xe7, 0x52, 0x9e, 0x83, 0x37, 0xb8, 0xf9,
+  0x91, 0xfa, 0xb2, 0xce, 0x6a, 0xc6, 0xce, 0x49, 0x70, 0xf6, 0xa6, 0x02, 0x0a, 0x58, 0xbb, 0xf0,
+  0x8a, 0x26, 0xbf, 0x4d, 0xa8, 0x7b, 0x83, 0xc2, 0x0a, 0x77, 0x3e, 0xf6, 0x29, 0x72, 0xdd, 0xa9,
+  0x97, 0x4f, 0x85, 0x57, 0x3a, 0xb3, 0xa6, 0x11, 0xa3, 0x21, 0xa3, 0x7c, 0x86, 0xfc, 0xe4, 0xcb,
+  0xbe, 0x4a, 0xf2, 0xfc, 0x90, 0x90, 0x62, 0x12, 0x63, 0xd3, 0xa9, 0x4a, 0xb5, 0x60, 0xf8, 0x3a,
+  0x7a, 0x02, 0x6d, 0xe7, 0x4c, 0xbe, 0xdd, 0x0b, 0x22, 0x72, 0x5e, 0x7d, 0xbe, 0x61, 0x10, 0xa5,
+  0xbb, 0xcf, 0x57, 0x39, 0x33, 0xe6, 0x28, 0x68, 0x09, 0x0d, 0x47, 0x8c, 0xfa, 0xe8, 0x20, 0xa5,
+  0x4e, 0x49, 0x55, 0x9d, 0x00, 0x9d, 0xea, 0x89, 0xcc, 0x95, 0x41, 0x0f, 0xb3, 0x42, 0x5a, 0xa9,
+  0xa9, 0x8a, 0x7f, 0x97, 0x8b, 0x74, 0x2f, 0x72, 0x94, 0x1d, 0x35, 0x03, 0xb7, 0xda, 0x68, 0x07,
+  0xf3, 0xa8, 0x67, 0x01, 0xf9, 0x53, 0x5a, 0x41, 0x8b, 0x54, 0xbb, 0x07, 0xd0, 0x53, 0x90, 0x18,
+  0x8d, 0x45, 0x4c, 0x2a, 0x84, 0x63, 0x05, 0xed, 0x44, 0x1e, 0xd7, 0x49, 0xe1, 0x49, 0xf9, 0xa6,
+  0x35, 0xc2, 0xb8, 0xd6, 0xde, 0xa4, 0x0c, 0x04, 0x0e, 0x8e, 0xb2, 0x44, 0xb8, 0x8f, 0x05, 0xdc,
+  0x47, 0xba, 0xa0, 0x30, 0x4a, 0x1c, 0x85, 0x83, 0xfa, 0x40, 0x30, 0x0f, 0xf1, 0xb1, 0xa7, 0xc0,
+  0xb7, 0xe5, 0xda, 0x95, 0x93, 0x3c, 0x7b, 0x13, 0xc5, 0xb4, 0x2c, 0x28, 0xa1, 0x7c, 0x27, 0xbe,
+  0x4f, 0x33, 0x98, 0x4c, 0xec, 0x49, 0x94, 0x54, 0x11, 0xad, 0xa2, 0xb9, 0x77, 0xdd, 0xdd, 0x57,
+  0x2c, 0xcf, 0xe2, 0x94, 0x04, 0xad, 0xd1, 0x67, 0xf9, 0x3c, 0x34, 0x67, 0x15, 0x98, 0x79, 0xf6,
+  0x8e, 0x4f, 0x77, 0x81, 0xf9, 0x4d, 0x29, 0xb5, 0x8f, 0xd0, 0x17, 0x60, 0x64, 0xd3, 0x18, 0x9a,
+  0x0a, 0xe5, 0x0f, 0x58, 0x01, 0x0a, 0x69, 0x86, 0x3d, 0x46, 0x55, 0xf4, 0xed, 0xfe, 0x55, 0x6b,
+  0x84, 0xbf, 0xab, 0x61, 0x47, 0x6d, 0x1d, 0x82, 0x48, 0x88, 0xd3, 0x00, 0x58, 0x35, 0x25, 0x1b,
+  0x38, 0x39, 0x7a, 0x27, 0xa1, 0xa0, 0xb0, 0xf7, 0x4f, 0x6e, 0x5e, 0xb6, 0x46, 0x97, 0xb5, 0xcd,
+  0x8e, 0xa2, 0x77, 0xf4, 0xe8, 0x90, 0x67, 0x14, 0x34, 0xcd, 0xea, 0x14, 0x8f, 0x53, 0x8c, 0x30,
+  0xed, 0x2d, 0x3c, 0xca, 0xf3, 0x42, 0x7b, 0xc3, 0xd2, 0xb9, 0x86, 0x69, 0x54, 0x2f, 0xfd, 0x21,
+  0x2c, 0x96, 0x9e, 0x4a, 0xf2, 0xf9, 0x04, 0x0f, 0xfe, 0xb2, 0xf6, 0xab, 0x9a, 0xdf, 0xeb, 0x76,
+  0xf7, 0x1c, 0xf6, 0xf3, 0x81, 0xbf, 0x38, 0xa5, 0x70, 0xda, 0xdf, 0xc3, 0xef, 0xf1, 0x92, 0xa6,
+  0x7e, 0xb9, 0xcf, 0xa2, 0x4c, 0x8c, 0x60, 0x4a, 0xe5, 0x42, 0x7b, 0xf5, 0xfa, 0xee, 0x95, 0x07,
+  0xe7, 0xc9, 0xcf, 0x30, 0xe4, 0x08, 0x38, 0x66, 0xb0, 0x3d, 0xf0, 0x04, 0xcb, 0xa9, 0x85, 0xe7,
+  0x9e, 0xd7, 0xb5, 0xf0, 0x50, 0xf2, 0xe0, 0x08, 0xb1, 0x30, 0xe9, 0xbc, 0x9e, 0xa5, 0x8a, 0x97,
+  0xd7, 0x95, 0xf0, 0x50, 0x48, 0x3d, 0x3d, 0x91, 0x85, 0x56, 0x77, 0x15, 0x41, 0x79, 0xe8, 0x78,
+  0x30, 0x47, 0xe7, 0x73, 0x38, 0x47, 0xec, 0x29, 0x15, 0xaf, 0x63, 0x8a, 0xaf, 0x2f, 0xd6, 0xbf,
+  0x06, 0x86, 0x5e, 0x76, 0x80, 0xba, 0xe9, 0x86, 0x79, 0x22, 0x1b, 0x4a, 0x4c, 0xf4, 0x79, 0x66,
+  0x2c, 0x2c, 0x62, 0x4d, 0xcc, 0x0d, 0xa3, 0x22, 0x67, 0x60, 0xf9, 0x21, 0xb9, 0x25, 0x8e, 0xb1,
+  0x18, 0x4d, 0x6e, 0x27, 0xce, 0xc2, 0x74, 0xb7, 0x8f, 0x2a, 0xf0, 0x00, 0x8a, 0x8c, 0xb1, 0xa8,
+  0x20, 0xa1, 0xc5, 0x9c, 0xd9, 0x30, 0x29, 0xc1, 0xd2, 0x10, 0xb5, 0xb9, 0xed, 0x3a, 0x8b, 0x3a,
+  0x38, 0xcc, 0xeb, 0x79, 0xf6, 0x01, 0x50, 0xa2, 0xc0, 0xf2, 0x81, 0x81, 0x12, 0x13, 0x9a, 0xb3,
+  0x93, 0x42, 0x46, 0x81, 0x69, 0x41, 0xff, 0xe5, 0x01, 0x8c, 0xfd, 0x25, 0xa7, 0x6c, 0x7d, 0x2f,
+  0xfd, 0x9d, 0x32, 0x43, 0xc7, 0xf9, 0x0c, 0x44, 0x47, 0xdd, 0x89, 0xac, 0xd1, 0x5e, 0x48, 0x62,
+  0x68, 0xc0, 0xeb, 0xdc, 0x5e, 0xa5, 0xc2, 0xc8, 0x56, 0x56, 0xb6, 0x36, 0x37, 0x00, 0x6d, 0x4b,
+  0x9f, 0xd9, 0xd8, 0xbe, 0x79, 0xd9, 0xea, 0x99, 0x9e, 0xad, 0x74, 0x77, 0xb7, 0x0c, 0x19, 0xe1,
+  0x65, 0x6b, 0xb5, 0x5a, 0x93, 0x59, 0x1d, 0xc5, 0x86, 0xb9, 0x29, 0xc9, 0x81, 0x24, 0x7e, 0x1c,
+  0xc1, 0xea, 0xef, 0xe8, 0xfa, 0x4e, 0xdf, 0xda, 0xad, 0xfc, 0x22, 0x47, 0xc1, 0x4e, 0x1f, 0x6d,
+  0x84, 0xab, 0xd0, 0xe6, 0xbf, 0x5e, 0xc0, 0xfa, 0xdb, 0x08, 0x02, 0x27, 0x01, 0x2a, 0x7a, 0x31,
+  0x26, 0xc1, 0x0c, 0x97, 0xe8, 0x16, 0xf5, 0x46, 0x9b, 0x42, 0x74, 0x74, 0x33, 0x4e, 0x31, 0x30,
+  0x38, 0x89, 0x0f, 0x0a, 0xe6, 0x25, 0xc9, 0xc0, 0xa8, 0xd4, 0xa0, 0x76, 0x81, 0xf4, 0x2b, 0x0e,
+  0xde, 0x24, 0x09, 0x62, 0x58, 0x03, 0x0e, 0xa6, 0x7b, 0x96, 0xc5, 0x3c, 0x5d, 0x50, 0xc5, 0x22,
+  0x0a, 0x0d, 0xc5, 0xc5, 0xfc, 0x7e, 0xec, 0x3c, 0x6b, 0x88, 0xa7, 0x2c, 0x5b, 0x9a, 0xc2, 0xf5,
+  0x27, 0x38, 0x74, 0x4a, 0x2a, 0x95, 0x9d, 0x2a, 0xda, 0x85, 0x57, 0x99, 0xf4, 0x19, 0xb8, 0xf3,
+  0x05, 0x8e, 0x5c, 0x30, 0xed, 0xbc, 0x94, 0x26, 0x82, 0xea, 0x2e, 0x0c, 0xe5, 0xb5, 0x6c, 0xe5,
+  0xd1, 0xc2, 0x70, 0xff, 0x04, 0x17, 0x55, 0x1f, 0xff, 0x72, 0x61, 0x47, 0x05, 0x22, 0xf8, 0x8e,
+  0x49, 0x7f, 0xc1, 0x83, 0xa1, 0x6d, 0x41, 0xec, 0x75, 0xb9, 0xb7, 0x86, 0x45, 0x70, 0x1a, 0xfc,
+  0x4e, 0x52, 0x48, 0xb0, 0xb9, 0x59, 0x84, 0x7d, 0xb2, 0xf2, 0x0c, 0xc0, 0x6c, 0x2b, 0x4c, 0xb3,
+  0xc3, 0x6c, 0x99, 0xa4, 0xe6, 0x4f, 0xfd, 0x76, 0xaf, 0x04, 0x59, 0x23, 0xc8, 0xba, 0x2d, 0x09,
+  0x20, 0x84, 0x1a, 0xe2, 0xeb, 0x20, 0x2b, 0x4f, 0x06, 0x77, 0xb2, 0x32, 0xad, 0x75, 0xf1, 0xba,
+  0x36, 0xdd, 0x2a, 0xa6, 0x0a, 0xea, 0x56, 0x45, 0x04, 0x8d, 0xb2, 0xb2, 0xda, 0x6b, 0xf4, 0x7d,
+  0x65, 0x28, 0x78, 0x95, 0xc4, 0xfc, 0x79, 0xe0, 0x6d, 0x02, 0x1c, 0x65, 0x1c, 0xc8, 0xde, 0x15,
+  0xfe, 0xac, 0x9d, 0xee, 0x56, 0x9a, 0x01, 0xa6, 0x39, 0xb1, 0x56, 0x16, 0xb6, 0x38, 0xfd, 0x02,
+  0x79, 0xbe, 0xe4, 0x5e, 0x92, 0xc7, 0xf1, 0xce, 0xb6, 0x4b, 0xfe, 0x3e, 0xa3, 0x09, 0xc4, 0x20,
+  0xee, 0xd0, 0xa5, 0xf6, 0x3b, 0x9d, 0xdc, 0xc3, 0xd8, 0x4b, 0x85, 0x31, 0x5e, 0x72, 0xa7, 0xd3,
+  0x79, 0xba, 0x81, 0x29, 0x98, 0x20, 0xa8, 0x3d, 0x4b, 0xb9, 0xc0, 0x66, 0x79, 0xeb, 0xdc, 0xf4,
+  0x3a, 0x63, 0xd3, 0x5d, 0x72, 0x3c, 0x5f, 0x08, 0x5b, 0x7f, 0xc2, 0x82, 0xa6, 0x13, 0xc6, 0xa0,
+  0xe3, 0xcb, 0x61, 0xce, 0x66, 0x3a, 0xee, 0xa5, 0x89, 0x1f, 0xa7, 0x9c, 0x7a, 0x86, 0x09, 0xce,
+  0x2e, 0xf9, 0x82, 0x92, 0x9f, 0xa2, 0x39, 0x4d, 0x73, 0x61, 0x28, 0xce, 0x16, 0x54, 0x3c, 0x74,
+  0x37, 0xe8, 0x53, 0x8a, 0xb2, 0x13, 0xee, 0x4b, 0xef, 0x72, 0xbf, 0x04, 0xc8, 0x29, 0xdb, 0x28,
+  0x6b, 0x49, 0xbb, 0x67, 0xf5, 0xcc, 0x9f, 0x7a, 0xd7, 0x83, 0x9b, 0xcb, 0x9d, 0x45, 0x96, 0xfc,
+  0x73, 0x26, 0xb9, 0x2e, 0xf9, 0xc5, 0x05, 0x08, 0xc2, 0xc0, 0xc2, 0x6b, 0x6c, 0x79, 0xa8, 0xe7,
+  0x79, 0xbd, 0xba, 0xea, 0xf7, 0x14, 0x68, 0x61, 0xb7, 0x5b, 0x46, 0xd6, 0x44, 0xda, 0xe0, 0x15,
+  0x11, 0xe4, 0x1f, 0x11, 0x5d, 0x1a, 0xf8, 0x71, 0x87, 0x6a, 0xbd, 0x90, 0x6a, 0x19, 0xbd, 0xbe,
+  0x89, 0x7e, 0xfa, 0xe2, 0x19, 0xf0, 0xf3, 0xac, 0x67, 0x5e, 0x74, 0x57, 0xa1, 0xbc, 0x3e, 0xc1,
+  0xdc, 0xfa, 0x0c, 0xd1, 0x7d, 0x03, 0xc1, 0xdb, 0x33, 0xeb, 0xdf, 0x3d, 0xcb, 0xc0, 0x12, 0x7b,
+  0x31, 0x30, 0xbf, 0x1a, 0xaa, 0xee, 0xde, 0x5e, 0x3a, 0x5d, 0xf3, 0xab, 0xe4, 0xba, 0x03, 0xec,
+  0x5d, 0x1b, 0x7d, 0x74, 0x91, 0x85, 0xd9, 0x5a, 0xac, 0xff, 0x2a, 0x97, 0x2f, 0x2d, 0xb4, 0x02,
+  0x78, 0xd9, 0x96, 0x4e, 0x36, 0x0f, 0x21, 0xae, 0x2b, 0x08, 0xbe, 0x3a, 0xb2, 0x7d, 0xb3, 0xdb,
+  0x5e, 0x37, 0xb6, 0x0b, 0xbe, 0xbd, 0xae, 0x75, 0x60, 0x59, 0x3c, 0x0e, 0x2c, 0x54, 0xe5, 0xa7,
+  0xeb, 0xab, 0xab, 0xc1, 0x55, 0x89, 0x06, 0xc6, 0xe4, 0x68, 0xb2, 0x89, 0xad, 0xfc, 0xdc, 0x28,
+  0xd8, 0x61, 0x9c, 0xf3, 0x99, 0x81, 0xde, 0x82, 0x6a, 0xca, 0xc5, 0x5d, 0x12, 0xcd, 0x65, 0xdc,
+  0xc8, 0xee, 0xd2, 0x90, 0xbb, 0xa6, 0x0b, 0x05, 0xe3, 0xb1, 0x8c, 0x4a, 0x53, 0x39, 0xd5, 0xad,
+  0x85, 0x28, 0x6e, 0xa2, 0xef, 0x0c, 0x13, 0xa3, 0x51, 0xfa, 0x06, 0x22, 0xa3, 0x80, 0x03, 0x46,
+  0x54, 0xf8, 0x33, 0x63, 0xdc, 0xf1, 0x45, 0xfc, 0x97, 0x34, 0xc5, 0xed, 0xda, 0x7b, 0xba, 0xa9,
+  0x0c, 0x03, 0x99, 0xf2, 0x26, 0x5a, 0xd1, 0xc0, 0x18, 0x98, 0xdb, 0xb1, 0x69, 0x43, 0xcc, 0x02,
+  0xb4, 0x8c, 0xbd, 0xad, 0x64, 0xab, 0x8c, 0x6f, 0x36, 0xc8, 0x70, 0xca, 0x16, 0x29, 0xbf, 0x5d,
+  0x15, 0x74, 0xf8, 0xaa, 0x4e, 0xe4, 0xa2, 0x24, 0xcf, 0xd7, 0x67, 0x69, 0x53, 0x10, 0xbd, 0x49,
+  0x15, 0xc7, 0xee, 0x1f, 0x23, 0x7a, 0x21, 0x8f, 0xe1, 0xa7, 0x1b, 0x7c, 0x6c, 0x2f, 0xe4, 0x61,
+  0xfc, 0x74, 0x83, 0x8f, 0x0a, 0xa8, 0x7f, 0x84, 0xf3, 0xf6, 0xd1, 0x59, 0x5b, 0x57, 0x47, 0xa2,
+  0x5e, 0xde, 0x94, 0xe8, 0x16, 0xd4, 0x91, 0x35, 0x62, 0x57, 0x66, 0xf3, 0xd6, 0x85, 0x0b, 0xe4,
+  0x31, 0xb1, 0xdd, 0xc3, 0x92, 0x37, 0x08, 0x4d, 0x2c, 0xbe, 0xf2, 0x56, 0xae, 0xd2, 0xe0, 0x00,
+  0x57, 0x25, 0x11, 0xde, 0x31, 0x9c, 0x6e, 0x0d, 0x70, 0x57, 0xaf, 0x81, 0x86, 0xe1, 0x59, 0xd8,
+  0x30, 0xac, 0xf7, 0x10, 0x20, 0x9c, 0xba, 0xdb, 0x30, 0xd2, 0xc4, 0xdc, 0x14, 0x7d, 0x4c, 0x9a,
+  0xb8, 0x48, 0xd4, 0x96, 0x93, 0x04, 0x1e, 0x37, 0x60, 0xb4, 0xe9, 0x14, 0x0e, 0x0c, 0x1d, 0x3a,
+  0x38, 0xdd, 0x02, 0x48, 0x57, 0x12, 0x3a, 0x05, 0xf0, 0x18, 0x21, 0x4e, 0xcb, 0xa0, 0xae, 0x39,
+  0x74, 0xb3, 0x38, 0xcb, 0xd3, 0x8c, 0xf8, 0x11, 0xe8, 0x9c, 0x26, 0xb7, 0x5d, 0xfb, 0xf2, 0xca,
+  0xe9, 0x9d, 0x46, 0x2d, 0x6e, 0x09, 0xce, 0xa0, 0x96, 0x61, 0x93, 0x47, 0x1d, 0xa5, 0x4c, 0x11,
+  0x3c, 0x69, 0x02, 0xfe, 0x07, 0xb0, 0x1e, 0x54, 0xf2, 0x23, 0x6e, 0x97, 0xea, 0x62, 0x7d, 0x8d,
+  0xfc, 0x07, 0x59, 0xe9, 0x76, 0x76, 0x51, 0x89, 0xaa, 0xf4, 0x3d, 0x0e, 0x21, 0x73, 0xad, 0xa6,
+  0x70, 0xa3, 0xf7, 0xb9, 0x8b, 0x63, 0x43, 0x57, 0x97, 0x94, 0xf2, 0x5e, 0x04, 0xb5, 0xff, 0x13,
+  0x14, 0x08, 0x53, 0xf6, 0x9a, 0x80, 0x0c, 0x0c, 0x44, 0x60, 0x47, 0xce, 0x76, 0x7f, 0x86, 0x37,
+  0x19, 0x10, 0x29, 0x28, 0xa3, 0x0c, 0xe6, 0xdf, 0x64, 0x7f, 0x6b, 0x1c, 0x67, 0x73, 0xc8, 0xc3,
+  0x29, 0xae, 0x7d, 0x80, 0x97, 0x6c, 0xc7, 0x65, 0x07, 0x50, 0x85, 0x14, 0x5a, 0xf2, 0x75, 0xec,
+  0x9d, 0xb5, 0xb4, 0x0e, 0xed, 0x1c, 0xa0, 0x9e, 0x01, 0x82, 0x5d, 0x08, 0x26, 0x45, 0xeb, 0x88,
+  0x0e, 0x52, 0xa4, 0x42, 0x05, 0x99, 0x82, 0xa5, 0x0a, 0x0a, 0xa1, 0x10, 0x0b, 0xa9, 0xd8, 0x82,
+  0xae, 0xc4, 0xcb, 0xe2, 0xdf, 0x7f, 0xf6, 0xd2, 0xb4, 0xd1, 0xb9, 0x80, 0xd5, 0xe5, 0x55, 0x87,
+  0xc1, 0xa1, 0xc9, 0x83, 0x2e, 0x9a, 0xbb, 0xb2, 0x71, 0x6e, 0xe0, 0x73, 0x1b, 0xff, 0xbd, 0xe9,
+  0x4e, 0x40, 0xb1, 0x03, 0x32, 0x9f, 0xb3, 0x0c, 0xfb, 0x33, 0x4e, 0x0d, 0xf3, 0x19, 0x54, 0x5b,
+  0xf0, 0x1f, 0x35, 0x7a, 0x67, 0xc2, 0x53, 0x5d, 0x9b, 0x80, 0xd5, 0x4e, 0x04, 0x37, 0x87, 0x33,
+  0x4f, 0x8f, 0x11, 0xe2, 0x2c, 0x0d, 0x75, 0x8d, 0xf2, 0x0d, 0x32, 0xc5, 0x08, 0x70, 0x9e, 0x92,
+  0xbc, 0x6b, 0xf9, 0x06, 0x21, 0xae, 0x60, 0xaa, 0xf0, 0xe7, 0x68, 0xa3, 0xdb, 0xa2, 0x06, 0xf2,
+  0x63, 0x11, 0xff, 0x6d, 0xfd, 0xf7, 0x82, 0x5d, 0x99, 0xfd, 0x47, 0x34, 0x3f, 0x4e, 0xe0, 0x87,
+  0x74, 0x3e, 0x4e, 0xa2, 0xd4, 0xf6, 0x24, 0x05, 0xd5, 0xd3, 0xed, 0xe1, 0x2b, 0xdb, 0xe8, 0x9d,
+  0x6a, 0xb3, 0x69, 0x92, 0xd3, 0xe2, 0x40, 0x63, 0xb1, 0x47, 0x4a, 0x1d, 0xaa, 0xb7, 0xc5, 0x99,
+  0x7a, 0x63, 0x3a, 0x25, 0xed, 0x02, 0xf6, 0x3b, 0x29, 0xcb, 0xab, 0xbe, 0xb3, 0xa4, 0x7b, 0xd7,
+  0x3b, 0xda, 0x8c, 0xfa, 0x9d, 0x12, 0xa3, 0xc9, 0x40, 0xa5, 0xb4, 0x1c, 0x30, 0x5f, 0x45, 0x8b,
+  0x33, 0x43, 0x24, 0x42, 0x54, 0x47, 0x85, 0xbc, 0x66, 0xf2, 0x4e, 0x95, 0x93, 0x27, 0x62, 0x12,
+  0x2b, 0x90, 0xfa, 0x71, 0x11, 0x30, 0xb2, 0xc4, 0xbb, 0x0c, 0x8e, 0x33, 0x56, 0xc1, 0xcf, 0x8e,
+  0x12, 0xc8, 0xf6, 0x5f, 0x3e, 0xbd, 0x7b, 0xeb, 0xe9, 0xba, 0x0b, 0x75, 0xcd, 0xc0, 0x4e, 0x39,
+  0x82, 0xc6, 0x30, 0x1a, 0x7a, 0x6a, 0xec, 0x75, 0xa3, 0x67, 0xcf, 0x76, 0x1d, 0x61, 0xc5, 0xd2,
+  0x87, 0x46, 0x52, 0xd0, 0x42, 0x44, 0x43, 0x57, 0xa3, 0xb7, 0x8e, 0xcd, 0x54, 0x3d, 0x9d, 0x23,
+  0x6c, 0x36, 0x22, 0x88, 0x72, 0x79, 0x7d, 0x35, 0xa9, 0xe5, 0x01, 0x54, 0x1c, 0x95, 0x04, 0x88,
+  0x52, 0x37, 0xa2, 0x94, 0x0d, 0x10, 0x6b, 0xe2, 0x42, 0x43, 0x5c, 0x09, 0x4c, 0xa0, 0x24, 0x24,
+  0xc1, 0xcb, 0x59, 0x14, 0x43, 0xe7, 0x05, 0x3b, 0xb5, 0x9e, 0xab, 0xb8, 0x10, 0x44, 0xf2, 0xa0,
+  0x62, 0xdd, 0xf4, 0x31, 0x2c, 0x81, 0xe5, 0xc5, 0x0c, 0x3a, 0x6a, 0x28, 0xda, 0xcc, 0xfe, 0x37,
+  0x4f, 0xa1, 0xb7, 0x2e, 0x56, 0xa0, 0x57, 0x2f, 0xa6, 0x37, 0x86, 0xc3, 0x46, 0x32, 0x15, 0xb3,
+  0xc7, 0x5e, 0xa1, 0xbd, 0xb9, 0x29, 0x86, 0xff, 0xdd, 0xde, 0xe9, 0x98, 0x48, 0x0a, 0x27, 0x35,
+  0x4c, 0x50, 0x58, 0xb1, 0xa1, 0xce, 0x23, 0xe9, 0x9c, 0xa6, 0xf1, 0x91, 0x41, 0x79, 0xb0, 0x44,
+  0x02, 0xfb, 0x0b, 0xe5, 0x69, 0x76, 0xd2, 0xe6, 0x02, 0x12, 0xc1, 0x15, 0xac, 0x46, 0x66, 0x3c,
+  0x14, 0xc1, 0xe8, 0xe9, 0x26, 0x82, 0x51, 0x1b, 0x58, 0x6d, 0x87, 0x1d, 0xf8, 0x7c, 0xa4, 0x15,
+  0x7f, 0xaa, 0x3d, 0xba, 0x02, 0x73, 0xf0, 0x5b, 0xfd, 0xfd, 0xdf, 0x75, 0x47, 0x37, 0xe8, 0x3c,
+  0x83, 0x06, 0x54, 0x3f, 0x05, 0x1c, 0xca, 0xeb, 0xd0, 0xaf, 0x5f, 0xbb, 0xa7, 0x00, 0x82, 0x9c,
+  0xc9, 0x6e, 0xeb, 0xaf, 0xf9, 0x39, 0xa8, 0x82, 0xe7, 0x78, 0x48, 0xb4, 0x19, 0xf8, 0xc9, 0x6b,
+  0x49, 0xbf, 0xe0, 0x78, 0x8e, 0xd7, 0x6c, 0xb7, 0xd2, 0xe7, 0x3b, 0xc1, 0x5b, 0x0a, 0x69, 0xb2,
+  0x16, 0x94, 0x03, 0x45, 0x32, 0x1a, 0x3b, 0x05, 0xe5, 0xb1, 0xab, 0x4c, 0x57, 0x0f, 0x03, 0xc1,
+  0x8a, 0xf3, 0xf1, 0xfb, 0x0b, 0x65, 0x11, 0x2a, 0xb5, 0xfc, 0xad, 0x05, 0x8f, 0xdb, 0x08, 0x24,
+  0xf7, 0x0c, 0x11, 0x79, 0x6b, 0x7b, 0xa2, 0x54, 0xa1, 0x7e, 0xf2, 0x7f, 0x10, 0x54, 0x81, 0xb7,
+  0xa3, 0x7a, 0x9e, 0xe8, 0xa7, 0xe3, 0x24, 0xc7, 0x3b, 0x92, 0xa5, 0xbd, 0xa4, 0xb1, 0xc6, 0x3f,
+  0x4a, 0xff, 0xfe, 0xb0, 0x28, 0x36, 0x85, 0x96, 0xdb, 0x87, 0x34, 0xab, 0x44, 0xc3, 0x4b, 0xdd,
+  0x3b, 0x36, 0xc5, 0x42, 0xa2, 0x82, 0x14, 0xaf, 0xf2, 0x4e, 0x97, 0x2e, 0xdc, 0x2d, 0x3b, 0x99,
+  0x62, 0x82, 0x19, 0x5f, 0xe0, 0xdd, 0x27, 0xb6, 0xf5, 0x27, 0xe5, 0x84, 0xfd, 0x12, 0x69, 0x7b,
+  0x81, 0x97, 0x8a, 0xe7, 0xa0, 0x71, 0x1f, 0x4b, 0xab, 0x6a, 0x9b, 0x54, 0xa7, 0xf8, 0xcc, 0x40,
+  0xc6, 0x90, 0xc9, 0xba, 0x7e, 0x3b, 0xbe, 0x90, 0x22, 0x3e, 0xdd, 0xe0, 0x63, 0x3b, 0x76, 0x74,
+  0xfd, 0x6c, 0x78, 0xc8, 0xdb, 0xed, 0x33, 0x4e, 0xc0, 0xfd, 0x86, 0x0f, 0x60, 0x4a, 0x61, 0x5e,
+  0x38, 0x7e, 0xb6, 0xb3, 0xcc, 0x19, 0x17, 0xc8, 0x3b, 0xf1, 0x1f, 0xa6, 0xce, 0xbe, 0x93, 0xba,
+  0xbc, 0x49, 0x3f, 0x43, 0x5d, 0xee, 0xff, 0x1f, 0x01, 0xa4, 0x2e, 0xc8, 0xf7, 0x18, 0x94, 0x71,
+  0xe0, 0x9d, 0x41, 0xc3, 0x9b, 0x79, 0x6c, 0x9e, 0xe1, 0xc1, 0xff, 0xe8, 0xfe, 0x69, 0xcd, 0xf9,
+  0xf4, 0x1c, 0xf8, 0x3b, 0x3e, 0xd5, 0xd5, 0x88, 0x1c, 0x96, 0xe3, 0x31, 0x60, 0x34, 0x4a, 0x6b,
+  0x21, 0x4b, 0x94, 0x4c, 0x6d, 0xdb, 0xd6, 0xdd, 0xba, 0x96, 0x6a, 0xa7, 0xa9, 0xa6, 0xb5, 0x99,
+  0x53, 0x31, 0x4b, 0x03, 0x47, 0xff, 0xf0, 0xfe, 0xfe, 0x93, 0x6e, 0x61, 0x21, 0x71, 0xc2, 0x6d,
+  0xfd, 0x5c, 0x40, 0xea, 0x46, 0xb1, 0x80, 0x35, 0x78, 0x9f, 0x23, 0xb3, 0xd3, 0x87, 0x5b, 0x3d,
+  0x7d, 0xd0, 0x9d, 0xfd, 0x2a, 0xb1, 0x35, 0x1b, 0xe5, 0xe7, 0x40, 0xd4, 0x90, 0x80, 0xde, 0x81,
+  0x2e, 0x0b, 0xd5, 0x99, 0x7e, 0x85, 0xd2, 0x87, 0x73, 0xc9, 0x0f, 0xdb, 0xb7, 0x73, 0x7e, 0x2e,
+  0x13, 0xea, 0xc9, 0x86, 0xf5, 0x78, 0x2c, 0x87, 0xd8, 0xc6, 0x3c, 0x74, 0xa4, 0x9f, 0x1b, 0x76,
+  0x8a, 0x1b, 0xf2, 0x61, 0xa7, 0xf8, 0x07, 0x2c, 0xf9, 0xff, 0xc0, 0xfe, 0x0b, 0x7f, 0x79, 0x21,
+  0xbc, 0x1d, 0x26, 0x00, 0x00
+};